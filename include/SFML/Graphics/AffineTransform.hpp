@@ -0,0 +1,321 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_AFFINETRANSFORM_HPP
+#define SFML_AFFINETRANSFORM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transform.hpp>
+#include <SFML/System/Vector2.hpp>
+
+
+namespace sf
+{
+class Angle;
+
+////////////////////////////////////////////////////////////
+/// \brief Compact 2D transform, without projection
+///
+////////////////////////////////////////////////////////////
+class AffineTransform
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an identity transform (a transform that does nothing).
+    ///
+    ////////////////////////////////////////////////////////////
+    constexpr AffineTransform();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a transform from a 2x3 matrix
+    ///
+    /// The third row of the matrix is implicitly (0, 0, 1).
+    ///
+    /// \param a00 Element (0, 0) of the matrix
+    /// \param a01 Element (0, 1) of the matrix
+    /// \param a02 Element (0, 2) of the matrix
+    /// \param a10 Element (1, 0) of the matrix
+    /// \param a11 Element (1, 1) of the matrix
+    /// \param a12 Element (1, 2) of the matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    constexpr AffineTransform(float a00, float a01, float a02,
+                              float a10, float a11, float a12);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the transform as a 2x3 matrix
+    ///
+    /// This function returns a pointer to an array of 6 floats
+    /// containing the elements of the matrix, row by row:
+    /// a00, a01, a02, a10, a11, a12.
+    ///
+    /// \return Pointer to a 2x3 matrix
+    ///
+    ////////////////////////////////////////////////////////////
+    constexpr const float* getMatrix() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the inverse of the transform
+    ///
+    /// If the inverse cannot be computed, an identity transform
+    /// is returned.
+    ///
+    /// \return A new transform which is the inverse of self
+    ///
+    ////////////////////////////////////////////////////////////
+    constexpr AffineTransform getInverse() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform a 2D point
+    ///
+    /// \param point Point to transform
+    ///
+    /// \return Transformed point
+    ///
+    ////////////////////////////////////////////////////////////
+    constexpr Vector2f transformPoint(const Vector2f& point) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Transform a rectangle
+    ///
+    /// The result is the axis-aligned bounding rectangle of the
+    /// transformed rectangle, like sf::Transform::transformRect.
+    ///
+    /// \param rectangle Rectangle to transform
+    ///
+    /// \return Transformed rectangle
+    ///
+    ////////////////////////////////////////////////////////////
+    constexpr FloatRect transformRect(const FloatRect& rectangle) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Combine the current transform with another one
+    ///
+    /// The result is a transform that is equivalent to applying
+    /// \a transform followed by *this. Mathematically, it is
+    /// equivalent to a matrix multiplication (*this) * transform.
+    ///
+    /// \param transform Transform to combine with this transform
+    ///
+    /// \return Reference to *this
+    ///
+    ////////////////////////////////////////////////////////////
+    constexpr AffineTransform& combine(const AffineTransform& transform);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Combine the current transform with a translation
+    ///
+    /// \param offset Translation offset to apply
+    ///
+    /// \return Reference to *this
+    ///
+    /// \see rotate, scale
+    ///
+    ////////////////////////////////////////////////////////////
+    constexpr AffineTransform& translate(const Vector2f& offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Combine the current transform with a rotation
+    ///
+    /// \param angle Rotation angle
+    ///
+    /// \return Reference to *this
+    ///
+    /// \see translate, scale
+    ///
+    ////////////////////////////////////////////////////////////
+    SFML_GRAPHICS_API AffineTransform& rotate(Angle angle);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Combine the current transform with a rotation
+    ///
+    /// The center of rotation is provided for convenience as a second
+    /// argument, like in sf::Transform::rotate.
+    ///
+    /// \param angle  Rotation angle
+    /// \param center Center of rotation
+    ///
+    /// \return Reference to *this
+    ///
+    /// \see translate, scale
+    ///
+    ////////////////////////////////////////////////////////////
+    SFML_GRAPHICS_API AffineTransform& rotate(Angle angle, const Vector2f& center);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Combine the current transform with a scaling
+    ///
+    /// \param factors Scaling factors
+    ///
+    /// \return Reference to *this
+    ///
+    /// \see translate, rotate
+    ///
+    ////////////////////////////////////////////////////////////
+    constexpr AffineTransform& scale(const Vector2f& factors);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Combine the current transform with a scaling
+    ///
+    /// \param factors Scaling factors
+    /// \param center  Center of scaling
+    ///
+    /// \return Reference to *this
+    ///
+    /// \see translate, rotate
+    ///
+    ////////////////////////////////////////////////////////////
+    constexpr AffineTransform& scale(const Vector2f& factors, const Vector2f& center);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Convert to a sf::Transform
+    ///
+    /// This allows affine transforms to be used wherever a
+    /// sf::Transform is expected, for example in render states.
+    ///
+    /// \return Equivalent sf::Transform
+    ///
+    ////////////////////////////////////////////////////////////
+    constexpr operator Transform() const;
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const AffineTransform Identity; //!< The identity transform (does nothing)
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    float m_matrix[6]; //!< 2x3 matrix defining the transformation, row by row
+};
+
+////////////////////////////////////////////////////////////
+/// \relates sf::AffineTransform
+/// \brief Overload of binary operator * to combine two transforms
+///
+/// \param left Left operand (the first transform)
+/// \param right Right operand (the second transform)
+///
+/// \return New combined transform
+///
+////////////////////////////////////////////////////////////
+constexpr AffineTransform operator *(const AffineTransform& left, const AffineTransform& right);
+
+////////////////////////////////////////////////////////////
+/// \relates sf::AffineTransform
+/// \brief Overload of binary operator *= to combine two transforms
+///
+/// \param left Left operand (the first transform)
+/// \param right Right operand (the second transform)
+///
+/// \return The combined transform
+///
+////////////////////////////////////////////////////////////
+constexpr AffineTransform& operator *=(AffineTransform& left, const AffineTransform& right);
+
+////////////////////////////////////////////////////////////
+/// \relates sf::AffineTransform
+/// \brief Overload of binary operator * to transform a point
+///
+/// \param left Left operand (the transform)
+/// \param right Right operand (the point to transform)
+///
+/// \return New transformed point
+///
+////////////////////////////////////////////////////////////
+constexpr Vector2f operator *(const AffineTransform& left, const Vector2f& right);
+
+////////////////////////////////////////////////////////////
+/// \relates sf::AffineTransform
+/// \brief Overload of binary operator == to compare two transforms
+///
+/// \param left Left operand (the first transform)
+/// \param right Right operand (the second transform)
+///
+/// \return true if the transforms are equal, false otherwise
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] constexpr bool operator ==(const AffineTransform& left, const AffineTransform& right);
+
+////////////////////////////////////////////////////////////
+/// \relates sf::AffineTransform
+/// \brief Overload of binary operator != to compare two transforms
+///
+/// \param left Left operand (the first transform)
+/// \param right Right operand (the second transform)
+///
+/// \return true if the transforms are not equal, false otherwise
+///
+////////////////////////////////////////////////////////////
+[[nodiscard]] constexpr bool operator !=(const AffineTransform& left, const AffineTransform& right);
+
+#include <SFML/Graphics/AffineTransform.inl>
+
+} // namespace sf
+
+
+#endif // SFML_AFFINETRANSFORM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::AffineTransform
+/// \ingroup graphics
+///
+/// sf::AffineTransform is a sf::Transform restricted to
+/// translations, rotations, scales and shears, which are all
+/// the transforms 2D entities need. It stores a 2x3 matrix
+/// (24 bytes) instead of the 4x4 matrix of sf::Transform
+/// (64 bytes), and combining, inverting or applying it skips
+/// the projective part of the matrix.
+///
+/// It is meant for large arrays of entities and for hierarchies
+/// of transforms, which are combined much more often than they
+/// are drawn. It converts implicitly to sf::Transform, which is
+/// the form OpenGL needs, when it is drawn.
+///
+/// sf::Transformable stores its transforms in this form.
+///
+/// Example:
+/// \code
+/// sf::AffineTransform parent;
+/// parent.translate({100, 50}).rotate(sf::degrees(30));
+///
+/// sf::AffineTransform child = parent * sf::AffineTransform().scale({2, 2});
+///
+/// window.draw(sprite, sf::Transform(child));
+/// \endcode
+///
+/// \see sf::Transform, sf::Transformable
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,214 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+
+////////////////////////////////////////////////////////////
+constexpr AffineTransform::AffineTransform()
+    // Identity matrix
+    : m_matrix{1.f, 0.f, 0.f,
+               0.f, 1.f, 0.f}
+{
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr AffineTransform::AffineTransform(float a00, float a01, float a02,
+                                           float a10, float a11, float a12)
+    : m_matrix{a00, a01, a02,
+               a10, a11, a12}
+{
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr const float* AffineTransform::getMatrix() const
+{
+    return m_matrix;
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr AffineTransform AffineTransform::getInverse() const
+{
+    const float* m = m_matrix;
+
+    // Compute the determinant of the linear part
+    float det = m[0] * m[4] - m[1] * m[3];
+
+    // Compute the inverse if the determinant is not zero
+    // (don't use an epsilon because the determinant may *really* be tiny)
+    if (det != 0.f)
+    {
+        return AffineTransform( m[4] / det, -m[1] / det, (m[1] * m[5] - m[4] * m[2]) / det,
+                               -m[3] / det,  m[0] / det, (m[3] * m[2] - m[0] * m[5]) / det);
+    }
+    else
+    {
+        return Identity;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr Vector2f AffineTransform::transformPoint(const Vector2f& point) const
+{
+    return Vector2f(m_matrix[0] * point.x + m_matrix[1] * point.y + m_matrix[2],
+                    m_matrix[3] * point.x + m_matrix[4] * point.y + m_matrix[5]);
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr FloatRect AffineTransform::transformRect(const FloatRect& rectangle) const
+{
+    // Each coordinate of the result is a sum of independent terms of x and y,
+    // its bounds are the sums of the bounds of the terms over the rectangle
+    const float* m = m_matrix;
+
+    const float x0 = m[0] * rectangle.left;
+    const float x1 = m[0] * (rectangle.left + rectangle.width);
+    const float x2 = m[1] * rectangle.top;
+    const float x3 = m[1] * (rectangle.top + rectangle.height);
+    const float y0 = m[3] * rectangle.left;
+    const float y1 = m[3] * (rectangle.left + rectangle.width);
+    const float y2 = m[4] * rectangle.top;
+    const float y3 = m[4] * (rectangle.top + rectangle.height);
+
+    const float left   = (x0 < x1 ? x0 : x1) + (x2 < x3 ? x2 : x3) + m[2];
+    const float right  = (x0 < x1 ? x1 : x0) + (x2 < x3 ? x3 : x2) + m[2];
+    const float top    = (y0 < y1 ? y0 : y1) + (y2 < y3 ? y2 : y3) + m[5];
+    const float bottom = (y0 < y1 ? y1 : y0) + (y2 < y3 ? y3 : y2) + m[5];
+
+    return FloatRect({left, top}, {right - left, bottom - top});
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr AffineTransform& AffineTransform::combine(const AffineTransform& transform)
+{
+    // Unlike the pixel loops of sf::Image, this stays scalar: SSE2/NEON intrinsics can't be
+    // used in constexpr functions, and an out-of-line SIMD version is slower than this inlined code
+    const float* a = m_matrix;
+    const float* b = transform.m_matrix;
+
+    *this = AffineTransform(a[0] * b[0] + a[1] * b[3],
+                            a[0] * b[1] + a[1] * b[4],
+                            a[0] * b[2] + a[1] * b[5] + a[2],
+                            a[3] * b[0] + a[4] * b[3],
+                            a[3] * b[1] + a[4] * b[4],
+                            a[3] * b[2] + a[4] * b[5] + a[5]);
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr AffineTransform& AffineTransform::translate(const Vector2f& offset)
+{
+    // Only the translation column changes
+    m_matrix[2] += m_matrix[0] * offset.x + m_matrix[1] * offset.y;
+    m_matrix[5] += m_matrix[3] * offset.x + m_matrix[4] * offset.y;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr AffineTransform& AffineTransform::scale(const Vector2f& factors)
+{
+    // Only the linear part changes
+    m_matrix[0] *= factors.x;
+    m_matrix[1] *= factors.y;
+    m_matrix[3] *= factors.x;
+    m_matrix[4] *= factors.y;
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr AffineTransform& AffineTransform::scale(const Vector2f& factors, const Vector2f& center)
+{
+    AffineTransform scaling(factors.x, 0,         center.x * (1 - factors.x),
+                            0,         factors.y, center.y * (1 - factors.y));
+
+    return combine(scaling);
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr AffineTransform::operator Transform() const
+{
+    return Transform(m_matrix[0], m_matrix[1], m_matrix[2],
+                     m_matrix[3], m_matrix[4], m_matrix[5],
+                     0.f,         0.f,         1.f);
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr AffineTransform operator *(const AffineTransform& left, const AffineTransform& right)
+{
+    return AffineTransform(left).combine(right);
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr AffineTransform& operator *=(AffineTransform& left, const AffineTransform& right)
+{
+    return left.combine(right);
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr Vector2f operator *(const AffineTransform& left, const Vector2f& right)
+{
+    return left.transformPoint(right);
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr bool operator ==(const AffineTransform& left, const AffineTransform& right)
+{
+    const float* a = left.getMatrix();
+    const float* b = right.getMatrix();
+
+    return ((a[0] == b[0]) && (a[1] == b[1]) && (a[2] == b[2]) &&
+            (a[3] == b[3]) && (a[4] == b[4]) && (a[5] == b[5]));
+}
+
+
+////////////////////////////////////////////////////////////
+constexpr bool operator !=(const AffineTransform& left, const AffineTransform& right)
+{
+    return !(left == right);
+}
+
+
+////////////////////////////////////////////////////////////
+// Static member data
+////////////////////////////////////////////////////////////
+
+// Note: the 'inline' keyword here is technically not required, but VS2019 fails
+// to compile with a bogus "multiple definition" error if not explicitly used.
+inline constexpr AffineTransform AffineTransform::Identity;
@@ -113,6 +113,10 @@ public:
     /// fonts installed on the user's system, thus you can't
     /// load them directly.
     ///
+    /// The file is mapped in memory rather than read, and fonts
+    /// loaded from the same file share the same mapping: loading
+    /// a file several times doesn't duplicate its data.
+    ///
     /// \warning SFML cannot preload all the font data in this
     /// function, so the file has to remain accessible until
     /// the sf::Font object loads a new font or is destroyed.
@@ -319,6 +323,40 @@ public:
     ////////////////////////////////////////////////////////////
     bool isSmooth() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable alpha-only glyph textures
+    ///
+    /// By default, the textures containing the glyphs store
+    /// white RGBA pixels whose alpha channel is the coverage
+    /// of the glyphs. Alpha-only textures store the coverage
+    /// alone, using 4 times less memory and upload bandwidth.
+    /// They render the same with the default pipeline, but
+    /// a shader sampling them gets black pixels (0, 0, 0, alpha):
+    /// such shaders should only use the alpha channel of the
+    /// texture to draw text.
+    ///
+    /// Changing this setting discards all the glyphs loaded so far.
+    /// Alpha-only textures are not supported with OpenGL ES, where
+    /// this setting has no effect. Alpha-only textures are disabled
+    /// by default.
+    ///
+    /// \param alphaOnly True to use alpha-only textures, false to use RGBA textures
+    ///
+    /// \see isAlphaOnly
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAlphaOnly(bool alphaOnly);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether the glyph textures only store an alpha channel
+    ///
+    /// \return True if alpha-only textures are enabled, false otherwise
+    ///
+    /// \see setAlphaOnly
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isAlphaOnly() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -347,7 +385,22 @@ private:
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    using GlyphTable = std::unordered_map<Uint64, Glyph>; //!< Table mapping a codepoint to its glyph
+    using GlyphTable   = std::unordered_map<Uint64, Glyph>; //!< Table mapping a codepoint to its glyph
+    using KerningTable = std::unordered_map<Uint64, float>; //!< Table mapping a pair of code points to their kerning
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Dense lookup table of the glyphs of one variant (boldness and outline thickness)
+    ///
+    /// The table covers the Basic Multilingual Plane and is split
+    /// into blocks of code points which are allocated on first use,
+    /// so that only the blocks actually in use take memory.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct GlyphLookup
+    {
+        Uint64                                 variant; //!< Boldness and outline thickness of the glyphs in the table
+        std::vector<std::vector<const Glyph*>> blocks;  //!< Blocks of glyphs, indexed by code point
+    };
 
     ////////////////////////////////////////////////////////////
     /// \brief Structure defining a page of glyphs
@@ -355,12 +408,40 @@ private:
     ////////////////////////////////////////////////////////////
     struct Page
     {
-        explicit Page(bool smooth);
-
-        GlyphTable       glyphs;  //!< Table mapping code points to their corresponding glyph
-        Texture          texture; //!< Texture containing the pixels of the glyphs
-        unsigned int     nextRow; //!< Y position of the next new row in the texture
-        std::vector<Row> rows;    //!< List containing the position of all the existing rows
+        Page(bool smooth, bool alphaOnly);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Copy constructor
+        ///
+        /// The dense lookup tables point into the glyph table of
+        /// the copied page, so they are not copied but rebuilt on demand.
+        ///
+        ////////////////////////////////////////////////////////////
+        Page(const Page& copy);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Copy assignment
+        ///
+        ////////////////////////////////////////////////////////////
+        Page& operator=(const Page& right);
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Get the dense lookup slot of a code point
+        ///
+        /// \param variant   Combined boldness and outline thickness of the glyph
+        /// \param codePoint Unicode code point, must be in the Basic Multilingual Plane
+        ///
+        /// \return Reference to the slot, null if the glyph was not looked up yet
+        ///
+        ////////////////////////////////////////////////////////////
+        const Glyph*& getGlyphSlot(Uint64 variant, Uint32 codePoint);
+
+        GlyphTable               glyphs;   //!< Table mapping code points to their corresponding glyph
+        std::vector<GlyphLookup> lookups;  //!< Dense lookup tables of the glyphs, one per variant in use
+        KerningTable             kernings; //!< Cache of the kerning offsets of the pairs already requested
+        Texture                  texture;  //!< Texture containing the pixels of the glyphs
+        unsigned int             nextRow;  //!< Y position of the next new row in the texture
+        std::vector<Row>         rows;     //!< List containing the position of all the existing rows
     };
 
     ////////////////////////////////////////////////////////////
@@ -425,6 +506,7 @@ private:
     ////////////////////////////////////////////////////////////
     std::shared_ptr<FontHandles>          m_fontHandles; //!< Shared information about the internal font instance
     bool                                  m_isSmooth;    //!< Status of the smooth filter
+    bool                                  m_isAlphaOnly; //!< Do the glyph textures only store the alpha channel?
     Info                                  m_info;        //!< Information about the font
     mutable PageTable                     m_pages;       //!< Table containing the glyphs pages by character size
     mutable std::vector<Uint8>            m_pixelBuffer; //!< Pixel buffer holding a glyph's pixels before being written to the texture
@@ -0,0 +1,271 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_FRAMERECORDER_HPP
+#define SFML_FRAMERECORDER_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <memory>
+
+
+namespace sf
+{
+class RenderTexture;
+class RenderWindow;
+
+////////////////////////////////////////////////////////////
+/// \brief Records the frames of a render target to a video file
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API FrameRecorder
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameRecorder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// The recording is stopped if it is still running.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~FrameRecorder();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameRecorder(const FrameRecorder&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    FrameRecorder& operator=(const FrameRecorder&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Start recording to a file
+    ///
+    /// The frames are written to the file in the YUV4MPEG2 (.y4m)
+    /// format, which most video players and encoders can read.
+    ///
+    /// \a bufferCount is the number of frames that can be in
+    /// flight at the same time, either being read back from the
+    /// graphics card or waiting to be written. When all of them
+    /// are in use, the captured frames are dropped instead of
+    /// waiting for the file to catch up. Each buffer holds the
+    /// RGBA pixels of one frame.
+    ///
+    /// If a recording is running, it is stopped first.
+    ///
+    /// \param filename    Path of the file to write
+    /// \param size        Size of the frames, in pixels
+    /// \param frameRate   Number of frames per second of the video
+    /// \param bufferCount Maximum number of frames in flight (at least 4)
+    ///
+    /// \return True if the recording was started
+    ///
+    /// \see stop
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool start(const std::filesystem::path& filename, const Vector2u& size, unsigned int frameRate = 60, std::size_t bufferCount = 8);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Stop recording
+    ///
+    /// The frames still in flight are written, then the file
+    /// is closed. This function does nothing if no recording
+    /// is running.
+    ///
+    /// \see start
+    ///
+    ////////////////////////////////////////////////////////////
+    void stop();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a recording is running
+    ///
+    /// \return True if the recorder is recording
+    ///
+    ////////////////////////////////////////////////////////////
+    bool isRecording() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture the current contents of a window
+    ///
+    /// This function must be called after drawing the frame and
+    /// before calling display() on the window. It activates the
+    /// window, and only issues the read of its pixels: they are
+    /// retrieved a few captures later, once the graphics card is
+    /// done with them, and written by a background thread.
+    ///
+    /// The size of the window must be the size of the recording.
+    ///
+    /// \param window Window to capture
+    ///
+    /// \return True if the frame was captured, false if it was dropped
+    ///
+    ////////////////////////////////////////////////////////////
+    bool capture(RenderWindow& window);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Capture the current contents of a render-texture
+    ///
+    /// This function must be called after calling display() on
+    /// the render-texture. Like for windows, the pixels are read
+    /// back and written asynchronously.
+    ///
+    /// The size of the render-texture must be the size of the
+    /// recording.
+    ///
+    /// \param renderTexture Render-texture to capture
+    ///
+    /// \return True if the frame was captured, false if it was dropped
+    ///
+    ////////////////////////////////////////////////////////////
+    bool capture(const RenderTexture& renderTexture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the recorded frames
+    ///
+    /// \return Size of the frames, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames written to the file
+    ///
+    /// The count is reset when a new recording is started.
+    ///
+    /// \return Number of frames written
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getFrameCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of frames that were dropped
+    ///
+    /// The count is reset when a new recording is started.
+    ///
+    /// \return Number of frames dropped
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint64 getDroppedFrameCount() const;
+
+private:
+
+    struct PixelBuffers;
+    struct Writer;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Read back a frame, through the pixel buffers if possible
+    ///
+    /// \param readPixels Function that reads the frame into the given
+    ///                   pointer, which is an offset in the bound pixel
+    ///                   buffer when pixel buffers are used
+    ///
+    /// \return True if the frame was captured
+    ///
+    ////////////////////////////////////////////////////////////
+    bool readFrame(const std::function<void(void*)>& readPixels);
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u                      m_size;         //!< Size of the recorded frames
+    std::unique_ptr<Writer>       m_writer;       //!< File, queue and thread writing the frames
+    std::unique_ptr<PixelBuffers> m_pixelBuffers; //!< Ring of pixel buffers used to read the frames back
+};
+
+} // namespace sf
+
+
+#endif // SFML_FRAMERECORDER_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::FrameRecorder
+/// \ingroup graphics
+///
+/// sf::FrameRecorder captures the frames rendered to a window
+/// or a render-texture, and writes them to a video file. It is
+/// meant for continuous capture, like recording replays, with
+/// as little impact as possible on the frame time:
+/// \li the pixels are read back into a ring of pixel buffer
+///     objects, and only retrieved a few frames later, so the
+///     rendering never waits for the graphics card to finish
+/// \li the conversion and the writes to the file happen in a
+///     background thread
+/// \li when the background thread can't keep up, frames are
+///     dropped instead of stalling the rendering
+///
+/// The video is written as an uncompressed YUV4MPEG2 stream
+/// (4:2:0, BT.601), which can be played or converted by most
+/// tools (ffmpeg, mpv, ...). The file is readable up to the last
+/// written frame at any time, even if the program ends without
+/// stopping the recording. Dropped frames are simply missing
+/// from the video.
+///
+/// When pixel buffer objects are not available (OpenGL ES, or
+/// OpenGL before 2.1), the pixels are read synchronously.
+///
+/// Usage example:
+/// \code
+/// sf::RenderWindow window(sf::VideoMode(1280, 720), "SFML window");
+///
+/// sf::FrameRecorder recorder;
+/// if (!recorder.start("replay.y4m", window.getSize()))
+/// {
+///     // Error...
+/// }
+///
+/// while (window.isOpen())
+/// {
+///     // Handle events...
+///
+///     window.clear();
+///     // Draw the frame...
+///     recorder.capture(window);
+///     window.display();
+/// }
+///
+/// recorder.stop();
+/// \endcode
+///
+/// \see sf::RenderWindow, sf::RenderTexture
+///
+////////////////////////////////////////////////////////////
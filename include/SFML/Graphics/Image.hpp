@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <filesystem>
 #include <string>
@@ -48,6 +49,64 @@ class SFML_GRAPHICS_API Image
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Filters available to resample an image
+    ///
+    ////////////////////////////////////////////////////////////
+    enum ResampleFilter
+    {
+        Nearest,  //!< Nearest pixel, fastest but blocky
+        Bilinear, //!< Linear interpolation (tent filter), smooth
+        Box,      //!< Average of the covered pixels, best suited to downsampling by integer factors (mipmaps)
+        Lanczos3  //!< Windowed sinc with 3 lobes, sharpest but slowest
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Settings of the encoders used to save images
+    ///
+    /// The settings that don't apply to the format being
+    /// saved are ignored.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct SaveSettings
+    {
+        ////////////////////////////////////////////////////////////
+        /// \brief Filters applied to the rows of PNG images before compression
+        ///
+        ////////////////////////////////////////////////////////////
+        enum PngFilter
+        {
+            AdaptiveFilter, //!< Best filter for each row, chosen by trying all of them (slowest)
+            NoFilter,       //!< No filter, fastest but usually compresses worst
+            SubFilter,      //!< Difference with the pixel on the left
+            UpFilter,       //!< Difference with the pixel above
+            AverageFilter,  //!< Difference with the average of the pixels on the left and above
+            PaethFilter     //!< Difference with the best predictor among the left, above and upper-left pixels
+        };
+
+        ////////////////////////////////////////////////////////////
+        /// \brief Default constructor
+        ///
+        /// \param pngLevel  Compression level of PNG images
+        /// \param filter    Filter of PNG images
+        /// \param quality   Quality of JPEG images
+        ///
+        ////////////////////////////////////////////////////////////
+        constexpr explicit SaveSettings(unsigned int pngLevel = 6, PngFilter filter = AdaptiveFilter, unsigned int quality = 90) :
+        pngCompressionLevel(pngLevel),
+        pngFilter          (filter),
+        jpegQuality        (quality)
+        {
+        }
+
+        ////////////////////////////////////////////////////////////
+        // Member data
+        ////////////////////////////////////////////////////////////
+        unsigned int pngCompressionLevel; //!< Compression effort of PNG images, from 1 (fastest) to 9 (smallest)
+        PngFilter    pngFilter;           //!< Filter applied to the rows of PNG images
+        unsigned int jpegQuality;         //!< Quality of JPEG images, from 1 (smallest) to 100 (best)
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -111,92 +170,179 @@ public:
     ////////////////////////////////////////////////////////////
     void create(unsigned int width, unsigned int height, const Uint8* pixels);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the image with a given pixel format
+    ///
+    /// The \a pixels array is assumed to contain pixels of the
+    /// given \a format, and have the given \a size. If not, this
+    /// is an undefined behavior.
+    /// If \a pixels is null, the pixels are filled with zeros.
+    ///
+    /// \param size   Size of the image
+    /// \param format Format of the pixels
+    /// \param pixels Array of pixels to copy to the image, can be null
+    ///
+    /// \see getPixelFormat, convert
+    ///
+    ////////////////////////////////////////////////////////////
+    void create(const Vector2u& size, PixelFormat format, const void* pixels = nullptr);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file on disk
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
+    /// psd, hdr, pic and qoi. Some format options are not supported,
     /// like progressive jpeg.
+    /// The pixels are decoded directly in the requested \a format:
+    /// 16-bit files keep their precision with R16 and the floating
+    /// point formats, and hdr files keep their range with the
+    /// floating point formats.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param filename Path of the image file to load
+    /// \param format   Format of the pixels of the image
     ///
     /// \return True if loading was successful
     ///
     /// \see loadFromMemory, loadFromStream, saveToFile
     ///
     ////////////////////////////////////////////////////////////
-    [[nodiscard]] bool loadFromFile(const std::filesystem::path& filename);
+    [[nodiscard]] bool loadFromFile(const std::filesystem::path& filename, PixelFormat format = RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a file in memory
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
+    /// psd, hdr, pic and qoi. Some format options are not supported,
     /// like progressive jpeg.
+    /// The pixels are decoded directly in the requested \a format:
+    /// 16-bit files keep their precision with R16 and the floating
+    /// point formats, and hdr files keep their range with the
+    /// floating point formats.
     /// If this function fails, the image is left unchanged.
     ///
-    /// \param data Pointer to the file data in memory
-    /// \param size Size of the data to load, in bytes
+    /// \param data   Pointer to the file data in memory
+    /// \param size   Size of the data to load, in bytes
+    /// \param format Format of the pixels of the image
     ///
     /// \return True if loading was successful
     ///
     /// \see loadFromFile, loadFromStream
     ///
     ////////////////////////////////////////////////////////////
-    [[nodiscard]] bool loadFromMemory(const void* data, std::size_t size);
+    [[nodiscard]] bool loadFromMemory(const void* data, std::size_t size, PixelFormat format = RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load the image from a custom stream
     ///
     /// The supported image formats are bmp, png, tga, jpg, gif,
-    /// psd, hdr and pic. Some format options are not supported,
+    /// psd, hdr, pic and qoi. Some format options are not supported,
     /// like progressive jpeg.
+    /// The pixels are decoded directly in the requested \a format:
+    /// 16-bit files keep their precision with R16 and the floating
+    /// point formats, and hdr files keep their range with the
+    /// floating point formats.
     /// If this function fails, the image is left unchanged.
     ///
     /// \param stream Source stream to read from
+    /// \param format Format of the pixels of the image
     ///
     /// \return True if loading was successful
     ///
     /// \see loadFromFile, loadFromMemory
     ///
     ////////////////////////////////////////////////////////////
-    [[nodiscard]] bool loadFromStream(InputStream& stream);
+    [[nodiscard]] bool loadFromStream(InputStream& stream, PixelFormat format = RGBA8);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Result of the loading of one image of a batch
+    ///
+    /// \see loadFromFiles, loadFromStreams
+    ///
+    ////////////////////////////////////////////////////////////
+    struct LoadResult;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load several images from files on disk, in parallel
+    ///
+    /// The files are decoded concurrently by the threads of the
+    /// library's thread pool and by the calling thread, which
+    /// is blocked until all of them are loaded.
+    /// A failure doesn't stop the batch: each result tells
+    /// whether its file was loaded, and the reason of the
+    /// failure otherwise. Unlike with loadFromFile, the failures
+    /// are not written to sf::err().
+    ///
+    /// \param filenames Paths of the image files to load
+    /// \param format    Format of the pixels of the images
+    ///
+    /// \return One result per file, in the same order
+    ///
+    /// \see loadFromFile, loadFromStreams
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::vector<LoadResult> loadFromFiles(const std::vector<std::filesystem::path>& filenames, PixelFormat format = RGBA8);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load several images from custom streams, in parallel
+    ///
+    /// This function works like loadFromFiles. Each stream is
+    /// read by a single thread, but not necessarily the calling
+    /// one; the streams must thus be distinct objects.
+    ///
+    /// \param streams Source streams to read from
+    /// \param format  Format of the pixels of the images
+    ///
+    /// \return One result per stream, in the same order
+    ///
+    /// \see loadFromStream, loadFromFiles
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::vector<LoadResult> loadFromStreams(const std::vector<InputStream*>& streams, PixelFormat format = RGBA8);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save the image to a file on disk
     ///
     /// The format of the image is automatically deduced from
     /// the extension. The supported image formats are bmp, png,
-    /// tga and jpg. The destination file is overwritten
+    /// tga, jpg and qoi. The destination file is overwritten
     /// if it already exists. This function fails if the image is empty.
+    /// R8, RGB8 and RGBA8 images are saved with their channels
+    /// (R8 as grayscale), the other formats are converted to
+    /// RGBA8 first (R16 to R8).
+    ///
+    /// QOI is a lossless format that is much faster to encode
+    /// and decode than PNG, for files of comparable size.
     ///
     /// \param filename Path of the file to save
+    /// \param settings Settings of the encoder
     ///
     /// \return True if saving was successful
     ///
     /// \see create, loadFromFile, loadFromMemory
     ///
     ////////////////////////////////////////////////////////////
-    [[nodiscard]] bool saveToFile(const std::filesystem::path& filename) const;
+    [[nodiscard]] bool saveToFile(const std::filesystem::path& filename, const SaveSettings& settings = SaveSettings()) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Save the image to a buffer in memory
     ///
     /// The format of the image must be specified.
-    /// The supported image formats are bmp, png, tga and jpg.
+    /// The supported image formats are bmp, png, tga, jpg and qoi.
     /// This function fails if the image is empty, or if
     /// the format was invalid.
+    /// The pixel formats are handled like in saveToFile.
     ///
-    /// \param output Buffer to fill with encoded data
-    /// \param format Encoding format to use
+    /// \param output   Buffer to fill with encoded data
+    /// \param format   Encoding format to use
+    /// \param settings Settings of the encoder
     ///
     /// \return True if saving was successful
     ///
     /// \see create, loadFromFile, loadFromMemory, saveToFile
     ///
     ////////////////////////////////////////////////////////////
-    [[nodiscard]] bool saveToMemory(std::vector<sf::Uint8>& output, const std::string& format) const;
+    [[nodiscard]] bool saveToMemory(std::vector<sf::Uint8>& output, const std::string& format, const SaveSettings& settings = SaveSettings()) const;
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the size (width and height) of the image
@@ -206,12 +352,44 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the format of the pixels of the image
+    ///
+    /// \return Pixel format of the image
+    ///
+    /// \see create, convert
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelFormat getPixelFormat() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a copy of the image with another pixel format
+    ///
+    /// Conversions between 8-bit formats only copy the channels,
+    /// other conversions go through floating point values:
+    /// normalized formats are mapped to [0, 1] and values out
+    /// of this range are clamped when converted back to them.
+    /// Missing color channels are set to 0 and a missing alpha
+    /// channel is opaque.
+    ///
+    /// Large images are processed by several threads.
+    ///
+    /// \param format Pixel format of the new image
+    ///
+    /// \return Converted image
+    ///
+    /// \see getPixelFormat
+    ///
+    ////////////////////////////////////////////////////////////
+    Image convert(PixelFormat format) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Create a transparency mask from a specified color-key
     ///
     /// This function sets the alpha value of every pixel matching
     /// the given color to \a alpha (0 by default), so that they
     /// become transparent.
+    /// Images without an alpha channel are left unchanged.
     ///
     /// \param color Color to make transparent
     /// \param alpha Alpha value to assign to transparent pixels
@@ -233,6 +411,9 @@ public:
     /// using the \b over operator. If it is false, the source
     /// pixels are copied unchanged with their alpha value.
     ///
+    /// If the source image has another pixel format, its
+    /// pixels are converted on the fly.
+    ///
     /// See https://en.wikipedia.org/wiki/Alpha_compositing for
     /// details on the \b over operator.
     ///
@@ -251,6 +432,7 @@ public:
     /// This function doesn't check the validity of the pixel
     /// coordinates, using out-of-range values will result in
     /// an undefined behavior.
+    /// The color is converted to the pixel format of the image.
     ///
     /// \param x     X coordinate of pixel to change
     /// \param y     Y coordinate of pixel to change
@@ -271,7 +453,7 @@ public:
     /// \param x X coordinate of pixel to get
     /// \param y Y coordinate of pixel to get
     ///
-    /// \return Color of the pixel at coordinates (x, y)
+    /// \return Color of the pixel at coordinates (x, y), converted to 8-bit RGBA
     ///
     /// \see setPixel
     ///
@@ -281,9 +463,11 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Get a read-only pointer to the array of pixels
     ///
-    /// The returned value points to an array of RGBA pixels made of
-    /// 8 bits integers components. The size of the array is
-    /// width * height * 4 (getSize().x * getSize().y * 4).
+    /// The returned value points to an array of pixels stored in
+    /// the format of the image (RGBA pixels made of 8 bits integers
+    /// components by default). The size of the array is
+    /// width * height * pixel size
+    /// (getSize().x * getSize().y * getPixelSize(getPixelFormat())).
     /// Warning: the returned pointer may become invalid if you
     /// modify the image, so you should never store it for too long.
     /// If the image is empty, a null pointer is returned.
@@ -305,15 +489,89 @@ public:
     ////////////////////////////////////////////////////////////
     void flipVertically();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a resampled copy of the image
+    ///
+    /// The image is filtered separately along each axis. When
+    /// downsampling, the filter is widened so that all the
+    /// source pixels contribute to the result.
+    /// The color components are weighted by the alpha of
+    /// their pixel, so that the color of transparent pixels
+    /// doesn't bleed into the visible ones.
+    ///
+    /// If \a sRgb is true, the color components are considered
+    /// to be sRGB encoded, and are converted to linear space
+    /// before being filtered, which gives correct brightness.
+    /// Only 8-bit formats can be sRGB encoded, the components
+    /// of the other formats are always considered linear.
+    ///
+    /// Large images are processed by several threads.
+    ///
+    /// \param size   Size of the resampled image, in pixels
+    /// \param filter Filter used to compute the new pixels
+    /// \param sRgb   Are the color components sRGB encoded?
+    ///
+    /// \return Resampled image, or an empty image if either size is empty
+    ///
+    /// \see resize, createMipmap
+    ///
+    ////////////////////////////////////////////////////////////
+    Image resample(const Vector2u& size, ResampleFilter filter = Bilinear, bool sRgb = false) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Resample the image to a new size
+    ///
+    /// This function is equivalent to replacing the image by
+    /// the result of resample.
+    ///
+    /// \param size   New size of the image, in pixels
+    /// \param filter Filter used to compute the new pixels
+    /// \param sRgb   Are the color components sRGB encoded?
+    ///
+    /// \see resample
+    ///
+    ////////////////////////////////////////////////////////////
+    void resize(const Vector2u& size, ResampleFilter filter = Bilinear, bool sRgb = false);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the mipmap levels of the image
+    ///
+    /// Each level is half the size of the previous one (rounded
+    /// down, and at least 1), down to a 1x1 level. The image
+    /// itself is the level 0 and is not part of the result.
+    /// The levels can be uploaded with sf::Texture::loadMipmap.
+    ///
+    /// \param filter Filter used to compute each level from the previous one
+    /// \param sRgb   Are the color components sRGB encoded?
+    ///
+    /// \return Levels 1 to N of the mipmap, empty if the image is empty
+    ///
+    /// \see resample, sf::Texture::loadMipmap
+    ///
+    ////////////////////////////////////////////////////////////
+    std::vector<Image> createMipmap(ResampleFilter filter = Box, bool sRgb = false) const;
+
 private:
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
     Vector2u           m_size;   //!< Image size
+    PixelFormat        m_format; //!< Format of the pixels
     std::vector<Uint8> m_pixels; //!< Pixels of the image
 };
 
+////////////////////////////////////////////////////////////
+/// \brief Result of the loading of one image of a batch
+///
+////////////////////////////////////////////////////////////
+struct Image::LoadResult
+{
+    Image       image;   //!< Loaded image, empty if the loading failed
+    bool        success; //!< Was the image loaded?
+    std::string error;   //!< Reason of the failure, empty on success
+};
+
 } // namespace sf
 
 
@@ -329,14 +587,14 @@ private:
 /// functions to load, read, write and save pixels, as well
 /// as many other useful functions.
 ///
-/// sf::Image can handle a unique internal representation of
-/// pixels, which is RGBA 32 bits. This means that a pixel
-/// must be composed of 8 bits red, green, blue and alpha
-/// channels -- just like a sf::Color.
-/// All the functions that return an array of pixels follow
-/// this rule, and all parameters that you pass to sf::Image
-/// functions (such as loadFromMemory) must use this
-/// representation as well.
+/// By default, sf::Image stores pixels as RGBA 32 bits. This
+/// means that a pixel is composed of 8 bits red, green, blue
+/// and alpha channels -- just like a sf::Color.
+/// Images can also be created, loaded or converted with
+/// another sf::PixelFormat, to save memory (R8, RG8, RGB8) or
+/// to keep more precision or range (R16, RGBA16F, RGBA32F).
+/// The array of pixels returned by getPixelsPtr, and the
+/// arrays passed to create, use the format of the image.
 ///
 /// A sf::Image can be copied, but it is a heavy resource and
 /// if possible you should always use [const] references to
@@ -361,6 +619,17 @@ private:
 /// color.a = 0;
 /// image.setPixel(0, 0, color);
 ///
+/// // Load many images at once, using all the cores
+/// std::vector<sf::Image::LoadResult> results = sf::Image::loadFromFiles({"a.png", "b.png", "c.jpg"});
+/// for (const sf::Image::LoadResult& result : results)
+/// {
+///     if (!result.success)
+///         std::cerr << "Failed to load an image: " << result.error << std::endl;
+/// }
+///
+/// // Make a thumbnail
+/// sf::Image thumbnail = background.resample({64, 64}, sf::Image::Lanczos3, true);
+///
 /// // Save the image to a file
 /// if (!image.saveToFile("result.png"))
 ///     return -1;
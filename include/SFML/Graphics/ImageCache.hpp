@@ -0,0 +1,169 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_IMAGECACHE_HPP
+#define SFML_IMAGECACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <filesystem>
+
+
+namespace sf
+{
+class Image;
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief On-disk cache of decoded images
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ImageCache
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct the cache from the directory that stores it
+    ///
+    /// The directory is created when the first entry is stored.
+    ///
+    /// \param directory Directory where the decoded images are stored
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ImageCache(const std::filesystem::path& directory);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a file, through the cache
+    ///
+    /// If the cache has an entry for the contents of the file and
+    /// the pixel format, the decoded pixels are read from it.
+    /// Otherwise the file is decoded like with Image::loadFromFile,
+    /// and a new entry is stored in the cache.
+    ///
+    /// If this function fails, the image is left unchanged.
+    ///
+    /// \param filename Path of the image file to load
+    /// \param image    Image to load
+    /// \param format   Format of the pixels of the image
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool loadImage(const std::filesystem::path& filename, Image& image, PixelFormat format = RGBA8) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load a texture from a file, through the cache
+    ///
+    /// This function works like loadImage, but the pixels are
+    /// uploaded directly from the cache entry (or the decoder),
+    /// without going through a sf::Image.
+    ///
+    /// \param filename Path of the image file to load
+    /// \param texture  Texture to load
+    /// \param area     Area of the image to load
+    /// \param format   Format of the pixels of the texture
+    ///
+    /// \return True if loading was successful
+    ///
+    /// \see loadImage, Texture::loadFromFile
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool loadTexture(const std::filesystem::path& filename, Texture& texture, const IntRect& area = IntRect(), PixelFormat format = RGBA8) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the entries of the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the directory that stores the cache
+    ///
+    /// \return Directory of the cache
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::filesystem::path& getDirectory() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::filesystem::path m_directory; //!< Directory where the entries are stored
+};
+
+} // namespace sf
+
+
+#endif // SFML_IMAGECACHE_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ImageCache
+/// \ingroup graphics
+///
+/// Decoding PNG or JPEG files takes much more time than reading
+/// raw pixels. sf::ImageCache stores the decoded pixels of the
+/// images it loads in a directory, so that the next loads of
+/// the same images, typically in the next runs of the program,
+/// only have to read them back.
+///
+/// The entries are identified by a hash of the contents of the
+/// source files, the requested pixel format and the version of
+/// the image decoders: they are never out of date, modified files
+/// (or new decoders) simply get new entries. Nothing prunes the
+/// entries that are not used anymore: they stay in the directory,
+/// and keep using disk space, until the cache is cleared.
+///
+/// The pixels of an entry are stored uncompressed and aligned,
+/// and the entries are memory-mapped when they are loaded: loading
+/// an image from the cache costs one copy of its pixels, and
+/// loading a texture is a direct upload from the mapped file.
+/// The entries are stored in the byte order of the machine, they
+/// are not meant to be shared between different platforms.
+///
+/// Several threads, or processes, can use the same cache at the
+/// same time.
+///
+/// Usage example:
+/// \code
+/// sf::ImageCache cache("cache/images");
+///
+/// sf::Texture texture;
+/// if (!cache.loadTexture("background.png", texture))
+/// {
+///     // Error...
+/// }
+/// \endcode
+///
+/// \see sf::Image, sf::Texture
+///
+////////////////////////////////////////////////////////////
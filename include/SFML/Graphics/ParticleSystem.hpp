@@ -0,0 +1,351 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_PARTICLESYSTEM_HPP
+#define SFML_PARTICLESYSTEM_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/System/Time.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Large set of simple particles, updated and drawn
+///        in bulk
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API ParticleSystem : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty system of white 1x1 particles, with no
+    /// acceleration and no texture.
+    ///
+    ////////////////////////////////////////////////////////////
+    ParticleSystem();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Emit a new particle
+    ///
+    /// Particles with a null or negative lifetime are ignored.
+    ///
+    /// \param position Initial position of the particle
+    /// \param velocity Initial velocity of the particle, in units per second
+    /// \param lifetime Time after which the particle disappears
+    ///
+    ////////////////////////////////////////////////////////////
+    void emit(const Vector2f& position, const Vector2f& velocity, Time lifetime);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move the particles and remove the dead ones
+    ///
+    /// The velocity of the particles is increased by the
+    /// acceleration, then their position by their velocity.
+    /// Particles which reach the end of their lifetime are
+    /// removed, which changes the order of the remaining ones.
+    ///
+    /// Large systems are updated by several threads.
+    ///
+    /// \param elapsed Time elapsed since the last update
+    ///
+    ////////////////////////////////////////////////////////////
+    void update(Time elapsed);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Preallocate memory for a number of particles
+    ///
+    /// \param count Number of particles
+    ///
+    ////////////////////////////////////////////////////////////
+    void reserve(std::size_t count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of living particles
+    ///
+    /// \return Number of particles
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getParticleCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position of a particle
+    ///
+    /// \param index Index of the particle, in [0, getParticleCount() - 1]
+    ///
+    /// \return Current position of the particle
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2f getParticlePosition(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color of a particle
+    ///
+    /// \param index Index of the particle, in [0, getParticleCount() - 1]
+    ///
+    /// \return Current color of the particle
+    ///
+    ////////////////////////////////////////////////////////////
+    Color getParticleColor(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the acceleration applied to all the particles
+    ///
+    /// \param acceleration Acceleration, in units per second squared
+    ///
+    /// \see getAcceleration
+    ///
+    ////////////////////////////////////////////////////////////
+    void setAcceleration(const Vector2f& acceleration);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the acceleration applied to all the particles
+    ///
+    /// \return Acceleration, in units per second squared
+    ///
+    /// \see setAcceleration
+    ///
+    ////////////////////////////////////////////////////////////
+    const Vector2f& getAcceleration() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the colors of the particles
+    ///
+    /// The color of a particle is interpolated linearly from
+    /// \a startColor, when it is emitted, to \a endColor, at
+    /// the end of its lifetime.
+    ///
+    /// \param startColor Color of the new particles
+    /// \param endColor   Color of the particles about to die
+    ///
+    /// \see getStartColor, getEndColor
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColors(const Color& startColor, const Color& endColor);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color of the new particles
+    ///
+    /// \return Start color
+    ///
+    /// \see setColors
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getStartColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color of the particles about to die
+    ///
+    /// \return End color
+    ///
+    /// \see setColors
+    ///
+    ////////////////////////////////////////////////////////////
+    const Color& getEndColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the size of the particles
+    ///
+    /// Particles are squares centered on their position.
+    ///
+    /// \param size Width and height of a particle
+    ///
+    /// \see getParticleSize
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParticleSize(float size);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the particles
+    ///
+    /// \return Width and height of a particle
+    ///
+    /// \see setParticleSize
+    ///
+    ////////////////////////////////////////////////////////////
+    float getParticleSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the texture of the particles
+    ///
+    /// The whole texture is mapped on each particle, and
+    /// modulated by its color. The texture must not be larger
+    /// than 32767 pixels in either dimension. Pass a null
+    /// pointer to draw plain squares.
+    ///
+    /// Only a pointer to the texture is kept: it must stay alive
+    /// as long as the system uses it.
+    ///
+    /// \param texture Texture of the particles
+    ///
+    /// \see getTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexture(const Texture* texture);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture of the particles
+    ///
+    /// \return Pointer to the texture, or a null pointer if none was set
+    ///
+    /// \see setTexture
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTexture() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Vertex of a particle quad (16 bytes)
+    ///
+    ////////////////////////////////////////////////////////////
+    struct ParticleVertex
+    {
+        Vector2f       position;  //!< 2D position of the vertex
+        Color          color;     //!< Color of the vertex
+        Vector2<Int16> texCoords; //!< Corner of the texture mapped to the vertex
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the particles to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(RenderTarget& target, const RenderStates& states) const override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the quads of a range of particles
+    ///
+    /// \param vertices Vertices of the first particle of the range
+    /// \param begin    Index of the first particle
+    /// \param end      Index past the last particle
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeQuads(ParticleVertex* vertices, std::size_t begin, std::size_t end) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Write the quads of all the particles
+    ///
+    /// \param vertices Vertices of the first particle
+    ///
+    ////////////////////////////////////////////////////////////
+    void writeAllQuads(ParticleVertex* vertices) const;
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<float>                  m_positionsX;   //!< Horizontal positions of the particles
+    std::vector<float>                  m_positionsY;   //!< Vertical positions of the particles
+    std::vector<float>                  m_velocitiesX;  //!< Horizontal velocities of the particles
+    std::vector<float>                  m_velocitiesY;  //!< Vertical velocities of the particles
+    std::vector<float>                  m_ages;         //!< Elapsed part of the lifetime of the particles, from 0 to 1
+    std::vector<float>                  m_agingRates;   //!< Inverse of the lifetime of the particles, in seconds
+    Vector2f                            m_acceleration; //!< Acceleration of all the particles
+    Color                               m_startColor;   //!< Color of the new particles
+    Color                               m_endColor;     //!< Color of the particles about to die
+    float                               m_size;         //!< Width and height of the particles
+    const Texture*                      m_texture;      //!< Texture of the particles
+    mutable VertexBuffer                m_buffer;       //!< Streaming buffer the quads are written to
+    mutable std::vector<ParticleVertex> m_vertices;     //!< Quads of the particles, when the buffer can't be mapped
+};
+
+} // namespace sf
+
+
+#endif // SFML_PARTICLESYSTEM_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::ParticleSystem
+/// \ingroup graphics
+///
+/// sf::ParticleSystem handles hundreds of thousands of simple
+/// particles: colored or textured squares which move under a
+/// common acceleration and fade from a color to another during
+/// their lifetime.
+///
+/// The attributes of the particles are stored in separate
+/// arrays (structure of arrays), so that the update loops work
+/// on contiguous floats, four particles at a time with SSE2 or
+/// NEON instructions when they are available.
+/// Large systems are split in chunks updated in parallel by
+/// the threads of SFML.
+///
+/// When drawn, the quads of the particles are written, also in
+/// parallel, directly into a mapped streaming vertex buffer
+/// with three copies, so that writing a frame doesn't wait for
+/// the graphics card to finish drawing the previous one. Only
+/// the vertices of the live particles are mapped. When
+/// vertex buffers can't be mapped, the quads are written to an
+/// array in memory and drawn from there.
+///
+/// Particles are drawn in world coordinates: the transform of
+/// the render states applies to all of them.
+///
+/// Usage example:
+/// \code
+/// sf::ParticleSystem particles;
+/// particles.setAcceleration({0.f, 98.f});
+/// particles.setColors(sf::Color::Yellow, sf::Color(255, 0, 0, 0));
+/// particles.setParticleSize(2.f);
+///
+/// while (window.isOpen())
+/// {
+///     for (int i = 0; i < 1000; ++i)
+///         particles.emit(emitterPosition, randomVelocity(), sf::seconds(2));
+///
+///     particles.update(clock.restart());
+///
+///     window.clear();
+///     window.draw(particles);
+///     window.display();
+/// }
+/// \endcode
+///
+/// \see sf::VertexBuffer
+///
+////////////////////////////////////////////////////////////
@@ -0,0 +1,105 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PIXELFORMAT_HPP
+#define SFML_PIXELFORMAT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \ingroup graphics
+/// \brief Memory layouts of the pixels of a sf::Image or sf::Texture
+///
+/// Channels are stored in the order of their name, without
+/// padding between pixels nor between rows. Multi-byte
+/// components are stored with the native byte order.
+///
+/// When a format is converted to a format with more channels,
+/// the missing color channels are set to 0 and the missing
+/// alpha channel is opaque, like OpenGL does when sampling
+/// such textures.
+///
+////////////////////////////////////////////////////////////
+enum PixelFormat
+{
+    R8,      //!< One 8-bit unsigned normalized channel
+    RG8,     //!< Two 8-bit unsigned normalized channels
+    RGB8,    //!< Three 8-bit unsigned normalized channels
+    RGBA8,   //!< Four 8-bit unsigned normalized channels, the default format
+    R16,     //!< One 16-bit unsigned normalized channel
+    RGBA16F, //!< Four 16-bit (half precision) floating point channels
+    RGBA32F  //!< Four 32-bit floating point channels
+};
+
+////////////////////////////////////////////////////////////
+/// \ingroup graphics
+/// \brief Get the number of channels of a pixel format
+///
+/// \param format Pixel format
+///
+/// \return Number of channels, between 1 and 4
+///
+////////////////////////////////////////////////////////////
+constexpr std::size_t getChannelCount(PixelFormat format)
+{
+    switch (format)
+    {
+        case R8:   return 1;
+        case RG8:  return 2;
+        case RGB8: return 3;
+        case R16:  return 1;
+        default:   return 4;
+    }
+}
+
+////////////////////////////////////////////////////////////
+/// \ingroup graphics
+/// \brief Get the size of one pixel of a pixel format
+///
+/// \param format Pixel format
+///
+/// \return Size of a pixel, in bytes
+///
+////////////////////////////////////////////////////////////
+constexpr std::size_t getPixelSize(PixelFormat format)
+{
+    switch (format)
+    {
+        case R16:     return 2;
+        case RGBA16F: return 8;
+        case RGBA32F: return 16;
+        default:      return getChannelCount(format);
+    }
+}
+
+} // namespace sf
+
+
+#endif // SFML_PIXELFORMAT_HPP
@@ -37,12 +37,14 @@
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <cstddef>
+#include <cstdint>
 
 
 namespace sf
 {
 class Drawable;
 class VertexBuffer;
+class VertexLayout;
 class Transform;
 
 ////////////////////////////////////////////////////////////
@@ -80,7 +82,7 @@ public:
     /// \param color Fill color to use to clear the render target
     ///
     ////////////////////////////////////////////////////////////
-    void clear(const Color& color = Color(0, 0, 0, 255));
+    virtual void clear(const Color& color = Color(0, 0, 0, 255));
 
     ////////////////////////////////////////////////////////////
     /// \brief Change the current active view
@@ -257,8 +259,27 @@ public:
     /// \param states      Render states to use for drawing
     ///
     ////////////////////////////////////////////////////////////
-    void draw(const Vertex* vertices, std::size_t vertexCount,
-              PrimitiveType type, const RenderStates& states = RenderStates::Default);
+    virtual void draw(const Vertex* vertices, std::size_t vertexCount,
+                      PrimitiveType type, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices in any format
+    ///
+    /// Unlike the sf::Vertex overload, the vertices are never
+    /// transformed by the CPU: this is meant for large arrays of
+    /// compact vertices, which are sent as is to the graphics card.
+    ///
+    /// \param vertices    Pointer to the first vertex
+    /// \param vertexCount Number of vertices in the array
+    /// \param layout      Layout of the vertices in memory
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    /// \see sf::VertexLayout
+    ///
+    ////////////////////////////////////////////////////////////
+    virtual void draw(const void* vertices, std::size_t vertexCount, const VertexLayout& layout,
+                      PrimitiveType type, const RenderStates& states = RenderStates::Default);
 
     ////////////////////////////////////////////////////////////
     /// \brief Draw primitives defined by a vertex buffer
@@ -278,7 +299,7 @@ public:
     /// \param states       Render states to use for drawing
     ///
     ////////////////////////////////////////////////////////////
-    void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
+    virtual void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default);
 
     ////////////////////////////////////////////////////////////
     /// \brief Return the size of the rendering region of the target
@@ -372,6 +393,12 @@ public:
     /// states needed by SFML are set, so that subsequent draw()
     /// calls will work as expected.
     ///
+    /// SFML keeps track of the bindings (textures, shader program,
+    /// vertex buffer, framebuffer) and of the blend mode of each
+    /// context to skip redundant OpenGL calls. This function
+    /// also forgets them, so it must be called after OpenGL code
+    /// which changes them.
+    ///
     /// Example:
     /// \code
     /// // OpenGL code here...
@@ -452,6 +479,27 @@ private:
     ////////////////////////////////////////////////////////////
     void setupDraw(bool useVertexCache, const RenderStates& states);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the vertex arrays to read vertices with a layout
+    ///
+    /// \param base   Address of the first vertex, or its offset in the bound vertex buffer
+    /// \param layout Layout of the vertices
+    /// \param states Render states to use for drawing
+    ///
+    /// \return True if the vertices can be drawn, false if their layout is not supported
+    ///
+    ////////////////////////////////////////////////////////////
+    bool setupVertexLayout(std::uintptr_t base, const VertexLayout& layout, const RenderStates& states);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Restore the vertex arrays changed by setupVertexLayout
+    ///
+    /// \param layout Layout of the vertices
+    /// \param states Render states used for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void cleanupVertexLayout(const VertexLayout& layout, const RenderStates& states);
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the primitives
     ///
@@ -525,6 +573,15 @@ private:
 /// OpenGL states are not messed up by calling the
 /// pushGLStates/popGLStates functions.
 ///
-/// \see sf::RenderWindow, sf::RenderTexture, sf::View
+/// Vertices don't have to be sf::Vertex: vertices in other
+/// formats, which are often smaller, can be drawn by describing
+/// their layout with sf::VertexLayout.
+///
+/// Targets which don't render with OpenGL, like
+/// sf::SoftwareRenderTarget, override the clear and draw
+/// functions taking vertices: all the drawables end up
+/// calling them.
+///
+/// \see sf::RenderWindow, sf::RenderTexture, sf::SoftwareRenderTarget, sf::View, sf::VertexLayout
 ///
 ////////////////////////////////////////////////////////////
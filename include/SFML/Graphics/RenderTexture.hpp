@@ -29,10 +29,13 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Window/ContextSettings.hpp>
+#include <initializer_list>
 #include <memory>
+#include <vector>
 
 
 namespace sf
@@ -87,6 +90,34 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] bool create(unsigned int width, unsigned int height, const ContextSettings& settings = ContextSettings());
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the render-texture with several target textures
+    ///
+    /// One texture is created for each format, and everything
+    /// drawn to the render-texture is rendered to all of them at
+    /// once. Fragment shaders write a different color to each
+    /// texture with gl_FragData[i], where i is the index of the
+    /// texture; without shader, or with a shader writing
+    /// gl_FragColor, the same color is written to all of them.
+    ///
+    /// The first texture is the one returned by getTexture(),
+    /// the others are retrieved with getTexture(index).
+    /// Formats which are not supported by the system fall back
+    /// to RGBA8, like in Texture::create, and the sRgbCapable
+    /// flag of \a settings only affects RGBA8 textures.
+    ///
+    /// \param width    Width of the render-texture
+    /// \param height   Height of the render-texture
+    /// \param formats  Formats of the target textures, from 1 to getMaximumTextureCount()
+    /// \param settings Additional settings for the underlying OpenGL textures and context
+    ///
+    /// \return True if creation has been successful
+    ///
+    /// \see getMaximumTextureCount, getTextureCount
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool create(unsigned int width, unsigned int height, std::initializer_list<PixelFormat> formats, const ContextSettings& settings = ContextSettings());
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the maximum anti-aliasing level supported by the system
     ///
@@ -95,10 +126,22 @@ public:
     ////////////////////////////////////////////////////////////
     static unsigned int getMaximumAntialiasingLevel();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of textures a render-texture can render to at once
+    ///
+    /// The value is 1 on systems which support neither frame
+    /// buffer objects nor multiple draw buffers (OpenGL 2.0).
+    ///
+    /// \return The maximum number of target textures supported by the system
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumTextureCount();
+
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable texture smoothing
     ///
-    /// This function is similar to Texture::setSmooth.
+    /// This function is similar to Texture::setSmooth, and
+    /// applies to all the target textures.
     /// This parameter is disabled by default.
     ///
     /// \param smooth True to enable smoothing, false to disable it
@@ -121,7 +164,8 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief Enable or disable texture repeating
     ///
-    /// This function is similar to Texture::setRepeated.
+    /// This function is similar to Texture::setRepeated, and
+    /// applies to all the target textures.
     /// This parameter is disabled by default.
     ///
     /// \param repeated True to enable repeating, false to disable it
@@ -145,7 +189,7 @@ public:
     /// \brief Generate a mipmap using the current texture data
     ///
     /// This function is similar to Texture::generateMipmap and operates
-    /// on the texture used as the target for drawing.
+    /// on the textures used as the targets for drawing.
     /// Be aware that any draw operation may modify the base level image data.
     /// For this reason, calling this function only makes sense after all
     /// drawing is completed and display has been called. Not calling display
@@ -175,9 +219,9 @@ public:
     [[nodiscard]] bool setActive(bool active = true) override;
 
     ////////////////////////////////////////////////////////////
-    /// \brief Update the contents of the target texture
+    /// \brief Update the contents of the target textures
     ///
-    /// This function updates the target texture with what
+    /// This function updates the target textures with what
     /// has been drawn so far. Like for windows, calling this
     /// function is mandatory at the end of rendering. Not calling
     /// it may leave the texture in an undefined state.
@@ -224,13 +268,49 @@ public:
     ////////////////////////////////////////////////////////////
     const Texture& getTexture() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a read-only reference to one of the target textures
+    ///
+    /// Index 0 is the texture returned by getTexture(). Like it,
+    /// the other textures are always the same instances, as long
+    /// as the render-texture is not created again with fewer
+    /// textures.
+    ///
+    /// \param index Index of the texture, in the order of the formats given to create
+    ///
+    /// \return Const reference to the texture
+    ///
+    /// \see getTextureCount
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture& getTexture(std::size_t index) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of target textures
+    ///
+    /// \return Number of textures drawn to, 1 unless several formats were given to create
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getTextureCount() const;
+
 private:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get one of the target textures
+    ///
+    /// \param index Index of the texture
+    ///
+    /// \return Reference to the texture
+    ///
+    ////////////////////////////////////////////////////////////
+    Texture& getTargetTexture(std::size_t index);
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    std::unique_ptr<priv::RenderTextureImpl> m_impl;    //!< Platform/hardware specific implementation
-    Texture                                  m_texture; //!< Target texture to draw on
+    std::unique_ptr<priv::RenderTextureImpl> m_impl;          //!< Platform/hardware specific implementation
+    Texture                                  m_texture;       //!< Target texture to draw on
+    std::vector<std::unique_ptr<Texture>>    m_extraTextures; //!< Additional target textures, drawn to at the same time as m_texture
 };
 
 } // namespace sf
@@ -295,6 +375,25 @@ private:
 /// }
 /// \endcode
 ///
+/// A render-texture can also render to several textures at once,
+/// for example to fill the buffers of a deferred lighting pass
+/// in a single draw: a shader writes each output to one texture
+/// with gl_FragData.
+///
+/// \code
+/// sf::RenderTexture gBuffer;
+/// if (!gBuffer.create(500, 500, {sf::RGBA8, sf::RGBA16F}))
+///     return -1;
+///
+/// // the fragment shader writes gl_FragData[0] and gl_FragData[1]
+/// gBuffer.clear();
+/// gBuffer.draw(sprite, &geometryShader);
+/// gBuffer.display();
+///
+/// const sf::Texture& albedo = gBuffer.getTexture(0);
+/// const sf::Texture& normals = gBuffer.getTexture(1);
+/// \endcode
+///
 /// Like sf::RenderWindow, sf::RenderTexture is still able to render direct
 /// OpenGL stuff. It is even possible to mix together OpenGL calls
 /// and regular SFML drawing commands. If you need a depth buffer for
@@ -0,0 +1,357 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_SCENEGRAPH_HPP
+#define SFML_SCENEGRAPH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/AffineTransform.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <vector>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Hierarchy of transformable nodes, with cached
+///        world transforms and bounds
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SceneGraph : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Identifier of a node
+    ///
+    ////////////////////////////////////////////////////////////
+    using NodeId = std::size_t;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates a graph which only contains the root node.
+    ///
+    ////////////////////////////////////////////////////////////
+    SceneGraph();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a node
+    ///
+    /// The node is added as the last child of \a parent (or of
+    /// the root if \a parent doesn't exist), with an identity
+    /// transform, empty bounds and nothing to draw. Creating
+    /// nodes invalidates the references returned by
+    /// getTransformable.
+    ///
+    /// \param parent Parent of the new node
+    ///
+    /// \return Identifier of the new node
+    ///
+    ////////////////////////////////////////////////////////////
+    NodeId createNode(NodeId parent = Root);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove a node and all its descendants
+    ///
+    /// The root can't be removed. The identifiers of removed
+    /// nodes may be reused by the next nodes created.
+    ///
+    /// \param node Node to remove
+    ///
+    ////////////////////////////////////////////////////////////
+    void removeNode(NodeId node);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Move a node and its descendants under another parent
+    ///
+    /// The node becomes the last child of \a parent. Nothing
+    /// happens if \a parent is the node itself or one of its
+    /// descendants.
+    ///
+    /// \param node   Node to move
+    /// \param parent New parent of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    void setParent(NodeId node, NodeId parent);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the parent of a node
+    ///
+    /// \param node Node to query
+    ///
+    /// \return Parent of the node (the root is its own parent)
+    ///
+    ////////////////////////////////////////////////////////////
+    NodeId getParent(NodeId node) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Tell whether a node exists
+    ///
+    /// \param node Node to check
+    ///
+    /// \return True if the node was created and not removed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool contains(NodeId node) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of nodes, including the root
+    ///
+    /// \return Number of nodes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getNodeCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local transform of a node, to modify it
+    ///
+    /// The transform of the node is relative to its parent.
+    /// This function marks the node as modified: its world
+    /// transform, and the ones of its descendants, are
+    /// recomputed the next time they are needed. Nodes which
+    /// are not accessed this way keep their cached transforms.
+    ///
+    /// The reference is invalidated when nodes are created,
+    /// removed or moved, and by the next update that follows.
+    ///
+    /// \param node Node to modify
+    ///
+    /// \return Reference to the transformable of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    Transformable& getTransformable(NodeId node);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local transform of a node
+    ///
+    /// \param node Node to query
+    ///
+    /// \return Const reference to the transformable of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    const Transformable& getTransformable(NodeId node) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the drawable attached to a node
+    ///
+    /// The drawable is drawn with the world transform of the
+    /// node, combined with its own transform if it has one.
+    /// Only a pointer is kept: the drawable must stay alive as
+    /// long as it is attached.
+    ///
+    /// \param node     Node to modify
+    /// \param drawable Drawable to attach, or a null pointer to detach it
+    ///
+    ////////////////////////////////////////////////////////////
+    void setDrawable(NodeId node, const Drawable* drawable);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the bounds of a node, in its local coordinates
+    ///
+    /// Nodes with bounds are culled when drawn: they are skipped
+    /// if their world bounds are outside of the view of the
+    /// target. Nodes with empty bounds (the default) are always
+    /// drawn.
+    ///
+    /// \param node   Node to modify
+    /// \param bounds Local bounds of the node, typically the
+    ///               local bounds of its drawable
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLocalBounds(NodeId node, const FloatRect& bounds);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the world transform of a node
+    ///
+    /// The world transform combines the transforms of all the
+    /// ancestors of the node with its own transform.
+    ///
+    /// \param node Node to query
+    ///
+    /// \return World transform of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    const AffineTransform& getWorldTransform(NodeId node) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the inverse of the world transform of a node
+    ///
+    /// It is computed the first time it is requested after the
+    /// world transform changed.
+    ///
+    /// \param node Node to query
+    ///
+    /// \return Inverse world transform of the node
+    ///
+    ////////////////////////////////////////////////////////////
+    const AffineTransform& getInverseWorldTransform(NodeId node) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounds of a node, in world coordinates
+    ///
+    /// \param node Node to query
+    ///
+    /// \return Local bounds of the node transformed by its world transform
+    ///
+    ////////////////////////////////////////////////////////////
+    const FloatRect& getWorldBounds(NodeId node) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Recompute the world transforms of the modified nodes
+    ///
+    /// This is done automatically when the world transforms are
+    /// needed. Calling it explicitly moves the cost to a chosen
+    /// point of the frame, for example before a parallel pass
+    /// which reads the transforms.
+    ///
+    ////////////////////////////////////////////////////////////
+    void update() const;
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static constexpr NodeId Root = 0; //!< Identifier of the root node
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the nodes to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(RenderTarget& target, const RenderStates& states) const override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Put the nodes back in depth-first order
+    ///
+    ////////////////////////////////////////////////////////////
+    void sortNodes() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the index of a node in the node array
+    ///
+    /// \param node Node to look up
+    ///
+    /// \return Index of the node, or the index of the root if it doesn't exist
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getIndex(NodeId node) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Node data
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Node
+    {
+        Transformable   transformable;         //!< Transform of the node, relative to its parent
+        AffineTransform worldTransform;        //!< Cached world transform
+        AffineTransform inverseWorldTransform; //!< Cached inverse world transform
+        FloatRect       localBounds;           //!< Bounds of the node, in local coordinates
+        FloatRect       worldBounds;           //!< Cached bounds of the node, in world coordinates
+        const Drawable* drawable;              //!< Drawable attached to the node, if any
+        NodeId          id;                    //!< Identifier of the node
+        NodeId          parent;                //!< Identifier of the parent
+        std::size_t     parentIndex;           //!< Index of the parent in the node array
+        std::size_t     end;                   //!< Index following the last descendant in the node array
+        bool            modified;              //!< Was the node modified since the last update?
+        bool            inverseNeedUpdate;     //!< Does the inverse world transform need to be recomputed?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    mutable std::vector<Node>        m_nodes;    //!< Nodes, in depth-first order once sorted
+    mutable std::vector<std::size_t> m_indices;  //!< Index of each node in m_nodes, by identifier
+    mutable std::vector<NodeId>      m_modified; //!< Identifiers of the nodes modified since the last update
+    std::vector<NodeId>              m_freeIds;  //!< Identifiers of removed nodes, to reuse
+    mutable bool                     m_needSort; //!< Were nodes created or moved since the last sort?
+};
+
+} // namespace sf
+
+
+#endif // SFML_SCENEGRAPH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SceneGraph
+/// \ingroup graphics
+///
+/// Entities made of parts that move together, like a character
+/// holding a weapon or a ship carrying turrets, are usually
+/// drawn by combining the transform of each part with the one
+/// of its parent. Doing it in every draw recomputes every
+/// transform of the hierarchy in every frame, even when nothing
+/// moved.
+///
+/// sf::SceneGraph stores such a hierarchy of nodes. Each node
+/// has a local transform (a sf::Transformable, relative to its
+/// parent), optional local bounds and an optional drawable.
+/// The graph caches the world transform of every node, its
+/// inverse and the world bounds, and only recomputes them for
+/// the nodes that were modified through getTransformable() and
+/// their descendants.
+///
+/// The nodes are stored contiguously, in depth-first order, so
+/// that the descendants of a node always follow it in memory:
+/// updating a modified subtree is a linear pass over a range
+/// of the array. Creating, removing and moving nodes only marks
+/// the order as invalid; it is restored, in linear time, the
+/// next time the transforms are needed.
+///
+/// Drawing the graph draws the drawables attached to the nodes
+/// in depth-first order (parents before their children), and
+/// skips the nodes whose world bounds are outside of the view.
+///
+/// Usage example:
+/// \code
+/// sf::SceneGraph scene;
+///
+/// sf::SceneGraph::NodeId ship = scene.createNode();
+/// scene.setDrawable(ship, &shipSprite);
+/// scene.setLocalBounds(ship, shipSprite.getLocalBounds());
+///
+/// sf::SceneGraph::NodeId turret = scene.createNode(ship);
+/// scene.getTransformable(turret).setPosition({20, 0});
+/// scene.setDrawable(turret, &turretSprite);
+///
+/// // the turret follows the ship
+/// scene.getTransformable(ship).move({5, 0});
+///
+/// window.draw(scene);
+/// \endcode
+///
+/// \see sf::Transformable, sf::AffineTransform
+///
+////////////////////////////////////////////////////////////
@@ -587,6 +587,11 @@ public:
     /// // draw OpenGL stuff that use no shader...
     /// \endcode
     ///
+    /// The bound shaders are tracked to skip redundant calls:
+    /// if you also change the program with OpenGL functions, call
+    /// sf::RenderTarget::resetGLStates (or use pushGLStates and
+    /// popGLStates) before using SFML again.
+    ///
     /// \param shader Shader to bind, can be null to use no shader
     ///
     ////////////////////////////////////////////////////////////
@@ -625,6 +630,8 @@ public:
 
 private:
 
+    friend class RenderTarget;
+
     ////////////////////////////////////////////////////////////
     /// \brief Compile the shader(s) and create the program
     ///
@@ -659,6 +666,19 @@ private:
     ////////////////////////////////////////////////////////////
     int getUniformLocation(const std::string& name);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the location ID of a vertex attribute
+    ///
+    /// Unlike uniforms, a missing attribute is not an error:
+    /// vertex layouts can have attributes that a shader doesn't use.
+    ///
+    /// \param name Name of the attribute variable to search
+    ///
+    /// \return Location ID of the attribute, or -1 if not found
+    ///
+    ////////////////////////////////////////////////////////////
+    int getAttributeLocation(const std::string& name) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief RAII object to save and restore the program
     ///        binding while uniforms are being set
@@ -671,16 +691,18 @@ private:
     ////////////////////////////////////////////////////////////
     // Types
     ////////////////////////////////////////////////////////////
-    using TextureTable = std::unordered_map<int, const Texture *>;
-    using UniformTable = std::unordered_map<std::string, int>;
+    using TextureTable   = std::unordered_map<int, const Texture *>;
+    using UniformTable   = std::unordered_map<std::string, int>;
+    using AttributeTable = std::unordered_map<std::string, int>;
 
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    unsigned int m_shaderProgram;  //!< OpenGL identifier for the program
-    int          m_currentTexture; //!< Location of the current texture in the shader
-    TextureTable m_textures;       //!< Texture variables in the shader, mapped to their location
-    UniformTable m_uniforms;       //!< Parameters location cache
+    unsigned int           m_shaderProgram;  //!< OpenGL identifier for the program
+    int                    m_currentTexture; //!< Location of the current texture in the shader
+    TextureTable           m_textures;       //!< Texture variables in the shader, mapped to their location
+    UniformTable           m_uniforms;       //!< Parameters location cache
+    mutable AttributeTable m_attributes;     //!< Vertex attributes location cache
 };
 
 } // namespace sf
@@ -0,0 +1,309 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_SOFTWARERENDERTARGET_HPP
+#define SFML_SOFTWARERENDERTARGET_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <memory>
+#include <vector>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Target for 2D rendering into an image, without OpenGL
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API SoftwareRenderTarget : public RenderTarget
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs an empty target. You must call create to
+    /// have a valid target.
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    SoftwareRenderTarget();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~SoftwareRenderTarget() override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the target
+    ///
+    /// The contents of the target are initialized to transparent
+    /// black, and the view is reset to the default view.
+    /// Sizes are limited to 16384 x 16384 pixels.
+    ///
+    /// \param width  Width of the target, in pixels
+    /// \param height Height of the target, in pixels
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool create(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Clear the entire target with a single color
+    ///
+    /// Everything drawn since the last call to display() and
+    /// not rendered yet is discarded.
+    ///
+    /// \param color Fill color to use to clear the target
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear(const Color& color = Color(0, 0, 0, 255)) override;
+
+    using RenderTarget::draw;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices
+    ///
+    /// The primitives are only queued, they are rendered by
+    /// display(). If the states have a texture, its pixels are
+    /// read back from the graphics card the first time it is
+    /// used, and again after it is modified. Shaders are not
+    /// supported and ignored.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives textured with an image
+    ///
+    /// This overload doesn't need an OpenGL driver to texture
+    /// the primitives. The texture coordinates of the vertices
+    /// are in pixels of the image, the image is sampled with
+    /// the nearest pixel and the coordinates are clamped to its
+    /// bounds. The texture of the states is ignored.
+    ///
+    /// The image is not copied: it must stay alive and must not
+    /// be modified until display() or clear() is called.
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param texture     Image to texture the primitives with
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const Vertex* vertices, std::size_t vertexCount,
+              PrimitiveType type, const Image& texture, const RenderStates& states = RenderStates::Default);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by an array of vertices in any format
+    ///
+    /// The position, color and texture coordinates of the
+    /// vertices are converted to sf::Vertex, custom attributes
+    /// are ignored like shaders.
+    ///
+    /// \param vertices    Pointer to the first vertex
+    /// \param vertexCount Number of vertices in the array
+    /// \param layout      Layout of the vertices in memory
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const void* vertices, std::size_t vertexCount, const VertexLayout& layout,
+              PrimitiveType type, const RenderStates& states = RenderStates::Default) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw primitives defined by a vertex buffer
+    ///
+    /// The vertices of vertex buffers only exist in the graphics
+    /// card memory, they can't be rendered by software targets:
+    /// this function prints an error and does nothing.
+    ///
+    /// \param vertexBuffer Vertex buffer
+    /// \param firstVertex  Index of the first vertex to render
+    /// \param vertexCount  Number of vertices to render
+    /// \param states       Render states to use for drawing
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(const VertexBuffer& vertexBuffer, std::size_t firstVertex, std::size_t vertexCount, const RenderStates& states = RenderStates::Default) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Render the queued primitives and update the image
+    ///
+    /// The primitives are rasterized by tiles, in parallel, then
+    /// the image returned by getImage() is updated. The result
+    /// doesn't depend on the number of threads nor on the
+    /// machine: the same primitives always produce the same
+    /// pixels.
+    ///
+    /// \see getImage
+    ///
+    ////////////////////////////////////////////////////////////
+    void display();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the size of the target
+    ///
+    /// \return Size in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate or deactivate the target for rendering
+    ///
+    /// Software targets have no OpenGL context, they can't be
+    /// activated: this function only succeeds when \a active
+    /// is false.
+    ///
+    /// \param active True to activate, false to deactivate
+    ///
+    /// \return True if operation was successful, false otherwise
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool setActive(bool active = true) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the image the target renders to
+    ///
+    /// The image is only updated by display().
+    ///
+    /// \return Const reference to the image
+    ///
+    /// \see display
+    ///
+    ////////////////////////////////////////////////////////////
+    const Image& getImage() const;
+
+private:
+
+    struct Batch;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue primitives with the current view
+    ///
+    /// \param vertices    Pointer to the vertices
+    /// \param vertexCount Number of vertices in the array
+    /// \param type        Type of primitives to draw
+    /// \param states      Render states to use for drawing
+    /// \param texture     Image to sample the texels from (can be a null pointer)
+    /// \param smooth      Is the texture sampled with bilinear filtering?
+    /// \param repeated    Are the texture coordinates wrapped, rather than clamped?
+    ///
+    ////////////////////////////////////////////////////////////
+    void queue(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states,
+               const Image* texture, bool smooth, bool repeated);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rasterize the queued primitives into the pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void flush();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u               m_size;   //!< Size of the target
+    std::vector<Uint8>     m_pixels; //!< Pixels being rendered to (RGBA)
+    Image                  m_image;  //!< Image holding the pixels of the last displayed frame
+    std::unique_ptr<Batch> m_batch;  //!< Queued primitives and the textures they sample
+};
+
+} // namespace sf
+
+
+#endif // SFML_SOFTWARERENDERTARGET_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::SoftwareRenderTarget
+/// \ingroup graphics
+///
+/// sf::SoftwareRenderTarget is a render target which renders
+/// with the CPU into a sf::Image, without any OpenGL context.
+/// It is meant for servers and continuous integration machines
+/// which have no graphics driver, or a broken one, and for
+/// comparing rendered images: its output is deterministic, the
+/// same vertices, transforms and states produce the same pixels
+/// on every machine. The vertices of shapes, sprites and texts
+/// and the combined transforms are computed by code built with
+/// the flags of your compiler though, so the same scene may
+/// produce slightly different vertices, and pixels, on machines
+/// with different floating point instructions (like fused
+/// multiply-adds).
+///
+/// Everything that can be drawn to a render target can be drawn
+/// to it, with views, transforms and blend modes. Like render
+/// textures, what is drawn becomes visible after display(),
+/// which renders the queued primitives in parallel, by tiles
+/// of the target.
+///
+/// The rasterization follows the rules of OpenGL for triangles
+/// (pixel centers, top-left fill rule), so the output is very
+/// close to what graphics cards render. Lines are one pixel
+/// wide and cover the pixels whose center they cross along
+/// their major axis; points cover the pixel they fall in.
+///
+/// Limitations:
+/// \li shaders are ignored
+/// \li sf::VertexBuffer can't be drawn
+/// \li no sRGB conversion is done
+/// \li sf::Texture needs a graphics driver to be read back:
+///     without one, use the draw overload taking a sf::Image
+///
+/// Usage example:
+///
+/// \code
+/// sf::SoftwareRenderTarget target;
+/// if (!target.create(500, 500))
+///     return -1;
+///
+/// sf::CircleShape circle(100.f);
+/// circle.setFillColor(sf::Color::Green);
+///
+/// target.clear(sf::Color::Black);
+/// target.draw(circle);
+/// target.display();
+///
+/// if (!target.getImage().saveToFile("circle.png"))
+///     return -1;
+/// \endcode
+///
+/// \see sf::RenderTarget, sf::RenderTexture, sf::Image
+///
+////////////////////////////////////////////////////////////
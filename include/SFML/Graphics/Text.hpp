@@ -133,6 +133,25 @@ public:
     ////////////////////////////////////////////////////////////
     void setString(const String& string);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Append a string at the end of the text's string
+    ///
+    /// Unlike setting the whole string, appending keeps the
+    /// geometry of the existing characters: only the appended
+    /// characters are laid out when the text is next drawn
+    /// or measured. This is well suited to texts that grow
+    /// over time, such as logs or chat windows.
+    ///
+    /// Note that setString also only lays out again the lines
+    /// that follow the first changed character.
+    ///
+    /// \param string String to append
+    ///
+    /// \see setString, getString
+    ///
+    ////////////////////////////////////////////////////////////
+    void appendString(const String& string);
+
     ////////////////////////////////////////////////////////////
     /// \brief Set the text's font
     ///
@@ -377,6 +396,47 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2f findCharacterPos(std::size_t index) const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Find the index of the character closest to a position
+    ///
+    /// This function is the inverse of findCharacterPos: it returns
+    /// the index of the caret position closest to \a position, which
+    /// is in global coordinates. It can be used for hit-testing,
+    /// for example to place a caret where the user clicked.
+    /// The line is selected by the vertical coordinate, and the
+    /// character within the line by the horizontal coordinate.
+    /// Like findCharacterPos, this function only uses the glyph
+    /// metrics and doesn't need the text's geometry.
+    ///
+    /// \param position Position to test, in global coordinates
+    ///
+    /// \return Index of the character, in range [0, getString().getSize()]
+    ///
+    /// \see findCharacterPos
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t findCharacterIndex(const Vector2f& position) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the text's string, wrapped to fit a given width
+    ///
+    /// Line breaks are inserted so that no line is wider than
+    /// \a width, in local coordinates: spaces are replaced by line
+    /// breaks when possible, and words that don't fit on a line
+    /// of their own are broken between two characters. Trailing
+    /// spaces are allowed to exceed the width. The existing line
+    /// breaks are kept.
+    ///
+    /// The text itself is not modified; pass the result to
+    /// setString to display the wrapped text.
+    ///
+    /// \param width Maximum width of a line, in local coordinates
+    ///
+    /// \return Wrapped string
+    ///
+    ////////////////////////////////////////////////////////////
+    String getWrappedString(float width) const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the local bounding rectangle of the entity
     ///
@@ -386,6 +446,9 @@ public:
     /// In other words, this function returns the bounds of the
     /// entity in the entity's coordinate system.
     ///
+    /// If the text's geometry is outdated, the bounds are
+    /// measured from the glyph metrics without building it.
+    ///
     /// \return Local bounding rectangle of the entity
     ///
     ////////////////////////////////////////////////////////////
@@ -407,6 +470,8 @@ public:
 
 private:
 
+    friend class TextBatch;
+
     ////////////////////////////////////////////////////////////
     /// \brief Draw the text to a render target
     ///
@@ -425,23 +490,56 @@ private:
     ////////////////////////////////////////////////////////////
     void ensureGeometryUpdate() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Compute the local bounds from the glyph metrics
+    ///
+    /// This produces the same bounds as ensureGeometryUpdate,
+    /// without generating any vertex.
+    ///
+    /// \return Local bounding rectangle of the text
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect measureLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief State of the layout before a given character
+    ///
+    /// Checkpoints are stored at the beginning of every line and
+    /// at the end of the string, so that the layout can resume
+    /// from the line of the first changed character rather
+    /// than from the beginning of the string.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct LayoutCheckpoint
+    {
+        std::size_t index;              //!< Index of the next character to lay out
+        Uint32      prevChar;           //!< Previous character, used for kerning
+        Vector2f    position;           //!< Position of the next character
+        std::size_t vertexCount;        //!< Number of fill vertices generated so far
+        std::size_t outlineVertexCount; //!< Number of outline vertices generated so far
+        Vector2f    min;                //!< Minimum coordinates of the bounds so far
+        Vector2f    max;                //!< Maximum coordinates of the bounds so far
+    };
+
     ////////////////////////////////////////////////////////////
     // Member data
     ////////////////////////////////////////////////////////////
-    String              m_string;              //!< String to display
-    const Font*         m_font;                //!< Font used to display the string
-    unsigned int        m_characterSize;       //!< Base size of characters, in pixels
-    float               m_letterSpacingFactor; //!< Spacing factor between letters
-    float               m_lineSpacingFactor;   //!< Spacing factor between lines
-    Uint32              m_style;               //!< Text style (see Style enum)
-    Color               m_fillColor;           //!< Text fill color
-    Color               m_outlineColor;        //!< Text outline color
-    float               m_outlineThickness;    //!< Thickness of the text's outline
-    mutable VertexArray m_vertices;            //!< Vertex array containing the fill geometry
-    mutable VertexArray m_outlineVertices;     //!< Vertex array containing the outline geometry
-    mutable FloatRect   m_bounds;              //!< Bounding rectangle of the text (in local coordinates)
-    mutable bool        m_geometryNeedUpdate;  //!< Does the geometry need to be recomputed?
-    mutable Uint64      m_fontTextureId;       //!< The font texture id
+    String                                m_string;              //!< String to display
+    const Font*                           m_font;                //!< Font used to display the string
+    unsigned int                          m_characterSize;       //!< Base size of characters, in pixels
+    float                                 m_letterSpacingFactor; //!< Spacing factor between letters
+    float                                 m_lineSpacingFactor;   //!< Spacing factor between lines
+    Uint32                                m_style;               //!< Text style (see Style enum)
+    Color                                 m_fillColor;           //!< Text fill color
+    Color                                 m_outlineColor;        //!< Text outline color
+    float                                 m_outlineThickness;    //!< Thickness of the text's outline
+    mutable VertexArray                   m_vertices;            //!< Vertex array containing the fill geometry
+    mutable VertexArray                   m_outlineVertices;     //!< Vertex array containing the outline geometry
+    mutable FloatRect                     m_bounds;              //!< Bounding rectangle of the text (in local coordinates)
+    mutable bool                          m_geometryNeedUpdate;  //!< Does the geometry need to be recomputed?
+    mutable std::size_t                   m_firstChangedChar;    //!< Index of the first character changed since the last update (String::InvalidPos if none)
+    mutable Uint64                        m_fontTextureId;       //!< The font texture id
+    mutable std::vector<LayoutCheckpoint> m_checkpoints;         //!< Checkpoints of the current layout, sorted by index
 };
 
 } // namespace sf
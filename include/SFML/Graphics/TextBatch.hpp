@@ -0,0 +1,190 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_TEXTBATCH_HPP
+#define SFML_TEXTBATCH_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <optional>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Collection of texts drawn together, with one draw call per font page
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TextBatch : public Drawable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty batch.
+    ///
+    ////////////////////////////////////////////////////////////
+    TextBatch();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remove all the texts from the batch
+    ///
+    /// The memory allocated for the geometry is kept, so that
+    /// a batch which is refilled every frame doesn't allocate.
+    ///
+    ////////////////////////////////////////////////////////////
+    void clear();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a text to the batch
+    ///
+    /// The geometry of the text is copied, transformed by the
+    /// text's transform. Modifying or destroying the text after
+    /// this call has no effect on the batch.
+    /// Texts without a font are ignored.
+    ///
+    /// \param text Text to add
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const Text& text);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a string to the batch
+    ///
+    /// This is a shortcut that avoids creating a sf::Text for
+    /// each label: the string is laid out with the given
+    /// attributes and its top-left corner is put at \a position.
+    ///
+    /// \param string        String to add
+    /// \param font          Font used to draw the string
+    /// \param characterSize Base size of characters, in pixels
+    /// \param position      Position of the string
+    /// \param fillColor     Fill color of the string
+    /// \param style         Style of the string (see sf::Text::Style)
+    ///
+    ////////////////////////////////////////////////////////////
+    void append(const String& string, const Font& font, unsigned int characterSize, const Vector2f& position,
+                const Color& fillColor = Color::White, Uint32 style = Text::Regular);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the bounding rectangle of the batch
+    ///
+    /// The returned rectangle encloses all the texts of the
+    /// batch, in the batch's coordinate system. It is empty
+    /// if the batch has no geometry.
+    ///
+    /// \return Bounding rectangle of the batch
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getBounds() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the batch to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(RenderTarget& target, const RenderStates& states) const override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry of the texts which use the same font page
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Page
+    {
+        Page(const Texture* pageTexture);
+
+        const Texture* texture;         //!< Texture of the font page
+        VertexArray    vertices;        //!< Fill geometry of all the texts using this page
+        VertexArray    outlineVertices; //!< Outline geometry of all the texts using this page
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<Page>        m_pages;   //!< Geometry of the batch, grouped by font page
+    std::optional<FloatRect> m_bounds;  //!< Bounding rectangle of the batch, empty if the batch has no geometry
+    Text                     m_scratch; //!< Text reused to lay out the strings added without a sf::Text
+};
+
+} // namespace sf
+
+
+#endif // SFML_TEXTBATCH_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TextBatch
+/// \ingroup graphics
+///
+/// sf::TextBatch collects the geometry of many texts into
+/// shared vertex arrays, so that they can be drawn with as
+/// few draw calls as possible. This is useful when a lot of
+/// small texts are displayed at the same time, like labels,
+/// name plates or damage numbers, since drawing each sf::Text
+/// separately costs one draw call per text (two with an
+/// outline).
+///
+/// The texts are grouped by font page, that is by font and
+/// character size: each page is drawn with one draw call for
+/// the outlines and one for the fills. As a consequence, the
+/// outlines of all the texts of a page are drawn below all
+/// their fills, regardless of the order in which the texts
+/// were added.
+///
+/// A batch only keeps a pointer to the textures of the fonts
+/// that it uses: fonts must outlive the batch, and the batch
+/// must be refilled after a font is reloaded or its
+/// alpha-only mode is changed.
+///
+/// The batch is meant to be refilled every frame: clear()
+/// keeps the allocated memory, so that refilling it is cheap.
+///
+/// Usage example:
+/// \code
+/// sf::TextBatch batch;
+///
+/// // Every frame
+/// batch.clear();
+/// for (const auto& enemy : enemies)
+///     batch.append(enemy.name, font, 14, enemy.position + sf::Vector2f(0, -20));
+///
+/// window.draw(batch);
+/// \endcode
+///
+/// \see sf::Text, sf::Font
+///
+////////////////////////////////////////////////////////////
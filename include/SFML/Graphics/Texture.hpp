@@ -30,9 +30,11 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Window/GlResource.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
 #include <SFML/Graphics/Rect.hpp>
 #include <filesystem>
 #include <string>
+#include <vector>
 
 
 namespace sf
@@ -99,6 +101,33 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] bool create(unsigned int width, unsigned int height);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture with a given pixel format
+    ///
+    /// The pixel format defines how the texture is stored in
+    /// the graphics card memory, and the format of the pixels
+    /// expected by the update functions that take raw pixels.
+    /// Formats with less than 4 channels are sampled with the
+    /// missing color channels set to 0 and an opaque alpha.
+    ///
+    /// Formats other than RGB8 and RGBA8 require OpenGL 3.0;
+    /// when they are not supported, a RGBA8 texture is created
+    /// instead (check getPixelFormat).
+    /// The sRGB conversion only applies to RGBA8 textures.
+    ///
+    /// If this function fails, the texture is left unchanged.
+    ///
+    /// \param width  Width of the texture
+    /// \param height Height of the texture
+    /// \param format Format of the pixels
+    ///
+    /// \return True if creation was successful
+    ///
+    /// \see getPixelFormat
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool create(unsigned int width, unsigned int height, PixelFormat format);
+
     ////////////////////////////////////////////////////////////
     /// \brief Load the texture from a file on disk
     ///
@@ -205,6 +234,8 @@ public:
     /// The maximum size for a texture depends on the graphics
     /// driver and can be retrieved with the getMaximumSize function.
     ///
+    /// The texture is created with the pixel format of the image.
+    ///
     /// If this function fails, the texture is left unchanged.
     ///
     /// \param image Image to load into the texture
@@ -225,6 +256,16 @@ public:
     ////////////////////////////////////////////////////////////
     Vector2u getSize() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Return the format of the pixels of the texture
+    ///
+    /// \return Pixel format of the texture
+    ///
+    /// \see create
+    ///
+    ////////////////////////////////////////////////////////////
+    PixelFormat getPixelFormat() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the texture pixels to an image
     ///
@@ -232,6 +273,7 @@ public:
     /// the texture's pixels from the graphics card and copies
     /// them to a new image, potentially applying transformations
     /// to pixels if necessary (texture may be padded or flipped).
+    /// The image has the pixel format of the texture.
     ///
     /// \return Image containing the texture's pixels
     ///
@@ -244,7 +286,8 @@ public:
     /// \brief Update the whole texture from an array of pixels
     ///
     /// The \a pixel array is assumed to have the same size as
-    /// the \a area rectangle, and to contain 32-bits RGBA pixels.
+    /// the \a area rectangle, and to contain pixels in the format
+    /// of the texture (32-bits RGBA pixels by default).
     ///
     /// No additional check is performed on the size of the pixel
     /// array, passing invalid arguments will lead to an undefined
@@ -262,7 +305,8 @@ public:
     /// \brief Update a part of the texture from an array of pixels
     ///
     /// The size of the \a pixel array must match the \a width and
-    /// \a height arguments, and it must contain 32-bits RGBA pixels.
+    /// \a height arguments, and it must contain pixels in the format
+    /// of the texture (32-bits RGBA pixels by default).
     ///
     /// No additional check is performed on the size of the pixel
     /// array or the bounds of the area to update, passing invalid
@@ -511,6 +555,34 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] bool generateMipmap();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Upload a mipmap computed on the CPU
+    ///
+    /// Instead of letting the driver generate the mipmap like
+    /// generateMipmap, this function uploads levels computed
+    /// beforehand, for example with sf::Image::createMipmap,
+    /// which gives control over their filtering and allows
+    /// computing them in advance. The levels are uploaded one
+    /// by one, starting from the level 1.
+    ///
+    /// \a levels must contain the complete chain of levels that
+    /// follow the current contents of the texture: each level
+    /// must be half the size of the previous one (rounded down,
+    /// and at least 1), down to a 1x1 level. Levels with another
+    /// pixel format than the texture are converted.
+    ///
+    /// Like with generateMipmap, the mipmap is discarded the next
+    /// time the base level image is modified.
+    ///
+    /// \param levels Levels 1 to N of the mipmap
+    ///
+    /// \return True if the mipmap was successfully uploaded
+    ///
+    /// \see generateMipmap, sf::Image::createMipmap
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool loadMipmap(const std::vector<Image>& levels);
+
     ////////////////////////////////////////////////////////////
     /// \brief Overload of assignment operator
     ///
@@ -568,6 +640,11 @@ public:
     /// coordinates more intuitive for the high-level API, users don't need
     /// to compute normalized values.
     ///
+    /// The bound textures are tracked to skip redundant calls:
+    /// if you also bind textures with OpenGL functions, call
+    /// sf::RenderTarget::resetGLStates (or use pushGLStates and
+    /// popGLStates) before using SFML again.
+    ///
     /// \param texture Pointer to the texture to bind, can be null to use no texture
     /// \param coordinateType Type of texture coordinates to use
     ///
@@ -588,9 +665,51 @@ public:
 
 private:
 
+    friend class Font;
+    friend class ImageCache;
     friend class Text;
     friend class RenderTexture;
     friend class RenderTarget;
+    friend class SoftwareRenderTarget;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the texture with a pixel format, or with a single alpha channel
+    ///
+    /// Alpha-only textures store one byte per pixel, and expect
+    /// one byte per pixel in the update functions that take
+    /// raw pixels. When sampled, their color is (0, 0, 0, alpha),
+    /// thus the default pipeline modulates the vertex color
+    /// by the alpha channel. They are used by sf::Font
+    /// for its glyph pages.
+    ///
+    /// Alpha-only textures are not supported with OpenGL ES,
+    /// a regular RGBA texture is created instead.
+    ///
+    /// \param width     Width of the texture
+    /// \param height    Height of the texture
+    /// \param format    Format of the pixels, ignored for alpha-only textures
+    /// \param alphaOnly True to store only the alpha channel
+    ///
+    /// \return True if creation was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool create(unsigned int width, unsigned int height, PixelFormat format, bool alphaOnly);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load the texture from an array of pixels
+    ///
+    /// This function works like loadFromImage, with pixels
+    /// that don't belong to a sf::Image.
+    ///
+    /// \param pixels Array of tightly packed pixels
+    /// \param size   Size of the array of pixels
+    /// \param format Format of the pixels
+    /// \param area   Area of the pixels to load
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool loadFromPixels(const Uint8* pixels, const Vector2u& size, PixelFormat format, const IntRect& area);
 
     ////////////////////////////////////////////////////////////
     /// \brief Get a valid image size according to hardware support
@@ -628,6 +747,8 @@ private:
     mutable bool m_pixelsFlipped; //!< To work around the inconsistency in Y orientation
     bool         m_fboAttachment; //!< Is this texture owned by a framebuffer object?
     bool         m_hasMipmap;     //!< Has the mipmap been generated?
+    bool         m_alphaOnly;     //!< Does the texture only store an alpha channel?
+    PixelFormat  m_format;        //!< Format of the pixels
     Uint64       m_cacheId;       //!< Unique number that identifies the texture to the render target's cache
 };
 
@@ -658,7 +779,9 @@ private:
 ///
 /// A texture can be loaded from an image, but also directly
 /// from a file/memory/stream. The necessary shortcuts are defined
-/// so that you don't need an image first for the most common cases.
+/// so that you don't need an image first for the most common cases:
+/// they upload the pixels as soon as they are decoded, without
+/// copying them to an intermediate image.
 /// However, if you want to perform some modifications on the pixels
 /// before creating the final texture, you can load your file to a
 /// sf::Image, do whatever you need with the pixels, and then call
@@ -0,0 +1,292 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_TILEMAP_HPP
+#define SFML_TILEMAP_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/Transformable.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VertexLayout.hpp>
+#include <vector>
+
+
+namespace sf
+{
+class Texture;
+
+////////////////////////////////////////////////////////////
+/// \brief Grid of tiles from a tileset, drawn by chunks
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API TileMap : public Drawable, public Transformable
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Creates an empty map, with no tileset.
+    ///
+    ////////////////////////////////////////////////////////////
+    TileMap();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the map
+    ///
+    /// All the tiles of the new map are empty. The size of a
+    /// chunk (ChunkSize x ChunkSize tiles) in pixels must fit
+    /// in 16-bit integers, which limits tiles to 1023 x 1023
+    /// pixels.
+    ///
+    /// \param size       Size of the map, in tiles
+    /// \param tileSize   Size of a tile, in pixels
+    /// \param layerCount Number of layers of tiles
+    ///
+    /// \return True if creation has been successful
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool create(const Vector2u& size, const Vector2u& tileSize, unsigned int layerCount = 1);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the texture holding the images of the tiles
+    ///
+    /// The tileset is a grid of tiles of the size given to
+    /// create(), numbered from 1, row by row, from its top-left
+    /// corner. The texture must not be larger than 32767 pixels
+    /// in either dimension.
+    ///
+    /// Only a pointer to the texture is kept: it must stay alive
+    /// as long as the map uses it.
+    ///
+    /// \param tileset Texture of the tiles
+    ///
+    /// \see getTileset
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTileset(const Texture& tileset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture holding the images of the tiles
+    ///
+    /// \return Pointer to the tileset, or a null pointer if none was set
+    ///
+    /// \see setTileset
+    ///
+    ////////////////////////////////////////////////////////////
+    const Texture* getTileset() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change a tile
+    ///
+    /// Tile 0 is empty, nothing is drawn. Tile n is the n-th
+    /// image of the tileset; tiles beyond the last image of
+    /// the tileset are not drawn. Only the geometry of the chunk
+    /// which contains the tile is rebuilt, the next time it
+    /// is drawn.
+    ///
+    /// \param layer    Layer of the tile
+    /// \param position Position of the tile in the map, in tiles
+    /// \param tile     New tile
+    ///
+    /// \see getTile, setTiles
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTile(unsigned int layer, const Vector2u& position, Uint16 tile);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Change all the tiles of a layer
+    ///
+    /// \param layer Layer to modify
+    /// \param tiles Array of size.x * size.y tiles, row by row
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTiles(unsigned int layer, const Uint16* tiles);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a tile
+    ///
+    /// \param layer    Layer of the tile
+    /// \param position Position of the tile in the map, in tiles
+    ///
+    /// \return The tile, or 0 if the position is out of the map
+    ///
+    /// \see setTile
+    ///
+    ////////////////////////////////////////////////////////////
+    Uint16 getTile(unsigned int layer, const Vector2u& position) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the map
+    ///
+    /// \return Size of the map, in tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a tile
+    ///
+    /// \return Size of a tile, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    Vector2u getTileSize() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of layers of the map
+    ///
+    /// \return Number of layers
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getLayerCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the local bounding rectangle of the map
+    ///
+    /// \return Local bounding rectangle of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getLocalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the global bounding rectangle of the map
+    ///
+    /// \return Global bounding rectangle of the map
+    ///
+    ////////////////////////////////////////////////////////////
+    FloatRect getGlobalBounds() const;
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static constexpr unsigned int ChunkSize = 32; //!< Width and height of a chunk, in tiles
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Draw the visible chunks to a render target
+    ///
+    /// \param target Render target to draw to
+    /// \param states Current render states
+    ///
+    ////////////////////////////////////////////////////////////
+    void draw(RenderTarget& target, const RenderStates& states) const override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Rebuild the geometry of a chunk
+    ///
+    /// \param chunk Position of the chunk, in chunks
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateChunk(const Vector2u& chunk) const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Geometry of a square of ChunkSize x ChunkSize tiles
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Chunk
+    {
+        VertexBuffer               buffer;      //!< Vertices of the tiles in graphics memory
+        std::vector<CompactVertex> vertices;    //!< Vertices of the tiles, when vertex buffers are not available
+        std::size_t                vertexCount; //!< Number of vertices of the chunk
+        Uint64                     lastDraw;    //!< Value of the draw counter the last time the chunk was visible
+        bool                       needUpdate;  //!< Do the vertices need to be rebuilt?
+        bool                       resident;    //!< Is the chunk in the list of chunks holding geometry?
+    };
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    Vector2u                           m_size;       //!< Size of the map, in tiles
+    Vector2u                           m_tileSize;   //!< Size of a tile, in pixels
+    unsigned int                       m_layerCount; //!< Number of layers
+    std::vector<Uint16>                m_tiles;      //!< Tiles of all the layers, layer by layer, row by row
+    const Texture*                     m_tileset;    //!< Texture of the tiles
+    Vector2u                           m_chunkCount; //!< Number of chunks in each dimension
+    mutable std::vector<Chunk>         m_chunks;     //!< Geometry of the chunks, row by row
+    mutable std::vector<std::size_t>   m_resident;   //!< Indices of the chunks holding geometry
+    mutable std::vector<CompactVertex> m_scratch;    //!< Vertices of the chunk being rebuilt
+    mutable Uint64                     m_drawCount;  //!< Number of draws of the map
+};
+
+} // namespace sf
+
+
+#endif // SFML_TILEMAP_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::TileMap
+/// \ingroup graphics
+///
+/// sf::TileMap draws a grid of tiles taken from a tileset
+/// texture, in one or more layers. It is meant for large maps:
+/// the cost of drawing it depends on the size of the view, not
+/// on the size of the map.
+///
+/// Tiles are stored as 16-bit numbers, 0 being an empty tile.
+/// The map is split in chunks of ChunkSize x ChunkSize tiles.
+/// The geometry of a chunk (two triangles per non-empty tile,
+/// in the compact vertex format) is built the first time the
+/// chunk is visible, and stored in a static vertex buffer. It
+/// is only rebuilt when one of its tiles changes. The geometry
+/// of the chunks that have not been visible during the last
+/// few hundred draws is released, so that the graphics memory
+/// used depends on the area explored recently, not on the size
+/// of the map; it is rebuilt when they are visible again.
+///
+/// When drawn, only the chunks that intersect the view of the
+/// target are drawn, one draw call per chunk, all layers at
+/// once (layers are drawn in order within a chunk).
+///
+/// Like shapes and sprites, the map is transformable.
+///
+/// Usage example:
+/// \code
+/// sf::Texture tileset;
+/// if (!tileset.loadFromFile("tileset.png"))
+///     return -1;
+///
+/// sf::TileMap map;
+/// if (!map.create({4096, 4096}, {16, 16}, 2))
+///     return -1;
+///
+/// map.setTileset(tileset);
+/// map.setTiles(0, ground.data());
+/// map.setTile(1, {10, 20}, 42);
+///
+/// window.draw(map);
+/// \endcode
+///
+/// \see sf::VertexBuffer, sf::Texture
+///
+////////////////////////////////////////////////////////////
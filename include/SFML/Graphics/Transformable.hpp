@@ -29,6 +29,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/AffineTransform.hpp>
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/System/Angle.hpp>
 
@@ -209,22 +210,42 @@ public:
     ////////////////////////////////////////////////////////////
     /// \brief get the combined transform of the object
     ///
+    /// The transform is stored in compact form (see getAffineTransform),
+    /// so it is returned by value: code that kept a pointer to it must
+    /// now keep a copy, or use getAffineTransform.
+    ///
     /// \return Transform combining the position/rotation/scale/origin of the object
     ///
-    /// \see getInverseTransform
+    /// \see getInverseTransform, getAffineTransform
     ///
     ////////////////////////////////////////////////////////////
-    const Transform& getTransform() const;
+    Transform getTransform() const;
 
     ////////////////////////////////////////////////////////////
     /// \brief get the inverse of the combined transform of the object
     ///
+    /// Like getTransform, this function returns the transform by value.
+    ///
     /// \return Inverse of the combined transformations applied to the object
     ///
     /// \see getTransform
     ///
     ////////////////////////////////////////////////////////////
-    const Transform& getInverseTransform() const;
+    Transform getInverseTransform() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief get the combined transform of the object, in compact form
+    ///
+    /// This is the transform returned by getTransform, without
+    /// the conversion to sf::Transform. Combining it with other
+    /// affine transforms is cheaper.
+    ///
+    /// \return Transform combining the position/rotation/scale/origin of the object
+    ///
+    /// \see getTransform
+    ///
+    ////////////////////////////////////////////////////////////
+    const AffineTransform& getAffineTransform() const;
 
 private:
 
@@ -235,10 +256,10 @@ private:
     Vector2f          m_position;                   //!< Position of the object in the 2D world
     Angle             m_rotation;                   //!< Orientation of the object
     Vector2f          m_scale;                      //!< Scale of the object
-    mutable Transform m_transform;                  //!< Combined transformation of the object
-    mutable bool      m_transformNeedUpdate;        //!< Does the transform need to be recomputed?
-    mutable Transform m_inverseTransform;           //!< Combined transformation of the object
-    mutable bool      m_inverseTransformNeedUpdate; //!< Does the transform need to be recomputed?
+    mutable AffineTransform m_transform;                  //!< Combined transformation of the object
+    mutable bool            m_transformNeedUpdate;        //!< Does the transform need to be recomputed?
+    mutable AffineTransform m_inverseTransform;           //!< Combined transformation of the object
+    mutable bool            m_inverseTransformNeedUpdate; //!< Does the transform need to be recomputed?
 };
 
 } // namespace sf
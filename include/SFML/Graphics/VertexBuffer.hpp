@@ -31,7 +31,9 @@
 #include <SFML/Graphics/Export.hpp>
 #include <SFML/Graphics/PrimitiveType.hpp>
 #include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/VertexLayout.hpp>
 #include <SFML/Window/GlResource.hpp>
+#include <vector>
 #include <cstddef>
 
 
@@ -123,8 +125,9 @@ public:
     /// \brief Create the vertex buffer
     ///
     /// Creates the vertex buffer and allocates enough graphics
-    /// memory to hold \p vertexCount vertices. Any previously
-    /// allocated memory is freed in the process.
+    /// memory to hold \p vertexCount vertices of the current
+    /// layout. Any previously allocated memory is freed in the
+    /// process.
     ///
     /// In order to deallocate previously allocated memory pass 0
     /// as \p vertexCount. Don't forget to recreate with a non-zero
@@ -198,6 +201,85 @@ public:
     ////////////////////////////////////////////////////////////
     [[nodiscard]] bool update(const Vertex* vertices, std::size_t vertexCount, unsigned int offset);
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from an array of vertices in any format
+    ///
+    /// This function works like the sf::Vertex overload, for
+    /// vertices described by the layout of the buffer: the size
+    /// of \a T must be the stride of the layout.
+    ///
+    /// \param vertices    Array of vertices to copy to the buffer
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    /// \see setLayout
+    ///
+    ////////////////////////////////////////////////////////////
+    template <typename T>
+    [[nodiscard]] bool update(const T* vertices, std::size_t vertexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map a part of the buffer to write vertices in place
+    ///
+    /// This function gives direct access to the graphics memory
+    /// of \p vertexCount vertices, starting at \p firstVertex, so
+    /// that they can be written without an intermediate array.
+    /// The access is write-only: the previous contents of the
+    /// range are discarded, every vertex of the range has to be
+    /// written. The vertices are in the format of the layout of
+    /// the buffer.
+    ///
+    /// Mapping the whole buffer never waits for the graphics card
+    /// to finish drawing the previous vertices. Mapping a part of
+    /// it may wait.
+    ///
+    /// The buffer can't be drawn or updated while it is mapped,
+    /// unmap() must be called when the vertices are written.
+    ///
+    /// \param firstVertex Index of the first vertex to map
+    /// \param vertexCount Number of vertices to map
+    ///
+    /// \return Pointer to the first vertex, or a null pointer on failure
+    ///
+    /// \see unmap
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] void* map(std::size_t firstVertex, std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map the first vertices of the buffer, discarding the others
+    ///
+    /// This overload is for buffers rewritten every frame with
+    /// a varying number of vertices: like mapping the whole
+    /// buffer, it never waits for the graphics card, but only
+    /// \p vertexCount vertices have to be written. The contents
+    /// of the vertices after them are undefined until they are
+    /// written again.
+    ///
+    /// \param vertexCount Number of vertices to map
+    ///
+    /// \return Pointer to the first vertex, or a null pointer on failure
+    ///
+    /// \see unmap
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] void* map(std::size_t vertexCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Finish writing the vertices of a mapped buffer
+    ///
+    /// The pointer returned by map() is invalid after this call.
+    ///
+    /// \return True on success, false if the buffer was not mapped
+    ///         or if its contents were lost and must be written again
+    ///
+    /// \see map
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool unmap();
+
     ////////////////////////////////////////////////////////////
     /// \brief Copy the contents of another buffer into this buffer
     ///
@@ -284,6 +366,69 @@ public:
     ////////////////////////////////////////////////////////////
     Usage getUsage() const;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the number of buffers the vertices are rotated between
+    ///
+    /// Updating vertices which the graphics card is still drawing
+    /// makes the CPU wait until the drawing is finished. With more
+    /// than one buffer, each update of the whole vertex buffer (or
+    /// map() of all its vertices, or map(std::size_t)) writes into
+    /// the next buffer, which the graphics card is done with, and
+    /// draws use the last buffer written. Three buffers are enough
+    /// for vertices updated every frame. Partial updates write into
+    /// the current buffer.
+    ///
+    /// The graphics memory used is multiplied by the number of
+    /// buffers. The new count takes effect at the next call to
+    /// create(). Rotating buffers needs OpenGL 3.2, with older
+    /// versions a single buffer is used, which is orphaned by
+    /// updates of all its vertices.
+    ///
+    /// The default count is 1. Keep it when drawing the buffer
+    /// with your own OpenGL code: bind() can't tell which of the
+    /// buffers holds the last vertices.
+    ///
+    /// \param count Number of buffers, at least 1
+    ///
+    /// \see getBufferCount, create
+    ///
+    ////////////////////////////////////////////////////////////
+    void setBufferCount(unsigned int count);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of buffers the vertices are rotated between
+    ///
+    /// \return Number of buffers requested with setBufferCount
+    ///
+    ////////////////////////////////////////////////////////////
+    unsigned int getBufferCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Set the layout of the vertices of this vertex buffer
+    ///
+    /// The layout defines the size of the vertices and how
+    /// their attributes are stored. The default layout is the
+    /// one of sf::Vertex.
+    ///
+    /// The vertex count is a number of vertices of the layout:
+    /// changing to a layout with a different size resets it to
+    /// 0, the buffer has to be created again.
+    ///
+    /// \param layout Layout of the vertices
+    ///
+    /// \see create, update
+    ///
+    ////////////////////////////////////////////////////////////
+    void setLayout(const VertexLayout& layout);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the layout of the vertices of this vertex buffer
+    ///
+    /// \return Layout of the vertices
+    ///
+    ////////////////////////////////////////////////////////////
+    const VertexLayout& getLayout() const;
+
     ////////////////////////////////////////////////////////////
     /// \brief Bind a vertex buffer for rendering
     ///
@@ -302,6 +447,11 @@ public:
     /// // draw OpenGL stuff that use no vertex buffer...
     /// \endcode
     ///
+    /// The bound vertex buffers are tracked to skip redundant calls:
+    /// if you also bind array buffers with OpenGL functions, call
+    /// sf::RenderTarget::resetGLStates (or use pushGLStates and
+    /// popGLStates) before using SFML again.
+    ///
     /// \param vertexBuffer Pointer to the vertex buffer to bind, can be null to use no vertex buffer
     ///
     ////////////////////////////////////////////////////////////
@@ -330,6 +480,65 @@ private:
     ////////////////////////////////////////////////////////////
     void draw(RenderTarget& target, const RenderStates& states) const override;
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Update a part of the buffer from raw vertex data
+    ///
+    /// \param vertices    Array of vertices to copy to the buffer
+    /// \param vertexSize  Size of a vertex of the array, in bytes
+    /// \param vertexCount Number of vertices to copy
+    /// \param offset      Offset in the buffer to copy to
+    ///
+    /// \return True if the update was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool updateData(const void* vertices, std::size_t vertexSize, std::size_t vertexCount, unsigned int offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map a part of the buffer
+    ///
+    /// \param firstVertex Index of the first vertex to map
+    /// \param vertexCount Number of vertices to map
+    /// \param discard     Discard the vertices outside the range?
+    ///
+    /// \return Pointer to the first vertex, or a null pointer on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    void* mapRange(std::size_t firstVertex, std::size_t vertexCount, bool discard);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Make the next buffer current, to write all the vertices
+    ///
+    /// Waits until the graphics card is done drawing the next
+    /// buffer (which normally is the case already).
+    ///
+    ////////////////////////////////////////////////////////////
+    void rotate();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the offset of the current buffer
+    ///
+    /// \return Offset of the vertices to draw in graphics memory, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getCurrentOffset() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Remember that the current buffer is being drawn
+    ///
+    /// Called by render targets after the vertices are drawn,
+    /// so that the buffer is not written until the draw is done.
+    ///
+    ////////////////////////////////////////////////////////////
+    void markDrawn() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Delete the fences of all the buffers
+    ///
+    ////////////////////////////////////////////////////////////
+    void clearFences();
+
+    friend class RenderTarget;
+
 private:
 
     ////////////////////////////////////////////////////////////
@@ -339,8 +548,16 @@ private:
     std::size_t   m_size;          //!< Size in Vertexes of the currently allocated buffer
     PrimitiveType m_primitiveType; //!< Type of primitives to draw
     Usage         m_usage;         //!< How this vertex buffer is to be used
+    VertexLayout  m_layout;        //!< Layout of the vertices
+    unsigned int  m_bufferCount;   //!< Number of buffers requested
+    unsigned int  m_buffers;       //!< Number of buffers allocated in graphics memory
+    unsigned int  m_current;       //!< Index of the buffer holding the vertices to draw
+    bool          m_mapped;        //!< Is the buffer mapped?
+    mutable std::vector<void*> m_fences; //!< Fence of the last draw of each buffer, if any (GLsync)
 };
 
+#include <SFML/Graphics/VertexBuffer.inl>
+
 } // namespace sf
 
 
@@ -372,6 +589,11 @@ private:
 /// the application. This allows the user to take full control of data
 /// transfers between system and graphics memory if they need to.
 ///
+/// Vertices updated every frame, like particles, should use
+/// several buffers (see setBufferCount) and be written in place
+/// with map() and unmap(): updates then never wait for the
+/// graphics card to finish drawing the previous frames.
+///
 /// In special cases, the user can make use of multiple threads to update
 /// vertex data in multiple distinct regions of the buffer simultaneously.
 /// This might make sense when e.g. the position of multiple objects has to
@@ -390,6 +612,11 @@ private:
 /// pending data transfers complete before the vertex buffer is sourced
 /// by the rendering pipeline.
 ///
+/// Vertices are sf::Vertex by default. Smaller vertices, like
+/// sf::CompactVertex, can be stored by setting the layout of the
+/// buffer before creating it, which divides the amount of graphics
+/// memory and of data transfers accordingly.
+///
 /// It inherits sf::Drawable, but unlike other drawables it
 /// is not transformable.
 ///
@@ -402,8 +629,15 @@ private:
 /// triangles.update(vertices);
 /// ...
 /// window.draw(triangles);
+///
+/// std::vector<sf::CompactVertex> tiles;
+/// ...
+/// sf::VertexBuffer tileMap(sf::Triangles, sf::VertexBuffer::Static);
+/// tileMap.setLayout(sf::VertexLayout::Compact);
+/// tileMap.create(tiles.size());
+/// tileMap.update(tiles.data(), tiles.size(), 0);
 /// \endcode
 ///
-/// \see sf::Vertex, sf::VertexArray
+/// \see sf::Vertex, sf::VertexArray, sf::VertexLayout
 ///
 ////////////////////////////////////////////////////////////
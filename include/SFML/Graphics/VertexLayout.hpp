@@ -0,0 +1,289 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_VERTEXLAYOUT_HPP
+#define SFML_VERTEXLAYOUT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/Export.hpp>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <optional>
+#include <string>
+#include <vector>
+#include <cstddef>
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+/// \brief Vertex with a position and a color, without
+///        texture coordinates (12 bytes)
+///
+////////////////////////////////////////////////////////////
+struct ColoredVertex
+{
+    Vector2f position;             //!< 2D position of the vertex
+    Color    color = Color::White; //!< Color of the vertex
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Vertex with 16-bit integer position and texture
+///        coordinates (12 bytes)
+///
+////////////////////////////////////////////////////////////
+struct CompactVertex
+{
+    Vector2<Int16> position;             //!< 2D position of the vertex
+    Color          color = Color::White; //!< Color of the vertex
+    Vector2<Int16> texCoords;            //!< Coordinates of the texture's pixel to map to the vertex
+};
+
+////////////////////////////////////////////////////////////
+/// \brief Describe how the attributes of a vertex are
+///        stored in memory
+///
+////////////////////////////////////////////////////////////
+class SFML_GRAPHICS_API VertexLayout
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Types of the components of an attribute
+    ///
+    ////////////////////////////////////////////////////////////
+    enum Type
+    {
+        Float,         //!< 32-bit floating point number
+        HalfFloat,     //!< 16-bit floating point number
+        Short,         //!< 16-bit signed integer
+        UnsignedShort, //!< 16-bit unsigned integer
+        UnsignedByte   //!< 8-bit unsigned integer
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Location and format of an attribute in a vertex
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Attribute
+    {
+        std::string  name;       //!< Name of the attribute in the vertex shader, empty for built-in attributes
+        Type         type;       //!< Type of the components
+        unsigned int size;       //!< Number of components, from 1 to 4
+        bool         normalized; //!< Are integers mapped to [0, 1] ([-1, 1] for signed types) rather than converted as is?
+        std::size_t  offset;     //!< Offset of the first component from the start of the vertex, in bytes
+    };
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    /// Constructs the layout of sf::Vertex.
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexLayout();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Construct a layout with only a position
+    ///
+    /// The position has two components, and can be stored as
+    /// Float, HalfFloat or Short. Integer positions are not
+    /// normalized, they are converted as is.
+    ///
+    /// \param stride         Size of a vertex, in bytes
+    /// \param positionType   Type of the position components
+    /// \param positionOffset Offset of the position in the vertex, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    VertexLayout(std::size_t stride, Type positionType, std::size_t positionOffset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store a color in the vertices
+    ///
+    /// The color is stored like sf::Color, as four unsigned
+    /// bytes. Vertices without color are drawn in white.
+    ///
+    /// \param offset Offset of the color in the vertex, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setColor(std::size_t offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Store texture coordinates in the vertices
+    ///
+    /// Texture coordinates have two components, and can be
+    /// stored as Float, HalfFloat or Short. Like the ones of
+    /// sf::Vertex, they are in pixels of the texture.
+    ///
+    /// \param type   Type of the texture coordinates components
+    /// \param offset Offset of the texture coordinates in the vertex, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void setTexCoords(Type type, std::size_t offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Add a custom attribute to the vertices
+    ///
+    /// Custom attributes are passed to the vertex shader of the
+    /// render states, to the attribute variable which has the
+    /// same name. They are ignored when drawing without shader,
+    /// or when the shader doesn't use them.
+    ///
+    /// \param name       Name of the attribute variable in the vertex shader
+    /// \param type       Type of the components
+    /// \param size       Number of components, from 1 to 4
+    /// \param normalized True to map integers to [0, 1] ([-1, 1] for signed types)
+    /// \param offset     Offset of the attribute in the vertex, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    void addAttribute(const std::string& name, Type type, unsigned int size, bool normalized, std::size_t offset);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a vertex
+    ///
+    /// \return Size of a vertex, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getStride() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the position attribute
+    ///
+    /// \return Position attribute
+    ///
+    ////////////////////////////////////////////////////////////
+    const Attribute& getPosition() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the color attribute
+    ///
+    /// \return Color attribute, or an empty optional if the vertices have no color
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::optional<Attribute>& getColor() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the texture coordinates attribute
+    ///
+    /// \return Texture coordinates attribute, or an empty optional if the vertices have none
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::optional<Attribute>& getTexCoords() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the custom attributes
+    ///
+    /// \return Custom attributes, in the order they were added
+    ///
+    ////////////////////////////////////////////////////////////
+    const std::vector<Attribute>& getAttributes() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of a component type
+    ///
+    /// \param type Type of component
+    ///
+    /// \return Size of a component, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    static std::size_t getTypeSize(Type type);
+
+    ////////////////////////////////////////////////////////////
+    // Static member data
+    ////////////////////////////////////////////////////////////
+    static const VertexLayout Default;  //!< Layout of sf::Vertex (20 bytes)
+    static const VertexLayout Colored;  //!< Layout of sf::ColoredVertex (12 bytes)
+    static const VertexLayout Compact;  //!< Layout of sf::CompactVertex (12 bytes)
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::size_t              m_stride;     //!< Size of a vertex, in bytes
+    Attribute                m_position;   //!< Position of the vertices
+    std::optional<Attribute> m_color;      //!< Color of the vertices, if any
+    std::optional<Attribute> m_texCoords;  //!< Texture coordinates of the vertices, if any
+    std::vector<Attribute>   m_attributes; //!< Custom attributes passed to the vertex shader
+};
+
+} // namespace sf
+
+
+#endif // SFML_VERTEXLAYOUT_HPP
+
+
+////////////////////////////////////////////////////////////
+/// \class sf::VertexLayout
+/// \ingroup graphics
+///
+/// sf::Vertex stores its position and texture coordinates as
+/// 32-bit floats, 20 bytes per vertex. A lot of geometry needs
+/// less: primitives which are not textured don't need texture
+/// coordinates, and tile maps fit in 16-bit integer positions.
+/// sf::VertexLayout describes vertices stored in other formats,
+/// to draw them without converting them to sf::Vertex and to
+/// transfer less data to the graphics card.
+///
+/// Two compact formats are predefined, each with its layout:
+/// \li sf::ColoredVertex, sf::VertexLayout::Colored: float position and color
+/// \li sf::CompactVertex, sf::VertexLayout::Compact: 16-bit position, color and 16-bit texture coordinates
+///
+/// Other formats are described by creating a layout with the
+/// size and position of the vertices, then adding the optional
+/// color and texture coordinates. Vertices can also carry custom
+/// attributes, which are passed to the vertex shader by name.
+/// Custom attributes can use any type, for example normalized
+/// 16-bit texture coordinates.
+///
+/// Layouts are used by sf::RenderTarget::draw to draw arrays of
+/// vertices in memory, and by sf::VertexBuffer to store vertices
+/// in graphics memory.
+///
+/// Usage example:
+/// \code
+/// // a tile map, drawn with 12 bytes per vertex instead of 20
+/// std::vector<sf::CompactVertex> vertices;
+/// ...
+/// window.draw(vertices.data(), vertices.size(), sf::VertexLayout::Compact, sf::Triangles, &tileset);
+///
+/// // a particle with a half float position and a custom attribute
+/// struct Particle
+/// {
+///     sf::Uint16 position[2];
+///     sf::Color  color;
+///     float      age;
+/// };
+///
+/// sf::VertexLayout layout(sizeof(Particle), sf::VertexLayout::HalfFloat, offsetof(Particle, position));
+/// layout.setColor(offsetof(Particle, color));
+/// layout.addAttribute("age", sf::VertexLayout::Float, 1, false, offsetof(Particle, age));
+///
+/// window.draw(particles.data(), particles.size(), layout, sf::Points, &shader);
+/// \endcode
+///
+/// \see sf::Vertex, sf::VertexBuffer, sf::RenderTarget
+///
+////////////////////////////////////////////////////////////
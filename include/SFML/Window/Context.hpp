@@ -30,6 +30,7 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Window/Export.hpp>
 #include <SFML/Window/GlResource.hpp>
+#include <SFML/System/Time.hpp>
 #include <memory>
 
 
@@ -52,6 +53,22 @@ class SFML_WINDOW_API Context : GlResource
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Statistics about the synchronization of the contexts
+    ///
+    /// Operating system context operations are serialized by a
+    /// global lock; these statistics tell how much the threads
+    /// using OpenGL wait for each other.
+    ///
+    ////////////////////////////////////////////////////////////
+    struct Statistics
+    {
+        Uint64 lockCount = 0;             //!< Number of times the global context lock was taken
+        Uint64 contendedLockCount = 0;    //!< Number of times a thread had to wait for another one to release it
+        Time   lockWaitTime;              //!< Total time spent waiting for the lock, by all threads
+        Uint64 transientContextCount = 0; //!< Number of contexts created for threads using OpenGL without an active context
+    };
+
     ////////////////////////////////////////////////////////////
     /// \brief Default constructor
     ///
@@ -145,6 +162,17 @@ public:
     ////////////////////////////////////////////////////////////
     static Uint64 getActiveContextId();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get statistics about the synchronization of the contexts
+    ///
+    /// The statistics are accumulated since the start of the
+    /// program, compare two calls to measure a period of time.
+    ///
+    /// \return Statistics about the global context lock and the transient contexts
+    ///
+    ////////////////////////////////////////////////////////////
+    static Statistics getStatistics();
+
     ////////////////////////////////////////////////////////////
     /// \brief Construct a in-memory context
     ///
@@ -205,4 +233,10 @@ private:
 /// // by the sf::Context destructor
 /// \endcode
 ///
+/// Threads which use SFML's OpenGL resources (like loading a
+/// sf::Texture) without an active context don't need one: they
+/// borrow a context from a pool, which shares its resources with
+/// all the other contexts. Each thread uses its own, so threads
+/// only wait for each other while contexts are activated.
+///
 ////////////////////////////////////////////////////////////
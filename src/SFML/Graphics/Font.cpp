@@ -33,6 +33,7 @@
 #endif
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/MappedFile.hpp>
 #include <SFML/System/Utils.hpp>
 #include <ft2build.h>
 #include FT_FREETYPE_H
@@ -41,10 +42,17 @@
 #include FT_BITMAP_H
 #include FT_STROKER_H
 #include <type_traits>
+#include <algorithm>
+#include <array>
+#include <iterator>
 #include <ostream>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
 #include <cmath>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 
 namespace
@@ -82,6 +90,31 @@ namespace
     {
         return (static_cast<sf::Uint64>(reinterpret<sf::Uint32>(outlineThickness)) << 32) | (static_cast<sf::Uint64>(bold) << 31) | index;
     }
+
+    // Combine two code points and boldness into a single 64-bit kerning key
+    sf::Uint64 combineKerning(sf::Uint32 first, sf::Uint32 second, bool bold)
+    {
+        return (static_cast<sf::Uint64>(first) << 32) | (static_cast<sf::Uint64>(second) << 1) | static_cast<sf::Uint64>(bold);
+    }
+
+    // Code points below this limit (the Basic Multilingual Plane) are looked up in dense tables
+    constexpr sf::Uint32 denseCodePointLimit = 0x10000;
+
+    // Number of code points per block of a dense table; blocks are only allocated when used
+    constexpr sf::Uint32 denseBlockSize = 256;
+
+    // Marker for the code points whose glyph index was not looked up yet
+    constexpr FT_UInt unknownCharIndex = ~FT_UInt(0);
+
+    // Coverage of the 8 pixels packed in each possible byte of a monochrome bitmap
+    constexpr std::array<std::array<sf::Uint8, 8>, 256> monoCoverage = []
+    {
+        std::array<std::array<sf::Uint8, 8>, 256> table{};
+        for (std::size_t byte = 0; byte < 256; ++byte)
+            for (std::size_t bit = 0; bit < 8; ++bit)
+                table[byte][bit] = (byte & (0x80u >> bit)) ? 255 : 0;
+        return table;
+    }();
 }
 
 
@@ -100,10 +133,122 @@ private:
     };
 
 public:
-    std::unique_ptr<std::remove_pointer_t<FT_Library>, Deleter> library;   //< Pointer to the internal library interface
-    std::unique_ptr<FT_StreamRec>                               streamRec; //< Pointer to the stream rec instance
-    std::unique_ptr<std::remove_pointer_t<FT_Face>,    Deleter> face;      //< Pointer to the internal font face
-    std::unique_ptr<std::remove_pointer_t<FT_Stroker>, Deleter> stroker;   //< Pointer to the stroker
+    using Library = std::shared_ptr<std::remove_pointer_t<FT_Library>>;
+
+    using File = std::shared_ptr<priv::MappedFile>;
+
+    // FreeType library and mapped files shared by all the fonts
+    // Every font handle keeps a reference to this state, so that it outlives all the fonts
+    // (including global ones) regardless of the order in which global objects are destroyed
+    // Faces are not shared: FreeType faces can't be used by several threads at the same time,
+    // and their size is part of their state
+    struct SharedState
+    {
+        std::recursive_mutex                                              mutex;   //< Protects the library, the mapped files and the creation and destruction of faces
+        std::weak_ptr<std::remove_pointer_t<FT_Library>>                  library; //< FreeType library, alive as long as a font uses it
+        std::unordered_map<std::string, std::weak_ptr<priv::MappedFile>> files;   //< Mapped font files, by path, size and modification time
+    };
+
+    static std::shared_ptr<SharedState> getSharedState()
+    {
+        static const auto state = std::make_shared<SharedState>();
+        return state;
+    }
+
+    FontHandles() :
+    sharedState(getSharedState())
+    {
+    }
+
+    ~FontHandles()
+    {
+        std::lock_guard lock(sharedState->mutex);
+
+        // FreeType requires faces to be destroyed under the same lock as the one used to create them
+        stroker.reset();
+        face.reset();
+        file.reset();
+
+        // Remove the file from the cache if no other font uses it, unless it was replaced in the meantime
+        if (!fileKey.empty())
+        {
+            auto it = sharedState->files.find(fileKey);
+            if ((it != sharedState->files.end()) && it->second.expired())
+                sharedState->files.erase(it);
+        }
+    }
+
+    FontHandles(const FontHandles&) = delete;
+    FontHandles& operator=(const FontHandles&) = delete;
+
+    // Get the FreeType library, initializing it if no font currently uses it
+    // The shared state must be locked by the caller
+    Library getLibrary()
+    {
+        Library sharedLibrary = sharedState->library.lock();
+        if (!sharedLibrary)
+        {
+            FT_Library newLibrary;
+            if (FT_Init_FreeType(&newLibrary) != 0)
+                return nullptr;
+
+            sharedLibrary.reset(newLibrary, Deleter());
+            sharedState->library = sharedLibrary;
+        }
+
+        return sharedLibrary;
+    }
+
+    // Map a font file in memory, reusing the mapping of another font if the file is already loaded
+    // The shared state must be locked by the caller
+    File mapFile(const std::filesystem::path& filename, const std::string& key)
+    {
+        std::weak_ptr<priv::MappedFile>& entry = sharedState->files[key];
+        File sharedFile = entry.lock();
+        if (!sharedFile)
+        {
+            sharedFile = std::make_shared<priv::MappedFile>();
+            if (!sharedFile->open(filename))
+            {
+                sharedState->files.erase(key);
+                return nullptr;
+            }
+
+            entry = sharedFile;
+        }
+
+        fileKey = key;
+        return sharedFile;
+    }
+
+    // Convert a code point to the glyph index of the face, caching the result for the Basic Multilingual Plane
+    FT_UInt getCharIndex(Uint32 codePoint)
+    {
+        if (codePoint >= denseCodePointLimit)
+            return FT_Get_Char_Index(face.get(), codePoint);
+
+        if (charIndices.empty())
+            charIndices.resize(denseCodePointLimit / denseBlockSize);
+
+        std::vector<FT_UInt>& block = charIndices[codePoint / denseBlockSize];
+        if (block.empty())
+            block.resize(denseBlockSize, unknownCharIndex);
+
+        FT_UInt& index = block[codePoint % denseBlockSize];
+        if (index == unknownCharIndex)
+            index = FT_Get_Char_Index(face.get(), codePoint);
+
+        return index;
+    }
+
+    std::shared_ptr<SharedState>                                sharedState; //< State shared by all the fonts
+    std::string                                                 fileKey;     //< Key of the mapped file in the shared state, empty if not loaded from a file
+    Library                                                     library;     //< Pointer to the internal library interface, shared by all the fonts
+    std::unique_ptr<FT_StreamRec>                               streamRec;   //< Pointer to the stream rec instance
+    File                                                        file;        //< Font file mapped in memory, shared by the fonts loaded from the same file
+    std::unique_ptr<std::remove_pointer_t<FT_Face>,    Deleter> face;        //< Pointer to the internal font face
+    std::unique_ptr<std::remove_pointer_t<FT_Stroker>, Deleter> stroker;     //< Pointer to the stroker
+    std::vector<std::vector<FT_UInt>>                           charIndices; //< Glyph indices of the Basic Multilingual Plane, by blocks allocated on first use
 };
 
 
@@ -111,6 +256,7 @@ public:
 Font::Font() :
 m_fontHandles(),
 m_isSmooth   (true),
+m_isAlphaOnly(false),
 m_info       ()
 {
 
@@ -121,6 +267,7 @@ m_info       ()
 Font::Font(const Font& copy) :
 m_fontHandles(copy.m_fontHandles),
 m_isSmooth   (copy.m_isSmooth),
+m_isAlphaOnly(copy.m_isAlphaOnly),
 m_info       (copy.m_info),
 m_pages      (copy.m_pages),
 m_pixelBuffer(copy.m_pixelBuffer)
@@ -152,22 +299,38 @@ bool Font::loadFromFile(const std::filesystem::path& filename)
     // Cleanup the previous resources
     cleanup();
 
-    auto fontHandles = std::make_unique<FontHandles>();
-
-    // Initialize FreeType
-    // Note: we initialize FreeType for every font instance in order to avoid having a single
-    // global manager that would create a lot of issues regarding creation and destruction order.
-    FT_Library library;
-    if (FT_Init_FreeType(&library) != 0)
+    // Identify the file by its absolute path, size and modification time, so that modified files are mapped again
+    std::error_code error;
+    std::filesystem::path path = std::filesystem::weakly_canonical(filename, error);
+    if (error)
+        path = std::filesystem::absolute(filename, error);
+    auto fileSize = std::filesystem::file_size(path, error);
+    auto fileTime = std::filesystem::last_write_time(path, error).time_since_epoch().count();
+    std::string key = path.string() + '|' + std::to_string(fileSize) + '|' + std::to_string(fileTime);
+
+    auto fontHandles = std::make_shared<FontHandles>();
+    std::lock_guard lock(fontHandles->sharedState->mutex);
+
+    // Get the FreeType library, shared by all the fonts
+    fontHandles->library = fontHandles->getLibrary();
+    if (!fontHandles->library)
     {
         err() << "Failed to load font (failed to initialize FreeType)\n" << formatDebugPathInfo(filename) << std::endl;
         return false;
     }
-    fontHandles->library.reset(library);
 
-    // Load the new font face from the specified file
+    // Map the file in memory rather than reading it: pages are loaded on demand by the system,
+    // and fonts loaded from the same file share the mapping
+    fontHandles->file = fontHandles->mapFile(filename, key);
+    if (!fontHandles->file)
+    {
+        err() << "Failed to load font (failed to open the file)\n" << formatDebugPathInfo(filename) << std::endl;
+        return false;
+    }
+
+    // Load the new font face from the mapped file
     FT_Face face;
-    if (FT_New_Face(library, filename.string().c_str(), 0, &face) != 0)
+    if (FT_New_Memory_Face(fontHandles->library.get(), static_cast<const FT_Byte*>(fontHandles->file->getData()), static_cast<FT_Long>(fontHandles->file->getSize()), 0, &face) != 0)
     {
         err() << "Failed to load font (failed to create the font face)\n" << formatDebugPathInfo(filename) << std::endl;
         return false;
@@ -176,7 +339,7 @@ bool Font::loadFromFile(const std::filesystem::path& filename)
 
     // Load the stroker that will be used to outline the font
     FT_Stroker stroker;
-    if (FT_Stroker_New(library, &stroker) != 0)
+    if (FT_Stroker_New(fontHandles->library.get(), &stroker) != 0)
     {
         err() << "Failed to load font (failed to create the stroker)\n" << formatDebugPathInfo(filename) << std::endl;
         return false;
@@ -213,22 +376,20 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
     // Cleanup the previous resources
     cleanup();
 
-    auto fontHandles = std::make_unique<FontHandles>();
+    auto fontHandles = std::make_shared<FontHandles>();
+    std::lock_guard lock(fontHandles->sharedState->mutex);
 
-    // Initialize FreeType
-    // Note: we initialize FreeType for every font instance in order to avoid having a single
-    // global manager that would create a lot of issues regarding creation and destruction order.
-    FT_Library library;
-    if (FT_Init_FreeType(&library) != 0)
+    // Get the FreeType library, shared by all the fonts
+    fontHandles->library = fontHandles->getLibrary();
+    if (!fontHandles->library)
     {
         err() << "Failed to load font from memory (failed to initialize FreeType)" << std::endl;
         return false;
     }
-    fontHandles->library.reset(library);
 
     // Load the new font face from the specified file
     FT_Face face;
-    if (FT_New_Memory_Face(library, reinterpret_cast<const FT_Byte*>(data), static_cast<FT_Long>(sizeInBytes), 0, &face) != 0)
+    if (FT_New_Memory_Face(fontHandles->library.get(), reinterpret_cast<const FT_Byte*>(data), static_cast<FT_Long>(sizeInBytes), 0, &face) != 0)
     {
         err() << "Failed to load font from memory (failed to create the font face)" << std::endl;
         return false;
@@ -237,7 +398,7 @@ bool Font::loadFromMemory(const void* data, std::size_t sizeInBytes)
 
     // Load the stroker that will be used to outline the font
     FT_Stroker stroker;
-    if (FT_Stroker_New(library, &stroker) != 0)
+    if (FT_Stroker_New(fontHandles->library.get(), &stroker) != 0)
     {
         err() << "Failed to load font from memory (failed to create the stroker)" << std::endl;
         return false;
@@ -267,18 +428,17 @@ bool Font::loadFromStream(InputStream& stream)
     // Cleanup the previous resources
     cleanup();
 
-    auto fontHandles = std::make_unique<FontHandles>();
+    auto fontHandles = std::make_shared<FontHandles>();
+    std::lock_guard lock(fontHandles->sharedState->mutex);
 
-    // Initialize FreeType
-    // Note: we initialize FreeType for every font instance in order to avoid having a single
-    // global manager that would create a lot of issues regarding creation and destruction order.
-    FT_Library library;
-    if (FT_Init_FreeType(&library) != 0)
+    // Get the FreeType library, shared by all the fonts
+    fontHandles->library = fontHandles->getLibrary();
+    if (!fontHandles->library)
     {
         err() << "Failed to load font from stream (failed to initialize FreeType)" << std::endl;
         return false;
     }
-    fontHandles->library.reset(library);
+    FT_Library library = fontHandles->library.get();
 
     // Make sure that the stream's reading position is at the beginning
     if (stream.seek(0) == -1)
@@ -349,30 +509,43 @@ const Font::Info& Font::getInfo() const
 const Glyph& Font::getGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, float outlineThickness) const
 {
     // Get the page corresponding to the character size
-    GlyphTable& glyphs = loadPage(characterSize).glyphs;
+    Page& page = loadPage(characterSize);
+
+    // Fast path: code points of the Basic Multilingual Plane that were already requested
+    // are found directly in the dense lookup table of their variant
+    const Glyph** slot = nullptr;
+    if (codePoint < denseCodePointLimit)
+    {
+        slot = &page.getGlyphSlot(combine(outlineThickness, bold, 0), codePoint);
+        if (*slot)
+            return **slot;
+    }
 
     // Build the key by combining the glyph index (based on code point), bold flag, and outline thickness
-    Uint64 key = combine(outlineThickness, bold, FT_Get_Char_Index(m_fontHandles ? m_fontHandles->face.get() : nullptr, codePoint));
+    Uint64 key = combine(outlineThickness, bold, m_fontHandles ? m_fontHandles->getCharIndex(codePoint) : 0);
 
     // Search the glyph into the cache
-    if (auto it = glyphs.find(key); it != glyphs.end())
-    {
-        // Found: just return it
-        return it->second;
-    }
-    else
+    GlyphTable& glyphs = page.glyphs;
+    auto it = glyphs.find(key);
+    if (it == glyphs.end())
     {
         // Not found: we have to load it
         Glyph glyph = loadGlyph(codePoint, characterSize, bold, outlineThickness);
-        return glyphs.emplace(key, glyph).first->second;
+        it = glyphs.emplace(key, glyph).first;
     }
+
+    // Remember the glyph in the dense lookup table (elements of the glyph table are never moved)
+    if (slot)
+        *slot = &it->second;
+
+    return it->second;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Font::hasGlyph(Uint32 codePoint) const
 {
-    return FT_Get_Char_Index(m_fontHandles ? m_fontHandles->face.get() : nullptr, codePoint) != 0;
+    return m_fontHandles && m_fontHandles->getCharIndex(codePoint) != 0;
 }
 
 
@@ -384,12 +557,21 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize,
         return 0.f;
 
     auto face = m_fontHandles ? m_fontHandles->face.get() : nullptr;
+    if (!face)
+        return 0.f;
 
-    if (face && setCurrentSize(characterSize))
+    // Search the pair into the kerning cache of the character size
+    KerningTable& kernings = loadPage(characterSize).kernings;
+    Uint64 key = combineKerning(first, second, bold);
+
+    if (auto it = kernings.find(key); it != kernings.end())
+        return it->second;
+
+    if (setCurrentSize(characterSize))
     {
         // Convert the characters to indices
-        FT_UInt index1 = FT_Get_Char_Index(face, first);
-        FT_UInt index2 = FT_Get_Char_Index(face, second);
+        FT_UInt index1 = m_fontHandles->getCharIndex(first);
+        FT_UInt index2 = m_fontHandles->getCharIndex(second);
 
         // Retrieve position compensation deltas generated by FT_LOAD_FORCE_AUTOHINT flag
         auto firstRsbDelta = static_cast<float>(getGlyph(first, characterSize, bold).rsbDelta);
@@ -402,12 +584,17 @@ float Font::getKerning(Uint32 first, Uint32 second, unsigned int characterSize,
             FT_Get_Kerning(face, index1, index2, FT_KERNING_UNFITTED, &kerning);
 
         // X advance is already in pixels for bitmap fonts
-        if (!FT_IS_SCALABLE(face))
-            return static_cast<float>(kerning.x);
+        float offset = static_cast<float>(kerning.x);
 
-        // Combine kerning with compensation deltas and return the X advance
+        // Combine kerning with compensation deltas to get the X advance
         // Flooring is required as we use FT_KERNING_UNFITTED flag which is not quantized in 64 based grid
-        return std::floor((secondLsbDelta - firstRsbDelta + static_cast<float>(kerning.x) + 32) / static_cast<float>(1 << 6));
+        if (FT_IS_SCALABLE(face))
+            offset = std::floor((secondLsbDelta - firstRsbDelta + offset + 32) / static_cast<float>(1 << 6));
+
+        // Store the offset in the cache, so that the next requests don't involve FreeType
+        kernings.emplace(key, offset);
+
+        return offset;
     }
     else
     {
@@ -500,6 +687,26 @@ bool Font::isSmooth() const
 }
 
 
+////////////////////////////////////////////////////////////
+void Font::setAlphaOnly(bool alphaOnly)
+{
+    if (alphaOnly != m_isAlphaOnly)
+    {
+        m_isAlphaOnly = alphaOnly;
+
+        // The pages have to be recreated with the new texture format
+        m_pages.clear();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool Font::isAlphaOnly() const
+{
+    return m_isAlphaOnly;
+}
+
+
 ////////////////////////////////////////////////////////////
 Font& Font::operator =(const Font& right)
 {
@@ -507,6 +714,7 @@ Font& Font::operator =(const Font& right)
 
     std::swap(m_fontHandles, temp.m_fontHandles);
     std::swap(m_isSmooth,    temp.m_isSmooth);
+    std::swap(m_isAlphaOnly, temp.m_isAlphaOnly);
     std::swap(m_info,        temp.m_info);
     std::swap(m_pages,       temp.m_pages);
     std::swap(m_pixelBuffer, temp.m_pixelBuffer);
@@ -534,7 +742,7 @@ void Font::cleanup()
 ////////////////////////////////////////////////////////////
 Font::Page& Font::loadPage(unsigned int characterSize) const
 {
-    return m_pages.try_emplace(characterSize, m_isSmooth).first->second;
+    return m_pages.try_emplace(characterSize, m_isSmooth, m_isAlphaOnly).first->second;
 }
 
 
@@ -645,48 +853,56 @@ Glyph Font::loadGlyph(Uint32 codePoint, unsigned int characterSize, bool bold, f
         glyph.bounds.width  = static_cast<float>( bitmap.width);
         glyph.bounds.height = static_cast<float>( bitmap.rows);
 
-        // Resize the pixel buffer to the new size and fill it with transparent white pixels
-        m_pixelBuffer.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4);
+        // Extract the glyph's coverage from the bitmap, surrounded by a transparent padding
+        // When the page stores RGBA pixels, the coverage is first written after the
+        // RGBA pixels in the buffer, and then expanded to transparent white pixels
+        const bool        alphaOnly     = page.texture.m_alphaOnly;
+        const std::size_t pixelCount    = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+        const std::size_t coverageStart = alphaOnly ? 0 : pixelCount * 4;
+        m_pixelBuffer.resize(coverageStart + pixelCount);
 
-        Uint8* current = m_pixelBuffer.data();
-        Uint8* end = current + width * height * 4;
+        Uint8* coverage = m_pixelBuffer.data() + coverageStart;
+        std::memset(coverage, 0, pixelCount);
 
-        while (current != end)
-        {
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 255;
-            (*current++) = 0;
-        }
-
-        // Extract the glyph's pixels from the bitmap
         const Uint8* pixels = bitmap.buffer;
+        Uint8*       row    = coverage + padding * width + padding;
         if (bitmap.pixel_mode == FT_PIXEL_MODE_MONO)
         {
-            // Pixels are 1 bit monochrome values
-            for (unsigned int y = padding; y < height - padding; ++y)
+            // Pixels are 1 bit monochrome values, unpacked 8 at a time
+            for (unsigned int y = 0; y < bitmap.rows; ++y)
             {
-                for (unsigned int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = ((pixels[(x - padding) / 8]) & (1 << (7 - ((x - padding) % 8)))) ? 255 : 0;
-                }
+                unsigned int x = 0;
+                for (; x + 8 <= bitmap.width; x += 8)
+                    std::memcpy(row + x, monoCoverage[pixels[x / 8]].data(), 8);
+                if (x < bitmap.width)
+                    std::memcpy(row + x, monoCoverage[pixels[x / 8]].data(), bitmap.width - x);
+
                 pixels += bitmap.pitch;
+                row += width;
             }
         }
         else
         {
-            // Pixels are 8 bits gray levels
-            for (unsigned int y = padding; y < height - padding; ++y)
+            // Pixels are 8 bits gray levels, they can be copied as is
+            for (unsigned int y = 0; y < bitmap.rows; ++y)
             {
-                for (unsigned int x = padding; x < width - padding; ++x)
-                {
-                    // The color channels remain white, just fill the alpha channel
-                    std::size_t index = x + y * width;
-                    m_pixelBuffer[index * 4 + 3] = pixels[x - padding];
-                }
+                std::memcpy(row, pixels, bitmap.width);
+
                 pixels += bitmap.pitch;
+                row += width;
+            }
+        }
+
+        if (!alphaOnly)
+        {
+            // The color channels remain white, the coverage goes to the alpha channel
+            Uint8* current = m_pixelBuffer.data();
+            for (std::size_t i = 0; i < pixelCount; ++i)
+            {
+                current[i * 4 + 0] = 255;
+                current[i * 4 + 1] = 255;
+                current[i * 4 + 2] = 255;
+                current[i * 4 + 3] = coverage[i];
             }
         }
 
@@ -746,7 +962,7 @@ IntRect Font::findGlyphRect(Page& page, unsigned int width, unsigned int height)
             {
                 // Make the texture 2 times bigger
                 Texture newTexture;
-                if (!newTexture.create(textureWidth * 2, textureHeight * 2))
+                if (!newTexture.create(textureWidth * 2, textureHeight * 2, RGBA8, page.texture.m_alphaOnly))
                 {
                     err() << "Failed to create new page texture" << std::endl;
                     return IntRect({0, 0}, {2, 2});
@@ -823,9 +1039,21 @@ bool Font::setCurrentSize(unsigned int characterSize) const
 
 
 ////////////////////////////////////////////////////////////
-Font::Page::Page(bool smooth) :
+Font::Page::Page(bool smooth, bool alphaOnly) :
 nextRow(3)
 {
+    if (alphaOnly && texture.create(128, 128, RGBA8, true) && texture.m_alphaOnly)
+    {
+        // Make sure that the texture is initialized by default, and
+        // reserve a 2x2 opaque square for texturing underlines
+        std::vector<Uint8> coverage(128 * 128, 0);
+        coverage[0] = coverage[1] = coverage[128] = coverage[129] = 255;
+        texture.update(coverage.data());
+
+        texture.setSmooth(smooth);
+        return;
+    }
+
     // Make sure that the texture is initialized by default
     sf::Image image;
     image.create(128, 128, Color(255, 255, 255, 0));
@@ -844,4 +1072,53 @@ nextRow(3)
     texture.setSmooth(smooth);
 }
 
+
+////////////////////////////////////////////////////////////
+Font::Page::Page(const Page& copy) :
+glyphs  (copy.glyphs),
+lookups (),
+kernings(copy.kernings),
+texture (copy.texture),
+nextRow (copy.nextRow),
+rows    (copy.rows)
+{
+
+}
+
+
+////////////////////////////////////////////////////////////
+Font::Page& Font::Page::operator=(const Page& right)
+{
+    glyphs   = right.glyphs;
+    kernings = right.kernings;
+    texture  = right.texture;
+    nextRow  = right.nextRow;
+    rows     = right.rows;
+
+    // The lookup tables would point into the glyph table of the other page
+    lookups.clear();
+
+    return *this;
+}
+
+
+////////////////////////////////////////////////////////////
+const Glyph*& Font::Page::getGlyphSlot(Uint64 variant, Uint32 codePoint)
+{
+    // Find the table of the variant; there are usually only a couple of them in use
+    auto lookup = std::find_if(lookups.begin(), lookups.end(), [variant](const GlyphLookup& l) { return l.variant == variant; });
+    if (lookup == lookups.end())
+    {
+        lookups.push_back({variant, std::vector<std::vector<const Glyph*>>(denseCodePointLimit / denseBlockSize)});
+        lookup = std::prev(lookups.end());
+    }
+
+    // Allocate the block of the code point on first use
+    std::vector<const Glyph*>& block = lookup->blocks[codePoint / denseBlockSize];
+    if (block.empty())
+        block.resize(denseBlockSize, nullptr);
+
+    return block[codePoint % denseBlockSize];
+}
+
 } // namespace sf
@@ -0,0 +1,581 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/FrameRecorder.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/Utils.hpp>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include <ostream>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+    // A nested named namespace is used here to allow unity builds of SFML.
+    namespace FrameRecorderImpl
+    {
+        // Number of pixel buffers the frames are read into: a buffer
+        // is mapped two captures after its read was issued, which
+        // leaves the graphics card enough time to complete it
+        constexpr std::size_t pixelBufferCount = 3;
+
+        // Convert a frame read back from OpenGL (RGBA, bottom row first)
+        // to the planar 4:2:0 layout of YUV4MPEG2 (BT.601, video range)
+        void convertToYuv420(const sf::Uint8* pixels, const sf::Vector2u& size, sf::Uint8* output)
+        {
+            const std::size_t width        = size.x;
+            const std::size_t height       = size.y;
+            const std::size_t chromaWidth  = (width + 1) / 2;
+            const std::size_t chromaHeight = (height + 1) / 2;
+
+            sf::Uint8* lumaPlane = output;
+            sf::Uint8* bluePlane = lumaPlane + width * height;
+            sf::Uint8* redPlane  = bluePlane + chromaWidth * chromaHeight;
+
+            const auto row = [&](std::size_t y) { return pixels + (height - 1 - y) * width * 4; };
+
+            for (std::size_t y = 0; y < height; ++y)
+            {
+                const sf::Uint8* source = row(y);
+                sf::Uint8*       luma   = lumaPlane + y * width;
+
+                for (std::size_t x = 0; x < width; ++x, source += 4)
+                    luma[x] = static_cast<sf::Uint8>(((66 * source[0] + 129 * source[1] + 25 * source[2] + 128) >> 8) + 16);
+            }
+
+            for (std::size_t y = 0; y < chromaHeight; ++y)
+            {
+                // Average each 2x2 block, repeating the last row and column for odd sizes
+                const sf::Uint8* top    = row(2 * y);
+                const sf::Uint8* bottom = row(std::min(2 * y + 1, height - 1));
+
+                for (std::size_t x = 0; x < chromaWidth; ++x)
+                {
+                    const std::size_t left  = 2 * x * 4;
+                    const std::size_t right = std::min(2 * x + 1, width - 1) * 4;
+
+                    int rgb[3];
+                    for (std::size_t i = 0; i < 3; ++i)
+                        rgb[i] = (top[left + i] + top[right + i] + bottom[left + i] + bottom[right + i] + 2) / 4;
+
+                    bluePlane[y * chromaWidth + x] = static_cast<sf::Uint8>(((-38 * rgb[0] - 74 * rgb[1] + 112 * rgb[2] + 128) >> 8) + 128);
+                    redPlane[y * chromaWidth + x]  = static_cast<sf::Uint8>(((112 * rgb[0] - 94 * rgb[1] - 18 * rgb[2] + 128) >> 8) + 128);
+                }
+            }
+        }
+
+        // Gives access to an OpenGL context to the functions that
+        // don't have a render target to activate
+        class ContextLock : sf::GlResource
+        {
+            TransientContextLock m_lock;
+        };
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct FrameRecorder::Writer
+{
+    ////////////////////////////////////////////////////////////
+    bool acquire(std::vector<Uint8>& frame)
+    {
+        std::scoped_lock lock(mutex);
+
+        if (!freeFrames.empty())
+        {
+            frame = std::move(freeFrames.back());
+            freeFrames.pop_back();
+            return true;
+        }
+
+        // Buffers are only allocated when needed, most recordings
+        // never have all of them in flight at the same time
+        if (allocatedFrames < maxFrames)
+        {
+            ++allocatedFrames;
+            frame.resize(static_cast<std::size_t>(size.x) * size.y * 4);
+            return true;
+        }
+
+        ++droppedFrames;
+        return false;
+    }
+
+    ////////////////////////////////////////////////////////////
+    void release(std::vector<Uint8>&& frame)
+    {
+        std::scoped_lock lock(mutex);
+        freeFrames.push_back(std::move(frame));
+    }
+
+    ////////////////////////////////////////////////////////////
+    void push(std::vector<Uint8>&& frame)
+    {
+        {
+            std::scoped_lock lock(mutex);
+            pendingFrames.push_back(std::move(frame));
+        }
+
+        condition.notify_one();
+    }
+
+    ////////////////////////////////////////////////////////////
+    void run()
+    {
+        std::vector<Uint8> yuv(static_cast<std::size_t>(size.x) * size.y + 2 * (static_cast<std::size_t>(size.x + 1) / 2) * ((size.y + 1) / 2));
+        bool failed = false;
+
+        for (;;)
+        {
+            std::vector<Uint8> frame;
+
+            {
+                std::unique_lock lock(mutex);
+                condition.wait(lock, [this] { return !pendingFrames.empty() || stopping; });
+
+                // Stop once all the pending frames are written
+                if (pendingFrames.empty())
+                    break;
+
+                frame = std::move(pendingFrames.front());
+                pendingFrames.pop_front();
+            }
+
+            if (!failed)
+            {
+                FrameRecorderImpl::convertToYuv420(frame.data(), size, yuv.data());
+
+                file.write("FRAME\n", 6);
+                file.write(reinterpret_cast<const char*>(yuv.data()), static_cast<std::streamsize>(yuv.size()));
+
+                if (file)
+                {
+                    ++writtenFrames;
+                }
+                else
+                {
+                    err() << "Failed to write recorded frame, the next frames will be dropped" << std::endl;
+                    failed = true;
+                }
+            }
+
+            if (failed)
+                ++droppedFrames;
+
+            release(std::move(frame));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::ofstream                   file;               //!< Output file
+    Vector2u                        size;               //!< Size of the frames
+    std::size_t                     maxFrames{};        //!< Maximum number of frame buffers
+    std::size_t                     allocatedFrames{};  //!< Number of frame buffers allocated so far
+    std::vector<std::vector<Uint8>> freeFrames;         //!< Frame buffers available for new captures
+    std::deque<std::vector<Uint8>>  pendingFrames;      //!< Frames waiting to be written
+    bool                            stopping{};         //!< Tells the thread to stop once the pending frames are written
+    std::mutex                      mutex;              //!< Protects the buffers and the stopping flag
+    std::condition_variable         condition;          //!< Wakes up the thread when frames are pending
+    std::atomic<Uint64>             writtenFrames{};    //!< Number of frames written to the file
+    std::atomic<Uint64>             droppedFrames{};    //!< Number of frames dropped
+    std::thread                     thread;             //!< Thread converting and writing the frames
+};
+
+
+#ifndef SFML_OPENGL_ES
+
+////////////////////////////////////////////////////////////
+struct FrameRecorder::PixelBuffers : private GlResource
+{
+    struct Slot
+    {
+        unsigned int       buffer{};  //!< Pixel buffer object
+        std::vector<Uint8> frame;     //!< Frame buffer reserved for the pixels being read
+        bool               pending{}; //!< Is a read pending in the pixel buffer?
+    };
+
+    ////////////////////////////////////////////////////////////
+    explicit PixelBuffers(std::size_t frameSize)
+    {
+        for (Slot& slot : slots)
+        {
+            GLuint buffer = 0;
+            glCheck(GLEXT_glGenBuffers(1, &buffer));
+            glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, buffer));
+            glCheck(GLEXT_glBufferData(GLEXT_GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptrARB>(frameSize), nullptr, GLEXT_GL_STREAM_READ));
+            slot.buffer = static_cast<unsigned int>(buffer);
+        }
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+    }
+
+    ////////////////////////////////////////////////////////////
+    ~PixelBuffers()
+    {
+        TransientContextLock contextLock;
+
+        for (Slot& slot : slots)
+        {
+            GLuint buffer = static_cast<GLuint>(slot.buffer);
+            glCheck(GLEXT_glDeleteBuffers(1, &buffer));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void retrieve(Slot& slot, Writer& writer)
+    {
+        slot.pending = false;
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, slot.buffer));
+
+        void* pixels = nullptr;
+        glCheck(pixels = GLEXT_glMapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, GLEXT_GL_READ_ONLY));
+
+        GLboolean mapped = GL_FALSE;
+        if (pixels)
+        {
+            std::memcpy(slot.frame.data(), pixels, slot.frame.size());
+            glCheck(mapped = GLEXT_glUnmapBuffer(GLEXT_GL_PIXEL_PACK_BUFFER));
+        }
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+        if (mapped == GL_TRUE)
+        {
+            writer.push(std::move(slot.frame));
+        }
+        else
+        {
+            err() << "Failed to retrieve captured frame (failed to map pixel buffer)" << std::endl;
+            ++writer.droppedFrames;
+            writer.release(std::move(slot.frame));
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    void flush(Writer& writer)
+    {
+        TransientContextLock contextLock;
+
+        // Retrieve the pending frames in the order they were captured
+        for (std::size_t i = 0; i < slots.size(); ++i)
+        {
+            Slot& slot = slots[(next + i) % slots.size()];
+            if (slot.pending)
+                retrieve(slot, writer);
+        }
+    }
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::array<Slot, FrameRecorderImpl::pixelBufferCount> slots; //!< Ring of pixel buffers
+    std::size_t                                          next{};  //!< Slot used by the next capture
+};
+
+#else
+
+////////////////////////////////////////////////////////////
+struct FrameRecorder::PixelBuffers
+{
+    // Pixel buffer objects are not available in OpenGL ES 1
+    void flush(Writer&)
+    {
+    }
+};
+
+#endif // SFML_OPENGL_ES
+
+
+////////////////////////////////////////////////////////////
+FrameRecorder::FrameRecorder() :
+m_size(0, 0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+FrameRecorder::~FrameRecorder()
+{
+    stop();
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::start(const std::filesystem::path& filename, const Vector2u& size, unsigned int frameRate, std::size_t bufferCount)
+{
+    stop();
+
+    if ((size.x == 0) || (size.y == 0) || (frameRate == 0))
+    {
+        err() << "Failed to start recording (invalid frame size or frame rate: "
+              << size.x << "x" << size.y << " at " << frameRate << " fps)" << std::endl;
+        return false;
+    }
+
+    auto writer = std::make_unique<Writer>();
+
+    writer->file.open(filename, std::ios::binary | std::ios::trunc);
+    writer->file << "YUV4MPEG2 W" << size.x << " H" << size.y << " F" << frameRate << ":1 Ip A1:1 C420jpeg\n";
+    writer->file.flush();
+
+    if (!writer->file)
+    {
+        err() << "Failed to start recording (failed to open the file)\n" << formatDebugPathInfo(filename) << std::endl;
+        return false;
+    }
+
+    // Each pixel buffer holds one frame buffer, at least one more
+    // is required for the frames to reach the writing thread
+    writer->size      = size;
+    writer->maxFrames = std::max(bufferCount, FrameRecorderImpl::pixelBufferCount + 1);
+    writer->thread    = std::thread(&Writer::run, writer.get());
+
+    m_writer = std::move(writer);
+    m_size   = size;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void FrameRecorder::stop()
+{
+    if (!isRecording())
+        return;
+
+    if (m_pixelBuffers)
+    {
+        m_pixelBuffers->flush(*m_writer);
+        m_pixelBuffers.reset();
+    }
+
+    {
+        std::scoped_lock lock(m_writer->mutex);
+        m_writer->stopping = true;
+    }
+
+    m_writer->condition.notify_one();
+    m_writer->thread.join();
+    m_writer->file.close();
+
+    // Keep the writer for its frame counts, but not its buffers
+    m_writer->freeFrames.clear();
+    m_writer->freeFrames.shrink_to_fit();
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::isRecording() const
+{
+    return m_writer && m_writer->thread.joinable();
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::capture(RenderWindow& window)
+{
+    if (!isRecording())
+        return false;
+
+    if (window.getSize() != m_size)
+    {
+        err() << "Failed to capture frame (the size of the window doesn't match the size of the recording)" << std::endl;
+        ++m_writer->droppedFrames;
+        return false;
+    }
+
+    if (!window.setActive(true))
+    {
+        err() << "Failed to capture frame (failed to activate the window)" << std::endl;
+        ++m_writer->droppedFrames;
+        return false;
+    }
+
+    // Read the back buffer, which holds the frame until display() is called
+    return readFrame([this](void* pixels)
+    {
+        glCheck(glReadPixels(0, 0, static_cast<GLsizei>(m_size.x), static_cast<GLsizei>(m_size.y), GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    });
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::capture(const RenderTexture& renderTexture)
+{
+    if (!isRecording())
+        return false;
+
+    const Texture& texture = renderTexture.getTexture();
+
+    if (texture.getSize() != m_size)
+    {
+        err() << "Failed to capture frame (the size of the render-texture doesn't match the size of the recording)" << std::endl;
+        ++m_writer->droppedFrames;
+        return false;
+    }
+
+    FrameRecorderImpl::ContextLock contextLock;
+
+#ifdef SFML_OPENGL_ES
+
+    // OpenGL ES can't read textures directly, Texture::copyToImage
+    // goes through a framebuffer object
+    const Image image = texture.copyToImage();
+
+    // The image starts with its top row, the frames with their bottom row
+    return readFrame([&image](void* pixels)
+    {
+        const std::size_t rowSize = static_cast<std::size_t>(image.getSize().x) * 4;
+        const std::size_t height  = image.getSize().y;
+        for (std::size_t y = 0; y < height; ++y)
+            std::memcpy(static_cast<Uint8*>(pixels) + (height - 1 - y) * rowSize, image.getPixelsPtr() + y * rowSize, rowSize);
+    });
+
+#else
+
+    priv::TextureSaver save;
+    priv::bindTexture(texture.getNativeHandle());
+
+    // The texture may be padded if non-power-of-two textures are not supported,
+    // it would need an extra copy to remove the padding, which isn't worth it
+    // for hardware that old
+    GLint width = 0;
+    GLint height = 0;
+    glCheck(glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_WIDTH, &width));
+    glCheck(glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_HEIGHT, &height));
+
+    if ((static_cast<unsigned int>(width) != m_size.x) || (static_cast<unsigned int>(height) != m_size.y))
+    {
+        err() << "Failed to capture frame (padded render-textures are not supported)" << std::endl;
+        ++m_writer->droppedFrames;
+        return false;
+    }
+
+    return readFrame([](void* pixels)
+    {
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+    });
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u FrameRecorder::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 FrameRecorder::getFrameCount() const
+{
+    return m_writer ? m_writer->writtenFrames.load() : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint64 FrameRecorder::getDroppedFrameCount() const
+{
+    return m_writer ? m_writer->droppedFrames.load() : 0;
+}
+
+
+////////////////////////////////////////////////////////////
+bool FrameRecorder::readFrame(const std::function<void(void*)>& readPixels)
+{
+    std::vector<Uint8> frame;
+
+#ifndef SFML_OPENGL_ES
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (GLEXT_pixel_buffer_object)
+    {
+        if (!m_pixelBuffers)
+            m_pixelBuffers = std::make_unique<PixelBuffers>(static_cast<std::size_t>(m_size.x) * m_size.y * 4);
+
+        PixelBuffers::Slot& slot = m_pixelBuffers->slots[m_pixelBuffers->next];
+        m_pixelBuffers->next = (m_pixelBuffers->next + 1) % m_pixelBuffers->slots.size();
+
+        // The read issued in this slot is old enough to be
+        // complete, retrieving it doesn't stall
+        if (slot.pending)
+            m_pixelBuffers->retrieve(slot, *m_writer);
+
+        if (!m_writer->acquire(frame))
+            return false;
+
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, slot.buffer));
+        readPixels(nullptr);
+        glCheck(GLEXT_glBindBuffer(GLEXT_GL_PIXEL_PACK_BUFFER, 0));
+
+        // Submit the read now, so that it completes even if the
+        // next capture happens in another context
+        glCheck(glFlush());
+
+        slot.frame   = std::move(frame);
+        slot.pending = true;
+
+        return true;
+    }
+
+#endif // SFML_OPENGL_ES
+
+    // No pixel buffers: the read is synchronous
+    if (!m_writer->acquire(frame))
+        return false;
+
+    readPixels(frame.data());
+    m_writer->push(std::move(frame));
+
+    return true;
+}
+
+} // namespace sf
@@ -122,6 +122,11 @@
     #define GLEXT_packed_depth_stencil                SF_GLAD_GL_OES_packed_depth_stencil
     #define GLEXT_GL_DEPTH24_STENCIL8                 GL_DEPTH24_STENCIL8_OES
 
+    // Core since 3.0 - NV_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 false
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                0
+    #define GLEXT_GL_STREAM_READ                      0
+
     // Core since 3.0
     #define GLEXT_framebuffer_blit                    false
     #define GLEXT_glBlitFramebuffer                   glBlitFramebufferEXT // Placeholder to satisfy the compiler, entry point is not loaded in GLES
@@ -135,16 +140,46 @@
     #define GLEXT_glRenderbufferStorageMultisample    glRenderbufferStorageMultisampleEXT // Placeholder to satisfy the compiler, entry point is not loaded in GLES
     #define GLEXT_GL_MAX_SAMPLES                      0
 
+    // Core since 3.0 - EXT_draw_buffers
+    #define GLEXT_draw_buffers                        false
+    #define GLEXT_glDrawBuffers                       glDrawBuffersARB // Placeholder to satisfy the compiler, entry point is not loaded in GLES
+    #define GLEXT_GL_MAX_DRAW_BUFFERS                 0
+    #define GLEXT_GL_MAX_COLOR_ATTACHMENTS            0
+
     // Core since 3.0 - NV_copy_buffer
     #define GLEXT_copy_buffer                         false
     #define GLEXT_GL_COPY_READ_BUFFER                 0
     #define GLEXT_GL_COPY_WRITE_BUFFER                0
     #define GLEXT_glCopyBufferSubData                 glCopyBufferSubData // Placeholder to satisfy the compiler, entry point is not loaded in GLES
 
+    // Core since 3.0 - EXT_map_buffer_range
+    #define GLEXT_map_buffer_range                    false
+
+    // Core since 3.0 - APPLE_sync
+    #define GLEXT_sync                                false
+
     // Core since 3.0 - EXT_sRGB
     #define GLEXT_texture_sRGB                        false
     #define GLEXT_GL_SRGB8_ALPHA8                     0
 
+    // Core since 3.0 - EXT_texture_rg
+    #define GLEXT_texture_rg                          false
+    #define GLEXT_GL_RED                              0
+    #define GLEXT_GL_RG                               0
+    #define GLEXT_GL_R8                               0
+    #define GLEXT_GL_RG8                              0
+    #define GLEXT_GL_R16                              0
+    #define GLEXT_GL_RGB8                             GL_RGB
+
+    // Core since 3.0 - OES_texture_float, OES_texture_half_float
+    #define GLEXT_texture_float                       false
+    #define GLEXT_GL_RGBA16F                          0
+    #define GLEXT_GL_RGBA32F                          0
+    #define GLEXT_GL_HALF_FLOAT                       0
+
+    // Core since 3.0 - ARB_half_float_vertex
+    #define GLEXT_half_float_vertex                   false
+
     // Core since 3.0 - EXT_blend_minmax
     #define GLEXT_blend_minmax                        SF_GLAD_GL_EXT_blend_minmax
     #define GLEXT_GL_MIN                              GL_MIN_EXT
@@ -247,6 +282,10 @@
 
     // Core since 2.0 - ARB_vertex_shader
     #define GLEXT_vertex_shader                       SF_GLAD_GL_ARB_vertex_shader
+    #define GLEXT_glVertexAttribPointer               glVertexAttribPointerARB
+    #define GLEXT_glEnableVertexAttribArray           glEnableVertexAttribArrayARB
+    #define GLEXT_glDisableVertexAttribArray          glDisableVertexAttribArrayARB
+    #define GLEXT_glGetAttribLocation                 glGetAttribLocationARB
     #define GLEXT_GL_VERTEX_SHADER                    GL_VERTEX_SHADER_ARB
     #define GLEXT_GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS GL_MAX_COMBINED_TEXTURE_IMAGE_UNITS_ARB
 
@@ -254,6 +293,11 @@
     #define GLEXT_fragment_shader                     SF_GLAD_GL_ARB_fragment_shader
     #define GLEXT_GL_FRAGMENT_SHADER                  GL_FRAGMENT_SHADER_ARB
 
+    // Core since 2.0 - ARB_draw_buffers
+    #define GLEXT_draw_buffers                        SF_GLAD_GL_ARB_draw_buffers
+    #define GLEXT_glDrawBuffers                       glDrawBuffersARB
+    #define GLEXT_GL_MAX_DRAW_BUFFERS                 GL_MAX_DRAW_BUFFERS_ARB
+
     // Core since 2.0 - ARB_texture_non_power_of_two
     #define GLEXT_texture_non_power_of_two            SF_GLAD_GL_ARB_texture_non_power_of_two
 
@@ -261,10 +305,33 @@
     #define GLEXT_blend_equation_separate             SF_GLAD_GL_EXT_blend_equation_separate
     #define GLEXT_glBlendEquationSeparate             glBlendEquationSeparateEXT
 
+    // Core since 2.1 - ARB_pixel_buffer_object
+    #define GLEXT_pixel_buffer_object                 SF_GLAD_GL_VERSION_2_1
+    #define GLEXT_GL_PIXEL_PACK_BUFFER                GL_PIXEL_PACK_BUFFER
+    #define GLEXT_GL_STREAM_READ                      GL_STREAM_READ
+
     // Core since 2.1 - EXT_texture_sRGB
     #define GLEXT_texture_sRGB                        SF_GLAD_GL_EXT_texture_sRGB
     #define GLEXT_GL_SRGB8_ALPHA8                     GL_SRGB8_ALPHA8_EXT
 
+    // Core since 3.0 - ARB_texture_rg
+    #define GLEXT_texture_rg                          SF_GLAD_GL_VERSION_3_0
+    #define GLEXT_GL_RED                              GL_RED
+    #define GLEXT_GL_RG                               GL_RG
+    #define GLEXT_GL_R8                               GL_R8
+    #define GLEXT_GL_RG8                              GL_RG8
+    #define GLEXT_GL_R16                              GL_R16
+    #define GLEXT_GL_RGB8                             GL_RGB8
+
+    // Core since 3.0 - ARB_texture_float, ARB_half_float_pixel
+    #define GLEXT_texture_float                       SF_GLAD_GL_VERSION_3_0
+    #define GLEXT_GL_RGBA16F                          GL_RGBA16F
+    #define GLEXT_GL_RGBA32F                          GL_RGBA32F
+    #define GLEXT_GL_HALF_FLOAT                       GL_HALF_FLOAT
+
+    // Core since 3.0 - ARB_half_float_vertex
+    #define GLEXT_half_float_vertex                   SF_GLAD_GL_VERSION_3_0
+
     // Core since 3.0 - EXT_framebuffer_object
     #define GLEXT_framebuffer_object                  SF_GLAD_GL_EXT_framebuffer_object
     #define GLEXT_glBindRenderbuffer                  glBindRenderbufferEXT
@@ -286,6 +353,7 @@
     #define GLEXT_GL_FRAMEBUFFER_BINDING              GL_FRAMEBUFFER_BINDING_EXT
     #define GLEXT_GL_INVALID_FRAMEBUFFER_OPERATION    GL_INVALID_FRAMEBUFFER_OPERATION_EXT
     #define GLEXT_GL_STENCIL_ATTACHMENT               GL_STENCIL_ATTACHMENT_EXT
+    #define GLEXT_GL_MAX_COLOR_ATTACHMENTS            GL_MAX_COLOR_ATTACHMENTS_EXT
 
     // Core since 3.0 - EXT_packed_depth_stencil
     #define GLEXT_packed_depth_stencil                SF_GLAD_GL_EXT_packed_depth_stencil
@@ -304,12 +372,30 @@
     #define GLEXT_glRenderbufferStorageMultisample    glRenderbufferStorageMultisampleEXT
     #define GLEXT_GL_MAX_SAMPLES                      GL_MAX_SAMPLES_EXT
 
+    // Core since 3.0 - ARB_map_buffer_range
+    #define GLEXT_map_buffer_range                    SF_GLAD_GL_ARB_map_buffer_range
+    #define GLEXT_GL_MAP_WRITE_BIT                    GL_MAP_WRITE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_RANGE_BIT         GL_MAP_INVALIDATE_RANGE_BIT
+    #define GLEXT_GL_MAP_INVALIDATE_BUFFER_BIT        GL_MAP_INVALIDATE_BUFFER_BIT
+    #define GLEXT_GL_MAP_UNSYNCHRONIZED_BIT           GL_MAP_UNSYNCHRONIZED_BIT
+    #define GLEXT_glMapBufferRange                    glMapBufferRange
+
     // Core since 3.1 - ARB_copy_buffer
     #define GLEXT_copy_buffer                         SF_GLAD_GL_ARB_copy_buffer
     #define GLEXT_GL_COPY_READ_BUFFER                 GL_COPY_READ_BUFFER
     #define GLEXT_GL_COPY_WRITE_BUFFER                GL_COPY_WRITE_BUFFER
     #define GLEXT_glCopyBufferSubData                 glCopyBufferSubData
 
+    // Core since 3.2 - ARB_sync
+    #define GLEXT_sync                                SF_GLAD_GL_ARB_sync
+    #define GLEXT_GLsync                              GLsync
+    #define GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE       GL_SYNC_GPU_COMMANDS_COMPLETE
+    #define GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT          GL_SYNC_FLUSH_COMMANDS_BIT
+    #define GLEXT_GL_TIMEOUT_EXPIRED                  GL_TIMEOUT_EXPIRED
+    #define GLEXT_glFenceSync                         glFenceSync
+    #define GLEXT_glClientWaitSync                    glClientWaitSync
+    #define GLEXT_glDeleteSync                        glDeleteSync
+
     // Core since 3.2 - ARB_geometry_shader4
     #define GLEXT_geometry_shader4                    SF_GLAD_GL_ARB_geometry_shader4
     #define GLEXT_GL_GEOMETRY_SHADER                  GL_GEOMETRY_SHADER_ARB
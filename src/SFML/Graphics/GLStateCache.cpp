@@ -0,0 +1,453 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+
+namespace
+{
+    // A nested named namespace is used here to allow unity builds of SFML.
+    namespace GLStateCacheImpl
+    {
+        // Incremented when objects are deleted, since their names can be reused: contexts
+        // which saw an older value forget their bindings of this kind of object
+        std::atomic<sf::Uint64> textureEpoch(0);
+        std::atomic<sf::Uint64> programEpoch(0);
+        std::atomic<sf::Uint64> bufferEpoch(0);
+        std::atomic<sf::Uint64> framebufferEpoch(0);
+
+        // Texture matrix of a texture unit: scale and vertical offset
+        using TextureMatrix = std::array<float, 3>;
+
+        // Known states of a context, empty when unknown
+        struct ContextState
+        {
+            std::vector<std::optional<GLuint>>        textures;         // Texture bound to each unit
+            std::vector<std::optional<TextureMatrix>> textureMatrices;  // Texture matrix of each unit
+            std::optional<unsigned int>               activeUnit;       // Active texture unit
+#ifndef SFML_OPENGL_ES
+            std::optional<GLEXT_GLhandle>             program;          // Program in use
+#endif
+            std::optional<GLuint>                     arrayBuffer;      // Buffer bound to GL_ARRAY_BUFFER
+            std::optional<GLuint>                     readFramebuffer;  // Framebuffer read from
+            std::optional<GLuint>                     drawFramebuffer;  // Framebuffer drawn to
+            std::optional<sf::BlendMode>              blendMode;        // Blend mode
+            sf::Uint64                                textureEpoch;     // Value of textureEpoch when the texture bindings were checked
+            sf::Uint64                                programEpoch;     // Value of programEpoch when the program was checked
+            sf::Uint64                                bufferEpoch;      // Value of bufferEpoch when the buffer binding was checked
+            sf::Uint64                                framebufferEpoch; // Value of framebufferEpoch when the framebuffer bindings were checked
+        };
+
+        // States of all the contexts, by context ID
+        std::mutex mutex;
+        std::unordered_map<sf::Uint64, std::unique_ptr<ContextState>> contextStates;
+
+        // Last state used by each thread, to avoid locking the mutex on every call
+        // Context IDs are never reused, so a state is never found after its context is destroyed
+        thread_local sf::Uint64    cachedContextId = 0;
+        thread_local ContextState* cachedState = nullptr;
+
+        // Forget the states of the context being destroyed (it is the active one)
+        void contextDestroyCallback(void*)
+        {
+            std::scoped_lock lock(mutex);
+            contextStates.erase(sf::Context::getActiveContextId());
+        }
+
+        // Gives access to the registration of context destruction callbacks
+        struct CallbackRegistrar : sf::GlResource
+        {
+            static void registerCallback()
+            {
+                registerContextDestroyCallback(contextDestroyCallback, nullptr);
+            }
+        };
+
+        // Forget the bindings of objects deleted since they were last checked
+        void checkEpochs(ContextState& state)
+        {
+            if (const sf::Uint64 epoch = textureEpoch.load(std::memory_order_acquire); epoch != state.textureEpoch)
+            {
+                state.textures.clear();
+                state.textureEpoch = epoch;
+            }
+
+            if (const sf::Uint64 epoch = programEpoch.load(std::memory_order_acquire); epoch != state.programEpoch)
+            {
+#ifndef SFML_OPENGL_ES
+                state.program.reset();
+#endif
+                state.programEpoch = epoch;
+            }
+
+            if (const sf::Uint64 epoch = bufferEpoch.load(std::memory_order_acquire); epoch != state.bufferEpoch)
+            {
+                state.arrayBuffer.reset();
+                state.bufferEpoch = epoch;
+            }
+
+            if (const sf::Uint64 epoch = framebufferEpoch.load(std::memory_order_acquire); epoch != state.framebufferEpoch)
+            {
+                state.readFramebuffer.reset();
+                state.drawFramebuffer.reset();
+                state.framebufferEpoch = epoch;
+            }
+        }
+
+        // Get the states of the active context, or a null pointer if no context is active
+        ContextState* getState()
+        {
+            const sf::Uint64 contextId = sf::Context::getActiveContextId();
+            if (!contextId)
+                return nullptr;
+
+            if (contextId != cachedContextId)
+            {
+                std::scoped_lock lock(mutex);
+
+                std::unique_ptr<ContextState>& state = contextStates[contextId];
+                if (!state)
+                {
+                    static bool callbackRegistered = false;
+                    if (!callbackRegistered)
+                    {
+                        CallbackRegistrar::registerCallback();
+                        callbackRegistered = true;
+                    }
+
+                    state = std::make_unique<ContextState>();
+                    state->textureEpoch = textureEpoch.load(std::memory_order_acquire);
+                    state->programEpoch = programEpoch.load(std::memory_order_acquire);
+                    state->bufferEpoch = bufferEpoch.load(std::memory_order_acquire);
+                    state->framebufferEpoch = framebufferEpoch.load(std::memory_order_acquire);
+                }
+
+                cachedContextId = contextId;
+                cachedState = state.get();
+            }
+
+            checkEpochs(*cachedState);
+
+            return cachedState;
+        }
+
+        // Get the active texture unit, reading it from OpenGL the first time
+        unsigned int getActiveUnit(ContextState& state)
+        {
+            if (!state.activeUnit)
+            {
+                GLint unit = GLEXT_GL_TEXTURE0;
+                if (GLEXT_multitexture)
+                    glCheck(glGetIntegerv(GL_ACTIVE_TEXTURE, &unit));
+
+                state.activeUnit = static_cast<unsigned int>(unit - GLEXT_GL_TEXTURE0);
+            }
+
+            return *state.activeUnit;
+        }
+
+        // Get an entry of a vector of per-unit states, adding it if needed
+        template <typename T>
+        std::optional<T>& getUnitEntry(std::vector<std::optional<T>>& entries, unsigned int unit)
+        {
+            if (unit >= entries.size())
+                entries.resize(unit + 1);
+
+            return entries[unit];
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+void bindTexture(GLuint texture, bool force)
+{
+    GLStateCacheImpl::ContextState* state = GLStateCacheImpl::getState();
+
+    if (!state)
+    {
+        glCheck(glBindTexture(GL_TEXTURE_2D, texture));
+        return;
+    }
+
+    std::optional<GLuint>& binding = GLStateCacheImpl::getUnitEntry(state->textures, GLStateCacheImpl::getActiveUnit(*state));
+    if (!force && (binding == texture))
+        return;
+
+    glCheck(glBindTexture(GL_TEXTURE_2D, texture));
+    binding = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+GLuint getTextureBinding()
+{
+    GLStateCacheImpl::ContextState* state = GLStateCacheImpl::getState();
+
+    if (state)
+    {
+        std::optional<GLuint>& binding = GLStateCacheImpl::getUnitEntry(state->textures, GLStateCacheImpl::getActiveUnit(*state));
+        if (binding)
+            return *binding;
+    }
+
+    GLint texture = 0;
+    glCheck(glGetIntegerv(GL_TEXTURE_BINDING_2D, &texture));
+
+    if (state)
+        GLStateCacheImpl::getUnitEntry(state->textures, *state->activeUnit) = static_cast<GLuint>(texture);
+
+    return static_cast<GLuint>(texture);
+}
+
+
+////////////////////////////////////////////////////////////
+void setActiveTextureUnit(unsigned int unit)
+{
+    GLStateCacheImpl::ContextState* state = GLStateCacheImpl::getState();
+
+    if (state && (state->activeUnit == unit))
+        return;
+
+    glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + static_cast<GLenum>(unit)));
+
+    if (state)
+        state->activeUnit = unit;
+}
+
+
+////////////////////////////////////////////////////////////
+void loadTextureMatrix(float scaleX, float scaleY, float offsetY)
+{
+    const GLStateCacheImpl::TextureMatrix matrix = {scaleX, scaleY, offsetY};
+
+    GLStateCacheImpl::ContextState* state = GLStateCacheImpl::getState();
+    std::optional<GLStateCacheImpl::TextureMatrix>* current = nullptr;
+
+    if (state)
+    {
+        current = &GLStateCacheImpl::getUnitEntry(state->textureMatrices, GLStateCacheImpl::getActiveUnit(*state));
+        if (*current == matrix)
+            return;
+    }
+
+    if ((scaleX == 1.f) && (scaleY == 1.f) && (offsetY == 0.f))
+    {
+        glCheck(glMatrixMode(GL_TEXTURE));
+        glCheck(glLoadIdentity());
+    }
+    else
+    {
+        const GLfloat values[16] = {scaleX, 0.f,    0.f, 0.f,
+                                    0.f,    scaleY, 0.f, 0.f,
+                                    0.f,    0.f,    1.f, 0.f,
+                                    0.f,    offsetY, 0.f, 1.f};
+
+        glCheck(glMatrixMode(GL_TEXTURE));
+        glCheck(glLoadMatrixf(values));
+    }
+
+    // Go back to model-view mode (sf::RenderTarget relies on it)
+    glCheck(glMatrixMode(GL_MODELVIEW));
+
+    if (current)
+        *current = matrix;
+}
+
+
+#ifndef SFML_OPENGL_ES
+
+////////////////////////////////////////////////////////////
+void useProgram(GLEXT_GLhandle program)
+{
+    GLStateCacheImpl::ContextState* state = GLStateCacheImpl::getState();
+
+    if (state && (state->program == program))
+        return;
+
+    glCheck(GLEXT_glUseProgramObject(program));
+
+    if (state)
+        state->program = program;
+}
+
+
+////////////////////////////////////////////////////////////
+GLEXT_GLhandle getProgramBinding()
+{
+    GLStateCacheImpl::ContextState* state = GLStateCacheImpl::getState();
+
+    if (state && state->program)
+        return *state->program;
+
+    GLEXT_GLhandle program;
+    glCheck(program = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
+
+    if (state)
+        state->program = program;
+
+    return program;
+}
+
+#endif
+
+
+////////////////////////////////////////////////////////////
+void bindArrayBuffer(GLuint buffer)
+{
+    GLStateCacheImpl::ContextState* state = GLStateCacheImpl::getState();
+
+    if (state && (state->arrayBuffer == buffer))
+        return;
+
+    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, buffer));
+
+    if (state)
+        state->arrayBuffer = buffer;
+}
+
+
+////////////////////////////////////////////////////////////
+void bindFramebuffer(GLenum target, GLuint frameBuffer)
+{
+    GLStateCacheImpl::ContextState* state = GLStateCacheImpl::getState();
+
+    const bool read = (target == GLEXT_GL_FRAMEBUFFER) || (target == GLEXT_GL_READ_FRAMEBUFFER);
+    const bool draw = (target == GLEXT_GL_FRAMEBUFFER) || (target == GLEXT_GL_DRAW_FRAMEBUFFER);
+
+    if (state && (!read || (state->readFramebuffer == frameBuffer)) && (!draw || (state->drawFramebuffer == frameBuffer)))
+        return;
+
+    glCheck(GLEXT_glBindFramebuffer(target, frameBuffer));
+
+    if (state)
+    {
+        if (read)
+            state->readFramebuffer = frameBuffer;
+
+        if (draw)
+            state->drawFramebuffer = frameBuffer;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+GLuint getFramebufferBinding(GLenum target)
+{
+    GLStateCacheImpl::ContextState* state = GLStateCacheImpl::getState();
+
+    const bool read = (target == GLEXT_GL_READ_FRAMEBUFFER);
+    std::optional<GLuint>* binding = state ? (read ? &state->readFramebuffer : &state->drawFramebuffer) : nullptr;
+
+    if (binding && *binding)
+        return **binding;
+
+    GLint frameBuffer = 0;
+    if (read && GLEXT_framebuffer_blit)
+        glCheck(glGetIntegerv(GLEXT_GL_READ_FRAMEBUFFER_BINDING, &frameBuffer));
+    else
+        glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &frameBuffer));
+
+    if (binding)
+        *binding = static_cast<GLuint>(frameBuffer);
+
+    return static_cast<GLuint>(frameBuffer);
+}
+
+
+////////////////////////////////////////////////////////////
+bool updateBlendMode(const BlendMode& mode)
+{
+    GLStateCacheImpl::ContextState* state = GLStateCacheImpl::getState();
+
+    if (!state)
+        return true;
+
+    if (state->blendMode == mode)
+        return false;
+
+    state->blendMode = mode;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void invalidateGLStates()
+{
+    if (GLStateCacheImpl::ContextState* state = GLStateCacheImpl::getState())
+    {
+        *state = GLStateCacheImpl::ContextState();
+        GLStateCacheImpl::checkEpochs(*state);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void invalidateTextureBindings()
+{
+    GLStateCacheImpl::textureEpoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+
+////////////////////////////////////////////////////////////
+void invalidateProgramBindings()
+{
+    GLStateCacheImpl::programEpoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+
+////////////////////////////////////////////////////////////
+void invalidateBufferBindings()
+{
+    GLStateCacheImpl::bufferEpoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+
+////////////////////////////////////////////////////////////
+void invalidateFramebufferBindings()
+{
+    GLStateCacheImpl::framebufferEpoch.fetch_add(1, std::memory_order_acq_rel);
+}
+
+} // namespace priv
+
+} // namespace sf
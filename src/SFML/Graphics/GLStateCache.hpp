@@ -0,0 +1,193 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_GLSTATECACHE_HPP
+#define SFML_GLSTATECACHE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/BlendMode.hpp>
+#include <SFML/Graphics/GLExtensions.hpp>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+// These functions change the OpenGL states of the active
+// context, and keep a copy of them, so that the calls which
+// don't change anything and the queries (glGet*) are skipped.
+// All the code of SFML must go through them for the states
+// they handle, any other change must be followed by a call
+// to invalidateGLStates().
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+/// \brief Bind a texture to the active texture unit
+///
+/// \param texture OpenGL name of the texture, 0 to unbind
+/// \param force   Issue the call even if the texture is already bound
+///
+////////////////////////////////////////////////////////////
+void bindTexture(GLuint texture, bool force = false);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the texture bound to the active texture unit
+///
+/// \return OpenGL name of the texture
+///
+////////////////////////////////////////////////////////////
+GLuint getTextureBinding();
+
+////////////////////////////////////////////////////////////
+/// \brief Select the active texture unit
+///
+/// \param unit Index of the unit, starting from 0
+///
+////////////////////////////////////////////////////////////
+void setActiveTextureUnit(unsigned int unit);
+
+////////////////////////////////////////////////////////////
+/// \brief Load the texture matrix of the active texture unit
+///
+/// The matrix scales the coordinates and offsets them
+/// vertically, which is all that textures need.
+///
+/// \param scaleX  Horizontal scale
+/// \param scaleY  Vertical scale
+/// \param offsetY Vertical offset
+///
+////////////////////////////////////////////////////////////
+void loadTextureMatrix(float scaleX, float scaleY, float offsetY);
+
+#ifndef SFML_OPENGL_ES
+
+////////////////////////////////////////////////////////////
+/// \brief Use a shader program
+///
+/// \param program OpenGL handle of the program, 0 to use none
+///
+////////////////////////////////////////////////////////////
+void useProgram(GLEXT_GLhandle program);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the shader program in use
+///
+/// \return OpenGL handle of the program
+///
+////////////////////////////////////////////////////////////
+GLEXT_GLhandle getProgramBinding();
+
+#endif
+
+////////////////////////////////////////////////////////////
+/// \brief Bind a buffer to the vertex array target
+///
+/// \param buffer OpenGL name of the buffer, 0 to unbind
+///
+////////////////////////////////////////////////////////////
+void bindArrayBuffer(GLuint buffer);
+
+////////////////////////////////////////////////////////////
+/// \brief Bind a framebuffer
+///
+/// \param target      GLEXT_GL_FRAMEBUFFER, GLEXT_GL_READ_FRAMEBUFFER or GLEXT_GL_DRAW_FRAMEBUFFER
+/// \param frameBuffer OpenGL name of the framebuffer
+///
+////////////////////////////////////////////////////////////
+void bindFramebuffer(GLenum target, GLuint frameBuffer);
+
+////////////////////////////////////////////////////////////
+/// \brief Get the framebuffer bound to a target
+///
+/// \param target GLEXT_GL_FRAMEBUFFER (same as draw), GLEXT_GL_READ_FRAMEBUFFER or GLEXT_GL_DRAW_FRAMEBUFFER
+///
+/// \return OpenGL name of the framebuffer
+///
+////////////////////////////////////////////////////////////
+GLuint getFramebufferBinding(GLenum target);
+
+////////////////////////////////////////////////////////////
+/// \brief Record the blend mode of the active context
+///
+/// \param mode Blend mode about to be applied
+///
+/// \return True if the blend mode differs from the current
+///         one and must be applied, false otherwise
+///
+////////////////////////////////////////////////////////////
+bool updateBlendMode(const BlendMode& mode);
+
+////////////////////////////////////////////////////////////
+/// \brief Forget the states of the active context
+///
+/// This must be called after the states are changed without
+/// going through the functions above, for example by user
+/// OpenGL code.
+///
+////////////////////////////////////////////////////////////
+void invalidateGLStates();
+
+////////////////////////////////////////////////////////////
+/// \brief Forget the texture bindings of all the contexts
+///
+/// This must be called after textures are deleted, since
+/// their names can be reused.
+///
+////////////////////////////////////////////////////////////
+void invalidateTextureBindings();
+
+////////////////////////////////////////////////////////////
+/// \brief Forget the shader program of all the contexts
+///
+/// This must be called after programs are deleted.
+///
+////////////////////////////////////////////////////////////
+void invalidateProgramBindings();
+
+////////////////////////////////////////////////////////////
+/// \brief Forget the buffer bindings of all the contexts
+///
+/// This must be called after buffers are deleted.
+///
+////////////////////////////////////////////////////////////
+void invalidateBufferBindings();
+
+////////////////////////////////////////////////////////////
+/// \brief Forget the framebuffer bindings of all the contexts
+///
+/// This must be called after framebuffers are deleted.
+///
+////////////////////////////////////////////////////////////
+void invalidateFramebufferBindings();
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_GLSTATECACHE_HPP
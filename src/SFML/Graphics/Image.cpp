@@ -27,20 +27,558 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Image.hpp>
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/PixelConversion.hpp>
 #include <SFML/System/Err.hpp>
+#include <SFML/System/ThreadPool.hpp>
 #ifdef SFML_SYSTEM_ANDROID
     #include <SFML/System/Android/ResourceStream.hpp>
 #endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_IMAGE_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_IMAGE_USE_NEON
+#endif
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <ostream>
+#include <cmath>
 #include <cstring>
 
 
+namespace
+{
+    // Images are split into bands of rows processed in parallel; bands smaller than this number of pixels are not worth a thread
+    constexpr std::size_t minPixelsPerBand = 64 * 1024;
+
+    // Process the rows of an image in parallel bands
+    template <typename F>
+    void forEachRowBand(unsigned int width, unsigned int height, F function)
+    {
+        std::size_t minRows = std::max(minPixelsPerBand / std::max(width, 1u), std::size_t(1));
+        sf::priv::ThreadPool::getGlobal().parallelFor(height, minRows, function);
+    }
+
+    // Read and write pixels as 32-bit words, without caring about the byte order
+    sf::Uint32 loadPixel(const sf::Uint8* pixel)
+    {
+        sf::Uint32 value;
+        std::memcpy(&value, pixel, 4);
+        return value;
+    }
+
+    void storePixel(sf::Uint8* pixel, sf::Uint32 value)
+    {
+        std::memcpy(pixel, &value, 4);
+    }
+
+    sf::Uint32 packPixel(sf::Uint8 r, sf::Uint8 g, sf::Uint8 b, sf::Uint8 a)
+    {
+        const sf::Uint8 components[4] = {r, g, b, a};
+        return loadPixel(components);
+    }
+
+    // Set the alpha of the pixels equal to key
+    void maskRow(sf::Uint8* pixels, std::size_t count, sf::Uint32 key, sf::Uint8 alpha)
+    {
+        const sf::Uint32 alphaMask  = packPixel(0, 0, 0, 255);
+        const sf::Uint32 alphaValue = packPixel(0, 0, 0, alpha);
+        std::size_t i = 0;
+
+#if defined(SFML_IMAGE_USE_SSE2)
+        const __m128i keys   = _mm_set1_epi32(static_cast<int>(key));
+        const __m128i masks  = _mm_set1_epi32(static_cast<int>(alphaMask));
+        const __m128i values = _mm_set1_epi32(static_cast<int>(alphaValue));
+        for (; i + 4 <= count; i += 4)
+        {
+            auto* address = reinterpret_cast<__m128i*>(pixels + i * 4);
+            __m128i block    = _mm_loadu_si128(address);
+            __m128i selected = _mm_and_si128(_mm_cmpeq_epi32(block, keys), masks);
+            _mm_storeu_si128(address, _mm_or_si128(_mm_andnot_si128(selected, block), _mm_and_si128(selected, values)));
+        }
+#elif defined(SFML_IMAGE_USE_NEON)
+        const uint32x4_t keys   = vdupq_n_u32(key);
+        const uint32x4_t masks  = vdupq_n_u32(alphaMask);
+        const uint32x4_t values = vdupq_n_u32(alphaValue);
+        for (; i + 4 <= count; i += 4)
+        {
+            uint32x4_t block    = vreinterpretq_u32_u8(vld1q_u8(pixels + i * 4));
+            uint32x4_t selected = vandq_u32(vceqq_u32(block, keys), masks);
+            vst1q_u8(pixels + i * 4, vreinterpretq_u8_u32(vbslq_u32(selected, values, block)));
+        }
+#endif
+
+        for (; i < count; ++i)
+        {
+            if (loadPixel(pixels + i * 4) == key)
+                pixels[i * 4 + 3] = alpha;
+        }
+    }
+
+    // Blend one source pixel over one destination pixel, using the alpha of both
+    void blendPixel(const sf::Uint8* src, sf::Uint8* dst)
+    {
+        sf::Uint8 srcAlpha = src[3];
+        sf::Uint8 dstAlpha = dst[3];
+
+        // Opaque source pixels replace the destination, transparent ones leave it unchanged
+        if (srcAlpha == 255)
+        {
+            std::memcpy(dst, src, 4);
+            return;
+        }
+        if ((srcAlpha == 0) && (dstAlpha != 0))
+            return;
+
+        // Interpolate RGBA components using the alpha values of the destination and source pixels
+        auto outAlpha = static_cast<sf::Uint8>(srcAlpha + dstAlpha - srcAlpha * dstAlpha / 255);
+
+        dst[3] = outAlpha;
+
+        if (outAlpha)
+            for (int k = 0; k < 3; k++)
+                dst[k] = static_cast<sf::Uint8>((src[k] * srcAlpha + dst[k] * (outAlpha - srcAlpha)) / outAlpha);
+        else
+            for (int k = 0; k < 3; k++)
+                dst[k] = src[k];
+    }
+
+    // Blend a row of source pixels over a row of destination pixels
+    void blendRow(const sf::Uint8* src, sf::Uint8* dst, std::size_t count)
+    {
+        std::size_t i = 0;
+
+        // Most images are made of large areas of opaque or transparent pixels,
+        // handle them 4 by 4 and only interpolate the blocks that need it
+#if defined(SFML_IMAGE_USE_SSE2)
+        const __m128i masks = _mm_set1_epi32(static_cast<int>(packPixel(0, 0, 0, 255)));
+        const __m128i zero  = _mm_setzero_si128();
+        for (; i + 4 <= count; i += 4)
+        {
+            __m128i srcBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 4));
+            __m128i srcAlpha = _mm_and_si128(srcBlock, masks);
+
+            if (_mm_movemask_epi8(_mm_cmpeq_epi32(srcAlpha, masks)) == 0xFFFF)
+            {
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), srcBlock);
+                continue;
+            }
+
+            __m128i dstAlpha = _mm_and_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(dst + i * 4)), masks);
+            if ((_mm_movemask_epi8(_mm_cmpeq_epi32(srcAlpha, zero)) == 0xFFFF) && (_mm_movemask_epi8(_mm_cmpeq_epi32(dstAlpha, zero)) == 0))
+                continue;
+
+            for (std::size_t j = i; j < i + 4; ++j)
+                blendPixel(src + j * 4, dst + j * 4);
+        }
+#elif defined(SFML_IMAGE_USE_NEON)
+        const uint32x4_t masks = vdupq_n_u32(packPixel(0, 0, 0, 255));
+        const uint32x4_t zero  = vdupq_n_u32(0);
+        const auto allSet = [](uint32x4_t comparison)
+        {
+            uint64x2_t halves = vreinterpretq_u64_u32(comparison);
+            return (vgetq_lane_u64(halves, 0) & vgetq_lane_u64(halves, 1)) == ~sf::Uint64(0);
+        };
+        const auto noneSet = [](uint32x4_t comparison)
+        {
+            uint64x2_t halves = vreinterpretq_u64_u32(comparison);
+            return (vgetq_lane_u64(halves, 0) | vgetq_lane_u64(halves, 1)) == 0;
+        };
+        for (; i + 4 <= count; i += 4)
+        {
+            uint32x4_t srcBlock = vreinterpretq_u32_u8(vld1q_u8(src + i * 4));
+            uint32x4_t srcAlpha = vandq_u32(srcBlock, masks);
+
+            if (allSet(vceqq_u32(srcAlpha, masks)))
+            {
+                vst1q_u8(dst + i * 4, vreinterpretq_u8_u32(srcBlock));
+                continue;
+            }
+
+            uint32x4_t dstAlpha = vandq_u32(vreinterpretq_u32_u8(vld1q_u8(dst + i * 4)), masks);
+            if (allSet(vceqq_u32(srcAlpha, zero)) && noneSet(vceqq_u32(dstAlpha, zero)))
+                continue;
+
+            for (std::size_t j = i; j < i + 4; ++j)
+                blendPixel(src + j * 4, dst + j * 4);
+        }
+#endif
+
+        for (; i < count; ++i)
+            blendPixel(src + i * 4, dst + i * 4);
+    }
+
+    // Reverse the order of the pixels of a row
+    void flipRow(sf::Uint8* pixels, std::size_t count)
+    {
+        std::size_t left  = 0;
+        std::size_t right = count;
+
+        // Swap blocks of 4 pixels from both ends, reversing them on the way
+#if defined(SFML_IMAGE_USE_SSE2)
+        for (; right - left >= 8; left += 4, right -= 4)
+        {
+            auto* leftAddress  = reinterpret_cast<__m128i*>(pixels + left * 4);
+            auto* rightAddress = reinterpret_cast<__m128i*>(pixels + (right - 4) * 4);
+            __m128i leftBlock  = _mm_shuffle_epi32(_mm_loadu_si128(leftAddress), _MM_SHUFFLE(0, 1, 2, 3));
+            __m128i rightBlock = _mm_shuffle_epi32(_mm_loadu_si128(rightAddress), _MM_SHUFFLE(0, 1, 2, 3));
+            _mm_storeu_si128(leftAddress, rightBlock);
+            _mm_storeu_si128(rightAddress, leftBlock);
+        }
+#elif defined(SFML_IMAGE_USE_NEON)
+        const auto reverse = [](uint32x4_t block)
+        {
+            block = vrev64q_u32(block);
+            return vcombine_u32(vget_high_u32(block), vget_low_u32(block));
+        };
+        for (; right - left >= 8; left += 4, right -= 4)
+        {
+            uint32x4_t leftBlock  = reverse(vreinterpretq_u32_u8(vld1q_u8(pixels + left * 4)));
+            uint32x4_t rightBlock = reverse(vreinterpretq_u32_u8(vld1q_u8(pixels + (right - 4) * 4)));
+            vst1q_u8(pixels + left * 4, vreinterpretq_u8_u32(rightBlock));
+            vst1q_u8(pixels + (right - 4) * 4, vreinterpretq_u8_u32(leftBlock));
+        }
+#endif
+
+        for (; right - left >= 2; ++left, --right)
+        {
+            sf::Uint32 leftPixel = loadPixel(pixels + left * 4);
+            storePixel(pixels + left * 4, loadPixel(pixels + (right - 1) * 4));
+            storePixel(pixels + (right - 1) * 4, leftPixel);
+        }
+    }
+
+    // Reverse the order of the pixels of a row, for any pixel size
+    void flipRow(sf::Uint8* pixels, std::size_t count, std::size_t pixelSize)
+    {
+        if (pixelSize == 4)
+        {
+            flipRow(pixels, count);
+            return;
+        }
+
+        sf::Uint8 buffer[16];
+        for (std::size_t left = 0, right = count; right - left >= 2; ++left, --right)
+        {
+            std::memcpy(buffer, pixels + left * pixelSize, pixelSize);
+            std::memcpy(pixels + left * pixelSize, pixels + (right - 1) * pixelSize, pixelSize);
+            std::memcpy(pixels + (right - 1) * pixelSize, buffer, pixelSize);
+        }
+    }
+
+    // Blend a row of source pixels over a row of destination pixels of any format, through floats
+    void blendRow(sf::PixelFormat sourceFormat, const sf::Uint8* src, sf::PixelFormat destinationFormat, sf::Uint8* dst, std::size_t count)
+    {
+        constexpr std::size_t chunkSize = 256;
+        float sourceValues[chunkSize * 4];
+        float destinationValues[chunkSize * 4];
+
+        std::size_t sourceSize      = sf::getPixelSize(sourceFormat);
+        std::size_t destinationSize = sf::getPixelSize(destinationFormat);
+        for (std::size_t i = 0; i < count; i += chunkSize)
+        {
+            std::size_t chunk = std::min(chunkSize, count - i);
+            sf::priv::decodePixels(sourceFormat, src + i * sourceSize, sourceValues, chunk);
+            sf::priv::decodePixels(destinationFormat, dst + i * destinationSize, destinationValues, chunk);
+
+            for (std::size_t j = 0; j < chunk; ++j)
+            {
+                const float* source      = sourceValues + j * 4;
+                float*       destination = destinationValues + j * 4;
+                float        srcAlpha    = std::clamp(source[3], 0.f, 1.f);
+                float        outAlpha    = srcAlpha + std::clamp(destination[3], 0.f, 1.f) * (1.f - srcAlpha);
+
+                for (std::size_t k = 0; k < 3; ++k)
+                    destination[k] = (outAlpha > 0.f) ? (source[k] * srcAlpha + destination[k] * (outAlpha - srcAlpha)) / outAlpha : source[k];
+                destination[3] = outAlpha;
+            }
+
+            sf::priv::encodePixels(destinationFormat, destinationValues, dst + i * destinationSize, chunk);
+        }
+    }
+
+    // Load a batch of images in parallel; the items are distributed one by one, since their decoding times vary a lot
+    template <typename F>
+    std::vector<sf::Image::LoadResult> loadBatch(std::size_t count, F loadItem)
+    {
+        std::vector<sf::Image::LoadResult> results(count);
+        std::atomic<std::size_t> next(0);
+
+        sf::priv::ThreadPool& pool = sf::priv::ThreadPool::getGlobal();
+        pool.parallelFor(std::min(count, pool.getThreadCount() + 1), 1, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t worker = begin; worker < end; ++worker)
+            {
+                for (std::size_t i = next++; i < count; i = next++)
+                    results[i].success = loadItem(i, results[i]);
+            }
+        });
+
+        return results;
+    }
+
+    // Format used to save the images of a given format: only 8-bit grayscale, RGB and RGBA can be encoded as is
+    sf::PixelFormat getSavedFormat(sf::PixelFormat format)
+    {
+        switch (format)
+        {
+            case sf::R8:
+            case sf::RGB8:
+            case sf::RGBA8: return format;
+            case sf::R16:   return sf::R8;
+            default:        return sf::RGBA8;
+        }
+    }
+
+    // Conversions between sRGB encoded components and linear intensities
+    constexpr std::size_t linearToSrgbTableSize = 16384;
+
+    const std::array<float, 256>& getSrgbToLinearTable()
+    {
+        static const std::array<float, 256> table = []
+        {
+            std::array<float, 256> values{};
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                float c = static_cast<float>(i) / 255.f;
+                values[i] = (c <= 0.04045f) ? c / 12.92f : std::pow((c + 0.055f) / 1.055f, 2.4f);
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    const std::array<sf::Uint8, linearToSrgbTableSize>& getLinearToSrgbTable()
+    {
+        static const std::array<sf::Uint8, linearToSrgbTableSize> table = []
+        {
+            std::array<sf::Uint8, linearToSrgbTableSize> values{};
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                float c = static_cast<float>(i) / static_cast<float>(linearToSrgbTableSize - 1);
+                float encoded = (c <= 0.0031308f) ? c * 12.92f : 1.055f * std::pow(c, 1.f / 2.4f) - 0.055f;
+                values[i] = static_cast<sf::Uint8>(std::lround(encoded * 255.f));
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    // Value of the resampling filters at a distance x from their center (in source pixels)
+    float getFilterRadius(sf::Image::ResampleFilter filter)
+    {
+        switch (filter)
+        {
+            case sf::Image::Box:      return 0.5f;
+            case sf::Image::Bilinear: return 1.f;
+            case sf::Image::Lanczos3: return 3.f;
+            default:                  return 0.f;
+        }
+    }
+
+    float evaluateFilter(sf::Image::ResampleFilter filter, float x)
+    {
+        constexpr float pi = 3.14159265358979323846f;
+
+        switch (filter)
+        {
+            case sf::Image::Box:
+                return ((x >= -0.5f) && (x < 0.5f)) ? 1.f : 0.f;
+
+            case sf::Image::Bilinear:
+                return std::max(1.f - std::abs(x), 0.f);
+
+            case sf::Image::Lanczos3:
+            {
+                if (std::abs(x) >= 3.f)
+                    return 0.f;
+                if (std::abs(x) < 1e-6f)
+                    return 1.f;
+                float px = pi * x;
+                return 3.f * std::sin(px) * std::sin(px / 3.f) / (px * px);
+            }
+
+            default:
+                return 0.f;
+        }
+    }
+
+    // Source pixels and weights contributing to each pixel of a resampled row or column
+    struct Contributions
+    {
+        std::vector<std::size_t> first;   // Index of the first contributing source pixel, for each destination pixel
+        std::vector<std::size_t> count;   // Number of contributing source pixels, for each destination pixel
+        std::vector<float>       weights; // Weights of the contributing pixels, "taps" values per destination pixel
+        std::size_t              taps;    // Maximum number of contributing pixels
+    };
+
+    Contributions computeContributions(unsigned int sourceSize, unsigned int destinationSize, sf::Image::ResampleFilter filter)
+    {
+        // When downsampling, widen the filter so that every source pixel contributes
+        float scale       = static_cast<float>(destinationSize) / static_cast<float>(sourceSize);
+        float filterScale = std::max(1.f / scale, 1.f);
+        float support     = getFilterRadius(filter) * filterScale;
+
+        Contributions contributions;
+        contributions.taps = static_cast<std::size_t>(std::ceil(support * 2.f)) + 1;
+        contributions.first.resize(destinationSize);
+        contributions.count.resize(destinationSize);
+        contributions.weights.resize(destinationSize * contributions.taps);
+
+        for (std::size_t i = 0; i < destinationSize; ++i)
+        {
+            // Center of the destination pixel, in source coordinates; source pixels outside of the image are ignored
+            float center = (static_cast<float>(i) + 0.5f) / scale;
+            auto  begin  = static_cast<std::size_t>(std::max(std::floor(center - support), 0.f));
+            auto  end    = std::min(static_cast<std::size_t>(std::max(std::ceil(center + support), 0.f)), std::size_t(sourceSize));
+            end          = std::min(end, begin + contributions.taps);
+
+            float* weights = &contributions.weights[i * contributions.taps];
+            float  total   = 0.f;
+            for (std::size_t j = begin; j < end; ++j)
+            {
+                weights[j - begin] = evaluateFilter(filter, (static_cast<float>(j) + 0.5f - center) / filterScale);
+                total += weights[j - begin];
+            }
+
+            if (total != 0.f)
+            {
+                for (std::size_t j = begin; j < end; ++j)
+                    weights[j - begin] /= total;
+            }
+            else
+            {
+                // No contribution (can only happen at the edges with the box filter): use the closest pixel
+                begin = std::min(static_cast<std::size_t>(center), std::size_t(sourceSize) - 1);
+                end = begin + 1;
+                weights[0] = 1.f;
+            }
+
+            contributions.first[i] = begin;
+            contributions.count[i] = end - begin;
+        }
+
+        return contributions;
+    }
+
+    // Add weighted floats to an accumulator
+    void multiplyAdd(float* accumulator, const float* values, std::size_t count, float weight)
+    {
+        std::size_t i = 0;
+
+#if defined(SFML_IMAGE_USE_SSE2)
+        const __m128 weights = _mm_set1_ps(weight);
+        for (; i + 4 <= count; i += 4)
+            _mm_storeu_ps(accumulator + i, _mm_add_ps(_mm_loadu_ps(accumulator + i), _mm_mul_ps(_mm_loadu_ps(values + i), weights)));
+#elif defined(SFML_IMAGE_USE_NEON)
+        const float32x4_t weights = vdupq_n_f32(weight);
+        for (; i + 4 <= count; i += 4)
+            vst1q_f32(accumulator + i, vmlaq_f32(vld1q_f32(accumulator + i), vld1q_f32(values + i), weights));
+#endif
+
+        for (; i < count; ++i)
+            accumulator[i] += values[i] * weight;
+    }
+
+    // Convert a row of pixels to linear (if needed) premultiplied floats
+    void decodeRow(const sf::Uint8* pixels, float* values, std::size_t count, bool sRgb)
+    {
+        const std::array<float, 256>& toLinear = getSrgbToLinearTable();
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float alpha = pixels[i * 4 + 3] / 255.f;
+            for (std::size_t k = 0; k < 3; ++k)
+                values[i * 4 + k] = (sRgb ? toLinear[pixels[i * 4 + k]] : pixels[i * 4 + k] / 255.f) * alpha;
+            values[i * 4 + 3] = alpha;
+        }
+    }
+
+    // Convert a row of pixels of any format to linear (if needed) premultiplied floats
+    void decodeRow(sf::PixelFormat format, const sf::Uint8* pixels, float* values, std::size_t count, bool sRgb)
+    {
+        if (format == sf::RGBA8)
+        {
+            decodeRow(pixels, values, count, sRgb);
+            return;
+        }
+
+        // Only 8-bit components can be sRGB encoded
+        const std::array<float, 256>& toLinear = getSrgbToLinearTable();
+        const bool linearize = sRgb && sf::priv::isEightBit(format);
+
+        sf::priv::decodePixels(format, pixels, values, count);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float alpha = values[i * 4 + 3];
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                float value = values[i * 4 + k];
+                if (linearize)
+                    value = toLinear[static_cast<std::size_t>(value * 255.f + 0.5f)];
+                values[i * 4 + k] = value * alpha;
+            }
+        }
+    }
+
+    // Convert a row of premultiplied floats back to pixels
+    void encodeRow(const float* values, sf::Uint8* pixels, std::size_t count, bool sRgb)
+    {
+        const std::array<sf::Uint8, linearToSrgbTableSize>& toSrgb = getLinearToSrgbTable();
+
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float alpha = std::clamp(values[i * 4 + 3], 0.f, 1.f);
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                float value = (alpha > 0.f) ? std::clamp(values[i * 4 + k] / alpha, 0.f, 1.f) : 0.f;
+                if (sRgb)
+                    pixels[i * 4 + k] = toSrgb[static_cast<std::size_t>(value * static_cast<float>(linearToSrgbTableSize - 1) + 0.5f)];
+                else
+                    pixels[i * 4 + k] = static_cast<sf::Uint8>(value * 255.f + 0.5f);
+            }
+            pixels[i * 4 + 3] = static_cast<sf::Uint8>(alpha * 255.f + 0.5f);
+        }
+    }
+
+    // Convert a row of premultiplied floats back to pixels of any format (the values are overwritten)
+    void encodeRow(sf::PixelFormat format, float* values, sf::Uint8* pixels, std::size_t count, bool sRgb)
+    {
+        if (format == sf::RGBA8)
+        {
+            encodeRow(values, pixels, count, sRgb);
+            return;
+        }
+
+        const std::array<sf::Uint8, linearToSrgbTableSize>& toSrgb = getLinearToSrgbTable();
+        const bool delinearize = sRgb && sf::priv::isEightBit(format);
+
+        // Floating point formats keep the values out of [0, 1], the others are clamped when encoded
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            float alpha = values[i * 4 + 3];
+            for (std::size_t k = 0; k < 3; ++k)
+            {
+                float value = (alpha > 0.f) ? values[i * 4 + k] / alpha : 0.f;
+                if (delinearize)
+                    value = toSrgb[static_cast<std::size_t>(std::clamp(value, 0.f, 1.f) * static_cast<float>(linearToSrgbTableSize - 1) + 0.5f)] / 255.f;
+                values[i * 4 + k] = value;
+            }
+        }
+
+        sf::priv::encodePixels(format, values, pixels, count);
+    }
+}
+
+
 namespace sf
 {
 ////////////////////////////////////////////////////////////
 Image::Image() :
-m_size(0, 0)
+m_size  (0, 0),
+m_format(RGBA8)
 {
 
 }
@@ -104,6 +642,8 @@ void Image::create(unsigned int width, unsigned int height, const Color& color)
         m_size.x = 0;
         m_size.y = 0;
     }
+
+    m_format = RGBA8;
 }
 
 
@@ -131,49 +671,159 @@ void Image::create(unsigned int width, unsigned int height, const Uint8* pixels)
         m_size.x = 0;
         m_size.y = 0;
     }
+
+    m_format = RGBA8;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::create(const Vector2u& size, PixelFormat format, const void* pixels)
+{
+    if (size.x && size.y)
+    {
+        // Create a new pixel buffer first for exception safety's sake
+        std::vector<Uint8> newPixels(static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * getPixelSize(format));
+        if (pixels)
+            std::memcpy(newPixels.data(), pixels, newPixels.size());
+
+        // Commit the new pixel buffer
+        m_pixels.swap(newPixels);
+
+        // Assign the new size
+        m_size = size;
+    }
+    else
+    {
+        // Dump the pixel buffer
+        std::vector<Uint8>().swap(m_pixels);
+
+        // Assign the new size
+        m_size.x = 0;
+        m_size.y = 0;
+    }
+
+    m_format = format;
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Image::loadFromFile(const std::filesystem::path& filename)
+bool Image::loadFromFile(const std::filesystem::path& filename, PixelFormat format)
 {
     #ifndef SFML_SYSTEM_ANDROID
 
-        return priv::ImageLoader::getInstance().loadImageFromFile(filename, m_pixels, m_size);
+        // Decode to a new pixel buffer first, so that the image is left unchanged on failure
+        std::vector<Uint8> pixels;
+        Vector2u size;
+        if (!priv::ImageLoader::getInstance().loadImageFromFile(filename, format, pixels, size))
+            return false;
+
+        m_pixels.swap(pixels);
+        m_size   = size;
+        m_format = format;
+        return true;
 
     #else
 
         priv::ResourceStream stream(filename);
-        return loadFromStream(stream);
+        return loadFromStream(stream, format);
 
     #endif
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Image::loadFromMemory(const void* data, std::size_t size)
+bool Image::loadFromMemory(const void* data, std::size_t size, PixelFormat format)
+{
+    // Decode to a new pixel buffer first, so that the image is left unchanged on failure
+    std::vector<Uint8> pixels;
+    Vector2u imageSize;
+    if (!priv::ImageLoader::getInstance().loadImageFromMemory(data, size, format, pixels, imageSize))
+        return false;
+
+    m_pixels.swap(pixels);
+    m_size   = imageSize;
+    m_format = format;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool Image::loadFromStream(InputStream& stream, PixelFormat format)
 {
-    return priv::ImageLoader::getInstance().loadImageFromMemory(data, size, m_pixels, m_size);
+    // Decode to a new pixel buffer first, so that the image is left unchanged on failure
+    std::vector<Uint8> pixels;
+    Vector2u size;
+    if (!priv::ImageLoader::getInstance().loadImageFromStream(stream, format, pixels, size))
+        return false;
+
+    m_pixels.swap(pixels);
+    m_size   = size;
+    m_format = format;
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<Image::LoadResult> Image::loadFromFiles(const std::vector<std::filesystem::path>& filenames, PixelFormat format)
+{
+    return loadBatch(filenames.size(), [&](std::size_t index, LoadResult& result)
+    {
+        Image& image = result.image;
+
+    #ifndef SFML_SYSTEM_ANDROID
+
+        if (!priv::ImageLoader::getInstance().loadImageFromFile(filenames[index], format, image.m_pixels, image.m_size, &result.error))
+            return false;
+
+    #else
+
+        priv::ResourceStream stream(filenames[index]);
+        if (!priv::ImageLoader::getInstance().loadImageFromStream(stream, format, image.m_pixels, image.m_size, &result.error))
+            return false;
+
+    #endif
+
+        image.m_format = format;
+        return true;
+    });
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Image::loadFromStream(InputStream& stream)
+std::vector<Image::LoadResult> Image::loadFromStreams(const std::vector<InputStream*>& streams, PixelFormat format)
 {
-    return priv::ImageLoader::getInstance().loadImageFromStream(stream, m_pixels, m_size);
+    return loadBatch(streams.size(), [&](std::size_t index, LoadResult& result)
+    {
+        Image& image = result.image;
+        if (!priv::ImageLoader::getInstance().loadImageFromStream(*streams[index], format, image.m_pixels, image.m_size, &result.error))
+            return false;
+
+        image.m_format = format;
+        return true;
+    });
 }
 
 
 ////////////////////////////////////////////////////////////
-bool Image::saveToFile(const std::filesystem::path& filename) const
+bool Image::saveToFile(const std::filesystem::path& filename, const SaveSettings& settings) const
 {
-    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size);
+    // Formats that the encoders don't support are converted first
+    PixelFormat format = getSavedFormat(m_format);
+    if (format != m_format)
+        return convert(format).saveToFile(filename, settings);
+
+    return priv::ImageLoader::getInstance().saveImageToFile(filename, m_pixels, m_size, static_cast<unsigned int>(getChannelCount(m_format)), settings);
 }
 
 ////////////////////////////////////////////////////////////
-bool Image::saveToMemory(std::vector<sf::Uint8>& output, const std::string& format) const
+bool Image::saveToMemory(std::vector<sf::Uint8>& output, const std::string& format, const SaveSettings& settings) const
 {
-    return priv::ImageLoader::getInstance().saveImageToMemory(format, output, m_pixels, m_size);
+    // Formats that the encoders don't support are converted first
+    PixelFormat pixelFormat = getSavedFormat(m_format);
+    if (pixelFormat != m_format)
+        return convert(pixelFormat).saveToMemory(output, format, settings);
+
+    return priv::ImageLoader::getInstance().saveImageToMemory(format, output, m_pixels, m_size, static_cast<unsigned int>(getChannelCount(m_format)), settings);
 }
 
 
@@ -184,21 +834,80 @@ Vector2u Image::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+PixelFormat Image::getPixelFormat() const
+{
+    return m_format;
+}
+
+
+////////////////////////////////////////////////////////////
+Image Image::convert(PixelFormat format) const
+{
+    if (format == m_format)
+        return *this;
+
+    Image result;
+    result.m_format = format;
+
+    if (m_pixels.empty())
+        return result;
+
+    result.m_size = m_size;
+    result.m_pixels.resize(static_cast<std::size_t>(m_size.x) * static_cast<std::size_t>(m_size.y) * getPixelSize(format));
+
+    // Convert the pixels by bands of rows in parallel
+    std::size_t sourcePitch      = m_size.x * getPixelSize(m_format);
+    std::size_t destinationPitch = m_size.x * getPixelSize(format);
+    forEachRowBand(m_size.x, m_size.y, [&](std::size_t begin, std::size_t end)
+    {
+        priv::convertPixels(m_format, m_pixels.data() + begin * sourcePitch, format, result.m_pixels.data() + begin * destinationPitch, (end - begin) * m_size.x);
+    });
+
+    return result;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Image::createMaskFromColor(const Color& color, Uint8 alpha)
 {
-    // Make sure that the image is not empty
-    if (!m_pixels.empty())
+    // Make sure that the image is not empty and has an alpha channel
+    if (m_pixels.empty() || (getChannelCount(m_format) < 4))
+        return;
+
+    if (m_format == RGBA8)
     {
         // Replace the alpha of the pixels that match the transparent color
-        Uint8* ptr = m_pixels.data();
-        Uint8* end = ptr + m_pixels.size();
-        while (ptr < end)
+        Uint32 key = packPixel(color.r, color.g, color.b, color.a);
+        forEachRowBand(m_size.x, m_size.y, [&](std::size_t begin, std::size_t end)
         {
-            if ((ptr[0] == color.r) && (ptr[1] == color.g) && (ptr[2] == color.b) && (ptr[3] == color.a))
-                ptr[3] = alpha;
-            ptr += 4;
-        }
+            maskRow(m_pixels.data() + begin * m_size.x * 4, (end - begin) * m_size.x, key, alpha);
+        });
+    }
+    else
+    {
+        // Floating point pixels match when they are equal to the color once converted to 8 bits
+        Uint32 key = packPixel(color.r, color.g, color.b, color.a);
+        std::size_t pixelSize = getPixelSize(m_format);
+        forEachRowBand(m_size.x, m_size.y, [&](std::size_t begin, std::size_t end)
+        {
+            std::vector<float> values(static_cast<std::size_t>(m_size.x) * 4);
+            std::vector<Uint8> converted(static_cast<std::size_t>(m_size.x) * 4);
+            for (std::size_t y = begin; y < end; ++y)
+            {
+                Uint8* row = m_pixels.data() + y * m_size.x * pixelSize;
+                priv::decodePixels(m_format, row, values.data(), m_size.x);
+                priv::encodePixels(RGBA8, values.data(), converted.data(), m_size.x);
+
+                for (std::size_t x = 0; x < m_size.x; ++x)
+                {
+                    if (loadPixel(converted.data() + x * 4) == key)
+                        values[x * 4 + 3] = static_cast<float>(alpha) / 255.f;
+                }
+
+                priv::encodePixels(m_format, values.data(), row, m_size.x);
+            }
+        });
     }
 }
 
@@ -238,60 +947,53 @@ void Image::copy(const Image& source, unsigned int destX, unsigned int destY, co
         return;
 
     // Precompute as much as possible
-    std::size_t  pitch     = static_cast<std::size_t>(width) * 4;
-    unsigned int rows      = height;
-    int          srcStride = static_cast<int>(source.m_size.x) * 4;
-    int          dstStride = static_cast<int>(m_size.x) * 4;
-    const Uint8* srcPixels = source.m_pixels.data() + (static_cast<unsigned int>(srcRect.left) + static_cast<unsigned int>(srcRect.top) * source.m_size.x) * 4;
-    Uint8*       dstPixels = m_pixels.data() + (destX + destY * m_size.x) * 4;
-
-    // Copy the pixels
-    if (applyAlpha)
+    std::size_t  srcSize    = getPixelSize(source.m_format);
+    std::size_t  dstSize    = getPixelSize(m_format);
+    std::size_t  pitch      = static_cast<std::size_t>(width) * dstSize;
+    std::size_t  srcStride  = static_cast<std::size_t>(source.m_size.x) * srcSize;
+    std::size_t  dstStride  = static_cast<std::size_t>(m_size.x) * dstSize;
+    const Uint8* srcPixels  = source.m_pixels.data() + (static_cast<std::size_t>(srcRect.left) + static_cast<std::size_t>(srcRect.top) * source.m_size.x) * srcSize;
+    Uint8*       dstPixels  = m_pixels.data() + (destX + static_cast<std::size_t>(destY) * m_size.x) * dstSize;
+    const bool   sameFormat = (source.m_format == m_format);
+
+    // Copy the pixels, by bands of rows in parallel for large areas
+    forEachRowBand(width, height, [&](std::size_t begin, std::size_t end)
     {
-        // Interpolation using alpha values, pixel by pixel (slower)
-        for (unsigned int i = 0; i < rows; ++i)
+        for (std::size_t i = begin; i < end; ++i)
         {
-            for (unsigned int j = 0; j < width; ++j)
+            if (applyAlpha)
             {
-                // Get a direct pointer to the components of the current pixel
-                const Uint8* src = srcPixels + j * 4;
-                Uint8*       dst = dstPixels + j * 4;
-
-                // Interpolate RGBA components using the alpha values of the destination and source pixels
-                Uint8 src_alpha = src[3];
-                Uint8 dst_alpha = dst[3];
-                Uint8 out_alpha = static_cast<Uint8>(src_alpha + dst_alpha - src_alpha * dst_alpha / 255);
-
-                dst[3] = out_alpha;
-
-                if (out_alpha)
-                    for (int k = 0; k < 3; k++)
-                        dst[k] = static_cast<Uint8>((src[k] * src_alpha + dst[k] * (out_alpha - src_alpha)) / out_alpha);
+                // Interpolation using alpha values, where needed
+                if (sameFormat && (m_format == RGBA8))
+                    blendRow(srcPixels + i * srcStride, dstPixels + i * dstStride, width);
                 else
-                    for (int k = 0; k < 3; k++)
-                        dst[k] = src[k];
+                    blendRow(source.m_format, srcPixels + i * srcStride, m_format, dstPixels + i * dstStride, width);
+            }
+            else if (sameFormat)
+            {
+                // Optimized copy ignoring alpha values, row by row (faster)
+                std::memcpy(dstPixels + i * dstStride, srcPixels + i * srcStride, pitch);
+            }
+            else
+            {
+                // Convert the pixels on the fly
+                priv::convertPixels(source.m_format, srcPixels + i * srcStride, m_format, dstPixels + i * dstStride, width);
             }
-
-            srcPixels += srcStride;
-            dstPixels += dstStride;
-        }
-    }
-    else
-    {
-        // Optimized copy ignoring alpha values, row by row (faster)
-        for (unsigned int i = 0; i < rows; ++i)
-        {
-            std::memcpy(dstPixels, srcPixels, pitch);
-            srcPixels += srcStride;
-            dstPixels += dstStride;
         }
-    }
+    });
 }
 
 
 ////////////////////////////////////////////////////////////
 void Image::setPixel(unsigned int x, unsigned int y, const Color& color)
 {
+    if (m_format != RGBA8)
+    {
+        const Uint8 components[4] = {color.r, color.g, color.b, color.a};
+        priv::convertPixels(RGBA8, components, m_format, &m_pixels[(x + static_cast<std::size_t>(y) * m_size.x) * getPixelSize(m_format)], 1);
+        return;
+    }
+
     Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
     *pixel++ = color.r;
     *pixel++ = color.g;
@@ -303,6 +1005,13 @@ void Image::setPixel(unsigned int x, unsigned int y, const Color& color)
 ////////////////////////////////////////////////////////////
 Color Image::getPixel(unsigned int x, unsigned int y) const
 {
+    if (m_format != RGBA8)
+    {
+        Uint8 components[4];
+        priv::convertPixels(m_format, &m_pixels[(x + static_cast<std::size_t>(y) * m_size.x) * getPixelSize(m_format)], RGBA8, components, 1);
+        return Color(components[0], components[1], components[2], components[3]);
+    }
+
     const Uint8* pixel = &m_pixels[(x + y * m_size.x) * 4];
     return Color(pixel[0], pixel[1], pixel[2], pixel[3]);
 }
@@ -328,22 +1037,122 @@ void Image::flipHorizontally()
 {
     if (!m_pixels.empty())
     {
-        std::size_t rowSize = m_size.x * 4;
+        std::size_t pixelSize = getPixelSize(m_format);
+        std::size_t rowSize   = m_size.x * pixelSize;
 
-        for (std::size_t y = 0; y < m_size.y; ++y)
+        forEachRowBand(m_size.x, m_size.y, [&](std::size_t begin, std::size_t end)
         {
-            auto left = m_pixels.begin() + static_cast<std::vector<Uint8>::iterator::difference_type>(y * rowSize);
-            auto right = m_pixels.begin() + static_cast<std::vector<Uint8>::iterator::difference_type>((y + 1) * rowSize - 4);
+            for (std::size_t y = begin; y < end; ++y)
+                flipRow(m_pixels.data() + y * rowSize, m_size.x, pixelSize);
+        });
+    }
+}
+
 
-            for (std::size_t x = 0; x < m_size.x / 2; ++x)
+////////////////////////////////////////////////////////////
+Image Image::resample(const Vector2u& size, ResampleFilter filter, bool sRgb) const
+{
+    Image result;
+
+    if (m_pixels.empty() || (size.x == 0) || (size.y == 0))
+        return result;
+
+    // All the filters are interpolating: resampling to the same size doesn't change anything
+    if (size == m_size)
+        return *this;
+
+    std::size_t pixelSize = getPixelSize(m_format);
+    result.m_size   = size;
+    result.m_format = m_format;
+    result.m_pixels.resize(static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * pixelSize);
+
+    if (filter == Nearest)
+    {
+        // Pick the source pixel under the center of each destination pixel
+        std::vector<std::size_t> columns(size.x);
+        for (std::size_t x = 0; x < size.x; ++x)
+            columns[x] = std::min(static_cast<std::size_t>((static_cast<double>(x) + 0.5) * m_size.x / size.x), std::size_t(m_size.x) - 1);
+
+        forEachRowBand(size.x, size.y, [&](std::size_t begin, std::size_t end)
+        {
+            for (std::size_t y = begin; y < end; ++y)
             {
-                std::swap_ranges(left, left + 4, right);
+                std::size_t sourceY = std::min(static_cast<std::size_t>((static_cast<double>(y) + 0.5) * m_size.y / size.y), std::size_t(m_size.y) - 1);
+                const Uint8* source = m_pixels.data() + sourceY * m_size.x * pixelSize;
+                Uint8* destination = result.m_pixels.data() + y * size.x * pixelSize;
+                for (std::size_t x = 0; x < size.x; ++x)
+                    std::memcpy(destination + x * pixelSize, source + columns[x] * pixelSize, pixelSize);
+            }
+        });
 
-                left += 4;
-                right -= 4;
+        return result;
+    }
+
+    // The filter is separable: resample the rows, then the columns
+    const Contributions horizontal = computeContributions(m_size.x, size.x, filter);
+    const Contributions vertical   = computeContributions(m_size.y, size.y, filter);
+
+    // Horizontal pass, into an intermediate image of premultiplied floats
+    std::vector<float> intermediate(static_cast<std::size_t>(size.x) * m_size.y * 4);
+    forEachRowBand(m_size.x, m_size.y, [&](std::size_t begin, std::size_t end)
+    {
+        std::vector<float> row(static_cast<std::size_t>(m_size.x) * 4);
+        for (std::size_t y = begin; y < end; ++y)
+        {
+            decodeRow(m_format, m_pixels.data() + y * m_size.x * pixelSize, row.data(), m_size.x, sRgb);
+
+            float* destination = intermediate.data() + y * size.x * 4;
+            for (std::size_t x = 0; x < size.x; ++x)
+            {
+                const float* weights = &horizontal.weights[x * horizontal.taps];
+                for (std::size_t k = 0; k < horizontal.count[x]; ++k)
+                    multiplyAdd(destination + x * 4, row.data() + (horizontal.first[x] + k) * 4, 4, weights[k]);
             }
         }
+    });
+
+    // Vertical pass, accumulating whole rows for better memory access
+    forEachRowBand(size.x, size.y, [&](std::size_t begin, std::size_t end)
+    {
+        std::vector<float> row(static_cast<std::size_t>(size.x) * 4);
+        for (std::size_t y = begin; y < end; ++y)
+        {
+            std::fill(row.begin(), row.end(), 0.f);
+
+            const float* weights = &vertical.weights[y * vertical.taps];
+            for (std::size_t k = 0; k < vertical.count[y]; ++k)
+                multiplyAdd(row.data(), intermediate.data() + (vertical.first[y] + k) * size.x * 4, row.size(), weights[k]);
+
+            encodeRow(m_format, row.data(), result.m_pixels.data() + y * size.x * pixelSize, size.x, sRgb);
+        }
+    });
+
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+void Image::resize(const Vector2u& size, ResampleFilter filter, bool sRgb)
+{
+    *this = resample(size, filter, sRgb);
+}
+
+
+////////////////////////////////////////////////////////////
+std::vector<Image> Image::createMipmap(ResampleFilter filter, bool sRgb) const
+{
+    std::vector<Image> levels;
+
+    // Compute each level from the previous one, halving the size until 1x1
+    const Image* previous = this;
+    while (!previous->m_pixels.empty() && ((previous->m_size.x > 1) || (previous->m_size.y > 1)))
+    {
+        Vector2u size(std::max(previous->m_size.x / 2, 1u), std::max(previous->m_size.y / 2, 1u));
+        levels.push_back(previous->resample(size, filter, sRgb));
+        previous = &levels.back();
     }
+
+    return levels;
 }
 
 
@@ -352,18 +1161,18 @@ void Image::flipVertically()
 {
     if (!m_pixels.empty())
     {
-        auto rowSize = static_cast<std::vector<Uint8>::iterator::difference_type>(m_size.x * 4);
+        std::size_t rowSize = m_size.x * getPixelSize(m_format);
 
-        auto top = m_pixels.begin();
-        auto bottom = m_pixels.end() - rowSize;
-
-        for (std::size_t y = 0; y < m_size.y / 2; ++y)
+        // Swap the rows of the top half with the ones of the bottom half, by bands of rows in parallel
+        forEachRowBand(m_size.x * 2, m_size.y / 2, [&](std::size_t begin, std::size_t end)
         {
-            std::swap_ranges(top, top + rowSize, bottom);
-
-            top += rowSize;
-            bottom -= rowSize;
-        }
+            for (std::size_t y = begin; y < end; ++y)
+            {
+                Uint8* top    = m_pixels.data() + y * rowSize;
+                Uint8* bottom = m_pixels.data() + (m_size.y - 1 - y) * rowSize;
+                std::swap_ranges(top, top + rowSize, bottom);
+            }
+        });
     }
 }
 
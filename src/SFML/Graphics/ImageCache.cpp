@@ -0,0 +1,291 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ImageCache.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/MappedFile.hpp>
+#include <SFML/System/Utils.hpp>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <sstream>
+#include <thread>
+
+
+namespace
+{
+    // A nested named namespace is used here to allow unity builds of SFML.
+    namespace ImageCacheImpl
+    {
+        // Entries written by other decoders (which may give different pixels)
+        // or with another layout are ignored; they are never removed though
+        constexpr sf::Uint32 magic   = 0x43494653; // "SFIC"
+        constexpr sf::Uint32 version = (sf::priv::ImageLoader::DecoderVersion << 8) | 1;
+
+        // Header of an entry; the pixels follow, at a 64-byte boundary
+        struct Header
+        {
+            sf::Uint32 magic;      // Identifier of the files of the cache
+            sf::Uint32 version;    // Version of the cache
+            sf::Uint64 sourceHash; // Hash of the contents of the source file
+            sf::Uint64 sourceSize; // Size of the source file, in bytes
+            sf::Uint32 format;     // Format of the pixels
+            sf::Uint32 width;      // Width of the image, in pixels
+            sf::Uint32 height;     // Height of the image, in pixels
+            sf::Uint32 reserved;   // Padding, always 0
+        };
+
+        constexpr std::size_t dataOffset = 64;
+        static_assert(sizeof(Header) <= dataOffset);
+
+        // 64-bit hash of some data (XXH64 algorithm, with a seed of 0)
+        sf::Uint64 hash(const void* data, std::size_t size)
+        {
+            constexpr sf::Uint64 prime1 = 11400714785074694791ULL;
+            constexpr sf::Uint64 prime2 = 14029467366897019727ULL;
+            constexpr sf::Uint64 prime3 = 1609587929392839161ULL;
+            constexpr sf::Uint64 prime4 = 9650029242287828579ULL;
+            constexpr sf::Uint64 prime5 = 2870177450012600261ULL;
+
+            auto rotate = [](sf::Uint64 value, int bits) { return (value << bits) | (value >> (64 - bits)); };
+            auto round  = [&](sf::Uint64 accumulator, sf::Uint64 input) { return rotate(accumulator + input * prime2, 31) * prime1; };
+            auto merge  = [&](sf::Uint64 accumulator, sf::Uint64 value) { return (accumulator ^ round(0, value)) * prime1 + prime4; };
+            auto read64 = [](const sf::Uint8* bytes) { sf::Uint64 value; std::memcpy(&value, bytes, sizeof(value)); return value; };
+            auto read32 = [](const sf::Uint8* bytes) { sf::Uint32 value; std::memcpy(&value, bytes, sizeof(value)); return value; };
+
+            const auto* bytes = static_cast<const sf::Uint8*>(data);
+            const sf::Uint8* const end = bytes + size;
+            sf::Uint64 result;
+
+            if (size >= 32)
+            {
+                // Four independent lanes, 32 bytes at a time
+                sf::Uint64 lane1 = prime1 + prime2;
+                sf::Uint64 lane2 = prime2;
+                sf::Uint64 lane3 = 0;
+                sf::Uint64 lane4 = 0 - prime1;
+
+                for (; bytes + 32 <= end; bytes += 32)
+                {
+                    lane1 = round(lane1, read64(bytes));
+                    lane2 = round(lane2, read64(bytes + 8));
+                    lane3 = round(lane3, read64(bytes + 16));
+                    lane4 = round(lane4, read64(bytes + 24));
+                }
+
+                result = rotate(lane1, 1) + rotate(lane2, 7) + rotate(lane3, 12) + rotate(lane4, 18);
+                result = merge(result, lane1);
+                result = merge(result, lane2);
+                result = merge(result, lane3);
+                result = merge(result, lane4);
+            }
+            else
+            {
+                result = prime5;
+            }
+
+            result += static_cast<sf::Uint64>(size);
+
+            // Remaining bytes
+            for (; bytes + 8 <= end; bytes += 8)
+                result = rotate(result ^ round(0, read64(bytes)), 27) * prime1 + prime4;
+            for (; bytes + 4 <= end; bytes += 4)
+                result = rotate(result ^ (read32(bytes) * prime1), 23) * prime2 + prime3;
+            for (; bytes < end; ++bytes)
+                result = rotate(result ^ (*bytes * prime5), 11) * prime1;
+
+            // Final mix
+            result ^= result >> 33;
+            result *= prime2;
+            result ^= result >> 29;
+            result *= prime3;
+            result ^= result >> 32;
+
+            return result;
+        }
+
+        // Path of the entry of a source file decoded in a given format
+        std::filesystem::path getEntryPath(const std::filesystem::path& directory, sf::Uint64 sourceHash, sf::PixelFormat format)
+        {
+            std::ostringstream name;
+            name << std::hex << std::setfill('0') << std::setw(16) << sourceHash << '-' << std::dec << static_cast<int>(format) << ".sfic";
+            return directory / name.str();
+        }
+
+        // Map an entry, and check that it matches the expected source and format
+        bool openEntry(const std::filesystem::path& path, const Header& expected, sf::priv::MappedFile& file, sf::Vector2u& size)
+        {
+            if (!file.open(path) || (file.getSize() < dataOffset))
+                return false;
+
+            Header header;
+            std::memcpy(&header, file.getData(), sizeof(header));
+            if ((header.magic != expected.magic) || (header.version != expected.version) || (header.sourceHash != expected.sourceHash) ||
+                (header.sourceSize != expected.sourceSize) || (header.format != expected.format))
+                return false;
+
+            const std::size_t pixelsSize = static_cast<std::size_t>(header.width) * header.height * sf::getPixelSize(static_cast<sf::PixelFormat>(header.format));
+            if (file.getSize() != dataOffset + pixelsSize)
+                return false;
+
+            size.x = header.width;
+            size.y = header.height;
+            return true;
+        }
+
+        // Write an entry; it is written to a temporary file first, so that other
+        // threads or processes never see a partially written entry
+        void storeEntry(const std::filesystem::path& path, const Header& header, const sf::Uint8* pixels)
+        {
+            std::error_code error;
+            std::filesystem::create_directories(path.parent_path(), error);
+
+            std::ostringstream suffix;
+            suffix << '.' << std::hash<std::thread::id>()(std::this_thread::get_id()) << '-' << std::chrono::steady_clock::now().time_since_epoch().count() << ".tmp";
+            std::filesystem::path temporaryPath = path;
+            temporaryPath += suffix.str();
+
+            const std::size_t pixelsSize = static_cast<std::size_t>(header.width) * header.height * sf::getPixelSize(static_cast<sf::PixelFormat>(header.format));
+            char headerBytes[dataOffset] = {};
+            std::memcpy(headerBytes, &header, sizeof(header));
+
+            {
+                std::ofstream file(temporaryPath, std::ios_base::binary | std::ios_base::trunc);
+                file.write(headerBytes, dataOffset);
+                file.write(reinterpret_cast<const char*>(pixels), static_cast<std::streamsize>(pixelsSize));
+                if (!file)
+                    error = std::make_error_code(std::errc::io_error);
+            }
+
+            if (!error)
+                std::filesystem::rename(temporaryPath, path, error);
+
+            if (error)
+            {
+                std::filesystem::remove(temporaryPath, error);
+                sf::err() << "Failed to store image in cache\n" << sf::formatDebugPathInfo(path) << std::endl;
+            }
+        }
+
+        // Load the pixels of an image file from the cache, or decode and store them
+        bool load(const std::filesystem::path& directory, const std::filesystem::path& filename, sf::PixelFormat format, const std::function<bool(const sf::Uint8*, const sf::Vector2u&)>& consumer)
+        {
+            // The source file is always read, to identify its contents
+            sf::priv::MappedFile source;
+            if (!source.open(filename))
+            {
+                sf::err() << "Failed to load image\n" << sf::formatDebugPathInfo(filename) << "\nReason: Unable to open file" << std::endl;
+                return false;
+            }
+
+            Header header = {};
+            header.magic      = magic;
+            header.version    = version;
+            header.sourceHash = hash(source.getData(), source.getSize());
+            header.sourceSize = source.getSize();
+            header.format     = static_cast<sf::Uint32>(format);
+
+            const std::filesystem::path path = getEntryPath(directory, header.sourceHash, format);
+
+            // Use the entry if there's a valid one
+            sf::priv::MappedFile entry;
+            sf::Vector2u size;
+            if (openEntry(path, header, entry, size))
+                return consumer(static_cast<const sf::Uint8*>(entry.getData()) + dataOffset, size);
+
+            // Otherwise decode the source, and store a new entry
+            bool result = false;
+            auto store = [&](const sf::Uint8* pixels, const sf::Vector2u& pixelsSize)
+            {
+                header.width  = pixelsSize.x;
+                header.height = pixelsSize.y;
+                storeEntry(path, header, pixels);
+                result = consumer(pixels, pixelsSize);
+            };
+
+            return sf::priv::ImageLoader::getInstance().loadImageFromMemory(source.getData(), source.getSize(), format, store) && result;
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ImageCache::ImageCache(const std::filesystem::path& directory) :
+m_directory(directory)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageCache::loadImage(const std::filesystem::path& filename, Image& image, PixelFormat format) const
+{
+    return ImageCacheImpl::load(m_directory, filename, format, [&](const Uint8* pixels, const Vector2u& size)
+    {
+        image.create(size, format, pixels);
+        return true;
+    });
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageCache::loadTexture(const std::filesystem::path& filename, Texture& texture, const IntRect& area, PixelFormat format) const
+{
+    return ImageCacheImpl::load(m_directory, filename, format, [&](const Uint8* pixels, const Vector2u& size)
+    {
+        return texture.loadFromPixels(pixels, size, format, area);
+    });
+}
+
+
+////////////////////////////////////////////////////////////
+void ImageCache::clear() const
+{
+    std::error_code error;
+    for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(m_directory, error))
+    {
+        if (entry.path().extension() == ".sfic")
+            std::filesystem::remove(entry.path(), error);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const std::filesystem::path& ImageCache::getDirectory() const
+{
+    return m_directory;
+}
+
+} // namespace sf
@@ -26,17 +26,29 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/ImageLoader.hpp>
+#include <SFML/Graphics/PixelConversion.hpp>
+#include <SFML/Graphics/QoiCodec.hpp>
+#include <SFML/System/FileInputStream.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
 #include <SFML/System/Utils.hpp>
 #define STB_IMAGE_IMPLEMENTATION
 #include <stb_image.h>
+#ifndef STBI_THREAD_LOCAL
+    #error "stb_image must keep its failure reason per thread, images are decoded concurrently"
+#endif
 #define STB_IMAGE_WRITE_IMPLEMENTATION
 #include <stb_image_write.h>
+#include <algorithm>
 #include <filesystem>
+#include <fstream>
+#include <functional>
+#include <cstring>
 #include <iomanip>
 #include <iterator>
+#include <mutex>
 #include <ostream>
+#include <shared_mutex>
 
 
 namespace
@@ -67,6 +79,194 @@ namespace
         auto* dest = static_cast<std::vector<sf::Uint8>*>(context);
         std::copy(source, source + size, std::back_inserter(*dest));
     }
+
+    // Entry points of stb_image for one source of encoded data (file, memory or stream)
+    struct Decoder
+    {
+        std::function<stbi_uc*(int&, int&, int)> load8;     // Decode to 8-bit components
+        std::function<stbi_us*(int&, int&, int)> load16;    // Decode to 16-bit components
+        std::function<float*(int&, int&, int)>   loadFloat; // Decode to float components
+        std::function<bool()>                    isHdr;     // Does the source contain floating point pixels?
+        std::function<bool()>                    is16Bit;   // Does the source contain 16-bit pixels?
+    };
+
+    // Decode an image directly in the requested pixel format, and pass the decoded pixels to a callback
+    bool decode(const Decoder& decoder, sf::PixelFormat format, const sf::priv::ImageLoader::PixelCallback& callback)
+    {
+        int width = 0;
+        int height = 0;
+        void* data = nullptr;
+        std::vector<float> values;
+        std::vector<sf::Uint8> converted;
+
+        if ((format == sf::RGBA16F) || (format == sf::RGBA32F))
+        {
+            // Floating point formats: keep the range of HDR files, and normalize
+            // other files without the gamma curve stb_image would apply
+            if (decoder.isHdr())
+            {
+                data = decoder.loadFloat(width, height, 4);
+            }
+            else if (decoder.is16Bit())
+            {
+                stbi_us* components = decoder.load16(width, height, 4);
+                if (components)
+                {
+                    values.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4);
+                    for (std::size_t i = 0; i < values.size(); ++i)
+                        values[i] = components[i] / 65535.f;
+                    data = components;
+                }
+            }
+            else
+            {
+                stbi_uc* components = decoder.load8(width, height, 4);
+                if (components)
+                {
+                    values.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4);
+                    sf::priv::decodePixels(sf::RGBA8, components, values.data(), values.size() / 4);
+                    data = components;
+                }
+            }
+        }
+        else if (format == sf::R16)
+        {
+            // With one channel, stb_image would compute the luminance: keep the red channel
+            // instead, like Image::convert
+            stbi_us* components = decoder.load16(width, height, 3);
+            if (components)
+            {
+                converted.resize(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 2);
+                for (std::size_t i = 0; i < converted.size() / 2; ++i)
+                    std::memcpy(&converted[i * 2], &components[i * 3], 2);
+                data = components;
+            }
+        }
+        else if ((format == sf::R8) || (format == sf::RG8))
+        {
+            // Same for one or two channels (luminance and alpha): keep the first color channels
+            stbi_uc* components = decoder.load8(width, height, 3);
+            if (components)
+            {
+                const std::size_t count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+                converted.resize(count * sf::getPixelSize(format));
+                sf::priv::convertPixels(sf::RGB8, components, format, converted.data(), count);
+                data = components;
+            }
+        }
+        else
+        {
+            // RGB8 and RGBA8: stb_image converts to the requested number of channels
+            data = decoder.load8(width, height, static_cast<int>(sf::getChannelCount(format)));
+        }
+
+        if (!data)
+            return false;
+
+        const std::size_t  count = static_cast<std::size_t>(width) * static_cast<std::size_t>(height);
+        const sf::Vector2u size(static_cast<unsigned int>(width), static_cast<unsigned int>(height));
+
+        if (!values.empty() || (format == sf::RGBA16F))
+        {
+            // Convert the loaded pixels to the requested format
+            std::vector<sf::Uint8> pixels(count * sf::getPixelSize(format));
+            sf::priv::encodePixels(format, values.empty() ? static_cast<const float*>(data) : values.data(), pixels.data(), count);
+            callback(pixels.data(), size);
+        }
+        else if (!converted.empty())
+        {
+            callback(converted.data(), size);
+        }
+        else
+        {
+            // The layout of the loaded pixels already matches the requested format: pass them without any copy
+            callback(static_cast<const sf::Uint8*>(data), size);
+        }
+
+        // Free the loaded pixels
+        stbi_image_free(data);
+
+        return true;
+    }
+
+    // Decode a QOI image in the requested pixel format, and pass the decoded pixels to a callback
+    bool decodeQoiImage(const void* data, std::size_t dataSize, sf::PixelFormat format, const sf::priv::ImageLoader::PixelCallback& callback)
+    {
+        std::vector<sf::Uint8> pixels;
+        sf::Vector2u size;
+        if (!sf::priv::decodeQoi(data, dataSize, pixels, size))
+            return false;
+
+        if (format != sf::RGBA8)
+        {
+            const std::size_t count = static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y);
+            std::vector<sf::Uint8> converted(count * sf::getPixelSize(format));
+            sf::priv::convertPixels(sf::RGBA8, pixels.data(), format, converted.data(), count);
+            pixels.swap(converted);
+        }
+
+        callback(pixels.data(), size);
+        return true;
+    }
+
+    // Read the whole contents of a stream if it contains a QOI image
+    bool readQoi(sf::InputStream& stream, std::vector<sf::Uint8>& data)
+    {
+        char signature[4];
+        if ((stream.read(signature, 4) != 4) || !sf::priv::isQoi(signature, 4))
+            return false;
+
+        const sf::Int64 size = stream.getSize();
+        if ((size < 4) || (stream.seek(0) != 0))
+            return false;
+
+        data.resize(static_cast<std::size_t>(size));
+        return stream.read(data.data(), size) == size;
+    }
+
+    // The settings of the PNG encoder of stb_image_write are global variables: saves that use the
+    // default settings share the lock, those that change them temporarily have it exclusively
+    std::shared_mutex pngSettingsMutex;
+
+    template <typename F>
+    bool writePng(const sf::Image::SaveSettings& settings, F write)
+    {
+        // Map the compression levels to the lengths of the hash chains of the stb_image_write
+        // deflate encoder (8 by default, 5 at least)
+        static constexpr int chainLengths[] = {5, 5, 6, 6, 7, 8, 16, 32, 64};
+        const int chainLength = chainLengths[std::clamp(settings.pngCompressionLevel, 1u, 9u) - 1];
+        const int filter      = static_cast<int>(settings.pngFilter) - 1;
+
+        if ((chainLength == 8) && (filter == -1))
+        {
+            std::shared_lock lock(pngSettingsMutex);
+            return write();
+        }
+
+        std::unique_lock lock(pngSettingsMutex);
+        stbi_write_png_compression_level = chainLength;
+        stbi_write_force_png_filter      = filter;
+        const bool result = write();
+        stbi_write_png_compression_level = 8;
+        stbi_write_force_png_filter      = -1;
+        return result;
+    }
+
+    // Quality of the JPEG encoder of stb_image_write
+    int getJpegQuality(const sf::Image::SaveSettings& settings)
+    {
+        return static_cast<int>(std::clamp(settings.jpegQuality, 1u, 100u));
+    }
+
+    // Callback that copies the decoded pixels to an array
+    sf::priv::ImageLoader::PixelCallback storePixels(sf::PixelFormat format, std::vector<sf::Uint8>& pixels, sf::Vector2u& size)
+    {
+        return [format, &pixels, &size](const sf::Uint8* data, const sf::Vector2u& dataSize)
+        {
+            size = dataSize;
+            pixels.assign(data, data + static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * sf::getPixelSize(format));
+        };
+    }
 }
 
 
@@ -98,39 +298,56 @@ ImageLoader::~ImageLoader()
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromFile(const std::filesystem::path& filename, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromFile(const std::filesystem::path& filename, PixelFormat format, std::vector<Uint8>& pixels, Vector2u& size, std::string* error)
 {
     // Clear the array (just in case)
     pixels.clear();
 
-    // Load the image and get a pointer to the pixels in memory
-    int width = 0;
-    int height = 0;
-    int channels = 0;
-    unsigned char* ptr = stbi_load(filename.string().c_str(), &width, &height, &channels, STBI_rgb_alpha);
+    return loadImageFromFile(filename, format, storePixels(format, pixels, size), error);
+}
+
 
-    if (ptr)
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadImageFromFile(const std::filesystem::path& filename, PixelFormat format, const PixelCallback& callback, std::string* error)
+{
+    // QOI images are decoded by SFML, the other formats by stb_image
+    FileInputStream file;
+    std::vector<Uint8> qoi;
+    if (file.open(filename) && readQoi(file, qoi))
     {
-        // Assign the image properties
-        size.x = static_cast<unsigned int>(width);
-        size.y = static_cast<unsigned int>(height);
+        if (decodeQoiImage(qoi.data(), qoi.size(), format, callback))
+            return true;
 
-        if (width > 0 && height > 0)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(static_cast<std::size_t>(width * height * 4));
-            memcpy(pixels.data(), ptr, pixels.size());
-        }
+        if (error)
+            *error = "Corrupt or unsupported QOI image";
+        else
+            err() << "Failed to load image\n" << formatDebugPathInfo(filename) << "\nReason: Corrupt or unsupported QOI image" << std::endl;
 
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+        return false;
+    }
 
+    // Load the image
+    const std::string path = filename.string();
+    int channels = 0;
+
+    Decoder decoder;
+    decoder.load8     = [&](int& width, int& height, int components) { return stbi_load(path.c_str(), &width, &height, &channels, components); };
+    decoder.load16    = [&](int& width, int& height, int components) { return stbi_load_16(path.c_str(), &width, &height, &channels, components); };
+    decoder.loadFloat = [&](int& width, int& height, int components) { return stbi_loadf(path.c_str(), &width, &height, &channels, components); };
+    decoder.isHdr     = [&]() { return stbi_is_hdr(path.c_str()) != 0; };
+    decoder.is16Bit   = [&]() { return stbi_is_16_bit(path.c_str()) != 0; };
+
+    if (decode(decoder, format, callback))
+    {
         return true;
     }
     else
     {
         // Error, failed to load the image
-        err() << "Failed to load image\n" << formatDebugPathInfo(filename) << "\nReason: " << stbi_failure_reason() << std::endl;
+        if (error)
+            *error = stbi_failure_reason();
+        else
+            err() << "Failed to load image\n" << formatDebugPathInfo(filename) << "\nReason: " << stbi_failure_reason() << std::endl;
 
         return false;
     }
@@ -138,65 +355,108 @@ bool ImageLoader::loadImageFromFile(const std::filesystem::path& filename, std::
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, PixelFormat format, std::vector<Uint8>& pixels, Vector2u& size, std::string* error)
+{
+    // Clear the array (just in case)
+    pixels.clear();
+
+    return loadImageFromMemory(data, dataSize, format, storePixels(format, pixels, size), error);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadImageFromMemory(const void* data, std::size_t dataSize, PixelFormat format, const PixelCallback& callback, std::string* error)
 {
     // Check input parameters
     if (data && dataSize)
     {
-        // Clear the array (just in case)
-        pixels.clear();
+        // QOI images are decoded by SFML, the other formats by stb_image
+        if (isQoi(data, dataSize))
+        {
+            if (decodeQoiImage(data, dataSize, format, callback))
+                return true;
 
-        // Load the image and get a pointer to the pixels in memory
-        int width = 0;
-        int height = 0;
-        int channels = 0;
-        const auto* buffer = static_cast<const unsigned char*>(data);
-        unsigned char* ptr = stbi_load_from_memory(buffer, static_cast<int>(dataSize), &width, &height, &channels, STBI_rgb_alpha);
+            if (error)
+                *error = "Corrupt or unsupported QOI image";
+            else
+                err() << "Failed to load image from memory. Reason: Corrupt or unsupported QOI image" << std::endl;
 
-        if (ptr)
-        {
-            // Assign the image properties
-            size.x = static_cast<unsigned int>(width);
-            size.y = static_cast<unsigned int>(height);
+            return false;
+        }
 
-            if (width > 0 && height > 0)
-            {
-                // Copy the loaded pixels to the pixel buffer
-                pixels.resize(static_cast<std::size_t>(width * height * 4));
-                memcpy(pixels.data(), ptr, pixels.size());
-            }
+        // Load the image
+        const auto* buffer = static_cast<const unsigned char*>(data);
+        const auto  length = static_cast<int>(dataSize);
+        int channels = 0;
 
-            // Free the loaded pixels (they are now in our own pixel buffer)
-            stbi_image_free(ptr);
+        Decoder decoder;
+        decoder.load8     = [&](int& width, int& height, int components) { return stbi_load_from_memory(buffer, length, &width, &height, &channels, components); };
+        decoder.load16    = [&](int& width, int& height, int components) { return stbi_load_16_from_memory(buffer, length, &width, &height, &channels, components); };
+        decoder.loadFloat = [&](int& width, int& height, int components) { return stbi_loadf_from_memory(buffer, length, &width, &height, &channels, components); };
+        decoder.isHdr     = [&]() { return stbi_is_hdr_from_memory(buffer, length) != 0; };
+        decoder.is16Bit   = [&]() { return stbi_is_16_bit_from_memory(buffer, length) != 0; };
 
+        if (decode(decoder, format, callback))
+        {
             return true;
         }
         else
         {
             // Error, failed to load the image
-            err() << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
+            if (error)
+                *error = stbi_failure_reason();
+            else
+                err() << "Failed to load image from memory. Reason: " << stbi_failure_reason() << std::endl;
 
             return false;
         }
     }
     else
     {
-        err() << "Failed to load image from memory, no data provided" << std::endl;
+        if (error)
+            *error = "No data provided";
+        else
+            err() << "Failed to load image from memory, no data provided" << std::endl;
         return false;
     }
 }
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size)
+bool ImageLoader::loadImageFromStream(InputStream& stream, PixelFormat format, std::vector<Uint8>& pixels, Vector2u& size, std::string* error)
 {
     // Clear the array (just in case)
     pixels.clear();
 
+    return loadImageFromStream(stream, format, storePixels(format, pixels, size), error);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ImageLoader::loadImageFromStream(InputStream& stream, PixelFormat format, const PixelCallback& callback, std::string* error)
+{
     // Make sure that the stream's reading position is at the beginning
     if (stream.seek(0) == -1)
     {
-        err() << "Failed to seek image stream" << std::endl;
+        if (error)
+            *error = "Failed to seek image stream";
+        else
+            err() << "Failed to seek image stream" << std::endl;
+        return false;
+    }
+
+    // QOI images are decoded by SFML, the other formats by stb_image
+    std::vector<Uint8> qoi;
+    if (readQoi(stream, qoi))
+    {
+        if (decodeQoiImage(qoi.data(), qoi.size(), format, callback))
+            return true;
+
+        if (error)
+            *error = "Corrupt or unsupported QOI image";
+        else
+            err() << "Failed to load image from stream. Reason: Corrupt or unsupported QOI image" << std::endl;
+
         return false;
     }
 
@@ -206,34 +466,28 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
     callbacks.skip = &skip;
     callbacks.eof  = &eof;
 
-    // Load the image and get a pointer to the pixels in memory
-    int width = 0;
-    int height = 0;
+    // Load the image; probing the
+    // contents consumes the stream, so each call starts from the beginning
     int channels = 0;
-    unsigned char* ptr = stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &channels, STBI_rgb_alpha);
 
-    if (ptr)
-    {
-        // Assign the image properties
-        size.x = static_cast<unsigned int>(width);
-        size.y = static_cast<unsigned int>(height);
-
-        if (width && height)
-        {
-            // Copy the loaded pixels to the pixel buffer
-            pixels.resize(static_cast<std::size_t>(width * height * 4));
-            memcpy(pixels.data(), ptr, pixels.size());
-        }
-
-        // Free the loaded pixels (they are now in our own pixel buffer)
-        stbi_image_free(ptr);
+    Decoder decoder;
+    decoder.load8     = [&](int& width, int& height, int components) { stream.seek(0); return stbi_load_from_callbacks(&callbacks, &stream, &width, &height, &channels, components); };
+    decoder.load16    = [&](int& width, int& height, int components) { stream.seek(0); return stbi_load_16_from_callbacks(&callbacks, &stream, &width, &height, &channels, components); };
+    decoder.loadFloat = [&](int& width, int& height, int components) { stream.seek(0); return stbi_loadf_from_callbacks(&callbacks, &stream, &width, &height, &channels, components); };
+    decoder.isHdr     = [&]() { stream.seek(0); return stbi_is_hdr_from_callbacks(&callbacks, &stream) != 0; };
+    decoder.is16Bit   = [&]() { stream.seek(0); return stbi_is_16_bit_from_callbacks(&callbacks, &stream) != 0; };
 
+    if (decode(decoder, format, callback))
+    {
         return true;
     }
     else
     {
         // Error, failed to load the image
-        err() << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
+        if (error)
+            *error = stbi_failure_reason();
+        else
+            err() << "Failed to load image from stream. Reason: " << stbi_failure_reason() << std::endl;
 
         return false;
     }
@@ -241,7 +495,7 @@ bool ImageLoader::loadImageFromStream(InputStream& stream, std::vector<Uint8>& p
 
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToFile(const std::filesystem::path& filename, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::saveImageToFile(const std::filesystem::path& filename, const std::vector<Uint8>& pixels, const Vector2u& size, unsigned int channels, const Image::SaveSettings& settings)
 {
     // Make sure the image is not empty
     if (!pixels.empty() && (size.x > 0) && (size.y > 0))
@@ -251,31 +505,43 @@ bool ImageLoader::saveImageToFile(const std::filesystem::path& filename, const s
         // Extract the extension
         const std::filesystem::path extension = filename.extension();
         const Vector2i convertedSize = Vector2i(size);
+        const auto components = static_cast<int>(channels);
 
         if (extension == ".bmp")
         {
             // BMP format
-            if (stbi_write_bmp(filename.string().c_str(), convertedSize.x, convertedSize.y, 4, pixels.data()))
+            if (stbi_write_bmp(filename.string().c_str(), convertedSize.x, convertedSize.y, components, pixels.data()))
                 return true;
         }
         else if (extension == ".tga")
         {
             // TGA format
-            if (stbi_write_tga(filename.string().c_str(), convertedSize.x, convertedSize.y, 4, pixels.data()))
+            if (stbi_write_tga(filename.string().c_str(), convertedSize.x, convertedSize.y, components, pixels.data()))
                 return true;
         }
         else if (extension == ".png")
         {
             // PNG format
-            if (stbi_write_png(filename.string().c_str(), convertedSize.x, convertedSize.y, 4, pixels.data(), 0))
+            if (writePng(settings, [&] { return stbi_write_png(filename.string().c_str(), convertedSize.x, convertedSize.y, components, pixels.data(), 0) != 0; }))
                 return true;
         }
         else if (extension == ".jpg" || extension == ".jpeg")
         {
             // JPG format
-            if (stbi_write_jpg(filename.string().c_str(), convertedSize.x, convertedSize.y, 4, pixels.data(), 90))
+            if (stbi_write_jpg(filename.string().c_str(), convertedSize.x, convertedSize.y, components, pixels.data(), getJpegQuality(settings)))
                 return true;
         }
+        else if (extension == ".qoi")
+        {
+            // QOI format
+            std::vector<Uint8> buffer;
+            if (encodeQoi(pixels.data(), size, channels, buffer))
+            {
+                std::ofstream file(filename, std::ios_base::binary | std::ios_base::trunc);
+                if (file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size())))
+                    return true;
+            }
+        }
     }
 
     err() << "Failed to save image\n" << formatDebugPathInfo(filename) << std::endl;
@@ -283,7 +549,7 @@ bool ImageLoader::saveImageToFile(const std::filesystem::path& filename, const s
 }
 
 ////////////////////////////////////////////////////////////
-bool ImageLoader::saveImageToMemory(const std::string& format, std::vector<sf::Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size)
+bool ImageLoader::saveImageToMemory(const std::string& format, std::vector<sf::Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size, unsigned int channels, const Image::SaveSettings& settings)
 {
     // Make sure the image is not empty
     if (!pixels.empty() && (size.x > 0) && (size.y > 0))
@@ -292,29 +558,36 @@ bool ImageLoader::saveImageToMemory(const std::string& format, std::vector<sf::U
 
         std::string specified = toLower(format);
         const Vector2i convertedSize = Vector2i(size);
+        const auto components = static_cast<int>(channels);
 
         if (specified == "bmp")
         {
             // BMP format
-            if (stbi_write_bmp_to_func(&bufferFromCallback, &output, convertedSize.x, convertedSize.y, 4, pixels.data()))
+            if (stbi_write_bmp_to_func(&bufferFromCallback, &output, convertedSize.x, convertedSize.y, components, pixels.data()))
                 return true;
         }
         else if (specified == "tga")
         {
             // TGA format
-            if (stbi_write_tga_to_func(&bufferFromCallback, &output, convertedSize.x, convertedSize.y, 4, pixels.data()))
+            if (stbi_write_tga_to_func(&bufferFromCallback, &output, convertedSize.x, convertedSize.y, components, pixels.data()))
                 return true;
         }
         else if (specified == "png")
         {
             // PNG format
-            if (stbi_write_png_to_func(&bufferFromCallback, &output, convertedSize.x, convertedSize.y, 4, pixels.data(), 0))
+            if (writePng(settings, [&] { return stbi_write_png_to_func(&bufferFromCallback, &output, convertedSize.x, convertedSize.y, components, pixels.data(), 0) != 0; }))
                 return true;
         }
         else if (specified == "jpg" || specified == "jpeg")
         {
             // JPG format
-            if (stbi_write_jpg_to_func(&bufferFromCallback, &output, convertedSize.x, convertedSize.y, 4, pixels.data(), 90))
+            if (stbi_write_jpg_to_func(&bufferFromCallback, &output, convertedSize.x, convertedSize.y, components, pixels.data(), getJpegQuality(settings)))
+                return true;
+        }
+        else if (specified == "qoi")
+        {
+            // QOI format
+            if (encodeQoi(pixels.data(), size, channels, output))
                 return true;
         }
     }
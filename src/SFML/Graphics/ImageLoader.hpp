@@ -29,8 +29,11 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Config.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/PixelFormat.hpp>
 #include <SFML/System/Vector2.hpp>
 #include <filesystem>
+#include <functional>
 #include <string>
 #include <vector>
 
@@ -44,11 +47,35 @@ namespace priv
 ////////////////////////////////////////////////////////////
 /// \brief Load/save image files
 ///
+/// The loader has no state and can be used by several threads
+/// at the same time: stb_image stores the reason of its
+/// failures in a thread-local variable.
+///
 ////////////////////////////////////////////////////////////
 class ImageLoader
 {
 public:
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Function receiving the pixels of a decoded image
+    ///
+    /// The pixels are only valid during the call, and are
+    /// tightly packed in the requested pixel format.
+    ///
+    ////////////////////////////////////////////////////////////
+    using PixelCallback = std::function<void(const Uint8* pixels, const Vector2u& size)>;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Version of the decoders
+    ///
+    /// The upper bytes hold the version of stb_image (2.26), the
+    /// lowest byte the revision of the decoding done by SFML (QOI
+    /// decoder and conversions to the requested pixel format).
+    /// It must change whenever a file may decode to different pixels.
+    ///
+    ////////////////////////////////////////////////////////////
+    static constexpr Uint32 DecoderVersion = (2 << 16) | (26 << 8) | 2;
+
     ////////////////////////////////////////////////////////////
     /// \brief Get the unique instance of the class
     ///
@@ -61,38 +88,84 @@ public:
     /// \brief Load an image from a file on disk
     ///
     /// \param filename Path of image file to load
+    /// \param format   Format of the pixels to decode
     /// \param pixels   Array of pixels to fill with loaded image
     /// \param size     Size of loaded image, in pixels
+    /// \param error    If not null, receives the reason of a failure instead of sf::err()
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromFile(const std::filesystem::path& filename, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromFile(const std::filesystem::path& filename, PixelFormat format, std::vector<Uint8>& pixels, Vector2u& size, std::string* error = nullptr);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a file on disk, without copying its pixels
+    ///
+    /// \param filename Path of image file to load
+    /// \param format   Format of the pixels to decode
+    /// \param callback Function receiving the decoded pixels, called once if the loading succeeds
+    /// \param error    If not null, receives the reason of a failure instead of sf::err()
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadImageFromFile(const std::filesystem::path& filename, PixelFormat format, const PixelCallback& callback, std::string* error = nullptr);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a file in memory
     ///
     /// \param data     Pointer to the file data in memory
     /// \param dataSize Size of the data to load, in bytes
+    /// \param format   Format of the pixels to decode
     /// \param pixels   Array of pixels to fill with loaded image
     /// \param size     Size of loaded image, in pixels
+    /// \param error    If not null, receives the reason of a failure instead of sf::err()
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromMemory(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromMemory(const void* data, std::size_t dataSize, PixelFormat format, std::vector<Uint8>& pixels, Vector2u& size, std::string* error = nullptr);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a file in memory, without copying its pixels
+    ///
+    /// \param data     Pointer to the file data in memory
+    /// \param dataSize Size of the data to load, in bytes
+    /// \param format   Format of the pixels to decode
+    /// \param callback Function receiving the decoded pixels, called once if the loading succeeds
+    /// \param error    If not null, receives the reason of a failure instead of sf::err()
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadImageFromMemory(const void* data, std::size_t dataSize, PixelFormat format, const PixelCallback& callback, std::string* error = nullptr);
 
     ////////////////////////////////////////////////////////////
     /// \brief Load an image from a custom stream
     ///
     /// \param stream Source stream to read from
+    /// \param format Format of the pixels to decode
     /// \param pixels Array of pixels to fill with loaded image
     /// \param size   Size of loaded image, in pixels
+    /// \param error  If not null, receives the reason of a failure instead of sf::err()
+    ///
+    /// \return True if loading was successful
+    ///
+    ////////////////////////////////////////////////////////////
+    bool loadImageFromStream(InputStream& stream, PixelFormat format, std::vector<Uint8>& pixels, Vector2u& size, std::string* error = nullptr);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Load an image from a custom stream, without copying its pixels
+    ///
+    /// \param stream   Source stream to read from
+    /// \param format   Format of the pixels to decode
+    /// \param callback Function receiving the decoded pixels, called once if the loading succeeds
+    /// \param error    If not null, receives the reason of a failure instead of sf::err()
     ///
     /// \return True if loading was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool loadImageFromStream(InputStream& stream, std::vector<Uint8>& pixels, Vector2u& size);
+    bool loadImageFromStream(InputStream& stream, PixelFormat format, const PixelCallback& callback, std::string* error = nullptr);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an image file
@@ -100,24 +173,28 @@ public:
     /// \param filename Path of image file to save
     /// \param pixels   Array of pixels to save to image
     /// \param size     Size of image to save, in pixels
+    /// \param channels Number of 8-bit channels of the pixels (1 to 4)
+    /// \param settings Settings of the encoder
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToFile(const std::filesystem::path& filename, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToFile(const std::filesystem::path& filename, const std::vector<Uint8>& pixels, const Vector2u& size, unsigned int channels, const Image::SaveSettings& settings);
 
     ////////////////////////////////////////////////////////////
     /// \brief Save an array of pixels as an encoded image buffer
     ///
-    /// \param format   Must be "bmp", "png", "tga" or "jpg"/"jpeg".
+    /// \param format   Must be "bmp", "png", "tga", "jpg"/"jpeg" or "qoi".
     /// \param output   Buffer to fill with encoded data
     /// \param pixels   Array of pixels to save to image
     /// \param size     Size of image to save, in pixels
+    /// \param channels Number of 8-bit channels of the pixels (1 to 4)
+    /// \param settings Settings of the encoder
     ///
     /// \return True if saving was successful
     ///
     ////////////////////////////////////////////////////////////
-    bool saveImageToMemory(const std::string& format, std::vector<sf::Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size);
+    bool saveImageToMemory(const std::string& format, std::vector<sf::Uint8>& output, const std::vector<Uint8>& pixels, const Vector2u& size, unsigned int channels, const Image::SaveSettings& settings);
 
 private:
 
@@ -0,0 +1,453 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/ThreadPool.hpp>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_PARTICLES_USE_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+    #include <arm_neon.h>
+    #define SFML_PARTICLES_USE_NEON
+#endif
+#include <algorithm>
+#include <cstring>
+#include <ostream>
+
+
+namespace
+{
+    // A nested named namespace is used here to allow unity builds of SFML.
+    namespace ParticleSystemImpl
+    {
+        // Particles are processed in parallel chunks; smaller chunks are not worth a thread
+        constexpr std::size_t minParticlesPerChunk = 16 * 1024;
+
+        // Largest texture coordinate of particle vertices
+        constexpr unsigned int maxCoordinate = 32767;
+
+        // The vector paths do the same IEEE operations as the scalar loops, in the same
+        // order, so that particles move the same way whatever the instruction set (this
+        // file is built without floating point contraction, see CMakeLists.txt)
+
+        // Accelerate and move one axis of a range of particles
+        void integrate(float* positions, float* velocities, std::size_t count, float acceleration, float elapsed)
+        {
+            std::size_t i = 0;
+
+#if defined(SFML_PARTICLES_USE_SSE2)
+            const __m128 accelerations = _mm_set1_ps(acceleration);
+            const __m128 durations     = _mm_set1_ps(elapsed);
+            for (; i + 4 <= count; i += 4)
+            {
+                const __m128 velocity = _mm_add_ps(_mm_loadu_ps(velocities + i), accelerations);
+                _mm_storeu_ps(velocities + i, velocity);
+                _mm_storeu_ps(positions + i, _mm_add_ps(_mm_loadu_ps(positions + i), _mm_mul_ps(velocity, durations)));
+            }
+#elif defined(SFML_PARTICLES_USE_NEON)
+            const float32x4_t accelerations = vdupq_n_f32(acceleration);
+            const float32x4_t durations     = vdupq_n_f32(elapsed);
+            for (; i + 4 <= count; i += 4)
+            {
+                const float32x4_t velocity = vaddq_f32(vld1q_f32(velocities + i), accelerations);
+                vst1q_f32(velocities + i, velocity);
+                vst1q_f32(positions + i, vaddq_f32(vld1q_f32(positions + i), vmulq_f32(velocity, durations)));
+            }
+#endif
+
+            for (; i < count; ++i)
+            {
+                velocities[i] += acceleration;
+                positions[i] += velocities[i] * elapsed;
+            }
+        }
+
+        // Age a range of particles
+        void age(float* ages, const float* agingRates, std::size_t count, float elapsed)
+        {
+            std::size_t i = 0;
+
+#if defined(SFML_PARTICLES_USE_SSE2)
+            const __m128 durations = _mm_set1_ps(elapsed);
+            for (; i + 4 <= count; i += 4)
+                _mm_storeu_ps(ages + i, _mm_add_ps(_mm_loadu_ps(ages + i), _mm_mul_ps(_mm_loadu_ps(agingRates + i), durations)));
+#elif defined(SFML_PARTICLES_USE_NEON)
+            const float32x4_t durations = vdupq_n_f32(elapsed);
+            for (; i + 4 <= count; i += 4)
+                vst1q_f32(ages + i, vaddq_f32(vld1q_f32(ages + i), vmulq_f32(vld1q_f32(agingRates + i), durations)));
+#endif
+
+            for (; i < count; ++i)
+                ages[i] += agingRates[i] * elapsed;
+        }
+
+        // Interpolate a color component
+        sf::Uint8 lerp(float start, float delta, float t)
+        {
+            return static_cast<sf::Uint8>(start + delta * t + 0.5f);
+        }
+
+        // Interpolate the four components of a color at once; start and delta are in RGBA order
+        sf::Color lerp(const float* start, const float* delta, float t)
+        {
+#if defined(SFML_PARTICLES_USE_SSE2)
+            const __m128 value = _mm_add_ps(_mm_add_ps(_mm_loadu_ps(start), _mm_mul_ps(_mm_loadu_ps(delta), _mm_set1_ps(t))), _mm_set1_ps(0.5f));
+            __m128i integers = _mm_cvttps_epi32(value);
+            integers = _mm_packs_epi32(integers, integers);
+            integers = _mm_packus_epi16(integers, integers);
+            const auto packed = static_cast<sf::Uint32>(_mm_cvtsi128_si32(integers));
+#elif defined(SFML_PARTICLES_USE_NEON)
+            const float32x4_t value = vaddq_f32(vaddq_f32(vld1q_f32(start), vmulq_f32(vld1q_f32(delta), vdupq_n_f32(t))), vdupq_n_f32(0.5f));
+            const uint16x4_t shorts = vmovn_u32(vcvtq_u32_f32(value));
+            const sf::Uint32 packed = vget_lane_u32(vreinterpret_u32_u8(vmovn_u16(vcombine_u16(shorts, shorts))), 0);
+#endif
+
+#if defined(SFML_PARTICLES_USE_SSE2) || defined(SFML_PARTICLES_USE_NEON)
+            sf::Uint8 components[4];
+            std::memcpy(components, &packed, 4);
+            return sf::Color(components[0], components[1], components[2], components[3]);
+#else
+            return sf::Color(lerp(start[0], delta[0], t), lerp(start[1], delta[1], t), lerp(start[2], delta[2], t), lerp(start[3], delta[3], t));
+#endif
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+ParticleSystem::ParticleSystem() :
+m_positionsX  (),
+m_positionsY  (),
+m_velocitiesX (),
+m_velocitiesY (),
+m_ages        (),
+m_agingRates  (),
+m_acceleration(),
+m_startColor  (Color::White),
+m_endColor    (Color::White),
+m_size        (1.f),
+m_texture     (nullptr),
+m_buffer      (Triangles, VertexBuffer::Stream),
+m_vertices    ()
+{
+    VertexLayout layout(sizeof(ParticleVertex), VertexLayout::Float, offsetof(ParticleVertex, position));
+    layout.setColor(offsetof(ParticleVertex, color));
+    layout.setTexCoords(VertexLayout::Short, offsetof(ParticleVertex, texCoords));
+
+    // The quads are rewritten every frame, while the previous frames may still be drawn
+    m_buffer.setLayout(layout);
+    m_buffer.setBufferCount(3);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::emit(const Vector2f& position, const Vector2f& velocity, Time lifetime)
+{
+    if (lifetime <= Time::Zero)
+        return;
+
+    m_positionsX.push_back(position.x);
+    m_positionsY.push_back(position.y);
+    m_velocitiesX.push_back(velocity.x);
+    m_velocitiesY.push_back(velocity.y);
+    m_ages.push_back(0.f);
+    m_agingRates.push_back(1.f / lifetime.asSeconds());
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::update(Time elapsed)
+{
+    const float seconds = elapsed.asSeconds();
+    if ((seconds <= 0.f) || m_ages.empty())
+        return;
+
+    float* positionsX = m_positionsX.data();
+    float* positionsY = m_positionsY.data();
+    float* velocitiesX = m_velocitiesX.data();
+    float* velocitiesY = m_velocitiesY.data();
+    float* ages = m_ages.data();
+    const float* agingRates = m_agingRates.data();
+    const Vector2f acceleration = m_acceleration * seconds;
+
+    priv::ThreadPool::getGlobal().parallelFor(m_ages.size(), ParticleSystemImpl::minParticlesPerChunk,
+        [&](std::size_t begin, std::size_t end)
+        {
+            ParticleSystemImpl::integrate(positionsX + begin, velocitiesX + begin, end - begin, acceleration.x, seconds);
+            ParticleSystemImpl::integrate(positionsY + begin, velocitiesY + begin, end - begin, acceleration.y, seconds);
+            ParticleSystemImpl::age(ages + begin, agingRates + begin, end - begin, seconds);
+        });
+
+    // Replace the dead particles by the last ones
+    std::size_t count = m_ages.size();
+    for (std::size_t i = 0; i < count;)
+    {
+        if (m_ages[i] < 1.f)
+        {
+            ++i;
+            continue;
+        }
+
+        --count;
+        m_positionsX[i]  = m_positionsX[count];
+        m_positionsY[i]  = m_positionsY[count];
+        m_velocitiesX[i] = m_velocitiesX[count];
+        m_velocitiesY[i] = m_velocitiesY[count];
+        m_ages[i]        = m_ages[count];
+        m_agingRates[i]  = m_agingRates[count];
+    }
+
+    m_positionsX.resize(count);
+    m_positionsY.resize(count);
+    m_velocitiesX.resize(count);
+    m_velocitiesY.resize(count);
+    m_ages.resize(count);
+    m_agingRates.resize(count);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::clear()
+{
+    m_positionsX.clear();
+    m_positionsY.clear();
+    m_velocitiesX.clear();
+    m_velocitiesY.clear();
+    m_ages.clear();
+    m_agingRates.clear();
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::reserve(std::size_t count)
+{
+    m_positionsX.reserve(count);
+    m_positionsY.reserve(count);
+    m_velocitiesX.reserve(count);
+    m_velocitiesY.reserve(count);
+    m_ages.reserve(count);
+    m_agingRates.reserve(count);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ParticleSystem::getParticleCount() const
+{
+    return m_ages.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2f ParticleSystem::getParticlePosition(std::size_t index) const
+{
+    return Vector2f(m_positionsX[index], m_positionsY[index]);
+}
+
+
+////////////////////////////////////////////////////////////
+Color ParticleSystem::getParticleColor(std::size_t index) const
+{
+    const float t = m_ages[index];
+
+    return Color(ParticleSystemImpl::lerp(m_startColor.r, static_cast<float>(m_endColor.r - m_startColor.r), t),
+                 ParticleSystemImpl::lerp(m_startColor.g, static_cast<float>(m_endColor.g - m_startColor.g), t),
+                 ParticleSystemImpl::lerp(m_startColor.b, static_cast<float>(m_endColor.b - m_startColor.b), t),
+                 ParticleSystemImpl::lerp(m_startColor.a, static_cast<float>(m_endColor.a - m_startColor.a), t));
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setAcceleration(const Vector2f& acceleration)
+{
+    m_acceleration = acceleration;
+}
+
+
+////////////////////////////////////////////////////////////
+const Vector2f& ParticleSystem::getAcceleration() const
+{
+    return m_acceleration;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setColors(const Color& startColor, const Color& endColor)
+{
+    m_startColor = startColor;
+    m_endColor = endColor;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& ParticleSystem::getStartColor() const
+{
+    return m_startColor;
+}
+
+
+////////////////////////////////////////////////////////////
+const Color& ParticleSystem::getEndColor() const
+{
+    return m_endColor;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setParticleSize(float size)
+{
+    m_size = size;
+}
+
+
+////////////////////////////////////////////////////////////
+float ParticleSystem::getParticleSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::setTexture(const Texture* texture)
+{
+    if (texture && ((texture->getSize().x > ParticleSystemImpl::maxCoordinate) || (texture->getSize().y > ParticleSystemImpl::maxCoordinate)))
+    {
+        err() << "Failed to set the texture of the particle system, textures larger than "
+              << ParticleSystemImpl::maxCoordinate << " pixels are not supported" << std::endl;
+        return;
+    }
+
+    m_texture = texture;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* ParticleSystem::getTexture() const
+{
+    return m_texture;
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::draw(RenderTarget& target, const RenderStates& states) const
+{
+    if (m_ages.empty())
+        return;
+
+    RenderStates particleStates(states);
+    particleStates.texture = m_texture;
+
+    const std::size_t vertexCount = m_ages.size() * 6;
+
+    if (VertexBuffer::isAvailable())
+    {
+        // Grow the buffer geometrically, so that it is not recreated every time particles are emitted
+        if (m_buffer.getVertexCount() < vertexCount)
+        {
+            if (!m_buffer.create(std::max(vertexCount, m_buffer.getVertexCount() * 2)))
+                err() << "Failed to create the vertex buffer of a particle system" << std::endl;
+        }
+
+        // The vertices after the particles are discarded, so that the quads are written to the copy which is not being drawn
+        if (m_buffer.getVertexCount() >= vertexCount)
+        {
+            if (void* vertices = m_buffer.map(vertexCount))
+            {
+                writeAllQuads(static_cast<ParticleVertex*>(vertices));
+
+                if (m_buffer.unmap())
+                {
+                    target.draw(m_buffer, 0, vertexCount, particleStates);
+                    return;
+                }
+            }
+        }
+    }
+
+    m_vertices.resize(vertexCount);
+    writeAllQuads(m_vertices.data());
+    target.draw(m_vertices.data(), vertexCount, m_buffer.getLayout(), Triangles, particleStates);
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::writeQuads(ParticleVertex* vertices, std::size_t begin, std::size_t end) const
+{
+    const float halfSize = m_size / 2.f;
+    const Vector2<Int16> textureSize = m_texture ? Vector2<Int16>(static_cast<Int16>(m_texture->getSize().x),
+                                                                  static_cast<Int16>(m_texture->getSize().y))
+                                                 : Vector2<Int16>();
+
+    const float start[] = {static_cast<float>(m_startColor.r),
+                           static_cast<float>(m_startColor.g),
+                           static_cast<float>(m_startColor.b),
+                           static_cast<float>(m_startColor.a)};
+    const float delta[] = {static_cast<float>(m_endColor.r - m_startColor.r),
+                           static_cast<float>(m_endColor.g - m_startColor.g),
+                           static_cast<float>(m_endColor.b - m_startColor.b),
+                           static_cast<float>(m_endColor.a - m_startColor.a)};
+
+    for (std::size_t i = begin; i < end; ++i)
+    {
+        const float x = m_positionsX[i];
+        const float y = m_positionsY[i];
+        const float t = m_ages[i];
+
+        const Color color = ParticleSystemImpl::lerp(start, delta, t);
+
+        const ParticleVertex topLeft{{x - halfSize, y - halfSize}, color, {0, 0}};
+        const ParticleVertex topRight{{x + halfSize, y - halfSize}, color, {textureSize.x, 0}};
+        const ParticleVertex bottomLeft{{x - halfSize, y + halfSize}, color, {0, textureSize.y}};
+        const ParticleVertex bottomRight{{x + halfSize, y + halfSize}, color, textureSize};
+
+        ParticleVertex* quad = vertices + (i - begin) * 6;
+        quad[0] = topLeft;
+        quad[1] = topRight;
+        quad[2] = bottomLeft;
+        quad[3] = bottomLeft;
+        quad[4] = topRight;
+        quad[5] = bottomRight;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void ParticleSystem::writeAllQuads(ParticleVertex* vertices) const
+{
+    priv::ThreadPool::getGlobal().parallelFor(m_ages.size(), ParticleSystemImpl::minParticlesPerChunk,
+        [&](std::size_t begin, std::size_t end)
+        {
+            writeQuads(vertices + begin * 6, begin, end);
+        });
+}
+
+} // namespace sf
@@ -0,0 +1,300 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PixelConversion.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+
+namespace
+{
+    // Convert between 8-bit formats; the channel counts are known at compile time so that the loop can be unrolled and vectorized
+    template <std::size_t From, std::size_t To>
+    void shuffleChannels(const sf::Uint8* source, sf::Uint8* destination, std::size_t count)
+    {
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t c = 0; c < To; ++c)
+                destination[i * To + c] = (c < From) ? source[i * From + c] : ((c == 3) ? 255 : 0);
+        }
+    }
+
+    using ShuffleFunction = void (*)(const sf::Uint8*, sf::Uint8*, std::size_t);
+
+    const ShuffleFunction shuffleFunctions[4][4] =
+    {
+        {&shuffleChannels<1, 1>, &shuffleChannels<1, 2>, &shuffleChannels<1, 3>, &shuffleChannels<1, 4>},
+        {&shuffleChannels<2, 1>, &shuffleChannels<2, 2>, &shuffleChannels<2, 3>, &shuffleChannels<2, 4>},
+        {&shuffleChannels<3, 1>, &shuffleChannels<3, 2>, &shuffleChannels<3, 3>, &shuffleChannels<3, 4>},
+        {&shuffleChannels<4, 1>, &shuffleChannels<4, 2>, &shuffleChannels<4, 3>, &shuffleChannels<4, 4>}
+    };
+
+    // Read and write unaligned multi-byte components
+    template <typename T>
+    T loadComponent(const sf::Uint8* bytes)
+    {
+        T value;
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    template <typename T>
+    void storeComponent(sf::Uint8* bytes, T value)
+    {
+        std::memcpy(bytes, &value, sizeof(T));
+    }
+
+    // Convert a float in [0, 1] to a normalized integer
+    template <typename T>
+    T normalize(float value, float maximum)
+    {
+        return static_cast<T>(std::clamp(value, 0.f, 1.f) * maximum + 0.5f);
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool isEightBit(PixelFormat format)
+{
+    return (format == R8) || (format == RG8) || (format == RGB8) || (format == RGBA8);
+}
+
+
+////////////////////////////////////////////////////////////
+float halfToFloat(Uint16 value)
+{
+    Uint32 sign     = static_cast<Uint32>(value & 0x8000) << 16;
+    Uint32 exponent = (value >> 10) & 0x1F;
+    Uint32 mantissa = value & 0x3FF;
+
+    // Subnormal numbers are normalized in single precision
+    if (exponent == 0)
+    {
+        float result = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -result : result;
+    }
+
+    Uint32 bits;
+    if (exponent == 0x1F)
+        bits = sign | 0x7F800000 | (mantissa << 13); // Infinity or NaN
+    else
+        bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+    float result;
+    std::memcpy(&result, &bits, sizeof(result));
+    return result;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint16 floatToHalf(float value)
+{
+    Uint32 bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    auto   sign     = static_cast<Uint16>((bits >> 16) & 0x8000);
+    Uint32 exponent = (bits >> 23) & 0xFF;
+    Uint32 mantissa = bits & 0x7FFFFF;
+
+    // Infinity or NaN (keep NaNs quiet)
+    if (exponent == 0xFF)
+        return static_cast<Uint16>(sign | 0x7C00 | (mantissa ? 0x200 : 0));
+
+    // Too large values become infinite
+    int halfExponent = static_cast<int>(exponent) - 127 + 15;
+    if (halfExponent >= 0x1F)
+        return static_cast<Uint16>(sign | 0x7C00);
+
+    // Too small values become subnormal, or zero; rounding is to nearest even in all cases
+    if (halfExponent <= 0)
+    {
+        if (halfExponent < -10)
+            return sign;
+
+        mantissa |= 0x800000;
+        auto   shift     = static_cast<Uint32>(14 - halfExponent);
+        Uint32 half      = mantissa >> shift;
+        Uint32 remainder = mantissa & ((1u << shift) - 1);
+        Uint32 halfway   = 1u << (shift - 1);
+        if ((remainder > halfway) || ((remainder == halfway) && (half & 1)))
+            ++half;
+
+        return static_cast<Uint16>(sign | half);
+    }
+
+    // A carry out of the mantissa correctly increments the exponent
+    Uint32 half      = (static_cast<Uint32>(halfExponent) << 10) | (mantissa >> 13);
+    Uint32 remainder = mantissa & 0x1FFF;
+    if ((remainder > 0x1000) || ((remainder == 0x1000) && (half & 1)))
+        ++half;
+
+    return static_cast<Uint16>(sign | half);
+}
+
+
+////////////////////////////////////////////////////////////
+void decodePixels(PixelFormat format, const Uint8* pixels, float* values, std::size_t count)
+{
+    // RGBA8 maps the components one to one, which vectorizes well
+    if (format == RGBA8)
+    {
+        for (std::size_t i = 0; i < count * 4; ++i)
+            values[i] = static_cast<float>(pixels[i]) * (1.f / 255.f);
+        return;
+    }
+
+    if (isEightBit(format))
+    {
+        std::size_t channels = getChannelCount(format);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t c = 0; c < 4; ++c)
+                values[i * 4 + c] = (c < channels) ? pixels[i * channels + c] / 255.f : ((c == 3) ? 1.f : 0.f);
+        }
+        return;
+    }
+
+    switch (format)
+    {
+        case R16:
+        {
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                values[i * 4 + 0] = loadComponent<Uint16>(pixels + i * 2) / 65535.f;
+                values[i * 4 + 1] = 0.f;
+                values[i * 4 + 2] = 0.f;
+                values[i * 4 + 3] = 1.f;
+            }
+            break;
+        }
+
+        case RGBA16F:
+        {
+            for (std::size_t i = 0; i < count * 4; ++i)
+                values[i] = halfToFloat(loadComponent<Uint16>(pixels + i * 2));
+            break;
+        }
+
+        case RGBA32F:
+        {
+            std::memcpy(values, pixels, count * 4 * sizeof(float));
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void encodePixels(PixelFormat format, const float* values, Uint8* pixels, std::size_t count)
+{
+    if (format == RGBA8)
+    {
+        for (std::size_t i = 0; i < count * 4; ++i)
+            pixels[i] = normalize<Uint8>(values[i], 255.f);
+        return;
+    }
+
+    if (isEightBit(format))
+    {
+        std::size_t channels = getChannelCount(format);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            for (std::size_t c = 0; c < channels; ++c)
+                pixels[i * channels + c] = normalize<Uint8>(values[i * 4 + c], 255.f);
+        }
+        return;
+    }
+
+    switch (format)
+    {
+        case R16:
+        {
+            for (std::size_t i = 0; i < count; ++i)
+                storeComponent(pixels + i * 2, normalize<Uint16>(values[i * 4], 65535.f));
+            break;
+        }
+
+        case RGBA16F:
+        {
+            for (std::size_t i = 0; i < count * 4; ++i)
+                storeComponent(pixels + i * 2, floatToHalf(values[i]));
+            break;
+        }
+
+        case RGBA32F:
+        {
+            std::memcpy(pixels, values, count * 4 * sizeof(float));
+            break;
+        }
+
+        default:
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void convertPixels(PixelFormat sourceFormat, const Uint8* source, PixelFormat destinationFormat, Uint8* destination, std::size_t count)
+{
+    if (sourceFormat == destinationFormat)
+    {
+        std::memcpy(destination, source, count * getPixelSize(sourceFormat));
+        return;
+    }
+
+    // Conversions between 8-bit formats only move bytes around
+    if (isEightBit(sourceFormat) && isEightBit(destinationFormat))
+    {
+        shuffleFunctions[getChannelCount(sourceFormat) - 1][getChannelCount(destinationFormat) - 1](source, destination, count);
+        return;
+    }
+
+    // Other conversions go through a small buffer of floats that stays in cache
+    constexpr std::size_t chunkSize = 256;
+    float values[chunkSize * 4];
+
+    std::size_t sourceSize      = getPixelSize(sourceFormat);
+    std::size_t destinationSize = getPixelSize(destinationFormat);
+    for (std::size_t i = 0; i < count; i += chunkSize)
+    {
+        std::size_t chunk = std::min(chunkSize, count - i);
+        decodePixels(sourceFormat, source + i * sourceSize, values, chunk);
+        encodePixels(destinationFormat, values, destination + i * destinationSize, chunk);
+    }
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_PIXELCONVERSION_HPP
+#define SFML_PIXELCONVERSION_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/PixelFormat.hpp>
+#include <SFML/Config.hpp>
+#include <cstddef>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Tell whether all the channels of a pixel format are stored in one byte
+///
+/// \param format Pixel format
+///
+/// \return True for R8, RG8, RGB8 and RGBA8
+///
+////////////////////////////////////////////////////////////
+bool isEightBit(PixelFormat format);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert a half precision float to a single precision float
+///
+/// \param value Bits of the half precision float
+///
+/// \return Single precision float
+///
+////////////////////////////////////////////////////////////
+float halfToFloat(Uint16 value);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert a single precision float to a half precision float
+///
+/// The value is rounded to the nearest representable half,
+/// too large values become infinite.
+///
+/// \param value Single precision float
+///
+/// \return Bits of the half precision float
+///
+////////////////////////////////////////////////////////////
+Uint16 floatToHalf(float value);
+
+////////////////////////////////////////////////////////////
+/// \brief Decode pixels to RGBA floats
+///
+/// Normalized formats are mapped to [0, 1], the missing color
+/// channels are set to 0 and the missing alpha channel to 1.
+///
+/// \param format Format of the pixels
+/// \param pixels Pixels to decode
+/// \param values Array of count * 4 floats to fill
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void decodePixels(PixelFormat format, const Uint8* pixels, float* values, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Encode RGBA floats to pixels
+///
+/// Values are clamped to [0, 1] for normalized formats,
+/// extra channels are dropped.
+///
+/// \param format Format of the pixels
+/// \param values Array of count * 4 floats to encode
+/// \param pixels Pixels to fill
+/// \param count  Number of pixels
+///
+////////////////////////////////////////////////////////////
+void encodePixels(PixelFormat format, const float* values, Uint8* pixels, std::size_t count);
+
+////////////////////////////////////////////////////////////
+/// \brief Convert pixels from a format to another
+///
+/// Conversions between 8-bit formats only shuffle bytes,
+/// other conversions go through RGBA floats.
+///
+/// \param sourceFormat      Format of the source pixels
+/// \param source            Source pixels
+/// \param destinationFormat Format of the destination pixels
+/// \param destination       Destination pixels, must not overlap the source
+/// \param count             Number of pixels
+///
+////////////////////////////////////////////////////////////
+void convertPixels(PixelFormat sourceFormat, const Uint8* source, PixelFormat destinationFormat, Uint8* destination, std::size_t count);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_PIXELCONVERSION_HPP
@@ -0,0 +1,331 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/QoiCodec.hpp>
+#include <array>
+#include <cstring>
+
+
+namespace
+{
+    // A nested named namespace is used here to allow unity builds of SFML.
+    namespace QoiImpl
+    {
+        // Layout of a QOI file: a 14 bytes header, the chunks, and 8 bytes of padding
+        // (see the specification at https://qoiformat.org/qoi-specification.pdf)
+        constexpr std::size_t headerSize  = 14;
+        constexpr std::size_t paddingSize = 8;
+        constexpr sf::Uint8   padding[paddingSize] = {0, 0, 0, 0, 0, 0, 0, 1};
+
+        // Largest image accepted by the reference decoder, to reject corrupt sizes early
+        constexpr std::size_t maxPixels = 400000000;
+
+        // Chunk tags
+        constexpr sf::Uint8 opIndex = 0x00; // 00iiiiii: pixel from the index
+        constexpr sf::Uint8 opDiff  = 0x40; // 01rrggbb: small difference with the previous pixel
+        constexpr sf::Uint8 opLuma  = 0x80; // 10gggggg rrrrbbbb: difference of green, and of red/blue relative to green
+        constexpr sf::Uint8 opRun   = 0xc0; // 11llllll: repetition of the previous pixel
+        constexpr sf::Uint8 opRgb   = 0xfe; // 11111110 r g b
+        constexpr sf::Uint8 opRgba  = 0xff; // 11111111 r g b a
+        constexpr sf::Uint8 mask    = 0xc0;
+
+        // Longest run of a single chunk (the 2 last values are taken by opRgb and opRgba)
+        constexpr unsigned int maxRun = 62;
+
+        struct Pixel
+        {
+            sf::Uint8 r, g, b, a;
+        };
+
+        bool operator ==(const Pixel& left, const Pixel& right)
+        {
+            return (left.r == right.r) && (left.g == right.g) && (left.b == right.b) && (left.a == right.a);
+        }
+
+        // Slot of a pixel in the index of recently seen pixels
+        unsigned int hash(const Pixel& pixel)
+        {
+            return (pixel.r * 3u + pixel.g * 5u + pixel.b * 7u + pixel.a * 11u) % 64u;
+        }
+
+        sf::Uint32 readBigEndian(const sf::Uint8* bytes)
+        {
+            return (static_cast<sf::Uint32>(bytes[0]) << 24) | (static_cast<sf::Uint32>(bytes[1]) << 16) |
+                   (static_cast<sf::Uint32>(bytes[2]) << 8)  |  static_cast<sf::Uint32>(bytes[3]);
+        }
+
+        void writeBigEndian(std::vector<sf::Uint8>& output, sf::Uint32 value)
+        {
+            output.push_back(static_cast<sf::Uint8>(value >> 24));
+            output.push_back(static_cast<sf::Uint8>(value >> 16));
+            output.push_back(static_cast<sf::Uint8>(value >> 8));
+            output.push_back(static_cast<sf::Uint8>(value));
+        }
+
+        // Read a pixel with any number of 8-bit channels
+        template <unsigned int Channels>
+        Pixel readPixel(const sf::Uint8* pixel)
+        {
+            switch (Channels)
+            {
+                case 1:  return {pixel[0], pixel[0], pixel[0], 255};
+                case 2:  return {pixel[0], pixel[0], pixel[0], pixel[1]};
+                case 3:  return {pixel[0], pixel[1], pixel[2], 255};
+                default: return {pixel[0], pixel[1], pixel[2], pixel[3]};
+            }
+        }
+
+        // Encode the chunks of an image; the output must have room for the worst case (5 bytes per pixel)
+        template <unsigned int Channels>
+        sf::Uint8* encodeChunks(const sf::Uint8* pixels, std::size_t count, sf::Uint8* out)
+        {
+            std::array<Pixel, 64> index = {};
+            Pixel previous = {0, 0, 0, 255};
+            unsigned int run = 0;
+
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const Pixel pixel = readPixel<Channels>(pixels + i * Channels);
+
+                if (pixel == previous)
+                {
+                    if (++run == maxRun)
+                    {
+                        *out++ = static_cast<sf::Uint8>(opRun | (run - 1));
+                        run = 0;
+                    }
+                    continue;
+                }
+
+                if (run > 0)
+                {
+                    *out++ = static_cast<sf::Uint8>(opRun | (run - 1));
+                    run = 0;
+                }
+
+                const unsigned int slot = hash(pixel);
+                if (index[slot] == pixel)
+                {
+                    *out++ = static_cast<sf::Uint8>(opIndex | slot);
+                }
+                else
+                {
+                    index[slot] = pixel;
+
+                    if (pixel.a == previous.a)
+                    {
+                        // Wrapping differences, as specified
+                        const auto dr = static_cast<signed char>(pixel.r - previous.r);
+                        const auto dg = static_cast<signed char>(pixel.g - previous.g);
+                        const auto db = static_cast<signed char>(pixel.b - previous.b);
+                        const int  drg = dr - dg;
+                        const int  dbg = db - dg;
+
+                        if ((dr >= -2) && (dr <= 1) && (dg >= -2) && (dg <= 1) && (db >= -2) && (db <= 1))
+                        {
+                            *out++ = static_cast<sf::Uint8>(opDiff | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+                        }
+                        else if ((drg >= -8) && (drg <= 7) && (dg >= -32) && (dg <= 31) && (dbg >= -8) && (dbg <= 7))
+                        {
+                            *out++ = static_cast<sf::Uint8>(opLuma | (dg + 32));
+                            *out++ = static_cast<sf::Uint8>(((drg + 8) << 4) | (dbg + 8));
+                        }
+                        else
+                        {
+                            *out++ = opRgb;
+                            *out++ = pixel.r;
+                            *out++ = pixel.g;
+                            *out++ = pixel.b;
+                        }
+                    }
+                    else
+                    {
+                        *out++ = opRgba;
+                        *out++ = pixel.r;
+                        *out++ = pixel.g;
+                        *out++ = pixel.b;
+                        *out++ = pixel.a;
+                    }
+                }
+
+                previous = pixel;
+            }
+
+            if (run > 0)
+                *out++ = static_cast<sf::Uint8>(opRun | (run - 1));
+
+            return out;
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+bool isQoi(const void* data, std::size_t dataSize)
+{
+    return data && (dataSize >= 4) && (std::memcmp(data, "qoif", 4) == 0);
+}
+
+
+////////////////////////////////////////////////////////////
+bool decodeQoi(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size)
+{
+    using namespace QoiImpl;
+
+    if (!isQoi(data, dataSize) || (dataSize < headerSize + paddingSize))
+        return false;
+
+    // Read the header
+    const auto*        bytes    = static_cast<const Uint8*>(data);
+    const Uint32       width    = readBigEndian(bytes + 4);
+    const Uint32       height   = readBigEndian(bytes + 8);
+    const unsigned int channels = bytes[12];
+    if ((width == 0) || (height == 0) || (height > maxPixels / width) || (channels < 3) || (channels > 4) || (bytes[13] > 1))
+        return false;
+
+    const std::size_t count = static_cast<std::size_t>(width) * height;
+    pixels.resize(count * 4);
+
+    // Decode the chunks; the padding guarantees that a chunk can be read entirely
+    // without bound checks, and the pixels left after truncated data repeat the last one
+    std::array<Pixel, 64> index = {};
+    Pixel pixel = {0, 0, 0, 255};
+    unsigned int run = 0;
+
+    std::size_t       position  = headerSize;
+    const std::size_t chunksEnd = dataSize - paddingSize;
+    Uint8*            out       = pixels.data();
+
+    for (std::size_t i = 0; i < count; ++i, out += 4)
+    {
+        if (run > 0)
+        {
+            --run;
+        }
+        else if (position < chunksEnd)
+        {
+            const Uint8 tag = bytes[position++];
+
+            if (tag == opRgb)
+            {
+                pixel.r = bytes[position];
+                pixel.g = bytes[position + 1];
+                pixel.b = bytes[position + 2];
+                position += 3;
+            }
+            else if (tag == opRgba)
+            {
+                pixel.r = bytes[position];
+                pixel.g = bytes[position + 1];
+                pixel.b = bytes[position + 2];
+                pixel.a = bytes[position + 3];
+                position += 4;
+            }
+            else if ((tag & mask) == opIndex)
+            {
+                pixel = index[tag];
+            }
+            else if ((tag & mask) == opDiff)
+            {
+                pixel.r = static_cast<Uint8>(pixel.r + ((tag >> 4) & 0x03) - 2);
+                pixel.g = static_cast<Uint8>(pixel.g + ((tag >> 2) & 0x03) - 2);
+                pixel.b = static_cast<Uint8>(pixel.b + (tag & 0x03) - 2);
+            }
+            else if ((tag & mask) == opLuma)
+            {
+                const Uint8 next = bytes[position++];
+                const int   dg   = (tag & 0x3f) - 32;
+                pixel.r = static_cast<Uint8>(pixel.r + dg - 8 + ((next >> 4) & 0x0f));
+                pixel.g = static_cast<Uint8>(pixel.g + dg);
+                pixel.b = static_cast<Uint8>(pixel.b + dg - 8 + (next & 0x0f));
+            }
+            else
+            {
+                run = tag & 0x3f;
+            }
+
+            index[hash(pixel)] = pixel;
+        }
+
+        out[0] = pixel.r;
+        out[1] = pixel.g;
+        out[2] = pixel.b;
+        out[3] = pixel.a;
+    }
+
+    size.x = width;
+    size.y = height;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+bool encodeQoi(const Uint8* pixels, const Vector2u& size, unsigned int channels, std::vector<Uint8>& output)
+{
+    using namespace QoiImpl;
+
+    if (!pixels || (size.x == 0) || (size.y == 0) || (size.y > maxPixels / size.x) || (channels < 1) || (channels > 4))
+        return false;
+
+    // Write the header; grayscale images are stored as RGB, the
+    // 8-bit colors as sRGB and the alpha channel as linear
+    const bool hasAlpha = (channels == 2) || (channels == 4);
+    output.insert(output.end(), {'q', 'o', 'i', 'f'});
+    writeBigEndian(output, size.x);
+    writeBigEndian(output, size.y);
+    output.push_back(hasAlpha ? 4 : 3);
+    output.push_back(0);
+
+    // Encode the chunks in place, in a buffer large enough for the worst case
+    const std::size_t count = static_cast<std::size_t>(size.x) * size.y;
+    const std::size_t start = output.size();
+    output.resize(start + count * (hasAlpha ? 5 : 4));
+
+    Uint8* end = nullptr;
+    switch (channels)
+    {
+        case 1:  end = encodeChunks<1>(pixels, count, output.data() + start); break;
+        case 2:  end = encodeChunks<2>(pixels, count, output.data() + start); break;
+        case 3:  end = encodeChunks<3>(pixels, count, output.data() + start); break;
+        default: end = encodeChunks<4>(pixels, count, output.data() + start); break;
+    }
+
+    output.resize(static_cast<std::size_t>(end - output.data()));
+    output.insert(output.end(), padding, padding + paddingSize);
+
+    return true;
+}
+
+} // namespace priv
+
+} // namespace sf
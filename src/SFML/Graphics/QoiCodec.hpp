@@ -0,0 +1,88 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+#ifndef SFML_QOICODEC_HPP
+#define SFML_QOICODEC_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Config.hpp>
+#include <SFML/System/Vector2.hpp>
+#include <cstddef>
+#include <vector>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Tell whether some data starts like a QOI image
+///
+/// \param data     Pointer to the data
+/// \param dataSize Size of the data, in bytes
+///
+/// \return True if the data starts with the QOI signature
+///
+////////////////////////////////////////////////////////////
+bool isQoi(const void* data, std::size_t dataSize);
+
+////////////////////////////////////////////////////////////
+/// \brief Decode a QOI image to RGBA8 pixels
+///
+/// \param data     Pointer to the encoded image
+/// \param dataSize Size of the encoded image, in bytes
+/// \param pixels   Array of pixels to fill with the decoded image
+/// \param size     Size of the decoded image, in pixels
+///
+/// \return True if the image was decoded
+///
+////////////////////////////////////////////////////////////
+bool decodeQoi(const void* data, std::size_t dataSize, std::vector<Uint8>& pixels, Vector2u& size);
+
+////////////////////////////////////////////////////////////
+/// \brief Encode 8-bit pixels as a QOI image
+///
+/// Grayscale pixels are encoded as RGB pixels, and gray + alpha
+/// pixels as RGBA pixels. The encoded image is appended to
+/// the output buffer.
+///
+/// \param pixels   Pixels to encode
+/// \param size     Size of the image, in pixels
+/// \param channels Number of 8-bit channels of the pixels (1 to 4)
+/// \param output   Buffer to append the encoded image to
+///
+/// \return True if the image was encoded
+///
+////////////////////////////////////////////////////////////
+bool encodeQoi(const Uint8* pixels, const Vector2u& size, unsigned int channels, std::vector<Uint8>& output);
+
+} // namespace priv
+
+} // namespace sf
+
+
+#endif // SFML_QOICODEC_HPP
@@ -31,7 +31,9 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VertexLayout.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/Err.hpp>
 #include <algorithm>
@@ -136,6 +138,29 @@ namespace
 
             return GLEXT_GL_FUNC_ADD;
         }
+
+
+        // Convert an sf::VertexLayout::Type constant to the corresponding OpenGL constant.
+        GLenum typeToGlConstant(sf::VertexLayout::Type type)
+        {
+            switch (type)
+            {
+                case sf::VertexLayout::Float:         return GL_FLOAT;
+                case sf::VertexLayout::HalfFloat:     return GLEXT_GL_HALF_FLOAT;
+                case sf::VertexLayout::Short:         return GL_SHORT;
+                case sf::VertexLayout::UnsignedShort: return GL_UNSIGNED_SHORT;
+                case sf::VertexLayout::UnsignedByte:  return GL_UNSIGNED_BYTE;
+            }
+
+            return GL_FLOAT;
+        }
+
+
+        // Get the address of an attribute, in client memory or in the bound vertex buffer
+        const void* getAttributePointer(std::uintptr_t base, const sf::VertexLayout::Attribute& attribute)
+        {
+            return reinterpret_cast<const void*>(base + attribute.offset);
+        }
     }
 }
 
@@ -330,6 +355,27 @@ void RenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
 }
 
 
+////////////////////////////////////////////////////////////
+void RenderTarget::draw(const void* vertices, std::size_t vertexCount, const VertexLayout& layout,
+                        PrimitiveType type, const RenderStates& states)
+{
+    // Nothing to draw?
+    if (!vertices || (vertexCount == 0))
+        return;
+
+    if (RenderTargetImpl::isActive(m_id) || setActive(true))
+    {
+        setupDraw(false, states);
+
+        if (setupVertexLayout(reinterpret_cast<std::uintptr_t>(vertices), layout, states))
+            drawPrimitives(type, 0, vertexCount);
+
+        cleanupVertexLayout(layout, states);
+        cleanupDraw(states);
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::draw(const VertexBuffer& vertexBuffer, const RenderStates& states)
 {
@@ -359,6 +405,12 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
     if (!vertexCount || !vertexBuffer.getNativeHandle())
         return;
 
+    if (vertexBuffer.m_mapped)
+    {
+        err() << "Failed to draw vertex buffer, it is mapped" << std::endl;
+        return;
+    }
+
     if (RenderTargetImpl::isActive(m_id) || setActive(true))
     {
         setupDraw(false, states);
@@ -366,24 +418,19 @@ void RenderTarget::draw(const VertexBuffer& vertexBuffer, std::size_t firstVerte
         // Bind vertex buffer
         VertexBuffer::bind(&vertexBuffer);
 
-        // Always enable texture coordinates
-        if (!m_cache.enable || !m_cache.texCoordsArrayEnabled)
-            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
-
-        glCheck(glVertexPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(0)));
-        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), reinterpret_cast<const void*>(8)));
-        glCheck(glTexCoordPointer(2, GL_FLOAT, sizeof(Vertex), reinterpret_cast<const void*>(12)));
+        // The attribute pointers are offsets in the bound buffer, from the buffer holding the last vertices
+        if (setupVertexLayout(vertexBuffer.getCurrentOffset(), vertexBuffer.getLayout(), states))
+        {
+            drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+            vertexBuffer.markDrawn();
+        }
 
-        drawPrimitives(vertexBuffer.getPrimitiveType(), firstVertex, vertexCount);
+        cleanupVertexLayout(vertexBuffer.getLayout(), states);
 
         // Unbind vertex buffer
         VertexBuffer::bind(nullptr);
 
         cleanupDraw(states);
-
-        // Update the cache
-        m_cache.useVertexCache = false;
-        m_cache.texCoordsArrayEnabled = true;
     }
 }
 
@@ -484,6 +531,9 @@ void RenderTarget::popGLStates()
             glCheck(glPopClientAttrib());
             glCheck(glPopAttrib());
         #endif
+
+        // The states are back to the ones of the OpenGL code
+        priv::invalidateGLStates();
     }
 }
 
@@ -509,11 +559,14 @@ void RenderTarget::resetGLStates()
         // Make sure that extensions are initialized
         priv::ensureExtensionsInit();
 
+        // The states may have been changed by OpenGL code, forget what we know about them
+        priv::invalidateGLStates();
+
         // Make sure that the texture unit which is active is the number 0
         if (GLEXT_multitexture)
         {
             glCheck(GLEXT_glClientActiveTexture(GLEXT_GL_TEXTURE0));
-            glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+            priv::setActiveTextureUnit(0);
         }
 
         // Define the default OpenGL states
@@ -592,6 +645,13 @@ void RenderTarget::applyBlendMode(const BlendMode& mode)
     using RenderTargetImpl::factorToGlConstant;
     using RenderTargetImpl::equationToGlConstant;
 
+    // Skip the calls if the context already uses this blend mode, for example after drawing to another target
+    if (!priv::updateBlendMode(mode))
+    {
+        m_cache.lastBlendMode = mode;
+        return;
+    }
+
     // Apply the blend mode, falling back to the non-separate versions if necessary
     if (GLEXT_blend_func_separate)
     {
@@ -729,6 +789,116 @@ void RenderTarget::setupDraw(bool useVertexCache, const RenderStates& states)
 }
 
 
+////////////////////////////////////////////////////////////
+bool RenderTarget::setupVertexLayout(std::uintptr_t base, const VertexLayout& layout, const RenderStates& states)
+{
+    using RenderTargetImpl::typeToGlConstant;
+    using RenderTargetImpl::getAttributePointer;
+
+    const VertexLayout::Attribute&                position  = layout.getPosition();
+    const std::optional<VertexLayout::Attribute>& color     = layout.getColor();
+    const std::optional<VertexLayout::Attribute>& texCoords = layout.getTexCoords();
+    const auto stride = static_cast<GLsizei>(layout.getStride());
+
+    // The fixed pipeline only reads half floats since OpenGL 3.0
+    bool halfFloat = (position.type == VertexLayout::HalfFloat) || (texCoords && (texCoords->type == VertexLayout::HalfFloat));
+    if (halfFloat && !GLEXT_half_float_vertex)
+    {
+        static bool warned = false;
+
+        if (!warned)
+        {
+            err() << "Half float vertex positions and texture coordinates need OpenGL 3.0 or later, drawing skipped" << std::endl;
+
+            warned = true;
+        }
+
+        // The vertex arrays don't match any vertex anymore
+        m_cache.useVertexCache = false;
+        return false;
+    }
+
+    glCheck(glVertexPointer(2, typeToGlConstant(position.type), stride, getAttributePointer(base, position)));
+
+    // Vertices without color are white
+    if (color)
+    {
+        glCheck(glColorPointer(4, GL_UNSIGNED_BYTE, stride, getAttributePointer(base, *color)));
+    }
+    else
+    {
+        glCheck(glDisableClientState(GL_COLOR_ARRAY));
+        glCheck(glColor4f(1.f, 1.f, 1.f, 1.f));
+    }
+
+    // Check if texture coordinates array is needed, and update client state accordingly
+    bool enableTexCoordsArray = texCoords && (states.texture || states.shader);
+    if (!m_cache.enable || (enableTexCoordsArray != m_cache.texCoordsArrayEnabled))
+    {
+        if (enableTexCoordsArray)
+            glCheck(glEnableClientState(GL_TEXTURE_COORD_ARRAY));
+        else
+            glCheck(glDisableClientState(GL_TEXTURE_COORD_ARRAY));
+    }
+
+    if (enableTexCoordsArray)
+        glCheck(glTexCoordPointer(2, typeToGlConstant(texCoords->type), stride, getAttributePointer(base, *texCoords)));
+
+#ifndef SFML_OPENGL_ES
+
+    // Pass the custom attributes to the vertex shader
+    if (states.shader)
+    {
+        for (const VertexLayout::Attribute& attribute : layout.getAttributes())
+        {
+            int location = states.shader->getAttributeLocation(attribute.name);
+            if (location < 0)
+                continue;
+
+            const auto index = static_cast<GLuint>(location);
+            glCheck(GLEXT_glEnableVertexAttribArray(index));
+            glCheck(GLEXT_glVertexAttribPointer(index, static_cast<GLint>(attribute.size), typeToGlConstant(attribute.type),
+                                                attribute.normalized ? GL_TRUE : GL_FALSE, stride, getAttributePointer(base, attribute)));
+        }
+    }
+
+#endif
+
+    // Update the cache
+    m_cache.useVertexCache = false;
+    m_cache.texCoordsArrayEnabled = enableTexCoordsArray;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void RenderTarget::cleanupVertexLayout(const VertexLayout& layout, const RenderStates& states)
+{
+    // Draws of sf::Vertex expect the color array to be enabled
+    if (!layout.getColor())
+        glCheck(glEnableClientState(GL_COLOR_ARRAY));
+
+#ifndef SFML_OPENGL_ES
+
+    if (states.shader)
+    {
+        for (const VertexLayout::Attribute& attribute : layout.getAttributes())
+        {
+            int location = states.shader->getAttributeLocation(attribute.name);
+            if (location >= 0)
+                glCheck(GLEXT_glDisableVertexAttribArray(static_cast<GLuint>(location)));
+        }
+    }
+
+#else
+
+    (void) states;
+
+#endif
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTarget::drawPrimitives(PrimitiveType type, std::size_t firstVertex, std::size_t vertexCount)
 {
@@ -29,6 +29,7 @@
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
 #include <SFML/Graphics/RenderTextureImplDefault.hpp>
 #include <SFML/System/Err.hpp>
+#include <cassert>
 #include <memory>
 #include <ostream>
 
@@ -46,16 +47,47 @@ RenderTexture::~RenderTexture() = default;
 ////////////////////////////////////////////////////////////
 bool RenderTexture::create(unsigned int width, unsigned int height, const ContextSettings& settings)
 {
-    // Set texture to be in sRGB scale if requested
-    m_texture.setSrgb(settings.sRgbCapable);
+    return create(width, height, {RGBA8}, settings);
+}
+
 
-    // Create the texture
-    if (!m_texture.create(width, height))
+////////////////////////////////////////////////////////////
+bool RenderTexture::create(unsigned int width, unsigned int height, std::initializer_list<PixelFormat> formats, const ContextSettings& settings)
+{
+    const unsigned int maximumCount = getMaximumTextureCount();
+    if ((formats.size() == 0) || (formats.size() > maximumCount))
     {
-        err() << "Impossible to create render texture (failed to create the target texture)" << std::endl;
+        err() << "Impossible to create render texture (" << formats.size() << " target textures requested, "
+              << "from 1 to " << maximumCount << " are supported)" << std::endl;
         return false;
     }
 
+    // Keep the existing texture instances, so that references to them stay valid
+    m_extraTextures.resize(formats.size() - 1);
+    for (auto& texture : m_extraTextures)
+    {
+        if (!texture)
+            texture = std::make_unique<Texture>();
+    }
+
+    std::vector<unsigned int> textureIds;
+    for (PixelFormat format : formats)
+    {
+        Texture& texture = getTargetTexture(textureIds.size());
+
+        // Set texture to be in sRGB scale if requested
+        texture.setSrgb(settings.sRgbCapable);
+
+        // Create the texture
+        if (!texture.create(width, height, format))
+        {
+            err() << "Impossible to create render texture (failed to create the target texture)" << std::endl;
+            return false;
+        }
+
+        textureIds.push_back(texture.m_texture);
+    }
+
     // We disable smoothing by default for render textures
     setSmooth(false);
 
@@ -65,8 +97,9 @@ bool RenderTexture::create(unsigned int width, unsigned int height, const Contex
         // Use frame-buffer object (FBO)
         m_impl = std::make_unique<priv::RenderTextureImplFBO>();
 
-        // Mark the texture as being a framebuffer object attachment
-        m_texture.m_fboAttachment = true;
+        // Mark the textures as being framebuffer object attachments
+        for (std::size_t i = 0; i < formats.size(); ++i)
+            getTargetTexture(i).m_fboAttachment = true;
     }
     else
     {
@@ -75,7 +108,7 @@ bool RenderTexture::create(unsigned int width, unsigned int height, const Contex
     }
 
     // Initialize the render texture
-    if (!m_impl->create(width, height, m_texture.m_texture, settings))
+    if (!m_impl->create(width, height, textureIds, settings))
         return false;
 
     // We can now initialize the render target part
@@ -99,10 +132,28 @@ unsigned int RenderTexture::getMaximumAntialiasingLevel()
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int RenderTexture::getMaximumTextureCount()
+{
+    if (priv::RenderTextureImplFBO::isAvailable())
+    {
+        return priv::RenderTextureImplFBO::getMaximumColorAttachments();
+    }
+    else
+    {
+        // The default implementation copies a single color buffer
+        return 1;
+    }
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTexture::setSmooth(bool smooth)
 {
     m_texture.setSmooth(smooth);
+
+    for (auto& texture : m_extraTextures)
+        texture->setSmooth(smooth);
 }
 
 
@@ -117,6 +168,9 @@ bool RenderTexture::isSmooth() const
 void RenderTexture::setRepeated(bool repeated)
 {
     m_texture.setRepeated(repeated);
+
+    for (auto& texture : m_extraTextures)
+        texture->setRepeated(repeated);
 }
 
 
@@ -130,7 +184,12 @@ bool RenderTexture::isRepeated() const
 ////////////////////////////////////////////////////////////
 bool RenderTexture::generateMipmap()
 {
-    return m_texture.generateMipmap();
+    bool success = m_texture.generateMipmap();
+
+    for (auto& texture : m_extraTextures)
+        success = texture->generateMipmap() && success;
+
+    return success;
 }
 
 
@@ -152,8 +211,13 @@ void RenderTexture::display()
     if (m_impl && (priv::RenderTextureImplFBO::isAvailable() || setActive(true)))
     {
         m_impl->updateTexture(m_texture.m_texture);
-        m_texture.m_pixelsFlipped = true;
-        m_texture.invalidateMipmap();
+
+        for (std::size_t i = 0; i < getTextureCount(); ++i)
+        {
+            Texture& texture = getTargetTexture(i);
+            texture.m_pixelsFlipped = true;
+            texture.invalidateMipmap();
+        }
     }
 }
 
@@ -178,4 +242,26 @@ const Texture& RenderTexture::getTexture() const
     return m_texture;
 }
 
+
+////////////////////////////////////////////////////////////
+const Texture& RenderTexture::getTexture(std::size_t index) const
+{
+    assert(index < getTextureCount());
+    return (index == 0) ? m_texture : *m_extraTextures[index - 1];
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t RenderTexture::getTextureCount() const
+{
+    return m_extraTextures.size() + 1;
+}
+
+
+////////////////////////////////////////////////////////////
+Texture& RenderTexture::getTargetTexture(std::size_t index)
+{
+    return (index == 0) ? m_texture : *m_extraTextures[index - 1];
+}
+
 } // namespace sf
@@ -28,6 +28,7 @@
 ////////////////////////////////////////////////////////////
 // Headers
 ////////////////////////////////////////////////////////////
+#include <vector>
 
 
 namespace sf
@@ -74,13 +75,13 @@ public:
     ///
     /// \param width      Width of the texture to render to
     /// \param height     Height of the texture to render to
-    /// \param textureId  OpenGL identifier of the target texture
+    /// \param textureIds OpenGL identifiers of the target textures, one per color attachment
     /// \param settings   Context settings to create render-texture with
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    virtual bool create(unsigned int width, unsigned int height, unsigned int textureId, const ContextSettings& settings) = 0;
+    virtual bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings) = 0;
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
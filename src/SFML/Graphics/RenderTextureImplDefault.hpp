@@ -76,13 +76,13 @@ private:
     ///
     /// \param width      Width of the texture to render to
     /// \param height     Height of the texture to render to
-    /// \param textureId  OpenGL identifier of the target texture
+    /// \param textureIds OpenGL identifiers of the target textures, one per color attachment
     /// \param settings   Context settings to create render-texture with
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    bool create(unsigned int width, unsigned int height, unsigned int textureId, const ContextSettings& settings) override;
+    bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings) override;
 
     ////////////////////////////////////////////////////////////
     /// \brief Activate or deactivate the render texture for rendering
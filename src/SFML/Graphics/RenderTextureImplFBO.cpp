@@ -29,14 +29,18 @@
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
 #include <SFML/Graphics/GLExtensions.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
+#include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/ContextSettings.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <mutex>
 #include <set>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 #include <ostream>
 
 namespace
@@ -70,6 +74,7 @@ namespace
             {
                 auto frameBuffer = static_cast<GLuint>(it->second);
                 glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+                sf::priv::invalidateFramebufferBindings();
 
                 staleFrameBuffers.erase(it++);
             }
@@ -96,6 +101,7 @@ namespace
                 {
                     GLuint frameBufferId = it->second;
                     glCheck(GLEXT_glDeleteFramebuffers(1, &frameBufferId));
+                    sf::priv::invalidateFramebufferBindings();
 
                     // Erase the entry from the RenderTextureImplFBO's map
                     frameBuffer->erase(it);
@@ -108,6 +114,20 @@ namespace
         // Destroy stale frame buffer objects
         destroyStaleFBOs();
     }
+
+    // Direct the fragment outputs to the first attachments of the bound frame buffer
+    // Frame buffers with a single attachment keep the default, which is the same
+    void setDrawBuffers(std::size_t count)
+    {
+        if (count < 2)
+            return;
+
+        std::vector<GLenum> drawBuffers(count);
+        for (std::size_t i = 0; i < count; ++i)
+            drawBuffers[i] = GLEXT_GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i);
+
+        glCheck(GLEXT_glDrawBuffers(static_cast<GLsizei>(count), drawBuffers.data()));
+    }
 }
 
 
@@ -118,11 +138,11 @@ namespace priv
 ////////////////////////////////////////////////////////////
 RenderTextureImplFBO::RenderTextureImplFBO() :
 m_depthStencilBuffer(0),
-m_colorBuffer       (0),
+m_colorBuffers      (),
 m_width             (0),
 m_height            (0),
 m_context           (),
-m_textureId         (0),
+m_textureIds        (),
 m_multisample       (false),
 m_stencil           (false),
 m_sRgb              (false)
@@ -149,11 +169,11 @@ RenderTextureImplFBO::~RenderTextureImplFBO()
     frameBuffers.erase(&m_frameBuffers);
     frameBuffers.erase(&m_multisampleFrameBuffers);
 
-    // Destroy the color buffer
-    if (m_colorBuffer)
+    // Destroy the color buffers
+    for (unsigned int colorBuffer : m_colorBuffers)
     {
-        GLuint colorBuffer = m_colorBuffer;
-        glCheck(GLEXT_glDeleteRenderbuffers(1, &colorBuffer));
+        GLuint buffer = colorBuffer;
+        glCheck(GLEXT_glDeleteRenderbuffers(1, &buffer));
     }
 
     // Destroy the depth/stencil buffer
@@ -204,15 +224,35 @@ unsigned int RenderTextureImplFBO::getMaximumAntialiasingLevel()
 }
 
 
+////////////////////////////////////////////////////////////
+unsigned int RenderTextureImplFBO::getMaximumColorAttachments()
+{
+    TransientContextLock lock;
+
+    // Make sure that extensions are initialized
+    priv::ensureExtensionsInit();
+
+    if (!GLEXT_framebuffer_object || !GLEXT_draw_buffers)
+        return 1;
+
+    GLint drawBuffers = 0;
+    GLint colorAttachments = 0;
+    glCheck(glGetIntegerv(GLEXT_GL_MAX_DRAW_BUFFERS, &drawBuffers));
+    glCheck(glGetIntegerv(GLEXT_GL_MAX_COLOR_ATTACHMENTS, &colorAttachments));
+
+    return static_cast<unsigned int>(std::max(std::min(drawBuffers, colorAttachments), 1));
+}
+
+
 ////////////////////////////////////////////////////////////
 void RenderTextureImplFBO::unbind()
 {
-    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+    priv::bindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0);
 }
 
 
 ////////////////////////////////////////////////////////////
-bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsigned int textureId, const ContextSettings& settings)
+bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings)
 {
     // Store the dimensions
     m_width = width;
@@ -230,6 +270,12 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
         if (settings.stencilBits && !GLEXT_packed_depth_stencil)
             return false;
 
+        if ((textureIds.size() > 1) && !GLEXT_draw_buffers)
+        {
+            err() << "Impossible to create render texture (rendering to multiple textures is not supported)" << std::endl;
+            return false;
+        }
+
         m_sRgb = settings.sRgbCapable && GLEXT_texture_sRGB;
 
 #ifndef SFML_OPENGL_ES
@@ -299,17 +345,27 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
 
 #ifndef SFML_OPENGL_ES
 
-            // Create the multisample color buffer
-            GLuint color = 0;
-            glCheck(GLEXT_glGenRenderbuffers(1, &color));
-            m_colorBuffer = color;
-            if (!m_colorBuffer)
+            // Create the multisample color buffers, with the same format as the textures they are resolved to
+            for (unsigned int textureId : textureIds)
             {
-                err() << "Impossible to create render texture (failed to create the attached multisample color buffer)" << std::endl;
-                return false;
+                GLint internalFormat = GL_RGBA;
+                {
+                    priv::TextureSaver save;
+                    priv::bindTexture(textureId);
+                    glCheck(glGetTexLevelParameteriv(GL_TEXTURE_2D, 0, GL_TEXTURE_INTERNAL_FORMAT, &internalFormat));
+                }
+
+                GLuint color = 0;
+                glCheck(GLEXT_glGenRenderbuffers(1, &color));
+                if (!color)
+                {
+                    err() << "Impossible to create render texture (failed to create the attached multisample color buffer)" << std::endl;
+                    return false;
+                }
+                m_colorBuffers.push_back(color);
+                glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, color));
+                glCheck(GLEXT_glRenderbufferStorageMultisample(GLEXT_GL_RENDERBUFFER, static_cast<GLsizei>(settings.antialiasingLevel), static_cast<GLenum>(internalFormat), static_cast<GLsizei>(width), static_cast<GLsizei>(height)));
             }
-            glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_colorBuffer));
-            glCheck(GLEXT_glRenderbufferStorageMultisample(GLEXT_GL_RENDERBUFFER, static_cast<GLsizei>(settings.antialiasingLevel), m_sRgb ? GL_SRGB8_ALPHA8_EXT : GL_RGBA, static_cast<GLsizei>(width), static_cast<GLsizei>(height)));
 
             // Create the multisample depth/stencil buffer if requested
             if (settings.stencilBits)
@@ -353,8 +409,8 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
         }
     }
 
-    // Save our texture ID in order to be able to attach it to an FBO at any time
-    m_textureId = textureId;
+    // Save our texture IDs in order to be able to attach them to an FBO at any time
+    m_textureIds = textureIds;
 
     // We can't create an FBO now if there is no active context
     if (!Context::getActiveContextId())
@@ -363,17 +419,14 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
 #ifndef SFML_OPENGL_ES
 
     // Save the current bindings so we can restore them after we are done
-    GLint readFramebuffer = 0;
-    GLint drawFramebuffer = 0;
-
-    glCheck(glGetIntegerv(GLEXT_GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer));
-    glCheck(glGetIntegerv(GLEXT_GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer));
+    const GLuint readFramebuffer = priv::getFramebufferBinding(GLEXT_GL_READ_FRAMEBUFFER);
+    const GLuint drawFramebuffer = priv::getFramebufferBinding(GLEXT_GL_DRAW_FRAMEBUFFER);
 
     if (createFrameBuffer())
     {
         // Restore previously bound framebuffers
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, static_cast<GLuint>(readFramebuffer)));
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(drawFramebuffer)));
+        priv::bindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, readFramebuffer);
+        priv::bindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, drawFramebuffer);
 
         return true;
     }
@@ -381,14 +434,12 @@ bool RenderTextureImplFBO::create(unsigned int width, unsigned int height, unsig
 #else
 
     // Save the current binding so we can restore them after we are done
-    GLint frameBuffer = 0;
-
-    glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &frameBuffer));
+    const GLuint frameBuffer = priv::getFramebufferBinding(GLEXT_GL_FRAMEBUFFER);
 
     if (createFrameBuffer())
     {
         // Restore previously bound framebuffer
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, static_cast<GLuint>(frameBuffer)));
+        priv::bindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer);
 
         return true;
     }
@@ -411,7 +462,7 @@ bool RenderTextureImplFBO::createFrameBuffer()
         err() << "Impossible to create render texture (failed to create the frame buffer object)" << std::endl;
         return false;
     }
-    glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
+    priv::bindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer);
 
     // Link the depth/stencil renderbuffer to the frame buffer
     if (!m_multisample && m_depthStencilBuffer)
@@ -429,16 +480,20 @@ bool RenderTextureImplFBO::createFrameBuffer()
 
     }
 
-    // Link the texture to the frame buffer
-    glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_textureId, 0));
+    // Link the textures to the frame buffer
+    for (std::size_t i = 0; i < m_textureIds.size(); ++i)
+        glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i), GL_TEXTURE_2D, m_textureIds[i], 0));
+
+    setDrawBuffers(m_textureIds.size());
 
     // A final check, just to be sure...
     GLenum status;
     glCheck(status = GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
     if (status != GLEXT_GL_FRAMEBUFFER_COMPLETE)
     {
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+        priv::bindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0);
         glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+        priv::invalidateFramebufferBindings();
         err() << "Impossible to create render texture (failed to link the target texture to the frame buffer)" << std::endl;
         return false;
     }
@@ -463,11 +518,13 @@ bool RenderTextureImplFBO::createFrameBuffer()
             err() << "Impossible to create render texture (failed to create the multisample frame buffer object)" << std::endl;
             return false;
         }
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, multisampleFrameBuffer));
+        priv::bindFramebuffer(GLEXT_GL_FRAMEBUFFER, multisampleFrameBuffer);
+
+        // Link the multisample color buffers to the frame buffer
+        for (std::size_t i = 0; i < m_colorBuffers.size(); ++i)
+            glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i), GLEXT_GL_RENDERBUFFER, m_colorBuffers[i]));
 
-        // Link the multisample color buffer to the frame buffer
-        glCheck(GLEXT_glBindRenderbuffer(GLEXT_GL_RENDERBUFFER, m_colorBuffer));
-        glCheck(GLEXT_glFramebufferRenderbuffer(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GLEXT_GL_RENDERBUFFER, m_colorBuffer));
+        setDrawBuffers(m_colorBuffers.size());
 
         // Link the depth/stencil renderbuffer to the frame buffer
         if (m_depthStencilBuffer)
@@ -484,8 +541,9 @@ bool RenderTextureImplFBO::createFrameBuffer()
         glCheck(status = GLEXT_glCheckFramebufferStatus(GLEXT_GL_FRAMEBUFFER));
         if (status != GLEXT_GL_FRAMEBUFFER_COMPLETE)
         {
-            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+            priv::bindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0);
             glCheck(GLEXT_glDeleteFramebuffers(1, &multisampleFrameBuffer));
+            priv::invalidateFramebufferBindings();
             err() << "Impossible to create render texture (failed to link the render buffers to the multisample frame buffer)" << std::endl;
             return false;
         }
@@ -510,7 +568,7 @@ bool RenderTextureImplFBO::activate(bool active)
     // Unbind the FBO if requested
     if (!active)
     {
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0));
+        priv::bindFramebuffer(GLEXT_GL_FRAMEBUFFER, 0);
         return true;
     }
 
@@ -552,7 +610,7 @@ bool RenderTextureImplFBO::activate(bool active)
 
             if (it != m_multisampleFrameBuffers.end())
             {
-                glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, it->second));
+                priv::bindFramebuffer(GLEXT_GL_FRAMEBUFFER, it->second);
 
                 return true;
             }
@@ -563,7 +621,7 @@ bool RenderTextureImplFBO::activate(bool active)
 
             if (it != m_frameBuffers.end())
             {
-                glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, it->second));
+                priv::bindFramebuffer(GLEXT_GL_FRAMEBUFFER, it->second);
 
                 return true;
             }
@@ -604,9 +662,29 @@ void RenderTextureImplFBO::updateTexture(unsigned int)
         if ((frameBufferIt != m_frameBuffers.end()) && (multisampleIt != m_multisampleFrameBuffers.end()))
         {
             // Set up the blit target (draw framebuffer) and blit (from the read framebuffer, our multisample FBO)
-            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, frameBufferIt->second));
-            glCheck(GLEXT_glBlitFramebuffer(0, 0, static_cast<GLint>(m_width), static_cast<GLint>(m_height), 0, 0, static_cast<GLint>(m_width), static_cast<GLint>(m_height), GL_COLOR_BUFFER_BIT, GL_NEAREST));
-            glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, multisampleIt->second));
+            priv::bindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, frameBufferIt->second);
+
+            if (m_colorBuffers.size() < 2)
+            {
+                glCheck(GLEXT_glBlitFramebuffer(0, 0, static_cast<GLint>(m_width), static_cast<GLint>(m_height), 0, 0, static_cast<GLint>(m_width), static_cast<GLint>(m_height), GL_COLOR_BUFFER_BIT, GL_NEAREST));
+            }
+            else
+            {
+                // A blit copies the read buffer to all the draw buffers, so resolve the attachments one at a time
+                for (std::size_t i = 0; i < m_colorBuffers.size(); ++i)
+                {
+                    const auto attachment = GLEXT_GL_COLOR_ATTACHMENT0 + static_cast<GLenum>(i);
+                    glCheck(glReadBuffer(attachment));
+                    glCheck(glDrawBuffer(attachment));
+                    glCheck(GLEXT_glBlitFramebuffer(0, 0, static_cast<GLint>(m_width), static_cast<GLint>(m_height), 0, 0, static_cast<GLint>(m_width), static_cast<GLint>(m_height), GL_COLOR_BUFFER_BIT, GL_NEAREST));
+                }
+
+                // Restore the attachments the FBOs read from and draw to
+                glCheck(glReadBuffer(GLEXT_GL_COLOR_ATTACHMENT0));
+                setDrawBuffers(m_colorBuffers.size());
+            }
+
+            priv::bindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, multisampleIt->second);
         }
     }
 
@@ -32,6 +32,7 @@
 #include <SFML/Window/GlResource.hpp>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 
 namespace sf
@@ -78,6 +79,14 @@ public:
     ////////////////////////////////////////////////////////////
     static unsigned int getMaximumAntialiasingLevel();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the maximum number of color attachments supported by the system
+    ///
+    /// \return The maximum number of textures that can be rendered to at once
+    ///
+    ////////////////////////////////////////////////////////////
+    static unsigned int getMaximumColorAttachments();
+
     ////////////////////////////////////////////////////////////
     /// \brief Unbind the currently bound FBO
     ///
@@ -91,13 +100,13 @@ private:
     ///
     /// \param width      Width of the texture to render to
     /// \param height     Height of the texture to render to
-    /// \param textureId  OpenGL identifier of the target texture
+    /// \param textureIds OpenGL identifiers of the target textures, one per color attachment
     /// \param settings   Context settings to create render-texture with
     ///
     /// \return True if creation has been successful
     ///
     ////////////////////////////////////////////////////////////
-    bool create(unsigned int width, unsigned int height, unsigned int textureId, const ContextSettings& settings) override;
+    bool create(unsigned int width, unsigned int height, const std::vector<unsigned int>& textureIds, const ContextSettings& settings) override;
 
     ////////////////////////////////////////////////////////////
     /// \brief Create an FBO in the current context
@@ -142,11 +151,11 @@ private:
     std::unordered_map<Uint64, unsigned int> m_frameBuffers;            //!< OpenGL frame buffer objects per context
     std::unordered_map<Uint64, unsigned int> m_multisampleFrameBuffers; //!< Optional per-context OpenGL frame buffer objects with multisample attachments
     unsigned int                             m_depthStencilBuffer;      //!< Optional depth/stencil buffer attached to the frame buffer
-    unsigned int                             m_colorBuffer;             //!< Optional multisample color buffer attached to the frame buffer
+    std::vector<unsigned int>                m_colorBuffers;            //!< Optional multisample color buffers attached to the frame buffer, one per texture
     unsigned int                             m_width;                   //!< Width of the attachments
     unsigned int                             m_height;                  //!< Height of the attachments
     std::unique_ptr<Context>                 m_context;                 //!< Backup OpenGL context, used when none already exist
-    unsigned int                             m_textureId;               //!< The ID of the texture to attach to the FBO
+    std::vector<unsigned int>                m_textureIds;              //!< The IDs of the textures to attach to the FBO, in the order of the color attachments
     bool                                     m_multisample;             //!< Whether we have to create a multisample frame buffer as well
     bool                                     m_stencil;                 //!< Whether we have stencil attachment
     bool                                     m_sRgb;                    //!< Whether we need to encode drawn pixels into sRGB color space
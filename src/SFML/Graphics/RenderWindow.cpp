@@ -29,6 +29,7 @@
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
 #include <SFML/Graphics/RenderTextureImplFBO.hpp>
 
 
@@ -94,7 +95,7 @@ bool RenderWindow::setActive(bool active)
     // try to draw to the default framebuffer of the RenderWindow
     if (active && result && priv::RenderTextureImplFBO::isAvailable())
     {
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_defaultFrameBuffer));
+        priv::bindFramebuffer(GLEXT_GL_FRAMEBUFFER, m_defaultFrameBuffer);
 
         return true;
     }
@@ -110,7 +111,7 @@ void RenderWindow::onCreate()
     {
         // Retrieve the framebuffer ID we have to bind when targeting the window for rendering
         // We assume that this window's context is still active at this point
-        glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, reinterpret_cast<GLint*>(&m_defaultFrameBuffer)));
+        m_defaultFrameBuffer = priv::getFramebufferBinding(GLEXT_GL_FRAMEBUFFER);
     }
 
     // Just initialize the render target part
@@ -0,0 +1,418 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SceneGraph.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <limits>
+#include <ostream>
+#include <utility>
+
+
+namespace
+{
+    // A nested named namespace is used here to allow unity builds of SFML.
+    namespace SceneGraphImpl
+    {
+        // Index of the identifiers which don't designate a node
+        constexpr std::size_t invalidIndex = std::numeric_limits<std::size_t>::max();
+
+        // Check whether two rectangles with positive sizes overlap (touching counts)
+        bool overlaps(const sf::FloatRect& left, const sf::FloatRect& right)
+        {
+            return (left.left <= right.left + right.width) && (right.left <= left.left + left.width) &&
+                   (left.top <= right.top + right.height) && (right.top <= left.top + left.height);
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+SceneGraph::SceneGraph() :
+m_nodes   (),
+m_indices (1, 0),
+m_modified(),
+m_freeIds (),
+m_needSort(false)
+{
+    m_nodes.push_back(Node{Transformable(), AffineTransform(), AffineTransform(), FloatRect(), FloatRect(),
+                           nullptr, Root, Root, 0, 1, false, false});
+}
+
+
+////////////////////////////////////////////////////////////
+SceneGraph::NodeId SceneGraph::createNode(NodeId parent)
+{
+    if (!contains(parent))
+    {
+        err() << "Failed to find the parent of the new scene graph node, it is added to the root" << std::endl;
+        parent = Root;
+    }
+
+    NodeId id = m_indices.size();
+    if (!m_freeIds.empty())
+    {
+        id = m_freeIds.back();
+        m_freeIds.pop_back();
+    }
+    else
+    {
+        m_indices.push_back(SceneGraphImpl::invalidIndex);
+    }
+
+    const std::size_t index = m_nodes.size();
+    const std::size_t parentIndex = m_indices[parent];
+
+    // A node added after the last descendant of its parent keeps the nodes in depth-first order:
+    // only the ranges of its ancestors grow. Otherwise, the order is restored later, all at once.
+    if (!m_needSort && (m_nodes[parentIndex].end == index))
+    {
+        for (std::size_t i = parentIndex; ; i = m_nodes[i].parentIndex)
+        {
+            ++m_nodes[i].end;
+
+            if (i == 0)
+                break;
+        }
+    }
+    else
+    {
+        m_needSort = true;
+    }
+
+    m_nodes.push_back(Node{Transformable(), AffineTransform(), AffineTransform(), FloatRect(), FloatRect(),
+                           nullptr, id, parent, parentIndex, index + 1, true, true});
+    m_indices[id] = index;
+    m_modified.push_back(id);
+
+    return id;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGraph::removeNode(NodeId node)
+{
+    if ((node == Root) || !contains(node))
+        return;
+
+    if (m_needSort)
+        sortNodes();
+
+    // The descendants of the node follow it in the array
+    const std::size_t first = m_indices[node];
+    const std::size_t last = m_nodes[first].end;
+
+    for (std::size_t i = first; i < last; ++i)
+    {
+        m_indices[m_nodes[i].id] = SceneGraphImpl::invalidIndex;
+        m_freeIds.push_back(m_nodes[i].id);
+    }
+
+    m_nodes.erase(m_nodes.begin() + static_cast<std::ptrdiff_t>(first), m_nodes.begin() + static_cast<std::ptrdiff_t>(last));
+
+    // Recompute the indices and ranges of the remaining nodes
+    sortNodes();
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGraph::setParent(NodeId node, NodeId parent)
+{
+    if ((node == Root) || !contains(node) || !contains(parent))
+        return;
+
+    if (m_needSort)
+        sortNodes();
+
+    // A node can't become a descendant of itself
+    const std::size_t index = m_indices[node];
+    const std::size_t parentIndex = m_indices[parent];
+    if ((parentIndex >= index) && (parentIndex < m_nodes[index].end))
+        return;
+
+    Node& data = m_nodes[index];
+    data.parent = parent;
+
+    if (!data.modified)
+    {
+        data.modified = true;
+        m_modified.push_back(node);
+    }
+
+    m_needSort = true;
+}
+
+
+////////////////////////////////////////////////////////////
+SceneGraph::NodeId SceneGraph::getParent(NodeId node) const
+{
+    return m_nodes[getIndex(node)].parent;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SceneGraph::contains(NodeId node) const
+{
+    return (node < m_indices.size()) && (m_indices[node] != SceneGraphImpl::invalidIndex);
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SceneGraph::getNodeCount() const
+{
+    return m_nodes.size();
+}
+
+
+////////////////////////////////////////////////////////////
+Transformable& SceneGraph::getTransformable(NodeId node)
+{
+    Node& data = m_nodes[getIndex(node)];
+
+    if (!data.modified)
+    {
+        data.modified = true;
+        m_modified.push_back(data.id);
+    }
+
+    return data.transformable;
+}
+
+
+////////////////////////////////////////////////////////////
+const Transformable& SceneGraph::getTransformable(NodeId node) const
+{
+    return m_nodes[getIndex(node)].transformable;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGraph::setDrawable(NodeId node, const Drawable* drawable)
+{
+    m_nodes[getIndex(node)].drawable = drawable;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGraph::setLocalBounds(NodeId node, const FloatRect& bounds)
+{
+    Node& data = m_nodes[getIndex(node)];
+    data.localBounds = bounds;
+
+    // The world bounds are recomputed with the world transform
+    if (!data.modified)
+    {
+        data.modified = true;
+        m_modified.push_back(data.id);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+const AffineTransform& SceneGraph::getWorldTransform(NodeId node) const
+{
+    update();
+
+    return m_nodes[getIndex(node)].worldTransform;
+}
+
+
+////////////////////////////////////////////////////////////
+const AffineTransform& SceneGraph::getInverseWorldTransform(NodeId node) const
+{
+    update();
+
+    Node& data = m_nodes[getIndex(node)];
+
+    if (data.inverseNeedUpdate)
+    {
+        data.inverseWorldTransform = data.worldTransform.getInverse();
+        data.inverseNeedUpdate = false;
+    }
+
+    return data.inverseWorldTransform;
+}
+
+
+////////////////////////////////////////////////////////////
+const FloatRect& SceneGraph::getWorldBounds(NodeId node) const
+{
+    update();
+
+    return m_nodes[getIndex(node)].worldBounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGraph::update() const
+{
+    if (m_needSort)
+        sortNodes();
+
+    if (m_modified.empty())
+        return;
+
+    // Turn the modified nodes into ranges of the array, in order, so that
+    // parents are always updated before their children
+    std::vector<std::size_t> first;
+    first.reserve(m_modified.size());
+    for (NodeId id : m_modified)
+    {
+        if (contains(id))
+            first.push_back(m_indices[id]);
+    }
+
+    std::sort(first.begin(), first.end());
+    m_modified.clear();
+
+    // Only the subtrees of the modified nodes are recomputed; a subtree
+    // inside another one is updated with it
+    std::size_t end = 0;
+    for (std::size_t start : first)
+    {
+        if (start < end)
+            continue;
+
+        end = m_nodes[start].end;
+
+        for (std::size_t i = start; i < end; ++i)
+        {
+            Node& node = m_nodes[i];
+
+            node.worldTransform = node.transformable.getAffineTransform();
+            if (i > 0)
+                node.worldTransform = m_nodes[node.parentIndex].worldTransform * node.worldTransform;
+
+            node.worldBounds = node.worldTransform.transformRect(node.localBounds);
+            node.inverseNeedUpdate = true;
+            node.modified = false;
+        }
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGraph::draw(RenderTarget& target, const RenderStates& states) const
+{
+    update();
+
+    // Area covered by the view of the target, in the coordinates of the graph
+    FloatRect visible = target.getView().getInverseTransform().transformRect(FloatRect({-1.f, -1.f}, {2.f, 2.f}));
+    if (states.transform != Transform::Identity)
+        visible = states.transform.getInverse().transformRect(visible);
+
+    RenderStates nodeStates(states);
+
+    for (const Node& node : m_nodes)
+    {
+        if (!node.drawable)
+            continue;
+
+        // Nodes without bounds can't be culled
+        const bool hasBounds = (node.localBounds.width != 0.f) || (node.localBounds.height != 0.f);
+        if (hasBounds && !SceneGraphImpl::overlaps(visible, node.worldBounds))
+            continue;
+
+        nodeStates.transform = states.transform * node.worldTransform;
+        target.draw(*node.drawable, nodeStates);
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SceneGraph::sortNodes() const
+{
+    // Group the children of each node by the identifier of their parent,
+    // keeping the current order of siblings
+    std::vector<std::size_t> offsets(m_indices.size() + 1, 0);
+    for (std::size_t i = 1; i < m_nodes.size(); ++i)
+        ++offsets[m_nodes[i].parent + 1];
+
+    for (std::size_t i = 1; i < offsets.size(); ++i)
+        offsets[i] += offsets[i - 1];
+
+    std::vector<std::size_t> children(m_nodes.size());
+    std::vector<std::size_t> cursors(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 1; i < m_nodes.size(); ++i)
+        children[cursors[m_nodes[i].parent]++] = i;
+
+    // Copy the nodes in depth-first order, the root first
+    std::vector<Node> sorted;
+    sorted.reserve(m_nodes.size());
+
+    std::vector<std::pair<std::size_t, std::size_t>> stack; // (current index, sorted index of the parent)
+    stack.emplace_back(0, 0);
+
+    while (!stack.empty())
+    {
+        const auto [index, parentIndex] = stack.back();
+        stack.pop_back();
+
+        const std::size_t sortedIndex = sorted.size();
+        sorted.push_back(m_nodes[index]);
+        sorted.back().parentIndex = parentIndex;
+        sorted.back().end = sortedIndex + 1;
+
+        // Push the children in reverse order, so that the first one is visited first
+        const NodeId id = m_nodes[index].id;
+        for (std::size_t i = offsets[id + 1]; i > offsets[id]; --i)
+            stack.emplace_back(children[i - 1], sortedIndex);
+    }
+
+    // Each subtree ends where the last subtree of its children ends
+    for (std::size_t i = sorted.size() - 1; i > 0; --i)
+    {
+        Node& parent = sorted[sorted[i].parentIndex];
+        parent.end = std::max(parent.end, sorted[i].end);
+    }
+
+    for (std::size_t i = 0; i < sorted.size(); ++i)
+        m_indices[sorted[i].id] = i;
+
+    m_nodes.swap(sorted);
+    m_needSort = false;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t SceneGraph::getIndex(NodeId node) const
+{
+    if (!contains(node))
+    {
+        err() << "Scene graph node " << node << " doesn't exist, using the root instead" << std::endl;
+        return 0;
+    }
+
+    return m_indices[node];
+}
+
+} // namespace sf
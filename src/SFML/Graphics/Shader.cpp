@@ -31,6 +31,7 @@
 #include <SFML/Graphics/Transform.hpp>
 #include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/System/InputStream.hpp>
 #include <SFML/System/Err.hpp>
@@ -194,9 +195,9 @@ struct Shader::UniformBinder
         if (currentProgram)
         {
             // Enable program object
-            glCheck(savedProgram = GLEXT_glGetHandle(GLEXT_GL_PROGRAM_OBJECT));
+            savedProgram = priv::getProgramBinding();
             if (currentProgram != savedProgram)
-                glCheck(GLEXT_glUseProgramObject(currentProgram));
+                priv::useProgram(currentProgram);
 
             // Store uniform location for further use outside constructor
             location = shader.getUniformLocation(name);
@@ -211,7 +212,7 @@ struct Shader::UniformBinder
     {
         // Disable program object
         if (currentProgram && (currentProgram != savedProgram))
-            glCheck(GLEXT_glUseProgramObject(savedProgram));
+            priv::useProgram(savedProgram);
     }
 
     ////////////////////////////////////////////////////////////
@@ -238,7 +239,8 @@ Shader::Shader() :
 m_shaderProgram (0),
 m_currentTexture(-1),
 m_textures      (),
-m_uniforms      ()
+m_uniforms      (),
+m_attributes    ()
 {
 }
 
@@ -250,7 +252,10 @@ Shader::~Shader()
 
     // Destroy effect program
     if (m_shaderProgram)
+    {
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+        priv::invalidateProgramBindings();
+    }
 }
 
 
@@ -697,7 +702,7 @@ void Shader::bind(const Shader* shader)
     if (shader && shader->m_shaderProgram)
     {
         // Enable the program
-        glCheck(GLEXT_glUseProgramObject(castToGlHandle(shader->m_shaderProgram)));
+        priv::useProgram(castToGlHandle(shader->m_shaderProgram));
 
         // Bind the textures
         shader->bindTextures();
@@ -709,7 +714,7 @@ void Shader::bind(const Shader* shader)
     else
     {
         // Bind no shader
-        glCheck(GLEXT_glUseProgramObject(0));
+        priv::useProgram(0);
     }
 }
 
@@ -791,6 +796,7 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
     if (m_shaderProgram)
     {
         glCheck(GLEXT_glDeleteObject(castToGlHandle(m_shaderProgram)));
+        priv::invalidateProgramBindings();
         m_shaderProgram = 0;
     }
 
@@ -798,6 +804,7 @@ bool Shader::compile(const char* vertexShaderCode, const char* geometryShaderCod
     m_currentTexture = -1;
     m_textures.clear();
     m_uniforms.clear();
+    m_attributes.clear();
 
     // Create the program
     GLEXT_GLhandle shaderProgram;
@@ -920,13 +927,13 @@ void Shader::bindTextures() const
     {
         auto index = static_cast<GLsizei>(i + 1);
         glCheck(GLEXT_glUniform1i(it->first, index));
-        glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0 + static_cast<GLenum>(index)));
+        priv::setActiveTextureUnit(static_cast<unsigned int>(index));
         Texture::bind(it->second);
         ++it;
     }
 
     // Make sure that the texture unit which is left active is the number 0
-    glCheck(GLEXT_glActiveTexture(GLEXT_GL_TEXTURE0));
+    priv::setActiveTextureUnit(0);
 }
 
 
@@ -952,6 +959,22 @@ int Shader::getUniformLocation(const std::string& name)
     }
 }
 
+
+////////////////////////////////////////////////////////////
+int Shader::getAttributeLocation(const std::string& name) const
+{
+    // Check the cache
+    if (auto it = m_attributes.find(name); it != m_attributes.end())
+        return it->second;
+
+    // Not in cache, request the location from OpenGL
+    int location = -1;
+    glCheck(location = GLEXT_glGetAttribLocation(castToGlHandle(m_shaderProgram), name.c_str()));
+    m_attributes.emplace(name, location);
+
+    return location;
+}
+
 } // namespace sf
 
 #else // SFML_OPENGL_ES
@@ -1180,6 +1203,13 @@ unsigned int Shader::getNativeHandle() const
 }
 
 
+////////////////////////////////////////////////////////////
+int Shader::getAttributeLocation(const std::string& /* name */) const
+{
+    return -1;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Shader::bind(const Shader* /* shader */)
 {
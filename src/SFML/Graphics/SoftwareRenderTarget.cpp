@@ -0,0 +1,1224 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/SoftwareRenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VertexLayout.hpp>
+#include <SFML/System/Err.hpp>
+#include <SFML/System/ThreadPool.hpp>
+// The results must not depend on the instruction set: the vector paths only use
+// operations which are exact IEEE operations on each lane, like the scalar path
+// (this file is compiled without floating point contraction, see CMakeLists.txt)
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+    #include <emmintrin.h>
+    #define SFML_SOFTWARE_USE_SSE2
+#elif defined(__aarch64__) || defined(_M_ARM64)
+    #include <arm_neon.h>
+    #define SFML_SOFTWARE_USE_NEON
+#endif
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <deque>
+#include <limits>
+#include <map>
+#include <optional>
+#include <ostream>
+
+
+namespace
+{
+    // A nested named namespace is used here to allow unity builds of SFML.
+    namespace SoftwareRenderTargetImpl
+    {
+        // Largest supported size of a target
+        constexpr unsigned int maximumSize = 16384;
+
+        // Vertices are snapped to 1/256th of pixel; their coordinates are clipped
+        // to this range, in pixels, so that the edge equations fit in 64 bits
+        constexpr float guardBand = 65536.f;
+        constexpr int   subPixelBits = 8;
+        constexpr sf::Int64 subPixels = 1 << subPixelBits;
+
+        // Primitives are binned into square tiles of this size, in pixels, which are rendered in parallel
+        constexpr int tileSize = 64;
+
+        // Number of queued primitives after which they are rendered, to bound the memory used
+        constexpr std::size_t maxQueuedPrimitives = 65536;
+
+        // Conversion of 8-bit components to floats in [0, 1]
+        const std::array<float, 256>& getNormalizedTable()
+        {
+            static const std::array<float, 256> table = []
+            {
+                std::array<float, 256> values{};
+                for (std::size_t i = 0; i < values.size(); ++i)
+                    values[i] = static_cast<float>(i) / 255.f;
+                return values;
+            }();
+
+            return table;
+        }
+
+        // The four components of a pixel, processed together
+#if defined(SFML_SOFTWARE_USE_SSE2)
+        struct Vec4
+        {
+            __m128 v;
+        };
+
+        Vec4 splat(float x)                  { return {_mm_set1_ps(x)}; }
+        Vec4 load(const float* values)       { return {_mm_loadu_ps(values)}; }
+        Vec4 operator+(Vec4 left, Vec4 right) { return {_mm_add_ps(left.v, right.v)}; }
+        Vec4 operator-(Vec4 left, Vec4 right) { return {_mm_sub_ps(left.v, right.v)}; }
+        Vec4 operator*(Vec4 left, Vec4 right) { return {_mm_mul_ps(left.v, right.v)}; }
+        Vec4 minimum(Vec4 left, Vec4 right)  { return {_mm_min_ps(left.v, right.v)}; } // left < right ? left : right
+        Vec4 maximum(Vec4 left, Vec4 right)  { return {_mm_max_ps(left.v, right.v)}; } // left > right ? left : right
+        Vec4 alpha(Vec4 value)               { return {_mm_shuffle_ps(value.v, value.v, _MM_SHUFFLE(3, 3, 3, 3))}; }
+
+        Vec4 withAlpha(Vec4 color, Vec4 alpha)
+        {
+            const __m128 mask = _mm_castsi128_ps(_mm_setr_epi32(0, 0, 0, -1));
+            return {_mm_or_ps(_mm_andnot_ps(mask, color.v), _mm_and_ps(mask, alpha.v))};
+        }
+
+        // Same values as getNormalizedTable: the conversion and the division are exact IEEE operations
+        Vec4 loadPixel(const sf::Uint8* pixel)
+        {
+            sf::Uint32 packed;
+            std::memcpy(&packed, pixel, 4);
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i integers = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(static_cast<int>(packed)), zero), zero);
+            return {_mm_div_ps(_mm_cvtepi32_ps(integers), _mm_set1_ps(255.f))};
+        }
+
+        // The value must be in [0, 1]
+        void storePixel(Vec4 value, sf::Uint8* pixel)
+        {
+            __m128i integers = _mm_cvttps_epi32(_mm_add_ps(_mm_mul_ps(value.v, _mm_set1_ps(255.f)), _mm_set1_ps(0.5f)));
+            integers = _mm_packs_epi32(integers, integers);
+            integers = _mm_packus_epi16(integers, integers);
+            auto packed = static_cast<sf::Uint32>(_mm_cvtsi128_si32(integers));
+            std::memcpy(pixel, &packed, 4);
+        }
+#elif defined(SFML_SOFTWARE_USE_NEON)
+        struct Vec4
+        {
+            float32x4_t v;
+        };
+
+        Vec4 splat(float x)                  { return {vdupq_n_f32(x)}; }
+        Vec4 load(const float* values)       { return {vld1q_f32(values)}; }
+        Vec4 operator+(Vec4 left, Vec4 right) { return {vaddq_f32(left.v, right.v)}; }
+        Vec4 operator-(Vec4 left, Vec4 right) { return {vsubq_f32(left.v, right.v)}; }
+        Vec4 operator*(Vec4 left, Vec4 right) { return {vmulq_f32(left.v, right.v)}; }
+        Vec4 minimum(Vec4 left, Vec4 right)  { return {vbslq_f32(vcltq_f32(left.v, right.v), left.v, right.v)}; }
+        Vec4 maximum(Vec4 left, Vec4 right)  { return {vbslq_f32(vcgtq_f32(left.v, right.v), left.v, right.v)}; }
+        Vec4 alpha(Vec4 value)               { return {vdupq_laneq_f32(value.v, 3)}; }
+        Vec4 withAlpha(Vec4 color, Vec4 alpha) { return {vcopyq_laneq_f32(color.v, 3, alpha.v, 3)}; }
+
+        // Same values as getNormalizedTable: the conversion and the division are exact IEEE operations
+        Vec4 loadPixel(const sf::Uint8* pixel)
+        {
+            sf::Uint32 packed;
+            std::memcpy(&packed, pixel, 4);
+            const uint32x4_t integers = vmovl_u16(vget_low_u16(vmovl_u8(vreinterpret_u8_u32(vdup_n_u32(packed)))));
+            return {vdivq_f32(vcvtq_f32_u32(integers), vdupq_n_f32(255.f))};
+        }
+
+        // The value must be in [0, 1]
+        void storePixel(Vec4 value, sf::Uint8* pixel)
+        {
+            uint32x4_t integers = vcvtq_u32_f32(vaddq_f32(vmulq_f32(value.v, vdupq_n_f32(255.f)), vdupq_n_f32(0.5f)));
+            uint16x4_t shorts   = vmovn_u32(integers);
+            uint8x8_t  bytes    = vmovn_u16(vcombine_u16(shorts, shorts));
+            sf::Uint32 packed   = vget_lane_u32(vreinterpret_u32_u8(bytes), 0);
+            std::memcpy(pixel, &packed, 4);
+        }
+#else
+        struct Vec4
+        {
+            float v[4];
+        };
+
+        template <typename F>
+        Vec4 apply(Vec4 left, Vec4 right, F function)
+        {
+            Vec4 result;
+            for (std::size_t i = 0; i < 4; ++i)
+                result.v[i] = function(left.v[i], right.v[i]);
+            return result;
+        }
+
+        Vec4 splat(float x)                  { return {{x, x, x, x}}; }
+        Vec4 load(const float* values)       { return {{values[0], values[1], values[2], values[3]}}; }
+        Vec4 operator+(Vec4 left, Vec4 right) { return apply(left, right, [](float a, float b) { return a + b; }); }
+        Vec4 operator-(Vec4 left, Vec4 right) { return apply(left, right, [](float a, float b) { return a - b; }); }
+        Vec4 operator*(Vec4 left, Vec4 right) { return apply(left, right, [](float a, float b) { return a * b; }); }
+        Vec4 minimum(Vec4 left, Vec4 right)  { return apply(left, right, [](float a, float b) { return a < b ? a : b; }); }
+        Vec4 maximum(Vec4 left, Vec4 right)  { return apply(left, right, [](float a, float b) { return a > b ? a : b; }); }
+        Vec4 alpha(Vec4 value)               { return splat(value.v[3]); }
+        Vec4 withAlpha(Vec4 color, Vec4 alpha) { return {{color.v[0], color.v[1], color.v[2], alpha.v[3]}}; }
+
+        Vec4 loadPixel(const sf::Uint8* pixel)
+        {
+            const std::array<float, 256>& table = getNormalizedTable();
+            return {{table[pixel[0]], table[pixel[1]], table[pixel[2]], table[pixel[3]]}};
+        }
+
+        // The value must be in [0, 1]
+        void storePixel(Vec4 value, sf::Uint8* pixel)
+        {
+            for (std::size_t i = 0; i < 4; ++i)
+                pixel[i] = static_cast<sf::Uint8>(static_cast<int>(value.v[i] * 255.f + 0.5f));
+        }
+#endif
+
+        Vec4 clamp01(Vec4 value)
+        {
+            // NaNs end up as 0: maximum returns its second argument when the comparison fails
+            return minimum(maximum(value, splat(0.f)), splat(1.f));
+        }
+
+        Vec4 lerp(Vec4 from, Vec4 to, Vec4 weight)
+        {
+            return from + (to - from) * weight;
+        }
+
+        // Floor division and its ceiling counterpart, for positive divisors
+        sf::Int64 floorDiv(sf::Int64 numerator, sf::Int64 divisor)
+        {
+            sf::Int64 quotient = numerator / divisor;
+            return (numerator % divisor < 0) ? quotient - 1 : quotient;
+        }
+
+        sf::Int64 ceilDiv(sf::Int64 numerator, sf::Int64 divisor)
+        {
+            return -floorDiv(-numerator, divisor);
+        }
+
+        // Round a float down to an integer coordinate, without overflowing (NaNs give 0)
+        int toCoordinate(float value)
+        {
+            constexpr float limit = 1073741824.f;
+            if (!(value > -limit))
+                return (value <= -limit) ? -static_cast<int>(limit) : 0;
+            if (!(value < limit))
+                return static_cast<int>(limit);
+
+            const auto truncated = static_cast<int>(value);
+            return (static_cast<float>(truncated) > value) ? truncated - 1 : truncated;
+        }
+
+        // Texture sampled by a primitive
+        struct Sampler
+        {
+            const sf::Uint8* pixels;   //!< Texels (RGBA)
+            int              width;    //!< Width of the texture, in pixels
+            int              height;   //!< Height of the texture, in pixels
+            bool             smooth;   //!< Use bilinear filtering?
+            bool             repeated; //!< Wrap the coordinates instead of clamping them?
+        };
+
+        int wrap(int coordinate, int size, bool repeated)
+        {
+            if (!repeated)
+                return std::clamp(coordinate, 0, size - 1);
+
+            coordinate %= size;
+            return (coordinate < 0) ? coordinate + size : coordinate;
+        }
+
+        Vec4 fetch(const Sampler& sampler, int x, int y)
+        {
+            x = wrap(x, sampler.width, sampler.repeated);
+            y = wrap(y, sampler.height, sampler.repeated);
+            return loadPixel(sampler.pixels + (static_cast<std::size_t>(y) * static_cast<std::size_t>(sampler.width) + static_cast<std::size_t>(x)) * 4);
+        }
+
+        // Texture coordinates are in pixels, like the ones of sf::Texture::Pixels
+        Vec4 sample(const Sampler& sampler, float u, float v)
+        {
+            if (!sampler.smooth)
+                return fetch(sampler, toCoordinate(u), toCoordinate(v));
+
+            // Bilinear filtering between the 4 texels whose centers surround the point
+            const float x = u - 0.5f;
+            const float y = v - 0.5f;
+            const float left = std::floor(x);
+            const float top = std::floor(y);
+            const int   x0 = toCoordinate(left);
+            const int   y0 = toCoordinate(top);
+            const Vec4  weightX = splat(x - left);
+            const Vec4  weightY = splat(y - top);
+
+            const Vec4 upper = lerp(fetch(sampler, x0, y0), fetch(sampler, x0 + 1, y0), weightX);
+            const Vec4 lower = lerp(fetch(sampler, x0, y0 + 1), fetch(sampler, x0 + 1, y0 + 1), weightX);
+            return lerp(upper, lower, weightY);
+        }
+
+        Vec4 getFactor(sf::BlendMode::Factor factor, Vec4 source, Vec4 destination)
+        {
+            switch (factor)
+            {
+                case sf::BlendMode::Zero:             return splat(0.f);
+                case sf::BlendMode::One:              return splat(1.f);
+                case sf::BlendMode::SrcColor:         return source;
+                case sf::BlendMode::OneMinusSrcColor: return splat(1.f) - source;
+                case sf::BlendMode::DstColor:         return destination;
+                case sf::BlendMode::OneMinusDstColor: return splat(1.f) - destination;
+                case sf::BlendMode::SrcAlpha:         return alpha(source);
+                case sf::BlendMode::OneMinusSrcAlpha: return splat(1.f) - alpha(source);
+                case sf::BlendMode::DstAlpha:         return alpha(destination);
+                case sf::BlendMode::OneMinusDstAlpha: return splat(1.f) - alpha(destination);
+            }
+
+            return splat(0.f);
+        }
+
+        Vec4 applyEquation(sf::BlendMode::Equation equation, sf::BlendMode::Factor sourceFactor,
+                           sf::BlendMode::Factor destinationFactor, Vec4 source, Vec4 destination)
+        {
+            // Like in OpenGL, the factors are ignored by the min and max equations
+            switch (equation)
+            {
+                case sf::BlendMode::Min: return minimum(source, destination);
+                case sf::BlendMode::Max: return maximum(source, destination);
+                default:                 break;
+            }
+
+            const Vec4 weightedSource = source * getFactor(sourceFactor, source, destination);
+            const Vec4 weightedDestination = destination * getFactor(destinationFactor, source, destination);
+
+            switch (equation)
+            {
+                case sf::BlendMode::Subtract:        return weightedSource - weightedDestination;
+                case sf::BlendMode::ReverseSubtract: return weightedDestination - weightedSource;
+                default:                             return weightedSource + weightedDestination;
+            }
+        }
+
+        Vec4 blend(const sf::BlendMode& mode, Vec4 source, Vec4 destination)
+        {
+            const Vec4 color = applyEquation(mode.colorEquation, mode.colorSrcFactor, mode.colorDstFactor, source, destination);
+
+            if ((mode.alphaEquation == mode.colorEquation) && (mode.alphaSrcFactor == mode.colorSrcFactor) && (mode.alphaDstFactor == mode.colorDstFactor))
+                return color;
+
+            return withAlpha(color, applyEquation(mode.alphaEquation, mode.alphaSrcFactor, mode.alphaDstFactor, source, destination));
+        }
+
+        // Primitive queued for rasterization, in the coordinates of the target
+        struct Primitive
+        {
+            enum Type
+            {
+                Triangle,
+                Line,
+                Point
+            };
+
+            enum Blending
+            {
+                Replace,  //!< The source overwrites the destination
+                Alpha,    //!< sf::BlendAlpha
+                Add,      //!< sf::BlendAdd
+                Multiply, //!< sf::BlendMultiply
+                Generic   //!< Any other blend mode
+            };
+
+            Type          type;
+            sf::IntRect   bounds;          //!< Pixels that may be covered, clipped to the viewport
+            sf::Int64     edges[3][3];     //!< Triangles: edge equations a * x + b * y + c >= 0, in sub-pixels, fill rule included
+            sf::Int64     ends[2][2];      //!< Lines: ends, in sub-pixels; points: pixel covered
+            float         color[3][4];     //!< Triangles: color at the origin and its x and y gradients; lines: color at the start and its difference to the end
+            float         texCoords[3][2]; //!< Texture coordinates, stored like the colors
+            Sampler       sampler;         //!< Texture, if pixels is not a null pointer
+            sf::BlendMode blendMode;       //!< Blend mode
+            Blending      blending;        //!< Implementation of the blend mode
+        };
+
+        // Shade and blend one pixel; the specialized blendings skip the factors which are
+        // 0 or 1, they give exactly the same results as the generic implementation
+        template <bool Textured, Primitive::Blending Blending>
+        void shade(const Primitive& primitive, Vec4 color, float u, float v, sf::Uint8* pixel)
+        {
+            Vec4 source = clamp01(color);
+
+            if constexpr (Textured)
+                source = source * sample(primitive.sampler, u, v);
+
+            if constexpr (Blending == Primitive::Alpha)
+            {
+                const Vec4 sourceAlpha = alpha(source);
+                source = clamp01(source * withAlpha(sourceAlpha, splat(1.f)) + loadPixel(pixel) * (splat(1.f) - sourceAlpha));
+            }
+            else if constexpr (Blending == Primitive::Add)
+            {
+                source = clamp01(source * withAlpha(alpha(source), splat(1.f)) + loadPixel(pixel));
+            }
+            else if constexpr (Blending == Primitive::Multiply)
+            {
+                source = clamp01(source * loadPixel(pixel));
+            }
+            else if constexpr (Blending == Primitive::Generic)
+            {
+                source = clamp01(blend(primitive.blendMode, source, loadPixel(pixel)));
+            }
+
+            storePixel(source, pixel);
+        }
+
+        using ShadeFunction = void (*)(const Primitive&, Vec4, float, float, sf::Uint8*);
+
+        ShadeFunction getShadeFunction(const Primitive& primitive)
+        {
+            static constexpr ShadeFunction functions[2][5] = {
+                {shade<false, Primitive::Replace>, shade<false, Primitive::Alpha>, shade<false, Primitive::Add>, shade<false, Primitive::Multiply>, shade<false, Primitive::Generic>},
+                {shade<true, Primitive::Replace>, shade<true, Primitive::Alpha>, shade<true, Primitive::Add>, shade<true, Primitive::Multiply>, shade<true, Primitive::Generic>}
+            };
+
+            return functions[primitive.sampler.pixels ? 1 : 0][primitive.blending];
+        }
+
+        // Shade and blend the pixels of a row of a triangle
+        template <bool Textured, Primitive::Blending Blending>
+        void shadeSpan(const Primitive& primitive, int y, int left, int right, sf::Uint8* pixel)
+        {
+            // Attributes are evaluated from their plane at each pixel center, so that
+            // the result of a pixel doesn't depend on where the span or the tile starts
+            const float (&texCoords)[3][2] = primitive.texCoords;
+            const float centerY = static_cast<float>(y) + 0.5f;
+            const Vec4  gradientX = load(primitive.color[1]);
+            const Vec4  rowColor = load(primitive.color[0]) + load(primitive.color[2]) * splat(centerY);
+            const float rowU = texCoords[0][0] + texCoords[2][0] * centerY;
+            const float rowV = texCoords[0][1] + texCoords[2][1] * centerY;
+
+            for (int x = left; x < right; ++x, pixel += 4)
+            {
+                const float centerX = static_cast<float>(x) + 0.5f;
+                shade<Textured, Blending>(primitive, rowColor + gradientX * splat(centerX), rowU + texCoords[1][0] * centerX, rowV + texCoords[1][1] * centerX, pixel);
+            }
+        }
+
+        using ShadeSpanFunction = void (*)(const Primitive&, int, int, int, sf::Uint8*);
+
+        ShadeSpanFunction getShadeSpanFunction(const Primitive& primitive)
+        {
+            static constexpr ShadeSpanFunction functions[2][5] = {
+                {shadeSpan<false, Primitive::Replace>, shadeSpan<false, Primitive::Alpha>, shadeSpan<false, Primitive::Add>, shadeSpan<false, Primitive::Multiply>, shadeSpan<false, Primitive::Generic>},
+                {shadeSpan<true, Primitive::Replace>, shadeSpan<true, Primitive::Alpha>, shadeSpan<true, Primitive::Add>, shadeSpan<true, Primitive::Multiply>, shadeSpan<true, Primitive::Generic>}
+            };
+
+            return functions[primitive.sampler.pixels ? 1 : 0][primitive.blending];
+        }
+
+        void rasterizeTriangle(const Primitive& primitive, const sf::IntRect& area, sf::Uint8* pixels, std::size_t width)
+        {
+            const ShadeSpanFunction shadeSpan = getShadeSpanFunction(primitive);
+
+            for (int y = area.top; y < area.top + area.height; ++y)
+            {
+                // Find the span of pixels whose centers are inside the 3 edges: the
+                // equations are linear in x, solve them exactly on integers
+                const sf::Int64 centerY = y * subPixels + subPixels / 2;
+                sf::Int64 left = area.left;
+                sf::Int64 right = area.left + area.width;
+
+                for (const sf::Int64 (&edge)[3] : primitive.edges)
+                {
+                    // Value at the center of the pixel at x = 0, the value increases by a * subPixels per pixel
+                    const sf::Int64 value = edge[0] * (subPixels / 2) + edge[1] * centerY + edge[2];
+                    const sf::Int64 step = edge[0] * subPixels;
+
+                    if (step > 0)
+                        left = std::max(left, ceilDiv(-value, step));
+                    else if (step < 0)
+                        right = std::min(right, floorDiv(value, -step) + 1);
+                    else if (value < 0)
+                        right = left;
+                }
+
+                if (left < right)
+                {
+                    sf::Uint8* pixel = pixels + (static_cast<std::size_t>(y) * width + static_cast<std::size_t>(left)) * 4;
+                    shadeSpan(primitive, y, static_cast<int>(left), static_cast<int>(right), pixel);
+                }
+            }
+        }
+
+        void rasterizeLine(const Primitive& primitive, const sf::IntRect& area, sf::Uint8* pixels, std::size_t width)
+        {
+            // Like in OpenGL, the line covers one pixel in each column (or row, if it is more
+            // vertical than horizontal) whose center is between the start included and the end
+            // excluded; the pixel is the one the line crosses at the center of the column
+            const sf::Int64 (&ends)[2][2] = primitive.ends;
+            const int major = (std::abs(ends[1][0] - ends[0][0]) >= std::abs(ends[1][1] - ends[0][1])) ? 0 : 1;
+            const int minor = 1 - major;
+            const sf::Int64 majorDelta = ends[1][major] - ends[0][major];
+            const sf::Int64 minorDelta = ends[1][minor] - ends[0][minor];
+
+            sf::Int64 first;
+            sf::Int64 last;
+            if (majorDelta > 0)
+            {
+                first = ceilDiv(ends[0][major] - subPixels / 2, subPixels);
+                last = ceilDiv(ends[1][major] - subPixels / 2, subPixels);
+            }
+            else
+            {
+                first = floorDiv(ends[1][major] - subPixels / 2, subPixels) + 1;
+                last = floorDiv(ends[0][major] - subPixels / 2, subPixels) + 1;
+            }
+
+            const int areaStart = major ? area.top : area.left;
+            const int areaEnd = areaStart + (major ? area.height : area.width);
+            first = std::max<sf::Int64>(first, areaStart);
+            last = std::min<sf::Int64>(last, areaEnd);
+
+            const ShadeFunction shade = getShadeFunction(primitive);
+            const Vec4 start = load(primitive.color[0]);
+            const Vec4 delta = load(primitive.color[1]);
+            const float (&texCoords)[3][2] = primitive.texCoords;
+            const sf::Int64 sign = (majorDelta > 0) ? 1 : -1;
+
+            for (sf::Int64 i = first; i < last; ++i)
+            {
+                const sf::Int64 center = i * subPixels + subPixels / 2;
+                const sf::Int64 offset = center - ends[0][major];
+                const sf::Int64 j = floorDiv((ends[0][minor] * majorDelta + minorDelta * offset) * sign, majorDelta * sign * subPixels);
+
+                const auto x = static_cast<int>(major ? j : i);
+                const auto y = static_cast<int>(major ? i : j);
+                if ((x < area.left) || (x >= area.left + area.width) || (y < area.top) || (y >= area.top + area.height))
+                    continue;
+
+                const float t = static_cast<float>(offset) / static_cast<float>(majorDelta);
+                sf::Uint8* pixel = pixels + (static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x)) * 4;
+                shade(primitive, start + delta * splat(t), texCoords[0][0] + texCoords[1][0] * t, texCoords[0][1] + texCoords[1][1] * t, pixel);
+            }
+        }
+
+        void rasterizePoint(const Primitive& primitive, const sf::IntRect& area, sf::Uint8* pixels, std::size_t width)
+        {
+            const auto x = static_cast<int>(primitive.ends[0][0]);
+            const auto y = static_cast<int>(primitive.ends[0][1]);
+
+            if (area.contains({x, y}))
+            {
+                sf::Uint8* pixel = pixels + (static_cast<std::size_t>(y) * width + static_cast<std::size_t>(x)) * 4;
+                getShadeFunction(primitive)(primitive, load(primitive.color[0]), primitive.texCoords[0][0], primitive.texCoords[0][1], pixel);
+            }
+        }
+
+        // Fill the attributes of a primitive from the vertices
+        void setColor(float (&color)[4], const sf::Color& source)
+        {
+            const std::array<float, 256>& table = getNormalizedTable();
+            color[0] = table[source.r];
+            color[1] = table[source.g];
+            color[2] = table[source.b];
+            color[3] = table[source.a];
+        }
+
+        bool isFinite(const sf::Vector2f& point)
+        {
+            return std::isfinite(point.x) && std::isfinite(point.y);
+        }
+
+        // Intersection of an edge with a vertical (axis 0) or horizontal (axis 1) line; it is
+        // computed from the same end whatever the direction of the edge, so that the triangles
+        // sharing the edge find exactly the same point
+        sf::Vector2f intersect(sf::Vector2f from, sf::Vector2f to, int axis, float position)
+        {
+            if ((to.x < from.x) || ((to.x == from.x) && (to.y < from.y)))
+                std::swap(from, to);
+
+            if (axis == 0)
+                return {position, from.y + (to.y - from.y) * ((position - from.x) / (to.x - from.x))};
+            else
+                return {from.x + (to.x - from.x) * ((position - from.y) / (to.y - from.y)), position};
+        }
+
+        // Clip a polygon against the guard band (Sutherland-Hodgman)
+        std::size_t clipToGuardBand(std::array<sf::Vector2f, 8>& polygon, std::size_t count)
+        {
+            for (int plane = 0; plane < 4; ++plane)
+            {
+                const int   axis = plane / 2;
+                const float bound = (plane % 2) ? guardBand : -guardBand;
+                const auto inside = [&](const sf::Vector2f& point)
+                {
+                    const float value = axis ? point.y : point.x;
+                    return (plane % 2) ? (value <= bound) : (value >= bound);
+                };
+
+                std::array<sf::Vector2f, 8> clipped;
+                std::size_t clippedCount = 0;
+                for (std::size_t i = 0; i < count; ++i)
+                {
+                    const sf::Vector2f& current = polygon[i];
+                    const sf::Vector2f& next = polygon[(i + 1) % count];
+
+                    if (inside(current))
+                        clipped[clippedCount++] = current;
+                    if (inside(current) != inside(next))
+                        clipped[clippedCount++] = intersect(current, next, axis, bound);
+                }
+
+                polygon = clipped;
+                count = clippedCount;
+                if (count < 3)
+                    return 0;
+            }
+
+            return count;
+        }
+
+        sf::Int64 snap(float coordinate)
+        {
+            return static_cast<sf::Int64>(std::floor(coordinate * static_cast<float>(subPixels) + 0.5f));
+        }
+
+        // Convert an IEEE half precision number to a float (exactly, every half is a float)
+        float halfToFloat(sf::Uint16 half)
+        {
+            const int exponent = (half >> 10) & 0x1F;
+            const int mantissa = half & 0x3FF;
+
+            float value;
+            if (exponent == 0)
+                value = std::ldexp(static_cast<float>(mantissa), -24);
+            else if (exponent == 31)
+                value = mantissa ? std::numeric_limits<float>::quiet_NaN() : std::numeric_limits<float>::infinity();
+            else
+                value = std::ldexp(static_cast<float>(mantissa | 0x400), exponent - 25);
+
+            return (half & 0x8000) ? -value : value;
+        }
+
+        // Read a component of a built-in vertex attribute, integers are not normalized
+        float readComponent(const sf::Uint8* data, sf::VertexLayout::Type type)
+        {
+            switch (type)
+            {
+                case sf::VertexLayout::Float:
+                {
+                    float value;
+                    std::memcpy(&value, data, sizeof(value));
+                    return value;
+                }
+                case sf::VertexLayout::HalfFloat:
+                {
+                    sf::Uint16 value;
+                    std::memcpy(&value, data, sizeof(value));
+                    return halfToFloat(value);
+                }
+                case sf::VertexLayout::Short:
+                {
+                    sf::Int16 value;
+                    std::memcpy(&value, data, sizeof(value));
+                    return static_cast<float>(value);
+                }
+                case sf::VertexLayout::UnsignedShort:
+                {
+                    sf::Uint16 value;
+                    std::memcpy(&value, data, sizeof(value));
+                    return static_cast<float>(value);
+                }
+                case sf::VertexLayout::UnsignedByte:
+                    return static_cast<float>(*data);
+            }
+
+            return 0.f;
+        }
+
+        // Read a two-components built-in vertex attribute
+        sf::Vector2f readVector(const sf::Uint8* vertex, const sf::VertexLayout::Attribute& attribute)
+        {
+            const sf::Uint8* data = vertex + attribute.offset;
+            const std::size_t size = sf::VertexLayout::getTypeSize(attribute.type);
+
+            return sf::Vector2f(readComponent(data, attribute.type), readComponent(data + size, attribute.type));
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+struct SoftwareRenderTarget::Batch
+{
+    ////////////////////////////////////////////////////////////
+    struct TextureCopy
+    {
+        Uint64 cacheId; //!< Cache identifier of the texture when it was read back
+        Uint64 frame;   //!< Frame during which the texture was read back
+        bool   used;    //!< Was the texture drawn since the last display?
+        Image  image;   //!< Pixels of the texture (RGBA)
+    };
+
+    std::vector<SoftwareRenderTargetImpl::Primitive> primitives; //!< Primitives waiting to be rasterized
+    std::vector<std::vector<Uint32>>                 bins;       //!< Indices of the primitives overlapping each tile
+    std::vector<Vector2f>                            positions;  //!< Positions of the vertices being queued, in pixels
+    std::map<const Texture*, TextureCopy>            textures;   //!< Pixels of the textures drawn recently
+    std::deque<Image>                                images;     //!< Copies of the images which are not RGBA, until the next display
+    std::vector<Vertex>                              vertices;   //!< Vertices converted from other layouts
+    Uint64                                           frame = 0;  //!< Number of calls to display
+};
+
+
+////////////////////////////////////////////////////////////
+SoftwareRenderTarget::SoftwareRenderTarget() :
+m_size  (),
+m_pixels(),
+m_image (),
+m_batch (std::make_unique<Batch>())
+{
+}
+
+
+////////////////////////////////////////////////////////////
+SoftwareRenderTarget::~SoftwareRenderTarget() = default;
+
+
+////////////////////////////////////////////////////////////
+bool SoftwareRenderTarget::create(unsigned int width, unsigned int height)
+{
+    using SoftwareRenderTargetImpl::maximumSize;
+
+    if ((width == 0) || (height == 0) || (width > maximumSize) || (height > maximumSize))
+    {
+        err() << "Failed to create software render target, invalid size (" << width << "x" << height << "), "
+              << "must be between 1x1 and " << maximumSize << "x" << maximumSize << std::endl;
+        return false;
+    }
+
+    m_size = Vector2u(width, height);
+    m_pixels.assign(static_cast<std::size_t>(width) * static_cast<std::size_t>(height) * 4, 0);
+    m_image.create(width, height, m_pixels.data());
+    m_batch = std::make_unique<Batch>();
+
+    // Setup the default view
+    RenderTarget::initialize();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::clear(const Color& color)
+{
+    // Whatever is queued would be overwritten
+    m_batch->primitives.clear();
+    m_batch->images.clear();
+
+    const Uint8 components[4] = {color.r, color.g, color.b, color.a};
+    Uint32 value;
+    std::memcpy(&value, components, 4);
+
+    for (std::size_t i = 0; i < m_pixels.size(); i += 4)
+        std::memcpy(&m_pixels[i], &value, 4);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
+                                PrimitiveType type, const RenderStates& states)
+{
+    if (!vertices || (vertexCount == 0) || m_pixels.empty())
+        return;
+
+    const Texture* texture = states.texture;
+    if (!texture || !texture->m_texture)
+    {
+        queue(vertices, vertexCount, type, states, nullptr, false, false);
+        return;
+    }
+
+    // Read the texture back when it is drawn for the first time, when it has been
+    // updated, and once per frame for the ones rendered by the graphics card
+    auto [it, inserted] = m_batch->textures.try_emplace(texture);
+    Batch::TextureCopy& copy = it->second;
+
+    if (inserted || (copy.cacheId != texture->m_cacheId) || (texture->m_pixelsFlipped && (copy.frame != m_batch->frame)))
+    {
+        // The queued primitives may sample the previous pixels
+        if (!inserted)
+            flush();
+
+        copy.image = texture->copyToImage();
+        if (copy.image.getPixelFormat() != RGBA8)
+            copy.image = copy.image.convert(RGBA8);
+
+        copy.cacheId = texture->m_cacheId;
+        copy.frame = m_batch->frame;
+    }
+
+    copy.used = true;
+    queue(vertices, vertexCount, type, states, &copy.image, texture->isSmooth(), texture->isRepeated());
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::draw(const Vertex* vertices, std::size_t vertexCount,
+                                PrimitiveType type, const Image& texture, const RenderStates& states)
+{
+    if (!vertices || (vertexCount == 0) || m_pixels.empty())
+        return;
+
+    const Image* image = &texture;
+    if (texture.getPixelFormat() != RGBA8)
+        image = &m_batch->images.emplace_back(texture.convert(RGBA8));
+
+    queue(vertices, vertexCount, type, states, image, false, false);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::draw(const void* vertices, std::size_t vertexCount, const VertexLayout& layout,
+                                PrimitiveType type, const RenderStates& states)
+{
+    using SoftwareRenderTargetImpl::readVector;
+
+    if (!vertices || (vertexCount == 0) || m_pixels.empty())
+        return;
+
+    // Convert the built-in attributes to sf::Vertex, the custom ones are for shaders
+    const auto* data = static_cast<const Uint8*>(vertices);
+    const std::optional<VertexLayout::Attribute>& color = layout.getColor();
+    const std::optional<VertexLayout::Attribute>& texCoords = layout.getTexCoords();
+
+    std::vector<Vertex>& converted = m_batch->vertices;
+    converted.resize(vertexCount);
+
+    for (std::size_t i = 0; i < vertexCount; ++i)
+    {
+        const Uint8* vertex = data + i * layout.getStride();
+        Vertex& result = converted[i];
+
+        result.position = readVector(vertex, layout.getPosition());
+        result.color = Color::White;
+        result.texCoords = Vector2f();
+
+        if (color)
+            std::memcpy(&result.color, vertex + color->offset, 4);
+
+        if (texCoords)
+            result.texCoords = readVector(vertex, *texCoords);
+    }
+
+    draw(converted.data(), vertexCount, type, states);
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::draw(const VertexBuffer&, std::size_t, std::size_t, const RenderStates&)
+{
+    err() << "Vertex buffers can't be drawn to a software render target, drawing skipped" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::display()
+{
+    flush();
+    m_batch->images.clear();
+
+    if (!m_pixels.empty())
+        m_image.create(m_size.x, m_size.y, m_pixels.data());
+
+    // Forget the textures which were not drawn during the frame
+    for (auto it = m_batch->textures.begin(); it != m_batch->textures.end();)
+    {
+        if (it->second.used)
+        {
+            it->second.used = false;
+            ++it;
+        }
+        else
+        {
+            it = m_batch->textures.erase(it);
+        }
+    }
+
+    ++m_batch->frame;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u SoftwareRenderTarget::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+bool SoftwareRenderTarget::setActive(bool active)
+{
+    return !active;
+}
+
+
+////////////////////////////////////////////////////////////
+const Image& SoftwareRenderTarget::getImage() const
+{
+    return m_image;
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::queue(const Vertex* vertices, std::size_t vertexCount, PrimitiveType type, const RenderStates& states,
+                                 const Image* texture, bool smooth, bool repeated)
+{
+    using namespace SoftwareRenderTargetImpl;
+
+    // The viewport clips everything, like in OpenGL
+    const IntRect viewport = getViewport(getView());
+    const auto clip = viewport.findIntersection(IntRect({0, 0}, Vector2i(m_size)));
+    if (!clip)
+        return;
+
+    // Transform the vertices to the pixels of the target: the view maps them to
+    // [-1, 1] with the y axis going up, which is then mapped to the viewport
+    const float halfWidth = static_cast<float>(viewport.width) / 2.f;
+    const float halfHeight = static_cast<float>(viewport.height) / 2.f;
+    Transform transform(halfWidth, 0.f,         static_cast<float>(viewport.left) + halfWidth,
+                        0.f,       -halfHeight, static_cast<float>(viewport.top) + halfHeight,
+                        0.f,       0.f,         1.f);
+    transform.combine(getView().getTransform()).combine(states.transform);
+
+    std::vector<Vector2f>& positions = m_batch->positions;
+    positions.resize(vertexCount);
+    for (std::size_t i = 0; i < vertexCount; ++i)
+        positions[i] = transform.transformPoint(vertices[i].position);
+
+    // State shared by all the primitives
+    Primitive primitive{};
+    primitive.blendMode = states.blendMode;
+    if (states.blendMode == BlendNone)
+        primitive.blending = Primitive::Replace;
+    else if (states.blendMode == BlendAlpha)
+        primitive.blending = Primitive::Alpha;
+    else if (states.blendMode == BlendAdd)
+        primitive.blending = Primitive::Add;
+    else if (states.blendMode == BlendMultiply)
+        primitive.blending = Primitive::Multiply;
+    else
+        primitive.blending = Primitive::Generic;
+    if (texture && (texture->getSize().x > 0) && (texture->getSize().y > 0))
+    {
+        primitive.sampler = {texture->getPixelsPtr(),
+                             static_cast<int>(texture->getSize().x),
+                             static_cast<int>(texture->getSize().y),
+                             smooth,
+                             repeated};
+    }
+
+    std::vector<Primitive>& primitives = m_batch->primitives;
+
+    // Alpha blending of opaque untextured primitives gives exactly the source color, the destination can be skipped
+    const Primitive::Blending blending = primitive.blending;
+    const auto setBlending = [&](std::initializer_list<std::size_t> indices)
+    {
+        const bool opaque = std::all_of(indices.begin(), indices.end(), [&](std::size_t i) { return vertices[i].color.a == 255; });
+        primitive.blending = ((blending == Primitive::Alpha) && !primitive.sampler.pixels && opaque) ? Primitive::Replace : blending;
+    };
+
+    const auto push = [&]
+    {
+        primitives.push_back(primitive);
+        if (primitives.size() >= maxQueuedPrimitives)
+            flush();
+    };
+
+    const auto addPoint = [&](std::size_t index)
+    {
+        const Vector2f& position = positions[index];
+        if (!isFinite(position))
+            return;
+
+        const Vector2i pixel(toCoordinate(position.x), toCoordinate(position.y));
+        if (!clip->contains(pixel))
+            return;
+
+        setBlending({index});
+        primitive.bounds = IntRect(pixel, {1, 1});
+        primitive.ends[0][0] = pixel.x;
+        primitive.ends[0][1] = pixel.y;
+        setColor(primitive.color[0], vertices[index].color);
+        primitive.texCoords[0][0] = vertices[index].texCoords.x;
+        primitive.texCoords[0][1] = vertices[index].texCoords.y;
+        push();
+    };
+
+    const auto addLine = [&](std::size_t start, std::size_t end)
+    {
+        if (!isFinite(positions[start]) || !isFinite(positions[end]))
+            return;
+
+        Vector2i pixels[2];
+        for (int i = 0; i < 2; ++i)
+        {
+            const Vector2f& position = positions[i ? end : start];
+            primitive.ends[i][0] = snap(std::clamp(position.x, -guardBand, guardBand));
+            primitive.ends[i][1] = snap(std::clamp(position.y, -guardBand, guardBand));
+            pixels[i].x = static_cast<int>(floorDiv(primitive.ends[i][0], subPixels));
+            pixels[i].y = static_cast<int>(floorDiv(primitive.ends[i][1], subPixels));
+        }
+
+        if ((primitive.ends[0][0] == primitive.ends[1][0]) && (primitive.ends[0][1] == primitive.ends[1][1]))
+            return;
+
+        const Vector2i topLeft(std::min(pixels[0].x, pixels[1].x), std::min(pixels[0].y, pixels[1].y));
+        const Vector2i bottomRight(std::max(pixels[0].x, pixels[1].x), std::max(pixels[0].y, pixels[1].y));
+        const auto bounds = IntRect(topLeft, bottomRight - topLeft + Vector2i(1, 1)).findIntersection(*clip);
+        if (!bounds)
+            return;
+
+        setBlending({start, end});
+        primitive.bounds = *bounds;
+        float endColor[4];
+        setColor(primitive.color[0], vertices[start].color);
+        setColor(endColor, vertices[end].color);
+        for (int i = 0; i < 4; ++i)
+            primitive.color[1][i] = endColor[i] - primitive.color[0][i];
+        primitive.texCoords[0][0] = vertices[start].texCoords.x;
+        primitive.texCoords[0][1] = vertices[start].texCoords.y;
+        primitive.texCoords[1][0] = vertices[end].texCoords.x - vertices[start].texCoords.x;
+        primitive.texCoords[1][1] = vertices[end].texCoords.y - vertices[start].texCoords.y;
+        push();
+    };
+
+    const auto addTriangle = [&](std::size_t index0, std::size_t index1, std::size_t index2)
+    {
+        const std::size_t indices[3] = {index0, index1, index2};
+        const Vector2f& p0 = positions[index0];
+        const Vector2f& p1 = positions[index1];
+        const Vector2f& p2 = positions[index2];
+        if (!isFinite(p0) || !isFinite(p1) || !isFinite(p2))
+            return;
+
+        setBlending({index0, index1, index2});
+
+        // Planes of the attributes: value(x, y) = origin + gradientX * x + gradientY * y
+        const float determinant = (p1.x - p0.x) * (p2.y - p0.y) - (p2.x - p0.x) * (p1.y - p0.y);
+        const float inverse = (determinant != 0.f) ? 1.f / determinant : 0.f;
+        const auto setPlane = [&](float& origin, float& gradientX, float& gradientY, float a0, float a1, float a2)
+        {
+            gradientX = ((a1 - a0) * (p2.y - p0.y) - (a2 - a0) * (p1.y - p0.y)) * inverse;
+            gradientY = ((a2 - a0) * (p1.x - p0.x) - (a1 - a0) * (p2.x - p0.x)) * inverse;
+            origin = a0 - gradientX * p0.x - gradientY * p0.y;
+        };
+
+        float colors[3][4];
+        for (int i = 0; i < 3; ++i)
+            setColor(colors[i], vertices[indices[i]].color);
+        for (int i = 0; i < 4; ++i)
+            setPlane(primitive.color[0][i], primitive.color[1][i], primitive.color[2][i], colors[0][i], colors[1][i], colors[2][i]);
+        setPlane(primitive.texCoords[0][0], primitive.texCoords[1][0], primitive.texCoords[2][0],
+                 vertices[index0].texCoords.x, vertices[index1].texCoords.x, vertices[index2].texCoords.x);
+        setPlane(primitive.texCoords[0][1], primitive.texCoords[1][1], primitive.texCoords[2][1],
+                 vertices[index0].texCoords.y, vertices[index1].texCoords.y, vertices[index2].texCoords.y);
+
+        // Clip the triangles that go beyond the guard band; the attributes keep the planes of the original triangle
+        std::array<Vector2f, 8> polygon = {p0, p1, p2};
+        std::size_t count = 3;
+        for (const Vector2f& point : {p0, p1, p2})
+        {
+            if ((std::abs(point.x) > guardBand) || (std::abs(point.y) > guardBand))
+            {
+                count = clipToGuardBand(polygon, count);
+                break;
+            }
+        }
+
+        for (std::size_t i = 1; i + 1 < count; ++i)
+        {
+            Int64 x[3] = {snap(polygon[0].x), snap(polygon[i].x), snap(polygon[i + 1].x)};
+            Int64 y[3] = {snap(polygon[0].y), snap(polygon[i].y), snap(polygon[i + 1].y)};
+
+            // Orient the triangle so that its inside is on the positive side of the edges
+            const Int64 area = (x[1] - x[0]) * (y[2] - y[0]) - (y[1] - y[0]) * (x[2] - x[0]);
+            if (area == 0)
+                continue;
+            if (area < 0)
+            {
+                std::swap(x[1], x[2]);
+                std::swap(y[1], y[2]);
+            }
+
+            for (int edge = 0; edge < 3; ++edge)
+            {
+                const int from = edge;
+                const int to = (edge + 1) % 3;
+                const Int64 a = y[from] - y[to];
+                const Int64 b = x[to] - x[from];
+
+                // Top-left fill rule: pixel centers exactly on an edge only belong to
+                // the triangle if the edge is a left edge or a horizontal top edge
+                const bool topLeft = (a > 0) || ((a == 0) && (b > 0));
+                primitive.edges[edge][0] = a;
+                primitive.edges[edge][1] = b;
+                primitive.edges[edge][2] = -(a * x[from] + b * y[from]) - (topLeft ? 0 : 1);
+            }
+
+            // Pixels whose centers are inside the bounding box
+            const Int64 left = ceilDiv(std::min({x[0], x[1], x[2]}) - subPixels / 2, subPixels);
+            const Int64 top = ceilDiv(std::min({y[0], y[1], y[2]}) - subPixels / 2, subPixels);
+            const Int64 right = floorDiv(std::max({x[0], x[1], x[2]}) - subPixels / 2, subPixels) + 1;
+            const Int64 bottom = floorDiv(std::max({y[0], y[1], y[2]}) - subPixels / 2, subPixels) + 1;
+            if ((left >= right) || (top >= bottom))
+                continue;
+
+            const IntRect box({static_cast<int>(left), static_cast<int>(top)}, {static_cast<int>(right - left), static_cast<int>(bottom - top)});
+            const auto bounds = box.findIntersection(*clip);
+            if (!bounds)
+                continue;
+
+            primitive.type = Primitive::Triangle;
+            primitive.bounds = *bounds;
+            push();
+        }
+    };
+
+    switch (type)
+    {
+        case Points:
+            primitive.type = Primitive::Point;
+            for (std::size_t i = 0; i < vertexCount; ++i)
+                addPoint(i);
+            break;
+
+        case Lines:
+            primitive.type = Primitive::Line;
+            for (std::size_t i = 0; i + 1 < vertexCount; i += 2)
+                addLine(i, i + 1);
+            break;
+
+        case LineStrip:
+            primitive.type = Primitive::Line;
+            for (std::size_t i = 0; i + 1 < vertexCount; ++i)
+                addLine(i, i + 1);
+            break;
+
+        case Triangles:
+            for (std::size_t i = 0; i + 2 < vertexCount; i += 3)
+                addTriangle(i, i + 1, i + 2);
+            break;
+
+        case TriangleStrip:
+            for (std::size_t i = 0; i + 2 < vertexCount; ++i)
+                addTriangle(i, i + 1, i + 2);
+            break;
+
+        case TriangleFan:
+            for (std::size_t i = 1; i + 1 < vertexCount; ++i)
+                addTriangle(0, i, i + 1);
+            break;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void SoftwareRenderTarget::flush()
+{
+    using namespace SoftwareRenderTargetImpl;
+
+    std::vector<Primitive>& primitives = m_batch->primitives;
+    if (primitives.empty())
+        return;
+
+    // Bin the primitives into the tiles they overlap, in submission order
+    const int tilesX = (static_cast<int>(m_size.x) + tileSize - 1) / tileSize;
+    const int tilesY = (static_cast<int>(m_size.y) + tileSize - 1) / tileSize;
+    std::vector<std::vector<Uint32>>& bins = m_batch->bins;
+    bins.resize(static_cast<std::size_t>(tilesX * tilesY));
+    for (std::vector<Uint32>& bin : bins)
+        bin.clear();
+
+    for (std::size_t i = 0; i < primitives.size(); ++i)
+    {
+        const IntRect& bounds = primitives[i].bounds;
+        const int lastX = (bounds.left + bounds.width - 1) / tileSize;
+        const int lastY = (bounds.top + bounds.height - 1) / tileSize;
+
+        for (int y = bounds.top / tileSize; y <= lastY; ++y)
+            for (int x = bounds.left / tileSize; x <= lastX; ++x)
+                bins[static_cast<std::size_t>(y * tilesX + x)].push_back(static_cast<Uint32>(i));
+    }
+
+    // Each tile is rendered by a single thread, which draws its primitives in order:
+    // the pixels get the same result whatever the number of threads
+    const std::size_t width = m_size.x;
+    Uint8* pixels = m_pixels.data();
+    const auto rasterizeTile = [&](std::size_t tile)
+    {
+        const int tileX = static_cast<int>(tile) % tilesX * tileSize;
+        const int tileY = static_cast<int>(tile) / tilesX * tileSize;
+        const IntRect tileArea({tileX, tileY}, {std::min(tileSize, static_cast<int>(m_size.x) - tileX),
+                                                std::min(tileSize, static_cast<int>(m_size.y) - tileY)});
+
+        for (Uint32 index : bins[tile])
+        {
+            const Primitive& primitive = primitives[index];
+            const auto area = primitive.bounds.findIntersection(tileArea);
+            if (!area)
+                continue;
+
+            switch (primitive.type)
+            {
+                case Primitive::Triangle: rasterizeTriangle(primitive, *area, pixels, width); break;
+                case Primitive::Line:     rasterizeLine(primitive, *area, pixels, width); break;
+                case Primitive::Point:    rasterizePoint(primitive, *area, pixels, width); break;
+            }
+        }
+    };
+
+    // Tiles are distributed one by one, since their costs vary a lot
+    std::atomic<std::size_t> next(0);
+    priv::ThreadPool& pool = priv::ThreadPool::getGlobal();
+    pool.parallelFor(std::min(bins.size(), pool.getThreadCount() + 1), 1, [&](std::size_t begin, std::size_t end)
+    {
+        for (std::size_t worker = begin; worker < end; ++worker)
+        {
+            for (std::size_t tile = next++; tile < bins.size(); tile = next++)
+            {
+                if (!bins[tile].empty())
+                    rasterizeTile(tile);
+            }
+        }
+    });
+
+    primitives.clear();
+}
+
+} // namespace sf
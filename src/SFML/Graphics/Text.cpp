@@ -91,6 +91,7 @@ m_vertices           (Triangles),
 m_outlineVertices    (Triangles),
 m_bounds             (),
 m_geometryNeedUpdate (false),
+m_firstChangedChar   (String::InvalidPos),
 m_fontTextureId      (0)
 {
 
@@ -112,6 +113,7 @@ m_vertices           (Triangles),
 m_outlineVertices    (Triangles),
 m_bounds             (),
 m_geometryNeedUpdate (true),
+m_firstChangedChar   (String::InvalidPos),
 m_fontTextureId      (0)
 {
 
@@ -139,8 +141,23 @@ void Text::setString(const String& string)
 {
     if (m_string != string)
     {
+        // Only the characters that follow the common prefix of both strings have to be laid out again
+        auto prefixEnd = std::mismatch(m_string.begin(), m_string.end(), string.begin(), string.end()).first;
+        m_firstChangedChar = std::min(m_firstChangedChar, static_cast<std::size_t>(prefixEnd - m_string.begin()));
+
         m_string = string;
-        m_geometryNeedUpdate = true;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void Text::appendString(const String& string)
+{
+    if (!string.isEmpty())
+    {
+        m_firstChangedChar = std::min(m_firstChangedChar, m_string.getSize());
+
+        m_string += string;
     }
 }
 
@@ -358,10 +375,175 @@ Vector2f Text::findCharacterPos(std::size_t index) const
 }
 
 
+////////////////////////////////////////////////////////////
+std::size_t Text::findCharacterIndex(const Vector2f& position) const
+{
+    // Make sure that we have a valid font
+    if (!m_font)
+        return 0;
+
+    // Transform the position to local coordinates
+    Vector2f localPosition = getInverseTransform().transformPoint(position);
+
+    // Precompute the variables needed by the algorithm
+    bool  isBold          = m_style & Bold;
+    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
+    float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
+    whitespaceWidth      += letterSpacing;
+    float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
+
+    // Find the line under the position
+    std::size_t targetLine = 0;
+    if ((localPosition.y > 0) && (lineSpacing > 0))
+        targetLine = static_cast<std::size_t>(localPosition.y / lineSpacing);
+
+    // Walk the characters the same way as findCharacterPos, until we pass the position on the target line
+    std::size_t line = 0;
+    float x = 0.f;
+    Uint32 prevChar = 0;
+    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    {
+        Uint32 curChar = m_string[i];
+
+        // The end of the target line is the closest position
+        if (curChar == '\n')
+        {
+            if (line == targetLine)
+                return i;
+
+            ++line;
+            x = 0;
+            prevChar = curChar;
+            continue;
+        }
+
+        // Compute the position of the next character
+        float next = x + m_font->getKerning(prevChar, curChar, m_characterSize, isBold);
+        prevChar = curChar;
+
+        switch (curChar)
+        {
+            case ' ':  next += whitespaceWidth;     break;
+            case '\t': next += whitespaceWidth * 4; break;
+            default:   next += m_font->getGlyph(curChar, m_characterSize, isBold).advance + letterSpacing; break;
+        }
+
+        // Stop if the position is closer to this character than to the next one
+        if ((line == targetLine) && (localPosition.x < (x + next) / 2.f))
+            return i;
+
+        x = next;
+    }
+
+    return m_string.getSize();
+}
+
+
+////////////////////////////////////////////////////////////
+String Text::getWrappedString(float width) const
+{
+    // Make sure that we have a valid font
+    if (!m_font)
+        return m_string;
+
+    // Precompute the variables needed by the algorithm
+    bool  isBold          = m_style & Bold;
+    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
+    float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
+    whitespaceWidth      += letterSpacing;
+
+    // Horizontal offset from a character to the next one, the same way as the layout computes it
+    auto getAdvance = [&](Uint32 prevChar, Uint32 curChar)
+    {
+        float advance = m_font->getKerning(prevChar, curChar, m_characterSize, isBold);
+
+        switch (curChar)
+        {
+            case L' ':  return advance + whitespaceWidth;
+            case L'\t': return advance + whitespaceWidth * 4;
+            default:    return advance + m_font->getGlyph(curChar, m_characterSize, isBold).advance + letterSpacing;
+        }
+    };
+
+    std::basic_string<Uint32> wrapped;
+    wrapped.reserve(m_string.getSize());
+
+    std::size_t lineStart = 0;                  // Index of the first character of the current line in the wrapped string
+    std::size_t breakPos  = String::InvalidPos; // Index of the last space of the current line in the wrapped string
+    float x = 0.f;
+    Uint32 prevChar = 0;
+    for (Uint32 curChar : m_string)
+    {
+        // Carriage returns are ignored by the layout
+        if (curChar == L'\r')
+        {
+            wrapped += curChar;
+            continue;
+        }
+
+        // Existing line breaks start a new line
+        if (curChar == L'\n')
+        {
+            wrapped += curChar;
+            lineStart = wrapped.size();
+            breakPos = String::InvalidPos;
+            x = 0.f;
+            prevChar = curChar;
+            continue;
+        }
+
+        float advance = getAdvance(prevChar, curChar);
+
+        // The character doesn't fit: break the line, at the last space if there is one
+        if ((curChar != L' ') && (curChar != L'\t') && (x + advance > width) && (wrapped.size() > lineStart))
+        {
+            x = 0.f;
+            prevChar = L'\n';
+
+            if (breakPos != String::InvalidPos)
+            {
+                // Replace the space by a line break, and measure the characters moved to the new line
+                wrapped[breakPos] = L'\n';
+                lineStart = breakPos + 1;
+
+                for (std::size_t i = lineStart; i < wrapped.size(); ++i)
+                {
+                    if (wrapped[i] == L'\r')
+                        continue;
+
+                    x += getAdvance(prevChar, wrapped[i]);
+                    prevChar = wrapped[i];
+                }
+            }
+            else
+            {
+                // No space on this line: break the word before the current character
+                wrapped += L'\n';
+                lineStart = wrapped.size();
+            }
+
+            breakPos = String::InvalidPos;
+            advance = getAdvance(prevChar, curChar);
+        }
+
+        if (curChar == L' ')
+            breakPos = wrapped.size();
+
+        wrapped += curChar;
+        x += advance;
+        prevChar = curChar;
+    }
+
+    return wrapped;
+}
+
+
 ////////////////////////////////////////////////////////////
 FloatRect Text::getLocalBounds() const
 {
-    ensureGeometryUpdate();
+    // Don't build the geometry only to get the bounds
+    if (m_font && (m_geometryNeedUpdate || (m_firstChangedChar != String::InvalidPos) || (m_font->getTexture(m_characterSize).m_cacheId != m_fontTextureId)))
+        return measureLocalBounds();
 
     return m_bounds;
 }
@@ -402,23 +584,49 @@ void Text::ensureGeometryUpdate() const
         return;
 
     // Do nothing, if geometry has not changed and the font texture has not changed
-    if (!m_geometryNeedUpdate && m_font->getTexture(m_characterSize).m_cacheId == m_fontTextureId)
+    const Uint64 fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+    if (!m_geometryNeedUpdate && (m_firstChangedChar == String::InvalidPos) && (fontTextureId == m_fontTextureId))
         return;
 
-    // Save the current fonts texture id
-    m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+    // Only the string changed: the geometry of the lines before the first changed character can be kept
+    // Any other change invalidates the whole layout, including the checkpoint of the first line
+    std::size_t firstChangedChar = m_firstChangedChar;
+    if (m_geometryNeedUpdate || (fontTextureId != m_fontTextureId))
+    {
+        firstChangedChar = 0;
+        m_checkpoints.clear();
+    }
 
     // Mark geometry as updated
     m_geometryNeedUpdate = false;
-
-    // Clear the previous geometry
-    m_vertices.clear();
-    m_outlineVertices.clear();
-    m_bounds = FloatRect();
+    m_firstChangedChar = String::InvalidPos;
 
     // No text: nothing to draw
     if (m_string.isEmpty())
+    {
+        m_vertices.clear();
+        m_outlineVertices.clear();
+        m_checkpoints.clear();
+        m_bounds = FloatRect();
+        m_fontTextureId = fontTextureId;
         return;
+    }
+
+    // Find the last checkpoint located before the first changed character, and resume the layout from there
+    while (!m_checkpoints.empty() && (m_checkpoints.back().index > firstChangedChar))
+        m_checkpoints.pop_back();
+
+    LayoutCheckpoint checkpoint{0, 0, Vector2f(0.f, static_cast<float>(m_characterSize)), 0, 0,
+                                Vector2f(static_cast<float>(m_characterSize), static_cast<float>(m_characterSize)), Vector2f()};
+    if (!m_checkpoints.empty())
+    {
+        checkpoint = m_checkpoints.back();
+        m_checkpoints.pop_back();
+    }
+
+    // Discard the geometry of the characters that follow the checkpoint
+    m_vertices.resize(checkpoint.vertexCount);
+    m_outlineVertices.resize(checkpoint.outlineVertexCount);
 
     // Compute values related to the text style
     bool  isBold             = m_style & Bold;
@@ -439,19 +647,22 @@ void Text::ensureGeometryUpdate() const
     float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
     whitespaceWidth      += letterSpacing;
     float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
-    float x               = 0.f;
-    auto y                = static_cast<float>(m_characterSize);
+    float x               = checkpoint.position.x;
+    float y               = checkpoint.position.y;
 
     // Create one quad for each character
-    auto minX = static_cast<float>(m_characterSize);
-    auto minY = static_cast<float>(m_characterSize);
-    float maxX = 0.f;
-    float maxY = 0.f;
-    Uint32 prevChar = 0;
-    for (std::size_t i = 0; i < m_string.getSize(); ++i)
+    float minX = checkpoint.min.x;
+    float minY = checkpoint.min.y;
+    float maxX = checkpoint.max.x;
+    float maxY = checkpoint.max.y;
+    Uint32 prevChar = checkpoint.prevChar;
+    for (std::size_t i = checkpoint.index; i < m_string.getSize(); ++i)
     {
-        Uint32 curChar = m_string[i];
+        // Remember the state of the layout at the beginning of each line
+        if ((i == 0) || (m_string[i - 1] == L'\n'))
+            m_checkpoints.push_back({i, prevChar, Vector2f(x, y), m_vertices.getVertexCount(), m_outlineVertices.getVertexCount(), Vector2f(minX, minY), Vector2f(maxX, maxY)});
 
+        Uint32 curChar = m_string[i];
         // Skip the \r char to avoid weird graphical issues
         if (curChar == '\r')
             continue;
@@ -545,6 +756,9 @@ void Text::ensureGeometryUpdate() const
         x += glyph.advance + letterSpacing;
     }
 
+    // Remember the state of the layout at the end of the string, so that appended characters can resume from there
+    m_checkpoints.push_back({m_string.getSize(), prevChar, Vector2f(x, y), m_vertices.getVertexCount(), m_outlineVertices.getVertexCount(), Vector2f(minX, minY), Vector2f(maxX, maxY)});
+
     // If we're using the underlined style, add the last line
     if (isUnderlined && (x > 0))
     {
@@ -568,6 +782,84 @@ void Text::ensureGeometryUpdate() const
     m_bounds.top = minY;
     m_bounds.width = maxX - minX;
     m_bounds.height = maxY - minY;
+
+    // Save the current font texture id, now that all the glyphs of the string are loaded
+    m_fontTextureId = m_font->getTexture(m_characterSize).m_cacheId;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect Text::measureLocalBounds() const
+{
+    // No text: empty bounds
+    if (!m_font || m_string.isEmpty())
+        return FloatRect();
+
+    // Compute values related to the text style
+    bool  isBold      = m_style & Bold;
+    float italicShear = (m_style & Italic) ? sf::degrees(12).asRadians() : 0.f;
+
+    // Precompute the variables needed by the algorithm
+    float whitespaceWidth = m_font->getGlyph(L' ', m_characterSize, isBold).advance;
+    float letterSpacing   = ( whitespaceWidth / 3.f ) * ( m_letterSpacingFactor - 1.f );
+    whitespaceWidth      += letterSpacing;
+    float lineSpacing     = m_font->getLineSpacing(m_characterSize) * m_lineSpacingFactor;
+    float x               = 0.f;
+    auto y                = static_cast<float>(m_characterSize);
+
+    // Accumulate the bounds of each character, exactly like ensureGeometryUpdate
+    auto minX = static_cast<float>(m_characterSize);
+    auto minY = static_cast<float>(m_characterSize);
+    float maxX = 0.f;
+    float maxY = 0.f;
+    Uint32 prevChar = 0;
+    for (Uint32 curChar : m_string)
+    {
+        // Skip the \r char, like the layout
+        if (curChar == '\r')
+            continue;
+
+        // Apply the kerning offset
+        x += m_font->getKerning(prevChar, curChar, m_characterSize, isBold);
+        prevChar = curChar;
+
+        // Handle special characters
+        if ((curChar == L' ') || (curChar == L'\n') || (curChar == L'\t'))
+        {
+            minX = std::min(minX, x);
+            minY = std::min(minY, y);
+
+            switch (curChar)
+            {
+                case L' ':  x += whitespaceWidth;     break;
+                case L'\t': x += whitespaceWidth * 4; break;
+                case L'\n': y += lineSpacing; x = 0;  break;
+            }
+
+            maxX = std::max(maxX, x);
+            maxY = std::max(maxY, y);
+            continue;
+        }
+
+        // The bounds are the ones of the outlined glyph if there is an outline
+        const Glyph& glyph = m_font->getGlyph(curChar, m_characterSize, isBold);
+        const FloatRect& bounds = (m_outlineThickness != 0) ? m_font->getGlyph(curChar, m_characterSize, isBold, m_outlineThickness).bounds : glyph.bounds;
+
+        float left   = bounds.left;
+        float top    = bounds.top;
+        float right  = bounds.left + bounds.width;
+        float bottom = bounds.top  + bounds.height;
+
+        minX = std::min(minX, x + left  - italicShear * bottom);
+        maxX = std::max(maxX, x + right - italicShear * top);
+        minY = std::min(minY, y + top);
+        maxY = std::max(maxY, y + bottom);
+
+        // Advance to the next character
+        x += glyph.advance + letterSpacing;
+    }
+
+    return FloatRect({minX, minY}, {maxX - minX, maxY - minY});
 }
 
 } // namespace sf
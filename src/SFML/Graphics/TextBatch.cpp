@@ -0,0 +1,170 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TextBatch.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <algorithm>
+
+
+namespace
+{
+    // Append the vertices of a text to a vertex array, transformed to the batch's coordinate system
+    void appendVertices(sf::VertexArray& destination, const sf::VertexArray& source, const sf::Transform& transform)
+    {
+        std::size_t offset = destination.getVertexCount();
+        destination.resize(offset + source.getVertexCount());
+
+        for (std::size_t i = 0; i < source.getVertexCount(); ++i)
+        {
+            sf::Vertex& vertex = destination[offset + i];
+            vertex = source[i];
+            vertex.position = transform.transformPoint(vertex.position);
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TextBatch::Page::Page(const Texture* pageTexture) :
+texture        (pageTexture),
+vertices       (Triangles),
+outlineVertices(Triangles)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+TextBatch::TextBatch() :
+m_pages  (),
+m_bounds (),
+m_scratch()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::clear()
+{
+    // Keep the pages and the capacity of their vertex arrays, they will most likely be reused
+    for (Page& page : m_pages)
+    {
+        page.vertices.clear();
+        page.outlineVertices.clear();
+    }
+
+    m_bounds.reset();
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::append(const Text& text)
+{
+    if (!text.m_font)
+        return;
+
+    text.ensureGeometryUpdate();
+
+    if (text.m_vertices.getVertexCount() == 0)
+        return;
+
+    // Find the page used by the text, or create it
+    const Texture* texture = &text.m_font->getTexture(text.m_characterSize);
+    auto it = std::find_if(m_pages.begin(), m_pages.end(), [texture](const Page& page) { return page.texture == texture; });
+    if (it == m_pages.end())
+    {
+        m_pages.emplace_back(texture);
+        it = m_pages.end() - 1;
+    }
+
+    // Copy the geometry of the text
+    const Transform& transform = text.getTransform();
+    appendVertices(it->vertices, text.m_vertices, transform);
+    if (text.m_outlineThickness != 0)
+        appendVertices(it->outlineVertices, text.m_outlineVertices, transform);
+
+    // Update the bounds of the batch
+    FloatRect bounds = transform.transformRect(text.m_bounds);
+    if (m_bounds)
+    {
+        float left   = std::min(m_bounds->left, bounds.left);
+        float top    = std::min(m_bounds->top, bounds.top);
+        float right  = std::max(m_bounds->left + m_bounds->width, bounds.left + bounds.width);
+        float bottom = std::max(m_bounds->top + m_bounds->height, bounds.top + bounds.height);
+
+        bounds = FloatRect({left, top}, {right - left, bottom - top});
+    }
+
+    m_bounds = bounds;
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::append(const String& string, const Font& font, unsigned int characterSize, const Vector2f& position,
+                       const Color& fillColor, Uint32 style)
+{
+    // Lay out the string with the internal text: successive strings that
+    // share a prefix (like counters or damage numbers) are laid out incrementally
+    m_scratch.setFont(font);
+    m_scratch.setCharacterSize(characterSize);
+    m_scratch.setStyle(style);
+    m_scratch.setFillColor(fillColor);
+    m_scratch.setString(string);
+    m_scratch.setPosition(position);
+
+    append(m_scratch);
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TextBatch::getBounds() const
+{
+    return m_bounds.value_or(FloatRect());
+}
+
+
+////////////////////////////////////////////////////////////
+void TextBatch::draw(RenderTarget& target, const RenderStates& states) const
+{
+    RenderStates statesCopy(states);
+
+    for (const Page& page : m_pages)
+    {
+        statesCopy.texture = page.texture;
+
+        // Draw all the outlines of the page below all its fills
+        if (page.outlineVertices.getVertexCount() > 0)
+            target.draw(page.outlineVertices, statesCopy);
+
+        if (page.vertices.getVertexCount() > 0)
+            target.draw(page.vertices, statesCopy);
+    }
+}
+
+} // namespace sf
@@ -27,11 +27,17 @@
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/Texture.hpp>
 #include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/ImageLoader.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
 #include <SFML/Graphics/TextureSaver.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/Window.hpp>
 #include <SFML/System/Err.hpp>
+#ifdef SFML_SYSTEM_ANDROID
+    #include <SFML/System/Android/ResourceStream.hpp>
+#endif
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 #include <climits>
@@ -57,6 +63,48 @@ namespace
 
             return id++;
         }
+
+        // OpenGL formats used to store and transfer the pixels of a given format
+        struct GlFormat
+        {
+            GLint  internalFormat; // Storage of the texture
+            GLenum format;         // Channels of the transferred pixels
+            GLenum type;           // Type of the components of the transferred pixels
+        };
+
+        GlFormat getGlFormat(sf::PixelFormat format, bool sRgb)
+        {
+            switch (format)
+            {
+                case sf::R8:      return {GLEXT_GL_R8,      GLEXT_GL_RED, GL_UNSIGNED_BYTE};
+                case sf::RG8:     return {GLEXT_GL_RG8,     GLEXT_GL_RG,  GL_UNSIGNED_BYTE};
+                case sf::RGB8:    return {GLEXT_GL_RGB8,    GL_RGB,       GL_UNSIGNED_BYTE};
+                case sf::R16:     return {GLEXT_GL_R16,     GLEXT_GL_RED, GL_UNSIGNED_SHORT};
+                case sf::RGBA16F: return {GLEXT_GL_RGBA16F, GL_RGBA,      GLEXT_GL_HALF_FLOAT};
+                case sf::RGBA32F: return {GLEXT_GL_RGBA32F, GL_RGBA,      GL_FLOAT};
+                default:          return {sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE};
+            }
+        }
+
+        // Check whether the driver can store textures of a given format
+        bool isFormatSupported(sf::PixelFormat format)
+        {
+            switch (format)
+            {
+                case sf::R8:
+                case sf::RG8:
+                case sf::R16:     return GLEXT_texture_rg;
+                case sf::RGBA16F:
+                case sf::RGBA32F: return GLEXT_texture_float;
+                default:          return true;
+            }
+        }
+
+        // Rows of pixels whose size is not a multiple of 4 bytes are not necessarily 4-byte aligned
+        GLint getRowAlignment(sf::PixelFormat format)
+        {
+            return (sf::getPixelSize(format) % 4 == 0) ? 4 : 1;
+        }
     }
 }
 
@@ -74,6 +122,8 @@ m_isRepeated   (false),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
+m_alphaOnly    (false),
+m_format       (RGBA8),
 m_cacheId      (TextureImpl::getUniqueId())
 {
 }
@@ -90,11 +140,13 @@ m_isRepeated   (copy.m_isRepeated),
 m_pixelsFlipped(false),
 m_fboAttachment(false),
 m_hasMipmap    (false),
+m_alphaOnly    (false),
+m_format       (RGBA8),
 m_cacheId      (TextureImpl::getUniqueId())
 {
     if (copy.m_texture)
     {
-        if (create(copy.getSize().x, copy.getSize().y))
+        if (create(copy.getSize().x, copy.getSize().y, copy.m_format, copy.m_alphaOnly))
         {
             update(copy);
         }
@@ -116,12 +168,27 @@ Texture::~Texture()
 
         GLuint texture = m_texture;
         glCheck(glDeleteTextures(1, &texture));
+        priv::invalidateTextureBindings();
     }
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Texture::create(unsigned int width, unsigned int height)
+{
+    return create(width, height, RGBA8, false);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::create(unsigned int width, unsigned int height, PixelFormat format)
+{
+    return create(width, height, format, false);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::create(unsigned int width, unsigned int height, PixelFormat format, bool alphaOnly)
 {
     // Check if texture parameters are valid before creating it
     if ((width == 0) || (height == 0))
@@ -149,6 +216,22 @@ bool Texture::create(unsigned int width, unsigned int height)
         return false;
     }
 
+    // Fall back to RGBA8 if the driver can't store the requested format
+    if (!TextureImpl::isFormatSupported(format))
+    {
+        static bool warned = false;
+
+        if (!warned)
+        {
+            err() << "OpenGL 3.0 is required for textures with one, two or floating point channels" << '\n'
+                  << "A RGBA8 texture is created instead" << std::endl;
+
+            warned = true;
+        }
+
+        format = RGBA8;
+    }
+
     // All the validity checks passed, we can store the new texture settings
     m_size.x        = width;
     m_size.y        = height;
@@ -156,6 +239,16 @@ bool Texture::create(unsigned int width, unsigned int height)
     m_pixelsFlipped = false;
     m_fboAttachment = false;
 
+    m_format        = alphaOnly ? RGBA8 : format;
+
+#ifndef SFML_OPENGL_ES
+    m_alphaOnly     = alphaOnly;
+#else
+    // Alpha-only textures can't be read back with OpenGL ES
+    m_alphaOnly     = false;
+    (void)alphaOnly;
+#endif
+
     // Create the OpenGL texture if it doesn't exist yet
     if (!m_texture)
     {
@@ -205,8 +298,14 @@ bool Texture::create(unsigned int width, unsigned int height)
     }
 
     // Initialize the texture
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-    glCheck(glTexImage2D(GL_TEXTURE_2D, 0, (m_sRgb ? GLEXT_GL_SRGB8_ALPHA8 : GL_RGBA), static_cast<GLsizei>(m_actualSize.x), static_cast<GLsizei>(m_actualSize.y), 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr));
+    priv::bindTexture(m_texture);
+    if (m_alphaOnly)
+        glCheck(glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, static_cast<GLsizei>(m_actualSize.x), static_cast<GLsizei>(m_actualSize.y), 0, GL_ALPHA, GL_UNSIGNED_BYTE, nullptr));
+    else
+    {
+        const TextureImpl::GlFormat glFormat = TextureImpl::getGlFormat(m_format, m_sRgb);
+        glCheck(glTexImage2D(GL_TEXTURE_2D, 0, glFormat.internalFormat, static_cast<GLsizei>(m_actualSize.x), static_cast<GLsizei>(m_actualSize.y), 0, glFormat.format, glFormat.type, nullptr));
+    }
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
@@ -222,42 +321,77 @@ bool Texture::create(unsigned int width, unsigned int height)
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromFile(const std::filesystem::path& filename, const IntRect& area)
 {
-    Image image;
-    return image.loadFromFile(filename) && loadFromImage(image, area);
+    // Upload the pixels straight from the decoder, rather than copying them to an image first
+    bool loaded = false;
+    auto upload = [&](const Uint8* pixels, const Vector2u& size) { loaded = loadFromPixels(pixels, size, RGBA8, area); };
+
+#ifndef SFML_SYSTEM_ANDROID
+
+    return priv::ImageLoader::getInstance().loadImageFromFile(filename, RGBA8, upload) && loaded;
+
+#else
+
+    priv::ResourceStream stream(filename);
+    return priv::ImageLoader::getInstance().loadImageFromStream(stream, RGBA8, upload) && loaded;
+
+#endif
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromMemory(const void* data, std::size_t size, const IntRect& area)
 {
-    Image image;
-    return image.loadFromMemory(data, size) && loadFromImage(image, area);
+    // Upload the pixels straight from the decoder, rather than copying them to an image first
+    bool loaded = false;
+    auto upload = [&](const Uint8* pixels, const Vector2u& imageSize) { loaded = loadFromPixels(pixels, imageSize, RGBA8, area); };
+
+    return priv::ImageLoader::getInstance().loadImageFromMemory(data, size, RGBA8, upload) && loaded;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromStream(InputStream& stream, const IntRect& area)
 {
-    Image image;
-    return image.loadFromStream(stream) && loadFromImage(image, area);
+    // Upload the pixels straight from the decoder, rather than copying them to an image first
+    bool loaded = false;
+    auto upload = [&](const Uint8* pixels, const Vector2u& size) { loaded = loadFromPixels(pixels, size, RGBA8, area); };
+
+    return priv::ImageLoader::getInstance().loadImageFromStream(stream, RGBA8, upload) && loaded;
 }
 
 
 ////////////////////////////////////////////////////////////
 bool Texture::loadFromImage(const Image& image, const IntRect& area)
+{
+    return loadFromPixels(image.getPixelsPtr(), image.getSize(), image.getPixelFormat(), area);
+}
+
+
+////////////////////////////////////////////////////////////
+bool Texture::loadFromPixels(const Uint8* pixels, const Vector2u& size, PixelFormat format, const IntRect& area)
 {
     // Retrieve the image size
-    int width = static_cast<int>(image.getSize().x);
-    int height = static_cast<int>(image.getSize().y);
+    int width = static_cast<int>(size.x);
+    int height = static_cast<int>(size.y);
 
     // Load the entire image if the source area is either empty or contains the whole image
     if (area.width == 0 || (area.height == 0) ||
        ((area.left <= 0) && (area.top <= 0) && (area.width >= width) && (area.height >= height)))
     {
         // Load the entire image
-        if (create(image.getSize().x, image.getSize().y))
+        if (create(size.x, size.y, format))
         {
-            update(image);
+            // The texture falls back to RGBA8 when its format is not supported
+            if (m_format != format)
+            {
+                Image image;
+                image.create(size, format, pixels);
+                update(image);
+            }
+            else
+            {
+                update(pixels);
+            }
 
             return true;
         }
@@ -278,21 +412,34 @@ bool Texture::loadFromImage(const Image& image, const IntRect& area)
         if (rectangle.top + rectangle.height > height) rectangle.height = height - rectangle.top;
 
         // Create the texture and upload the pixels
-        if (create(static_cast<unsigned int>(rectangle.width), static_cast<unsigned int>(rectangle.height)))
+        if (create(static_cast<unsigned int>(rectangle.width), static_cast<unsigned int>(rectangle.height), format))
         {
+            // The texture falls back to RGBA8 when its format is not supported
+            if (m_format != format)
+            {
+                Image image;
+                image.create(size, format, pixels);
+                image = image.convert(m_format);
+                return loadFromPixels(image.getPixelsPtr(), size, m_format, area);
+            }
+
             TransientContextLock lock;
 
             // Make sure that the current texture binding will be preserved
             priv::TextureSaver save;
 
             // Copy the pixels to the texture, row by row
-            const Uint8* pixels = image.getPixelsPtr() + 4 * (rectangle.left + (width * rectangle.top));
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            const std::size_t           pixelSize = getPixelSize(m_format);
+            const TextureImpl::GlFormat glFormat  = TextureImpl::getGlFormat(m_format, m_sRgb);
+            pixels += pixelSize * static_cast<std::size_t>(rectangle.left + (width * rectangle.top));
+            priv::bindTexture(m_texture);
+            glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, TextureImpl::getRowAlignment(m_format)));
             for (int i = 0; i < rectangle.height; ++i)
             {
-                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, rectangle.width, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels));
-                pixels += 4 * width;
+                glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, 0, i, rectangle.width, 1, glFormat.format, glFormat.type, pixels));
+                pixels += pixelSize * static_cast<std::size_t>(width);
             }
+            glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
 
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
             m_hasMipmap = false;
@@ -318,6 +465,13 @@ Vector2u Texture::getSize() const
 }
 
 
+////////////////////////////////////////////////////////////
+PixelFormat Texture::getPixelFormat() const
+{
+    return m_format;
+}
+
+
 ////////////////////////////////////////////////////////////
 Image Texture::copyToImage() const
 {
@@ -331,7 +485,8 @@ Image Texture::copyToImage() const
     priv::TextureSaver save;
 
     // Create an array of pixels
-    std::vector<Uint8> pixels(static_cast<std::size_t>(m_size.x) * static_cast<std::size_t>(m_size.y) * 4);
+    const std::size_t pixelSize = getPixelSize(m_format);
+    std::vector<Uint8> pixels(static_cast<std::size_t>(m_size.x) * static_cast<std::size_t>(m_size.y) * pixelSize);
 
 #ifdef SFML_OPENGL_ES
 
@@ -342,39 +497,68 @@ Image Texture::copyToImage() const
 
     if (frameBuffer)
     {
-        GLint previousFrameBuffer;
-        glCheck(glGetIntegerv(GLEXT_GL_FRAMEBUFFER_BINDING, &previousFrameBuffer));
+        const GLuint previousFrameBuffer = priv::getFramebufferBinding(GLEXT_GL_FRAMEBUFFER);
 
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer));
+        priv::bindFramebuffer(GLEXT_GL_FRAMEBUFFER, frameBuffer);
         glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0));
         glCheck(glReadPixels(0, 0, static_cast<GLint>(m_size.x), static_cast<GLint>(m_size.y), GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
         glCheck(GLEXT_glDeleteFramebuffers(1, &frameBuffer));
+        priv::invalidateFramebufferBindings();
 
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_FRAMEBUFFER, static_cast<GLuint>(previousFrameBuffer)));
+        priv::bindFramebuffer(GLEXT_GL_FRAMEBUFFER, previousFrameBuffer);
     }
 
 #else
 
-    if ((m_size == m_actualSize) && !m_pixelsFlipped)
+    if (m_alphaOnly)
+    {
+        // Texture only stores the alpha channel: read it, then expand it to white pixels
+        std::vector<Uint8> alpha(static_cast<std::size_t>(m_actualSize.x) * static_cast<std::size_t>(m_actualSize.y));
+        priv::bindTexture(m_texture);
+        glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 1));
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_ALPHA, GL_UNSIGNED_BYTE, alpha.data()));
+        glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 4));
+
+        Uint8* dst = pixels.data();
+        for (unsigned int y = 0; y < m_size.y; ++y)
+        {
+            const Uint8* src = alpha.data() + static_cast<std::size_t>(m_actualSize.x) * (m_pixelsFlipped ? m_size.y - 1 - y : y);
+
+            for (unsigned int x = 0; x < m_size.x; ++x)
+            {
+                *dst++ = 255;
+                *dst++ = 255;
+                *dst++ = 255;
+                *dst++ = src[x];
+            }
+        }
+    }
+    else if ((m_size == m_actualSize) && !m_pixelsFlipped)
     {
         // Texture is not padded nor flipped, we can use a direct copy
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data()));
+        const TextureImpl::GlFormat glFormat = TextureImpl::getGlFormat(m_format, m_sRgb);
+        priv::bindTexture(m_texture);
+        glCheck(glPixelStorei(GL_PACK_ALIGNMENT, TextureImpl::getRowAlignment(m_format)));
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, glFormat.format, glFormat.type, pixels.data()));
+        glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 4));
     }
     else
     {
         // Texture is either padded or flipped, we have to use a slower algorithm
 
         // All the pixels will first be copied to a temporary array
-        std::vector<Uint8> allPixels(static_cast<std::size_t>(m_actualSize.x) * static_cast<std::size_t>(m_actualSize.y) * 4);
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, GL_RGBA, GL_UNSIGNED_BYTE, allPixels.data()));
+        const TextureImpl::GlFormat glFormat = TextureImpl::getGlFormat(m_format, m_sRgb);
+        std::vector<Uint8> allPixels(static_cast<std::size_t>(m_actualSize.x) * static_cast<std::size_t>(m_actualSize.y) * pixelSize);
+        priv::bindTexture(m_texture);
+        glCheck(glPixelStorei(GL_PACK_ALIGNMENT, TextureImpl::getRowAlignment(m_format)));
+        glCheck(glGetTexImage(GL_TEXTURE_2D, 0, glFormat.format, glFormat.type, allPixels.data()));
+        glCheck(glPixelStorei(GL_PACK_ALIGNMENT, 4));
 
         // Then we copy the useful pixels from the temporary array to the final one
         const Uint8* src = allPixels.data();
         Uint8* dst = pixels.data();
-        int srcPitch = static_cast<int>(m_actualSize.x * 4);
-        unsigned int dstPitch = m_size.x * 4;
+        int srcPitch = static_cast<int>(m_actualSize.x * pixelSize);
+        auto dstPitch = static_cast<unsigned int>(m_size.x * pixelSize);
 
         // Handle the case where source pixels are flipped vertically
         if (m_pixelsFlipped)
@@ -395,7 +579,7 @@ Image Texture::copyToImage() const
 
     // Create the image
     Image image;
-    image.create(m_size.x, m_size.y, pixels.data());
+    image.create(m_size, m_format, pixels.data());
 
     return image;
 }
@@ -423,8 +607,23 @@ void Texture::update(const Uint8* pixels, unsigned int width, unsigned int heigh
         priv::TextureSaver save;
 
         // Copy pixels from the given array to the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
-        glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(x), static_cast<GLint>(y), static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_RGBA, GL_UNSIGNED_BYTE, pixels));
+        priv::bindTexture(m_texture);
+
+        if (m_alphaOnly)
+        {
+            // Rows of single byte pixels are not necessarily 4-byte aligned
+            glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 1));
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(x), static_cast<GLint>(y), static_cast<GLsizei>(width), static_cast<GLsizei>(height), GL_ALPHA, GL_UNSIGNED_BYTE, pixels));
+            glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+        }
+        else
+        {
+            const TextureImpl::GlFormat glFormat = TextureImpl::getGlFormat(m_format, m_sRgb);
+            glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, TextureImpl::getRowAlignment(m_format)));
+            glCheck(glTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(x), static_cast<GLint>(y), static_cast<GLsizei>(width), static_cast<GLsizei>(height), glFormat.format, glFormat.type, pixels));
+            glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+        }
+
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
         m_hasMipmap = false;
         m_pixelsFlipped = false;
@@ -463,16 +662,14 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         priv::ensureExtensionsInit();
     }
 
-    if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit)
+    // Alpha-only textures are not color-renderable, they can't be attached to a framebuffer
+    if (GLEXT_framebuffer_object && GLEXT_framebuffer_blit && !m_alphaOnly && !texture.m_alphaOnly)
     {
         TransientContextLock lock;
 
         // Save the current bindings so we can restore them after we are done
-        GLint readFramebuffer = 0;
-        GLint drawFramebuffer = 0;
-
-        glCheck(glGetIntegerv(GLEXT_GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer));
-        glCheck(glGetIntegerv(GLEXT_GL_DRAW_FRAMEBUFFER_BINDING, &drawFramebuffer));
+        const GLuint readFramebuffer = priv::getFramebufferBinding(GLEXT_GL_READ_FRAMEBUFFER);
+        const GLuint drawFramebuffer = priv::getFramebufferBinding(GLEXT_GL_DRAW_FRAMEBUFFER);
 
         // Create the framebuffers
         GLuint sourceFrameBuffer = 0;
@@ -487,11 +684,11 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         }
 
         // Link the source texture to the source frame buffer
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, sourceFrameBuffer));
+        priv::bindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, sourceFrameBuffer);
         glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_READ_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, texture.m_texture, 0));
 
         // Link the destination texture to the destination frame buffer
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, destFrameBuffer));
+        priv::bindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, destFrameBuffer);
         glCheck(GLEXT_glFramebufferTexture2D(GLEXT_GL_DRAW_FRAMEBUFFER, GLEXT_GL_COLOR_ATTACHMENT0, GL_TEXTURE_2D, m_texture, 0));
 
         // A final check, just to be sure...
@@ -516,18 +713,19 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
         }
 
         // Restore previously bound framebuffers
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, static_cast<GLuint>(readFramebuffer)));
-        glCheck(GLEXT_glBindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, static_cast<GLuint>(drawFramebuffer)));
+        priv::bindFramebuffer(GLEXT_GL_READ_FRAMEBUFFER, readFramebuffer);
+        priv::bindFramebuffer(GLEXT_GL_DRAW_FRAMEBUFFER, drawFramebuffer);
 
         // Delete the framebuffers
         glCheck(GLEXT_glDeleteFramebuffers(1, &sourceFrameBuffer));
         glCheck(GLEXT_glDeleteFramebuffers(1, &destFrameBuffer));
+        priv::invalidateFramebufferBindings();
 
         // Make sure that the current texture binding will be preserved
         priv::TextureSaver save;
 
         // Set the parameters of this texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        priv::bindTexture(m_texture);
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
         m_hasMipmap = false;
         m_pixelsFlipped = false;
@@ -550,13 +748,33 @@ void Texture::update(const Texture& texture, unsigned int x, unsigned int y)
 void Texture::update(const Image& image)
 {
     // Update the whole texture
-    update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, 0, 0);
+    update(image, 0, 0);
 }
 
 
 ////////////////////////////////////////////////////////////
 void Texture::update(const Image& image, unsigned int x, unsigned int y)
 {
+    // Convert the pixels to the format of the texture (alpha-only textures take their alpha from RGBA8 pixels)
+    if (image.getPixelFormat() != m_format)
+    {
+        update(image.convert(m_format), x, y);
+        return;
+    }
+
+    if (m_alphaOnly)
+    {
+        // Only keep the alpha channel of the image
+        std::vector<Uint8> alpha(static_cast<std::size_t>(image.getSize().x) * static_cast<std::size_t>(image.getSize().y));
+        const Uint8* pixels = image.getPixelsPtr();
+
+        for (std::size_t i = 0; i < alpha.size(); ++i)
+            alpha[i] = pixels[i * 4 + 3];
+
+        update(alpha.data(), image.getSize().x, image.getSize().y, x, y);
+        return;
+    }
+
     update(image.getPixelsPtr(), image.getSize().x, image.getSize().y, x, y);
 }
 
@@ -582,7 +800,7 @@ void Texture::update(const Window& window, unsigned int x, unsigned int y)
         priv::TextureSaver save;
 
         // Copy pixels from the back-buffer to the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+        priv::bindTexture(m_texture);
         glCheck(glCopyTexSubImage2D(GL_TEXTURE_2D, 0, static_cast<GLint>(x), static_cast<GLint>(y), 0, 0, static_cast<GLsizei>(window.getSize().x), static_cast<GLsizei>(window.getSize().y)));
         glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
         m_hasMipmap = false;
@@ -610,7 +828,7 @@ void Texture::setSmooth(bool smooth)
             // Make sure that the current texture binding will be preserved
             priv::TextureSaver save;
 
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            priv::bindTexture(m_texture);
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
 
             if (m_hasMipmap)
@@ -677,7 +895,7 @@ void Texture::setRepeated(bool repeated)
                 }
             }
 
-            glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+            priv::bindTexture(m_texture);
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
             glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, m_isRepeated ? GL_REPEAT : (textureEdgeClamp ? GLEXT_GL_CLAMP_TO_EDGE : GLEXT_GL_CLAMP)));
         }
@@ -709,7 +927,7 @@ bool Texture::generateMipmap()
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    priv::bindTexture(m_texture);
     glCheck(GLEXT_glGenerateMipmap(GL_TEXTURE_2D));
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
 
@@ -719,6 +937,68 @@ bool Texture::generateMipmap()
 }
 
 
+////////////////////////////////////////////////////////////
+bool Texture::loadMipmap(const std::vector<Image>& levels)
+{
+    if (!m_texture)
+        return false;
+
+    // Levels are only computed for the RGBA pixels of the whole texture
+    if (m_alphaOnly || m_pixelsFlipped || (m_actualSize != m_size))
+    {
+        err() << "Failed to load mipmap, the texture contents don't match the mipmap levels" << std::endl;
+        return false;
+    }
+
+    // Check that the levels form a complete chain
+    Vector2u size = m_size;
+    for (const Image& level : levels)
+    {
+        size = Vector2u(std::max(size.x / 2, 1u), std::max(size.y / 2, 1u));
+        if (level.getSize() != size)
+        {
+            err() << "Failed to load mipmap, invalid level size "
+                  << "(expected: " << size.x << "x" << size.y << ", "
+                  << "got: " << level.getSize().x << "x" << level.getSize().y << ")" << std::endl;
+            return false;
+        }
+    }
+
+    if ((size.x != 1) || (size.y != 1))
+    {
+        err() << "Failed to load mipmap, the chain of levels must end with a 1x1 level" << std::endl;
+        return false;
+    }
+
+    TransientContextLock lock;
+
+    // Make sure that the current texture binding will be preserved
+    priv::TextureSaver save;
+
+    // Upload the levels one by one, in the format of the texture
+    const TextureImpl::GlFormat glFormat = TextureImpl::getGlFormat(m_format, m_sRgb);
+    priv::bindTexture(m_texture);
+    glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, TextureImpl::getRowAlignment(m_format)));
+    for (std::size_t i = 0; i < levels.size(); ++i)
+    {
+        Image converted;
+        const Image& level = (levels[i].getPixelFormat() == m_format) ? levels[i] : (converted = levels[i].convert(m_format));
+        const Vector2u& levelSize = level.getSize();
+        glCheck(glTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(i + 1), glFormat.internalFormat, static_cast<GLsizei>(levelSize.x), static_cast<GLsizei>(levelSize.y), 0, glFormat.format, glFormat.type, level.getPixelsPtr()));
+    }
+    glCheck(glPixelStorei(GL_UNPACK_ALIGNMENT, 4));
+    glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR_MIPMAP_LINEAR : GL_NEAREST_MIPMAP_LINEAR));
+
+    // Force an OpenGL flush, so that the texture data will appear updated
+    // in all contexts immediately (solves problems in multi-threaded apps)
+    glCheck(glFlush());
+
+    m_hasMipmap = true;
+
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void Texture::invalidateMipmap()
 {
@@ -730,7 +1010,7 @@ void Texture::invalidateMipmap()
     // Make sure that the current texture binding will be preserved
     priv::TextureSaver save;
 
-    glCheck(glBindTexture(GL_TEXTURE_2D, m_texture));
+    priv::bindTexture(m_texture);
     glCheck(glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, m_isSmooth ? GL_LINEAR : GL_NEAREST));
 
     m_hasMipmap = false;
@@ -744,51 +1024,43 @@ void Texture::bind(const Texture* texture, CoordinateType coordinateType)
 
     if (texture && texture->m_texture)
     {
-        // Bind the texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, texture->m_texture));
+        // Bind the texture, always if it is attached to a FBO, so that
+        // the driver makes changes made in other contexts visible here
+        priv::bindTexture(texture->m_texture, texture->m_fboAttachment);
 
         // Check if we need to define a special texture matrix
         if ((coordinateType == Pixels) || texture->m_pixelsFlipped)
         {
-            GLfloat matrix[16] = {1.f, 0.f, 0.f, 0.f,
-                                  0.f, 1.f, 0.f, 0.f,
-                                  0.f, 0.f, 1.f, 0.f,
-                                  0.f, 0.f, 0.f, 1.f};
+            float scaleX = 1.f;
+            float scaleY = 1.f;
+            float offsetY = 0.f;
 
             // If non-normalized coordinates (= pixels) are requested, we need to
             // setup scale factors that convert the range [0 .. size] to [0 .. 1]
             if (coordinateType == Pixels)
             {
-                matrix[0] = 1.f / static_cast<float>(texture->m_actualSize.x);
-                matrix[5] = 1.f / static_cast<float>(texture->m_actualSize.y);
+                scaleX = 1.f / static_cast<float>(texture->m_actualSize.x);
+                scaleY = 1.f / static_cast<float>(texture->m_actualSize.y);
             }
 
             // If pixels are flipped we must invert the Y axis
             if (texture->m_pixelsFlipped)
             {
-                matrix[5] = -matrix[5];
-                matrix[13] = static_cast<float>(texture->m_size.y) / static_cast<float>(texture->m_actualSize.y);
+                scaleY = -scaleY;
+                offsetY = static_cast<float>(texture->m_size.y) / static_cast<float>(texture->m_actualSize.y);
             }
 
             // Load the matrix
-            glCheck(glMatrixMode(GL_TEXTURE));
-            glCheck(glLoadMatrixf(matrix));
-
-            // Go back to model-view mode (sf::RenderTarget relies on it)
-            glCheck(glMatrixMode(GL_MODELVIEW));
+            priv::loadTextureMatrix(scaleX, scaleY, offsetY);
         }
     }
     else
     {
         // Bind no texture
-        glCheck(glBindTexture(GL_TEXTURE_2D, 0));
+        priv::bindTexture(0);
 
         // Reset the texture matrix
-        glCheck(glMatrixMode(GL_TEXTURE));
-        glCheck(glLoadIdentity());
-
-        // Go back to model-view mode (sf::RenderTarget relies on it)
-        glCheck(glMatrixMode(GL_MODELVIEW));
+        priv::loadTextureMatrix(1.f, 1.f, 0.f);
     }
 }
 
@@ -837,6 +1109,8 @@ void Texture::swap(Texture& right)
     std::swap(m_pixelsFlipped, right.m_pixelsFlipped);
     std::swap(m_fboAttachment, right.m_fboAttachment);
     std::swap(m_hasMipmap,     right.m_hasMipmap);
+    std::swap(m_alphaOnly,     right.m_alphaOnly);
+    std::swap(m_format,        right.m_format);
 
     m_cacheId = TextureImpl::getUniqueId();
     right.m_cacheId = TextureImpl::getUniqueId();
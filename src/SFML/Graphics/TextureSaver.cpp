@@ -26,6 +26,7 @@
 // Headers
 ////////////////////////////////////////////////////////////
 #include <SFML/Graphics/TextureSaver.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
 
 
 namespace sf
@@ -35,14 +36,14 @@ namespace priv
 ////////////////////////////////////////////////////////////
 TextureSaver::TextureSaver()
 {
-    glCheck(glGetIntegerv(GL_TEXTURE_BINDING_2D, &m_textureBinding));
+    m_textureBinding = getTextureBinding();
 }
 
 
 ////////////////////////////////////////////////////////////
 TextureSaver::~TextureSaver()
 {
-    glCheck(glBindTexture(GL_TEXTURE_2D, static_cast<GLuint>(m_textureBinding)));
+    bindTexture(m_textureBinding);
 }
 
 } // namespace priv
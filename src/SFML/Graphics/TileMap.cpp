@@ -0,0 +1,383 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/View.hpp>
+#include <SFML/System/Err.hpp>
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+
+
+namespace
+{
+    // A nested named namespace is used here to allow unity builds of SFML.
+    namespace TileMapImpl
+    {
+        // Largest coordinate of compact vertices
+        constexpr unsigned int maxCoordinate = 32767;
+
+        // Number of draws after which the geometry of a chunk that was not visible is released
+        constexpr sf::Uint64 releaseDelay = 600;
+
+        // Convert a range of coordinates to the range of chunks it overlaps
+        void getChunkRange(float first, float last, unsigned int chunkSize, unsigned int chunkCount,
+                           unsigned int& begin, unsigned int& end)
+        {
+            const float size = static_cast<float>(chunkSize);
+            const float count = static_cast<float>(chunkCount);
+
+            begin = static_cast<unsigned int>(std::clamp(std::floor(first / size), 0.f, count));
+            end = static_cast<unsigned int>(std::clamp(std::ceil(last / size), 0.f, count));
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+TileMap::TileMap() :
+m_size      (),
+m_tileSize  (),
+m_layerCount(0),
+m_tiles     (),
+m_tileset   (nullptr),
+m_chunkCount(),
+m_chunks    (),
+m_resident  (),
+m_scratch   (),
+m_drawCount (0)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+bool TileMap::create(const Vector2u& size, const Vector2u& tileSize, unsigned int layerCount)
+{
+    if ((size.x == 0) || (size.y == 0) || (layerCount == 0))
+    {
+        err() << "Failed to create tile map, invalid size (" << size.x << "x" << size.y
+              << ", " << layerCount << " layers)" << std::endl;
+        return false;
+    }
+
+    if ((tileSize.x == 0) || (tileSize.y == 0) ||
+        (tileSize.x * ChunkSize > TileMapImpl::maxCoordinate) || (tileSize.y * ChunkSize > TileMapImpl::maxCoordinate))
+    {
+        err() << "Failed to create tile map, invalid tile size (" << tileSize.x << "x" << tileSize.y
+              << "), must be between 1x1 and " << TileMapImpl::maxCoordinate / ChunkSize << "x"
+              << TileMapImpl::maxCoordinate / ChunkSize << std::endl;
+        return false;
+    }
+
+    m_size       = size;
+    m_tileSize   = tileSize;
+    m_layerCount = layerCount;
+    m_chunkCount = Vector2u((size.x + ChunkSize - 1) / ChunkSize, (size.y + ChunkSize - 1) / ChunkSize);
+
+    m_tiles.assign(static_cast<std::size_t>(size.x) * size.y * layerCount, 0);
+
+    m_chunks.clear();
+    m_chunks.resize(static_cast<std::size_t>(m_chunkCount.x) * m_chunkCount.y);
+    for (Chunk& chunk : m_chunks)
+    {
+        chunk.vertexCount = 0;
+        chunk.lastDraw = 0;
+        chunk.needUpdate = false;
+        chunk.resident = false;
+    }
+    m_resident.clear();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTileset(const Texture& tileset)
+{
+    if ((tileset.getSize().x > TileMapImpl::maxCoordinate) || (tileset.getSize().y > TileMapImpl::maxCoordinate))
+    {
+        err() << "Failed to set the tileset of the tile map, textures larger than "
+              << TileMapImpl::maxCoordinate << " pixels are not supported" << std::endl;
+        return;
+    }
+
+    m_tileset = &tileset;
+
+    // The texture coordinates of all the tiles change
+    for (Chunk& chunk : m_chunks)
+        chunk.needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+const Texture* TileMap::getTileset() const
+{
+    return m_tileset;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTile(unsigned int layer, const Vector2u& position, Uint16 tile)
+{
+    if ((layer >= m_layerCount) || (position.x >= m_size.x) || (position.y >= m_size.y))
+        return;
+
+    Uint16& current = m_tiles[(static_cast<std::size_t>(layer) * m_size.y + position.y) * m_size.x + position.x];
+    if (current == tile)
+        return;
+
+    current = tile;
+    m_chunks[(position.y / ChunkSize) * m_chunkCount.x + position.x / ChunkSize].needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::setTiles(unsigned int layer, const Uint16* tiles)
+{
+    if ((layer >= m_layerCount) || !tiles)
+        return;
+
+    const std::size_t layerSize = static_cast<std::size_t>(m_size.x) * m_size.y;
+    std::copy(tiles, tiles + layerSize, m_tiles.begin() + static_cast<std::ptrdiff_t>(layer * layerSize));
+
+    for (Chunk& chunk : m_chunks)
+        chunk.needUpdate = true;
+}
+
+
+////////////////////////////////////////////////////////////
+Uint16 TileMap::getTile(unsigned int layer, const Vector2u& position) const
+{
+    if ((layer >= m_layerCount) || (position.x >= m_size.x) || (position.y >= m_size.y))
+        return 0;
+
+    return m_tiles[(static_cast<std::size_t>(layer) * m_size.y + position.y) * m_size.x + position.x];
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TileMap::getSize() const
+{
+    return m_size;
+}
+
+
+////////////////////////////////////////////////////////////
+Vector2u TileMap::getTileSize() const
+{
+    return m_tileSize;
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int TileMap::getLayerCount() const
+{
+    return m_layerCount;
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getLocalBounds() const
+{
+    return FloatRect({0.f, 0.f}, {static_cast<float>(m_size.x * m_tileSize.x), static_cast<float>(m_size.y * m_tileSize.y)});
+}
+
+
+////////////////////////////////////////////////////////////
+FloatRect TileMap::getGlobalBounds() const
+{
+    return getTransform().transformRect(getLocalBounds());
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::draw(RenderTarget& target, const RenderStates& states) const
+{
+    if (!m_tileset || m_chunks.empty())
+        return;
+
+    RenderStates mapStates(states);
+    mapStates.transform *= getTransform();
+    mapStates.texture = m_tileset;
+
+    // Area covered by the view of the target, in the coordinates of the map
+    FloatRect visible = target.getView().getInverseTransform().transformRect(FloatRect({-1.f, -1.f}, {2.f, 2.f}));
+    visible = mapStates.transform.getInverse().transformRect(visible);
+
+    // Only the chunks in this area are considered, whatever the size of the map
+    unsigned int left = 0, right = 0, top = 0, bottom = 0;
+    TileMapImpl::getChunkRange(visible.left, visible.left + visible.width, m_tileSize.x * ChunkSize, m_chunkCount.x, left, right);
+    TileMapImpl::getChunkRange(visible.top, visible.top + visible.height, m_tileSize.y * ChunkSize, m_chunkCount.y, top, bottom);
+
+    const bool useBuffers = VertexBuffer::isAvailable();
+    ++m_drawCount;
+
+    for (unsigned int y = top; y < bottom; ++y)
+    {
+        for (unsigned int x = left; x < right; ++x)
+        {
+            const std::size_t index = y * m_chunkCount.x + x;
+            Chunk& chunk = m_chunks[index];
+            chunk.lastDraw = m_drawCount;
+
+            if (chunk.needUpdate)
+                updateChunk({x, y});
+
+            if ((chunk.vertexCount > 0) && !chunk.resident)
+            {
+                chunk.resident = true;
+                m_resident.push_back(index);
+            }
+
+            if (chunk.vertexCount == 0)
+                continue;
+
+            // Vertices are relative to the chunk, to fit in 16-bit integers
+            RenderStates chunkStates(mapStates);
+            chunkStates.transform.translate({static_cast<float>(x * ChunkSize * m_tileSize.x),
+                                             static_cast<float>(y * ChunkSize * m_tileSize.y)});
+
+            if (useBuffers)
+                target.draw(chunk.buffer, 0, chunk.vertexCount, chunkStates);
+            else
+                target.draw(chunk.vertices.data(), chunk.vertexCount, VertexLayout::Compact, Triangles, chunkStates);
+        }
+    }
+
+    // Release the geometry of the chunks that have not been visible for a while, it is rebuilt when they are visible again
+    for (std::size_t i = 0; i < m_resident.size();)
+    {
+        Chunk& chunk = m_chunks[m_resident[i]];
+        if (m_drawCount - chunk.lastDraw < TileMapImpl::releaseDelay)
+        {
+            ++i;
+            continue;
+        }
+
+        chunk.buffer = VertexBuffer();
+        chunk.vertices = std::vector<CompactVertex>();
+        chunk.vertexCount = 0;
+        chunk.needUpdate = true;
+        chunk.resident = false;
+
+        m_resident[i] = m_resident.back();
+        m_resident.pop_back();
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void TileMap::updateChunk(const Vector2u& chunk) const
+{
+    Chunk& data = m_chunks[chunk.y * m_chunkCount.x + chunk.x];
+    data.needUpdate = false;
+
+    const unsigned int columns = m_tileSize.x ? m_tileset->getSize().x / m_tileSize.x : 0;
+    const unsigned int tileCount = m_tileSize.y ? columns * (m_tileset->getSize().y / m_tileSize.y) : 0;
+    const Vector2u first(chunk.x * ChunkSize, chunk.y * ChunkSize);
+    const Vector2u last(std::min(first.x + ChunkSize, m_size.x), std::min(first.y + ChunkSize, m_size.y));
+    const auto width = static_cast<Int16>(m_tileSize.x);
+    const auto height = static_cast<Int16>(m_tileSize.y);
+
+    // Two triangles per non-empty tile, layer after layer
+    m_scratch.clear();
+    for (unsigned int layer = 0; layer < m_layerCount; ++layer)
+    {
+        for (unsigned int y = first.y; y < last.y; ++y)
+        {
+            const Uint16* row = &m_tiles[(static_cast<std::size_t>(layer) * m_size.y + y) * m_size.x];
+
+            for (unsigned int x = first.x; x < last.x; ++x)
+            {
+                // Tiles beyond the last image of the tileset are not drawn
+                const Uint16 tile = row[x];
+                if ((tile == 0) || (tile > tileCount))
+                    continue;
+
+                const unsigned int image = tile - 1u;
+                const Vector2<Int16> position(static_cast<Int16>((x - first.x) * m_tileSize.x),
+                                              static_cast<Int16>((y - first.y) * m_tileSize.y));
+                const Vector2<Int16> texCoords(static_cast<Int16>((image % columns) * m_tileSize.x),
+                                               static_cast<Int16>((image / columns) * m_tileSize.y));
+
+                const CompactVertex topLeft{position, Color::White, texCoords};
+                const CompactVertex topRight{{static_cast<Int16>(position.x + width), position.y}, Color::White,
+                                             {static_cast<Int16>(texCoords.x + width), texCoords.y}};
+                const CompactVertex bottomLeft{{position.x, static_cast<Int16>(position.y + height)}, Color::White,
+                                               {texCoords.x, static_cast<Int16>(texCoords.y + height)}};
+                const CompactVertex bottomRight{{static_cast<Int16>(position.x + width), static_cast<Int16>(position.y + height)}, Color::White,
+                                                {static_cast<Int16>(texCoords.x + width), static_cast<Int16>(texCoords.y + height)}};
+
+                m_scratch.push_back(topLeft);
+                m_scratch.push_back(topRight);
+                m_scratch.push_back(bottomLeft);
+                m_scratch.push_back(bottomLeft);
+                m_scratch.push_back(topRight);
+                m_scratch.push_back(bottomRight);
+            }
+        }
+    }
+
+    data.vertexCount = m_scratch.size();
+
+    if (!VertexBuffer::isAvailable())
+    {
+        data.vertices = m_scratch;
+        return;
+    }
+
+    if (data.vertexCount == 0)
+        return;
+
+    // The geometry only changes with the tiles, it is uploaded once
+    if (!data.buffer.getNativeHandle())
+    {
+        data.buffer.setPrimitiveType(Triangles);
+        data.buffer.setUsage(VertexBuffer::Static);
+        data.buffer.setLayout(VertexLayout::Compact);
+
+        if (!data.buffer.create(data.vertexCount))
+        {
+            err() << "Failed to create the vertex buffer of a tile map chunk" << std::endl;
+            data.vertexCount = 0;
+            return;
+        }
+    }
+
+    if (!data.buffer.update(m_scratch.data(), data.vertexCount, 0))
+    {
+        err() << "Failed to update the vertex buffer of a tile map chunk" << std::endl;
+        data.vertexCount = 0;
+    }
+}
+
+} // namespace sf
@@ -138,7 +138,28 @@ void Transformable::scale(const Vector2f& factor)
 
 
 ////////////////////////////////////////////////////////////
-const Transform& Transformable::getTransform() const
+Transform Transformable::getTransform() const
+{
+    return getAffineTransform();
+}
+
+
+////////////////////////////////////////////////////////////
+Transform Transformable::getInverseTransform() const
+{
+    // Recompute the inverse transform if needed
+    if (m_inverseTransformNeedUpdate)
+    {
+        m_inverseTransform = getAffineTransform().getInverse();
+        m_inverseTransformNeedUpdate = false;
+    }
+
+    return m_inverseTransform;
+}
+
+
+////////////////////////////////////////////////////////////
+const AffineTransform& Transformable::getAffineTransform() const
 {
     // Recompute the combined transform if needed
     if (m_transformNeedUpdate)
@@ -153,27 +174,12 @@ const Transform& Transformable::getTransform() const
         float tx     = -m_origin.x * sxc - m_origin.y * sys + m_position.x;
         float ty     =  m_origin.x * sxs - m_origin.y * syc + m_position.y;
 
-        m_transform = Transform( sxc, sys, tx,
-                                -sxs, syc, ty,
-                                 0.f, 0.f, 1.f);
+        m_transform = AffineTransform( sxc, sys, tx,
+                                      -sxs, syc, ty);
         m_transformNeedUpdate = false;
     }
 
     return m_transform;
 }
 
-
-////////////////////////////////////////////////////////////
-const Transform& Transformable::getInverseTransform() const
-{
-    // Recompute the inverse transform if needed
-    if (m_inverseTransformNeedUpdate)
-    {
-        m_inverseTransform = getTransform().getInverse();
-        m_inverseTransformNeedUpdate = false;
-    }
-
-    return m_inverseTransform;
-}
-
 } // namespace sf
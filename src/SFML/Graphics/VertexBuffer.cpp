@@ -29,7 +29,9 @@
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/Vertex.hpp>
 #include <SFML/Graphics/GLCheck.hpp>
+#include <SFML/Graphics/GLStateCache.hpp>
 #include <SFML/System/Err.hpp>
+#include <algorithm>
 #include <mutex>
 #include <utility>
 #include <ostream>
@@ -63,7 +65,13 @@ VertexBuffer::VertexBuffer() :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (Stream)
+m_usage        (Stream),
+m_layout       (),
+m_bufferCount  (1),
+m_buffers      (1),
+m_current      (0),
+m_mapped       (false),
+m_fences       ()
 {
 }
 
@@ -73,7 +81,13 @@ VertexBuffer::VertexBuffer(PrimitiveType type) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (Stream)
+m_usage        (Stream),
+m_layout       (),
+m_bufferCount  (1),
+m_buffers      (1),
+m_current      (0),
+m_mapped       (false),
+m_fences       ()
 {
 }
 
@@ -83,7 +97,13 @@ VertexBuffer::VertexBuffer(VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(Points),
-m_usage        (usage)
+m_usage        (usage),
+m_layout       (),
+m_bufferCount  (1),
+m_buffers      (1),
+m_current      (0),
+m_mapped       (false),
+m_fences       ()
 {
 }
 
@@ -93,7 +113,13 @@ VertexBuffer::VertexBuffer(PrimitiveType type, VertexBuffer::Usage usage) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(type),
-m_usage        (usage)
+m_usage        (usage),
+m_layout       (),
+m_bufferCount  (1),
+m_buffers      (1),
+m_current      (0),
+m_mapped       (false),
+m_fences       ()
 {
 }
 
@@ -103,7 +129,13 @@ VertexBuffer::VertexBuffer(const VertexBuffer& copy) :
 m_buffer       (0),
 m_size         (0),
 m_primitiveType(copy.m_primitiveType),
-m_usage        (copy.m_usage)
+m_usage        (copy.m_usage),
+m_layout       (copy.m_layout),
+m_bufferCount  (copy.m_bufferCount),
+m_buffers      (1),
+m_current      (0),
+m_mapped       (false),
+m_fences       ()
 {
     if (copy.m_buffer && copy.m_size)
     {
@@ -126,7 +158,10 @@ VertexBuffer::~VertexBuffer()
     {
         TransientContextLock contextLock;
 
+        clearFences();
+
         glCheck(GLEXT_glDeleteBuffers(1, &m_buffer));
+        priv::invalidateBufferBindings();
     }
 }
 
@@ -148,11 +183,21 @@ bool VertexBuffer::create(std::size_t vertexCount)
         return false;
     }
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
-    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLsizeiptrARB>(sizeof(Vertex) * vertexCount), nullptr, VertexBufferImpl::usageToGlEnum(m_usage)));
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+    // Rotating buffers needs fences, to know when the graphics card is done drawing them
+    m_buffers = 1;
+    if ((m_bufferCount > 1) && GLEXT_map_buffer_range && GLEXT_copy_buffer && GLEXT_sync)
+        m_buffers = m_bufferCount;
+
+    clearFences();
+
+    // The buffers are allocated one after the other in the same buffer object
+    priv::bindArrayBuffer(m_buffer);
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLsizeiptrARB>(m_layout.getStride() * vertexCount * m_buffers), nullptr, VertexBufferImpl::usageToGlEnum(m_usage)));
+    priv::bindArrayBuffer(0);
 
     m_size = vertexCount;
+    m_current = 0;
+    m_mapped = false;
 
     return true;
 }
@@ -174,6 +219,13 @@ bool VertexBuffer::update(const Vertex* vertices)
 
 ////////////////////////////////////////////////////////////
 bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsigned int offset)
+{
+    return updateData(vertices, sizeof(Vertex), vertexCount, offset);
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::updateData(const void* vertices, std::size_t vertexSize, std::size_t vertexCount, unsigned int offset)
 {
     // Sanity checks
     if (!m_buffer)
@@ -185,21 +237,50 @@ bool VertexBuffer::update(const Vertex* vertices, std::size_t vertexCount, unsig
     if (offset && (offset + vertexCount > m_size))
         return false;
 
+    if (vertexSize != m_layout.getStride())
+    {
+        err() << "Failed to update vertex buffer, the size of the vertices (" << vertexSize
+              << " bytes) doesn't match its layout (" << m_layout.getStride() << " bytes)" << std::endl;
+        return false;
+    }
+
+    if (m_mapped)
+    {
+        err() << "Failed to update vertex buffer, it is mapped" << std::endl;
+        return false;
+    }
+
+    const std::size_t stride = m_layout.getStride();
+
     TransientContextLock contextLock;
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+    // Write all the vertices to the next buffer, which the graphics card is done with
+    if ((m_buffers > 1) && !offset && vertexCount && (vertexCount == m_size))
+    {
+        void* destination = map(0, vertexCount);
+        if (!destination)
+            return false;
+
+        std::memcpy(destination, vertices, stride * vertexCount);
+
+        return unmap();
+    }
+
+    priv::bindArrayBuffer(m_buffer);
 
     // Check if we need to resize or orphan the buffer
     if (vertexCount >= m_size)
     {
-        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLsizeiptrARB>(sizeof(Vertex) * vertexCount), nullptr, VertexBufferImpl::usageToGlEnum(m_usage)));
+        glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLsizeiptrARB>(stride * vertexCount * m_buffers), nullptr, VertexBufferImpl::usageToGlEnum(m_usage)));
 
         m_size = vertexCount;
+        m_current = 0;
+        clearFences();
     }
 
-    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLintptrARB>(sizeof(Vertex) * offset), static_cast<GLsizeiptrARB>(sizeof(Vertex) * vertexCount), vertices));
+    glCheck(GLEXT_glBufferSubData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLintptrARB>(getCurrentOffset() + stride * offset), static_cast<GLsizeiptrARB>(stride * vertexCount), vertices));
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+    priv::bindArrayBuffer(0);
 
     return true;
 }
@@ -218,6 +299,20 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
     if (!m_buffer || !vertexBuffer.m_buffer)
         return false;
 
+    if (m_mapped || vertexBuffer.m_mapped)
+    {
+        err() << "Failed to copy vertex buffer, a buffer is mapped" << std::endl;
+        return false;
+    }
+
+    if (m_layout.getStride() != vertexBuffer.m_layout.getStride())
+    {
+        err() << "Failed to copy vertex buffer, the sizes of the vertices of the buffers don't match" << std::endl;
+        return false;
+    }
+
+    const std::size_t byteCount = m_layout.getStride() * vertexBuffer.m_size;
+
     TransientContextLock contextLock;
 
     // Make sure that extensions are initialized
@@ -228,7 +323,10 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, vertexBuffer.m_buffer));
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, m_buffer));
 
-        glCheck(GLEXT_glCopyBufferSubData(GLEXT_GL_COPY_READ_BUFFER, GLEXT_GL_COPY_WRITE_BUFFER, 0, 0, static_cast<GLsizeiptr>(sizeof(Vertex) * vertexBuffer.m_size)));
+        glCheck(GLEXT_glCopyBufferSubData(GLEXT_GL_COPY_READ_BUFFER, GLEXT_GL_COPY_WRITE_BUFFER,
+                                          static_cast<GLintptr>(vertexBuffer.getCurrentOffset()),
+                                          static_cast<GLintptr>(getCurrentOffset()),
+                                          static_cast<GLsizeiptr>(byteCount)));
 
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_WRITE_BUFFER, 0));
         glCheck(GLEXT_glBindBuffer(GLEXT_GL_COPY_READ_BUFFER, 0));
@@ -236,28 +334,28 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
         return true;
     }
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
-    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLsizeiptrARB>(sizeof(Vertex) * vertexBuffer.m_size), nullptr, VertexBufferImpl::usageToGlEnum(m_usage)));
+    priv::bindArrayBuffer(m_buffer);
+    glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLsizeiptrARB>(byteCount), nullptr, VertexBufferImpl::usageToGlEnum(m_usage)));
 
     void* destination = nullptr;
     glCheck(destination = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_WRITE_ONLY));
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer.m_buffer));
+    priv::bindArrayBuffer(vertexBuffer.m_buffer);
 
     void* source = nullptr;
     glCheck(source = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_READ_ONLY));
 
-    std::memcpy(destination, source, sizeof(Vertex) * vertexBuffer.m_size);
+    std::memcpy(destination, source, byteCount);
 
     GLboolean sourceResult = GL_FALSE;
     glCheck(sourceResult = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, m_buffer));
+    priv::bindArrayBuffer(m_buffer);
 
     GLboolean destinationResult = GL_FALSE;
     glCheck(destinationResult = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, 0));
+    priv::bindArrayBuffer(0);
 
     if ((sourceResult == GL_FALSE) || (destinationResult == GL_FALSE))
         return false;
@@ -268,6 +366,124 @@ bool VertexBuffer::update(const VertexBuffer& vertexBuffer)
 }
 
 
+////////////////////////////////////////////////////////////
+void* VertexBuffer::map(std::size_t firstVertex, std::size_t vertexCount)
+{
+    return mapRange(firstVertex, vertexCount, !firstVertex && (vertexCount == m_size));
+}
+
+
+////////////////////////////////////////////////////////////
+void* VertexBuffer::map(std::size_t vertexCount)
+{
+    return mapRange(0, vertexCount, true);
+}
+
+
+////////////////////////////////////////////////////////////
+void* VertexBuffer::mapRange(std::size_t firstVertex, std::size_t vertexCount, bool discard)
+{
+#ifdef SFML_OPENGL_ES
+
+    (void) firstVertex;
+    (void) vertexCount;
+    (void) discard;
+
+    err() << "Failed to map vertex buffer, mapping is not supported with OpenGL ES" << std::endl;
+    return nullptr;
+
+#else
+
+    // Sanity checks
+    if (!m_buffer || m_mapped)
+        return nullptr;
+
+    if (!vertexCount || (firstVertex + vertexCount > m_size))
+        return nullptr;
+
+    const std::size_t stride = m_layout.getStride();
+
+    TransientContextLock contextLock;
+
+    if (discard && (m_buffers > 1))
+        rotate();
+
+    const auto offset = static_cast<GLintptr>(getCurrentOffset() + stride * firstVertex);
+    const auto length = static_cast<GLsizeiptr>(stride * vertexCount);
+
+    priv::bindArrayBuffer(m_buffer);
+
+    void* pointer = nullptr;
+
+    if (GLEXT_map_buffer_range)
+    {
+        GLbitfield access = GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_INVALIDATE_RANGE_BIT;
+
+        // rotate() waited for the draws of the next buffer, the driver doesn't need to synchronize
+        if (discard && (m_buffers > 1))
+            access |= GLEXT_GL_MAP_UNSYNCHRONIZED_BIT;
+        else if (discard)
+            access = GLEXT_GL_MAP_WRITE_BIT | GLEXT_GL_MAP_INVALIDATE_BUFFER_BIT;
+
+        glCheck(pointer = GLEXT_glMapBufferRange(GLEXT_GL_ARRAY_BUFFER, offset, length, access));
+    }
+    else
+    {
+        // Orphan the buffer when its contents are discarded, so that the driver doesn't wait for the previous draws
+        if (discard)
+            glCheck(GLEXT_glBufferData(GLEXT_GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(stride * m_size), nullptr, VertexBufferImpl::usageToGlEnum(m_usage)));
+
+        glCheck(pointer = GLEXT_glMapBuffer(GLEXT_GL_ARRAY_BUFFER, GLEXT_GL_WRITE_ONLY));
+
+        if (pointer)
+            pointer = static_cast<char*>(pointer) + offset;
+    }
+
+    priv::bindArrayBuffer(0);
+
+    if (!pointer)
+    {
+        err() << "Failed to map vertex buffer" << std::endl;
+        return nullptr;
+    }
+
+    m_mapped = true;
+
+    return pointer;
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+bool VertexBuffer::unmap()
+{
+#ifdef SFML_OPENGL_ES
+
+    return false;
+
+#else
+
+    if (!m_buffer || !m_mapped)
+        return false;
+
+    TransientContextLock contextLock;
+
+    priv::bindArrayBuffer(m_buffer);
+
+    GLboolean result = GL_FALSE;
+    glCheck(result = GLEXT_glUnmapBuffer(GLEXT_GL_ARRAY_BUFFER));
+
+    priv::bindArrayBuffer(0);
+
+    m_mapped = false;
+
+    return result == GL_TRUE;
+
+#endif // SFML_OPENGL_ES
+}
+
+
 ////////////////////////////////////////////////////////////
 VertexBuffer& VertexBuffer::operator =(const VertexBuffer& right)
 {
@@ -286,6 +502,12 @@ void VertexBuffer::swap(VertexBuffer& right)
     std::swap(m_buffer,        right.m_buffer);
     std::swap(m_primitiveType, right.m_primitiveType);
     std::swap(m_usage,         right.m_usage);
+    std::swap(m_layout,        right.m_layout);
+    std::swap(m_bufferCount,   right.m_bufferCount);
+    std::swap(m_buffers,       right.m_buffers);
+    std::swap(m_current,       right.m_current);
+    std::swap(m_mapped,        right.m_mapped);
+    std::swap(m_fences,        right.m_fences);
 }
 
 
@@ -296,6 +518,38 @@ unsigned int VertexBuffer::getNativeHandle() const
 }
 
 
+////////////////////////////////////////////////////////////
+void VertexBuffer::setLayout(const VertexLayout& layout)
+{
+    // The vertex count is meaningless with a different vertex size
+    if (layout.getStride() != m_layout.getStride())
+        m_size = 0;
+
+    m_layout = layout;
+}
+
+
+////////////////////////////////////////////////////////////
+const VertexLayout& VertexBuffer::getLayout() const
+{
+    return m_layout;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::setBufferCount(unsigned int count)
+{
+    m_bufferCount = std::max(count, 1u);
+}
+
+
+////////////////////////////////////////////////////////////
+unsigned int VertexBuffer::getBufferCount() const
+{
+    return m_bufferCount;
+}
+
+
 ////////////////////////////////////////////////////////////
 void VertexBuffer::bind(const VertexBuffer* vertexBuffer)
 {
@@ -304,7 +558,7 @@ void VertexBuffer::bind(const VertexBuffer* vertexBuffer)
 
     TransientContextLock lock;
 
-    glCheck(GLEXT_glBindBuffer(GLEXT_GL_ARRAY_BUFFER, vertexBuffer ? vertexBuffer->m_buffer : 0));
+    priv::bindArrayBuffer(vertexBuffer ? vertexBuffer->m_buffer : 0);
 }
 
 
@@ -360,6 +614,82 @@ bool VertexBuffer::isAvailable()
 }
 
 
+////////////////////////////////////////////////////////////
+void VertexBuffer::rotate()
+{
+#ifndef SFML_OPENGL_ES
+
+    m_current = (m_current + 1) % m_buffers;
+
+    void*& fence = m_fences[m_current];
+
+    if (fence)
+    {
+        const auto sync = static_cast<GLEXT_GLsync>(fence);
+
+        // The last draw of this buffer was a few frames ago, it is normally finished already
+        GLenum result = GLEXT_GL_TIMEOUT_EXPIRED;
+        while (result == GLEXT_GL_TIMEOUT_EXPIRED)
+            glCheck(result = GLEXT_glClientWaitSync(sync, GLEXT_GL_SYNC_FLUSH_COMMANDS_BIT, 1000000));
+
+        glCheck(GLEXT_glDeleteSync(sync));
+        fence = nullptr;
+    }
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexBuffer::getCurrentOffset() const
+{
+    return m_layout.getStride() * m_size * m_current;
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::markDrawn() const
+{
+#ifndef SFML_OPENGL_ES
+
+    if (m_buffers < 2)
+        return;
+
+    if (m_fences.size() != m_buffers)
+        m_fences.resize(m_buffers, nullptr);
+
+    // A later fence signals after the earlier ones, only the last draw matters
+    void*& fence = m_fences[m_current];
+
+    if (fence)
+        glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(fence)));
+
+    glCheck(fence = GLEXT_glFenceSync(GLEXT_GL_SYNC_GPU_COMMANDS_COMPLETE, 0));
+
+    // The fence may be waited for from another context, make sure it reaches the graphics card
+    glCheck(glFlush());
+
+#endif // SFML_OPENGL_ES
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexBuffer::clearFences()
+{
+#ifndef SFML_OPENGL_ES
+
+    for (void* fence : m_fences)
+    {
+        if (fence)
+            glCheck(GLEXT_glDeleteSync(static_cast<GLEXT_GLsync>(fence)));
+    }
+
+#endif // SFML_OPENGL_ES
+
+    m_fences.assign(m_buffers, nullptr);
+}
+
+
 ////////////////////////////////////////////////////////////
 void VertexBuffer::draw(RenderTarget& target, const RenderStates& states) const
 {
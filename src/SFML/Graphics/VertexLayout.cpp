@@ -0,0 +1,184 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Graphics/VertexLayout.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/System/Err.hpp>
+#include <iomanip>
+#include <ostream>
+
+
+namespace
+{
+    // A nested named namespace is used here to allow unity builds of SFML.
+    namespace VertexLayoutImpl
+    {
+        // Built-in attributes go through the fixed pipeline, which can't read unsigned or normalized integers
+        bool isBuiltInType(sf::VertexLayout::Type type)
+        {
+            return (type == sf::VertexLayout::Float) || (type == sf::VertexLayout::HalfFloat) || (type == sf::VertexLayout::Short);
+        }
+
+        sf::VertexLayout makeColoredLayout()
+        {
+            sf::VertexLayout layout(sizeof(sf::ColoredVertex), sf::VertexLayout::Float, offsetof(sf::ColoredVertex, position));
+            layout.setColor(offsetof(sf::ColoredVertex, color));
+            return layout;
+        }
+
+        sf::VertexLayout makeCompactLayout()
+        {
+            sf::VertexLayout layout(sizeof(sf::CompactVertex), sf::VertexLayout::Short, offsetof(sf::CompactVertex, position));
+            layout.setColor(offsetof(sf::CompactVertex, color));
+            layout.setTexCoords(sf::VertexLayout::Short, offsetof(sf::CompactVertex, texCoords));
+            return layout;
+        }
+    }
+}
+
+
+namespace sf
+{
+////////////////////////////////////////////////////////////
+const VertexLayout VertexLayout::Default;
+const VertexLayout VertexLayout::Colored = VertexLayoutImpl::makeColoredLayout();
+const VertexLayout VertexLayout::Compact = VertexLayoutImpl::makeCompactLayout();
+
+
+////////////////////////////////////////////////////////////
+VertexLayout::VertexLayout() :
+m_stride    (sizeof(Vertex)),
+m_position  {"", Float, 2, false, offsetof(Vertex, position)},
+m_color     (Attribute{"", UnsignedByte, 4, true, offsetof(Vertex, color)}),
+m_texCoords (Attribute{"", Float, 2, false, offsetof(Vertex, texCoords)}),
+m_attributes()
+{
+}
+
+
+////////////////////////////////////////////////////////////
+VertexLayout::VertexLayout(std::size_t stride, Type positionType, std::size_t positionOffset) :
+m_stride    (stride),
+m_position  {"", positionType, 2, false, positionOffset},
+m_color     (),
+m_texCoords (),
+m_attributes()
+{
+    if (!VertexLayoutImpl::isBuiltInType(positionType))
+    {
+        err() << "Vertex positions must be stored as Float, HalfFloat or Short, falling back to Float" << std::endl;
+        m_position.type = Float;
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexLayout::setColor(std::size_t offset)
+{
+    m_color = Attribute{"", UnsignedByte, 4, true, offset};
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexLayout::setTexCoords(Type type, std::size_t offset)
+{
+    if (!VertexLayoutImpl::isBuiltInType(type))
+    {
+        err() << "Vertex texture coordinates must be stored as Float, HalfFloat or Short "
+              << "(use a custom attribute to pass other types to a shader)" << std::endl;
+        return;
+    }
+
+    m_texCoords = Attribute{"", type, 2, false, offset};
+}
+
+
+////////////////////////////////////////////////////////////
+void VertexLayout::addAttribute(const std::string& name, Type type, unsigned int size, bool normalized, std::size_t offset)
+{
+    if (name.empty() || (size < 1) || (size > 4))
+    {
+        err() << "Failed to add vertex attribute " << std::quoted(name)
+              << ", it must have a name and from 1 to 4 components" << std::endl;
+        return;
+    }
+
+    m_attributes.push_back(Attribute{name, type, size, normalized, offset});
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexLayout::getStride() const
+{
+    return m_stride;
+}
+
+
+////////////////////////////////////////////////////////////
+const VertexLayout::Attribute& VertexLayout::getPosition() const
+{
+    return m_position;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::optional<VertexLayout::Attribute>& VertexLayout::getColor() const
+{
+    return m_color;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::optional<VertexLayout::Attribute>& VertexLayout::getTexCoords() const
+{
+    return m_texCoords;
+}
+
+
+////////////////////////////////////////////////////////////
+const std::vector<VertexLayout::Attribute>& VertexLayout::getAttributes() const
+{
+    return m_attributes;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t VertexLayout::getTypeSize(Type type)
+{
+    switch (type)
+    {
+        case Float:         return 4;
+        case HalfFloat:     return 2;
+        case Short:         return 2;
+        case UnsignedShort: return 2;
+        case UnsignedByte:  return 1;
+    }
+
+    return 0;
+}
+
+} // namespace sf
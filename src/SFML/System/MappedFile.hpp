@@ -0,0 +1,122 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_MAPPEDFILE_HPP
+#define SFML_MAPPEDFILE_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <cstddef>
+#include <filesystem>
+
+
+namespace sf::priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Read-only view of a file mapped in memory
+///
+/// The pages of the file are loaded on demand by the operating
+/// system and shared between all the processes that map the
+/// same file, instead of being copied into a heap buffer.
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API MappedFile
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Default constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    MappedFile();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~MappedFile();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    MappedFile(const MappedFile&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Map a file in memory
+    ///
+    /// Any previously mapped file is unmapped first.
+    /// Empty files can't be mapped.
+    ///
+    /// \param filename Path of the file to map
+    ///
+    /// \return True if the file was successfully mapped
+    ///
+    ////////////////////////////////////////////////////////////
+    [[nodiscard]] bool open(const std::filesystem::path& filename);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Unmap the file
+    ///
+    ////////////////////////////////////////////////////////////
+    void close();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get a pointer to the contents of the file
+    ///
+    /// \return Pointer to the mapped bytes, or null if no file is mapped
+    ///
+    ////////////////////////////////////////////////////////////
+    const void* getData() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the size of the file
+    ///
+    /// \return Size of the mapped file, in bytes
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getSize() const;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    const void* m_data;    //!< Address of the mapping
+    std::size_t m_size;    //!< Size of the mapping, in bytes
+    void*       m_mapping; //!< OS handle of the mapping, if the OS needs one
+};
+
+} // namespace sf::priv
+
+
+#endif // SFML_MAPPEDFILE_HPP
@@ -0,0 +1,206 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/ThreadPool.hpp>
+#include <algorithm>
+#include <exception>
+
+
+namespace sf::priv
+{
+////////////////////////////////////////////////////////////
+ThreadPool::ThreadPool(std::size_t threadCount) :
+m_threads  (),
+m_tasks    (),
+m_mutex    (),
+m_condition(),
+m_stopping (false)
+{
+    m_threads.reserve(threadCount);
+    for (std::size_t i = 0; i < threadCount; ++i)
+        m_threads.emplace_back(&ThreadPool::work, this);
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+
+    m_condition.notify_all();
+
+    for (std::thread& thread : m_threads)
+        thread.join();
+}
+
+
+////////////////////////////////////////////////////////////
+ThreadPool& ThreadPool::getGlobal()
+{
+    static ThreadPool pool(std::max(std::thread::hardware_concurrency(), 1u) - 1);
+    return pool;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t ThreadPool::getThreadCount() const
+{
+    return m_threads.size();
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::enqueue(std::function<void()> task)
+{
+    if (m_threads.empty())
+    {
+        task();
+        return;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+
+    m_condition.notify_all();
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::parallelFor(std::size_t count, std::size_t minChunk, const std::function<void(std::size_t, std::size_t)>& function)
+{
+    if (count == 0)
+        return;
+
+    // Use at most one chunk per thread, including the calling one
+    std::size_t chunks = std::min(count / std::max(minChunk, std::size_t(1)), m_threads.size() + 1);
+    if (chunks <= 1)
+    {
+        function(0, count);
+        return;
+    }
+
+    // Queue all the chunks but the first one, which is processed by the calling thread.
+    // The tasks reference local variables, so this function must not return (or throw)
+    // before all of them are done: exceptions are caught and the first one is rethrown
+    // once every chunk has finished
+    std::size_t        remaining = chunks - 1;
+    std::exception_ptr exception;
+    {
+        std::lock_guard lock(m_mutex);
+        for (std::size_t i = 1; i < chunks; ++i)
+        {
+            std::size_t begin = count * i / chunks;
+            std::size_t end   = count * (i + 1) / chunks;
+            m_tasks.push_back([this, &function, &remaining, &exception, begin, end]
+            {
+                std::exception_ptr taskException;
+                try
+                {
+                    function(begin, end);
+                }
+                catch (...)
+                {
+                    taskException = std::current_exception();
+                }
+
+                std::lock_guard taskLock(m_mutex);
+                if (taskException && !exception)
+                    exception = taskException;
+                --remaining;
+                m_condition.notify_all();
+            });
+        }
+    }
+
+    m_condition.notify_all();
+
+    std::exception_ptr callerException;
+    try
+    {
+        function(0, count / chunks);
+    }
+    catch (...)
+    {
+        callerException = std::current_exception();
+    }
+
+    // Help with the queued tasks rather than waiting idle: this also
+    // guarantees progress when parallelFor is called from a worker
+    std::unique_lock lock(m_mutex);
+    while (remaining > 0)
+    {
+        if (!runPendingTask(lock))
+            m_condition.wait(lock);
+    }
+
+    if (callerException)
+        std::rethrow_exception(callerException);
+
+    if (exception)
+        std::rethrow_exception(exception);
+}
+
+
+////////////////////////////////////////////////////////////
+bool ThreadPool::runPendingTask(std::unique_lock<std::mutex>& lock)
+{
+    if (m_tasks.empty())
+        return false;
+
+    std::function<void()> task = std::move(m_tasks.front());
+    m_tasks.pop_front();
+
+    lock.unlock();
+    task();
+    lock.lock();
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void ThreadPool::work()
+{
+    std::unique_lock lock(m_mutex);
+    for (;;)
+    {
+        if (runPendingTask(lock))
+            continue;
+
+        if (m_stopping)
+            return;
+
+        m_condition.wait(lock);
+    }
+}
+
+} // namespace sf::priv
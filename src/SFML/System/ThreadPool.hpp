@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_THREADPOOL_HPP
+#define SFML_THREADPOOL_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/Export.hpp>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace sf::priv
+{
+////////////////////////////////////////////////////////////
+/// \brief Fixed set of worker threads executing queued tasks
+///
+////////////////////////////////////////////////////////////
+class SFML_SYSTEM_API ThreadPool
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the pool and start its workers
+    ///
+    /// \param threadCount Number of worker threads, may be 0
+    ///
+    ////////////////////////////////////////////////////////////
+    explicit ThreadPool(std::size_t threadCount);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    /// Executes the remaining tasks, then stops the workers.
+    ///
+    ////////////////////////////////////////////////////////////
+    ~ThreadPool();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy constructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ThreadPool(const ThreadPool&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Deleted copy assignment
+    ///
+    ////////////////////////////////////////////////////////////
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the pool shared by the whole library
+    ///
+    /// It has one worker less than the number of hardware
+    /// threads, since the threads which submit work to it
+    /// take part in its execution.
+    ///
+    /// \return Shared pool
+    ///
+    ////////////////////////////////////////////////////////////
+    static ThreadPool& getGlobal();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the number of worker threads
+    ///
+    /// \return Number of workers
+    ///
+    ////////////////////////////////////////////////////////////
+    std::size_t getThreadCount() const;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Queue a task to be executed by a worker
+    ///
+    /// If the pool has no worker, the task is executed immediately.
+    ///
+    /// \param task Task to execute
+    ///
+    ////////////////////////////////////////////////////////////
+    void enqueue(std::function<void()> task);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Split a range of items into chunks processed in parallel
+    ///
+    /// \a function is called with the bounds [begin, end) of each
+    /// chunk. The calling thread processes chunks too, and the
+    /// function returns once all of them are done. Ranges too
+    /// small to be split are processed by the calling thread only.
+    /// It is safe to call this function from a task of the pool.
+    /// If chunks throw, the function still waits for all of them
+    /// and then rethrows the first exception.
+    ///
+    /// \param count    Number of items
+    /// \param minChunk Minimum number of items per chunk
+    /// \param function Function processing a chunk
+    ///
+    ////////////////////////////////////////////////////////////
+    void parallelFor(std::size_t count, std::size_t minChunk, const std::function<void(std::size_t, std::size_t)>& function);
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Execute one queued task, if there is one
+    ///
+    /// \param lock Lock on the queue, released while the task runs
+    ///
+    /// \return True if a task was executed
+    ///
+    ////////////////////////////////////////////////////////////
+    bool runPendingTask(std::unique_lock<std::mutex>& lock);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Main function of the worker threads
+    ///
+    ////////////////////////////////////////////////////////////
+    void work();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    std::vector<std::thread>          m_threads;   //!< Worker threads
+    std::deque<std::function<void()>> m_tasks;     //!< Tasks waiting for a worker
+    std::mutex                        m_mutex;     //!< Protects the queue
+    std::condition_variable           m_condition; //!< Signaled when a task is queued or completed, or when the pool stops
+    bool                              m_stopping;  //!< Are the workers being stopped?
+};
+
+} // namespace sf::priv
+
+
+#endif // SFML_THREADPOOL_HPP
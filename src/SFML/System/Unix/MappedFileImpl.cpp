@@ -0,0 +1,104 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/MappedFile.hpp>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+namespace sf::priv
+{
+////////////////////////////////////////////////////////////
+MappedFile::MappedFile() :
+m_data   (nullptr),
+m_size   (0),
+m_mapping(nullptr)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFile::open(const std::filesystem::path& filename)
+{
+    close();
+
+    int file = ::open(filename.c_str(), O_RDONLY);
+    if (file == -1)
+        return false;
+
+    // The mapping stays valid after the descriptor is closed
+    struct stat status;
+    void* data = MAP_FAILED;
+    if ((fstat(file, &status) == 0) && (status.st_size > 0))
+        data = mmap(nullptr, static_cast<std::size_t>(status.st_size), PROT_READ, MAP_PRIVATE, file, 0);
+
+    ::close(file);
+
+    if (data == MAP_FAILED)
+        return false;
+
+    m_data = data;
+    m_size = static_cast<std::size_t>(status.st_size);
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void MappedFile::close()
+{
+    if (m_data)
+        munmap(const_cast<void*>(m_data), m_size);
+
+    m_data = nullptr;
+    m_size = 0;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* MappedFile::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t MappedFile::getSize() const
+{
+    return m_size;
+}
+
+} // namespace sf::priv
@@ -0,0 +1,113 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/System/MappedFile.hpp>
+#include <SFML/System/Win32/WindowsHeader.hpp>
+
+
+namespace sf::priv
+{
+////////////////////////////////////////////////////////////
+MappedFile::MappedFile() :
+m_data   (nullptr),
+m_size   (0),
+m_mapping(nullptr)
+{
+}
+
+
+////////////////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+    close();
+}
+
+
+////////////////////////////////////////////////////////////
+bool MappedFile::open(const std::filesystem::path& filename)
+{
+    close();
+
+    HANDLE file = CreateFileW(filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+
+    // The mapping object keeps the file open, the file handle isn't needed anymore once it is created
+    LARGE_INTEGER size;
+    HANDLE mapping = nullptr;
+    if (GetFileSizeEx(file, &size) && (size.QuadPart > 0))
+        mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+    CloseHandle(file);
+
+    if (!mapping)
+        return false;
+
+    const void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!data)
+    {
+        CloseHandle(mapping);
+        return false;
+    }
+
+    m_data    = data;
+    m_size    = static_cast<std::size_t>(size.QuadPart);
+    m_mapping = mapping;
+
+    return true;
+}
+
+
+////////////////////////////////////////////////////////////
+void MappedFile::close()
+{
+    if (m_data)
+        UnmapViewOfFile(m_data);
+
+    if (m_mapping)
+        CloseHandle(static_cast<HANDLE>(m_mapping));
+
+    m_data    = nullptr;
+    m_size    = 0;
+    m_mapping = nullptr;
+}
+
+
+////////////////////////////////////////////////////////////
+const void* MappedFile::getData() const
+{
+    return m_data;
+}
+
+
+////////////////////////////////////////////////////////////
+std::size_t MappedFile::getSize() const
+{
+    return m_size;
+}
+
+} // namespace sf::priv
@@ -103,6 +103,13 @@ Uint64 Context::getActiveContextId()
 }
 
 
+////////////////////////////////////////////////////////////
+Context::Statistics Context::getStatistics()
+{
+    return priv::GlContext::getStatistics();
+}
+
+
 ////////////////////////////////////////////////////////////
 bool Context::isExtensionAvailable(const char* name)
 {
@@ -28,14 +28,15 @@
 #include <SFML/Window/GlContext.hpp>
 #include <SFML/Window/Context.hpp>
 #include <SFML/Window/EglContext.hpp>
+#include <SFML/System/Clock.hpp>
 #include <SFML/System/Err.hpp>
 #include <glad/gl.h>
 
 #include <algorithm>
+#include <atomic>
 #include <iomanip>
 #include <memory>
 #include <mutex>
-#include <optional>
 #include <ostream>
 #include <string>
 #include <unordered_map>
@@ -77,6 +78,15 @@
         #include <SFML/Window/Unix/GlxContext.hpp>
         using ContextType = sf::priv::GlxContext;
 
+        #if !defined(SFML_SYSTEM_EMSCRIPTEN)
+
+            // Without a display, contexts are created through EGL instead of GLX
+            #include <SFML/Window/Unix/Display.hpp>
+            #include <SFML/Window/Unix/HeadlessContext.hpp>
+            #define SFML_HEADLESS_CONTEXT
+
+        #endif
+
     #endif
 
 #elif defined(SFML_SYSTEM_MACOS)
@@ -161,13 +171,56 @@ namespace
     // A nested named namespace is used here to allow unity builds of SFML.
     namespace GlContextImpl
     {
+        // Statistics about the contention on the global mutex
+        std::atomic<sf::Uint64> lockCount(0);
+        std::atomic<sf::Uint64> contendedLockCount(0);
+        std::atomic<sf::Int64>  lockWaitTime(0);
+        std::atomic<sf::Uint64> transientContextCount(0);
+
+        // Recursive mutex which records how often and how long threads wait for it
+        class InstrumentedMutex
+        {
+        public:
+
+            void lock()
+            {
+                if (!m_mutex.try_lock())
+                {
+                    sf::Clock clock;
+                    m_mutex.lock();
+                    lockWaitTime.fetch_add(clock.getElapsedTime().asMicroseconds(), std::memory_order_relaxed);
+                    contendedLockCount.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                lockCount.fetch_add(1, std::memory_order_relaxed);
+            }
+
+            bool try_lock()
+            {
+                if (!m_mutex.try_lock())
+                    return false;
+
+                lockCount.fetch_add(1, std::memory_order_relaxed);
+                return true;
+            }
+
+            void unlock()
+            {
+                m_mutex.unlock();
+            }
+
+        private:
+
+            std::recursive_mutex m_mutex;
+        };
+
         // AMD drivers have issues with internal synchronization
         // We need to make sure that no operating system context
         // or pixel format operations are performed simultaneously
         // This mutex is also used to protect the shared context
-        // from being locked on multiple threads and for managing
-        // the resource count
-        std::recursive_mutex mutex;
+        // from being activated on multiple threads, the pool of
+        // transient contexts and the resource count
+        InstrumentedMutex mutex;
 
         // OpenGL resources counter
         unsigned int resourceCount = 0;
@@ -176,7 +229,41 @@ namespace
         thread_local sf::priv::GlContext* currentContext(nullptr);
 
         // The hidden, inactive context that will be shared with all other contexts
-        std::unique_ptr<ContextType> sharedContext;
+        std::unique_ptr<sf::priv::GlContext> sharedContext;
+
+        // Inactive contexts sharing with the shared context, lent to the
+        // threads which need a transient context and have no active context
+        // Each thread activates its own, so they don't serialize on the mutex
+        std::vector<std::unique_ptr<sf::priv::GlContext>> transientContextPool;
+
+        // Are the contexts created without a display server?
+        bool headless = false;
+
+        // Create a context of the type used by the process
+        template <typename... Args>
+        std::unique_ptr<sf::priv::GlContext> createContext(sf::priv::GlContext* shared, const Args&... args)
+        {
+#if defined(SFML_HEADLESS_CONTEXT)
+            if (headless)
+                return std::make_unique<sf::priv::HeadlessContext>(static_cast<sf::priv::HeadlessContext*>(shared), args...);
+#endif
+
+            return std::make_unique<ContextType>(static_cast<ContextType*>(shared), args...);
+        }
+
+        // Decide whether the contexts must be created without a display server
+        bool useHeadlessContexts()
+        {
+#if defined(SFML_HEADLESS_CONTEXT)
+            // The SFML_HEADLESS environment variable forces the choice
+            if (const char* value = std::getenv("SFML_HEADLESS"); value && *value)
+                return (std::strcmp(value, "0") != 0) && sf::priv::HeadlessContext::isAvailable();
+
+            return !sf::priv::IsDisplayAvailable() && sf::priv::HeadlessContext::isAvailable();
+#else
+            return false;
+#endif
+        }
 
         // Unique identifier, used for identifying contexts when managing unshareable OpenGL resources
         sf::Uint64 id = 1; // start at 1, zero is "no context"
@@ -197,20 +284,31 @@ namespace
             ///
             ////////////////////////////////////////////////////////////
             TransientContext() :
-            referenceCount   (0),
-            context          (nullptr),
-            sharedContextLock(),
-            useSharedContext (false)
+            referenceCount(0),
+            context       (nullptr),
+            pooledContext (nullptr)
             {
+                std::scoped_lock lock(mutex);
+
                 if (resourceCount == 0)
                 {
                     context = std::make_unique<sf::Context>();
                 }
                 else if (!currentContext)
                 {
-                    sharedContextLock.emplace(mutex);
-                    useSharedContext = true;
-                    sharedContext->setActive(true);
+                    if (!transientContextPool.empty())
+                    {
+                        pooledContext = std::move(transientContextPool.back());
+                        transientContextPool.pop_back();
+                    }
+                    else
+                    {
+                        // Create a context sharing with the shared context
+                        pooledContext = sf::priv::GlContext::create();
+                        transientContextCount.fetch_add(1, std::memory_order_relaxed);
+                    }
+
+                    pooledContext->setActive(true);
                 }
             }
 
@@ -220,10 +318,30 @@ namespace
             ////////////////////////////////////////////////////////////
             ~TransientContext()
             {
-                if (useSharedContext)
-                    sharedContext->setActive(false);
+                if (pooledContext)
+                {
+                    pooledContext->setActive(false);
+
+                    std::scoped_lock lock(mutex);
+
+                    // Give the context back, unless the shared context was destroyed in the meantime
+                    if (sharedContext)
+                    {
+                        transientContextPool.push_back(std::move(pooledContext));
+                    }
+                    else
+                    {
+                        // The context is activated again to run the destroy callbacks, and without shared
+                        // context its destructor doesn't reset the current context of the thread
+                        sf::priv::GlContext* destroyedContext = pooledContext.get();
+                        pooledContext.reset();
+
+                        if (currentContext == destroyedContext)
+                            currentContext = nullptr;
+                    }
+                }
 
-                sharedContextLock.reset();
+                pooledContext.reset();
                 context.reset();
             }
 
@@ -242,10 +360,9 @@ namespace
             ///////////////////////////////////////////////////////////
             // Member data
             ////////////////////////////////////////////////////////////
-            unsigned int                                          referenceCount;
-            std::unique_ptr<sf::Context>                          context;
-            std::optional<std::scoped_lock<std::recursive_mutex>> sharedContextLock;
-            bool                                                  useSharedContext;
+            unsigned int                         referenceCount;
+            std::unique_ptr<sf::Context>         context;
+            std::unique_ptr<sf::priv::GlContext> pooledContext;
         };
 
         // This per-thread variable tracks if and how a transient
@@ -340,6 +457,9 @@ void GlContext::initResource()
     using GlContextImpl::resourceCount;
     using GlContextImpl::currentContext;
     using GlContextImpl::sharedContext;
+    using GlContextImpl::headless;
+    using GlContextImpl::createContext;
+    using GlContextImpl::useHeadlessContexts;
     using GlContextImpl::loadExtensions;
 
     // Protect from concurrent access
@@ -357,7 +477,8 @@ void GlContext::initResource()
         }
 
         // Create the shared context
-        sharedContext = std::make_unique<ContextType>(nullptr);
+        headless = useHeadlessContexts();
+        sharedContext = createContext(nullptr);
         sharedContext->initialize(ContextSettings());
 
         // Load our extensions vector
@@ -378,6 +499,7 @@ void GlContext::cleanupResource()
     using GlContextImpl::mutex;
     using GlContextImpl::resourceCount;
     using GlContextImpl::sharedContext;
+    using GlContextImpl::transientContextPool;
 
     // Protect from concurrent access
     std::scoped_lock lock(mutex);
@@ -391,7 +513,10 @@ void GlContext::cleanupResource()
         if (!sharedContext)
             return;
 
-        // Destroy the shared context
+        // Destroy the transient contexts, then the shared context
+        // Each context runs the destroy callbacks (cleanupUnsharedResources) in its destructor, so the
+        // unshared objects of the pooled contexts, such as FBOs, are released while the shared context is alive
+        transientContextPool.clear();
         sharedContext.reset();
     }
 }
@@ -407,12 +532,11 @@ void GlContext::registerContextDestroyCallback(ContextDestroyCallback callback,
 ////////////////////////////////////////////////////////////
 void GlContext::acquireTransientContext()
 {
-    using GlContextImpl::mutex;
     using GlContextImpl::TransientContext;
     using GlContextImpl::transientContext;
 
-    // Protect from concurrent access
-    std::scoped_lock lock(mutex);
+    // The state object is local to this thread, only its
+    // construction and destruction need to be protected
 
     // If this is the first TransientContextLock on this thread
     // construct the state object
@@ -427,12 +551,8 @@ void GlContext::acquireTransientContext()
 ////////////////////////////////////////////////////////////
 void GlContext::releaseTransientContext()
 {
-    using GlContextImpl::mutex;
     using GlContextImpl::transientContext;
 
-    // Protect from concurrent access
-    std::scoped_lock lock(mutex);
-
     // Make sure a matching acquireTransientContext() was called
     assert(transientContext);
 
@@ -448,11 +568,29 @@ void GlContext::releaseTransientContext()
 }
 
 
+////////////////////////////////////////////////////////////
+Context::Statistics GlContext::getStatistics()
+{
+    using GlContextImpl::lockCount;
+    using GlContextImpl::contendedLockCount;
+    using GlContextImpl::lockWaitTime;
+    using GlContextImpl::transientContextCount;
+
+    Context::Statistics statistics;
+    statistics.lockCount             = lockCount.load(std::memory_order_relaxed);
+    statistics.contendedLockCount    = contendedLockCount.load(std::memory_order_relaxed);
+    statistics.lockWaitTime          = microseconds(lockWaitTime.load(std::memory_order_relaxed));
+    statistics.transientContextCount = transientContextCount.load(std::memory_order_relaxed);
+    return statistics;
+}
+
+
 ////////////////////////////////////////////////////////////
 std::unique_ptr<GlContext> GlContext::create()
 {
     using GlContextImpl::mutex;
     using GlContextImpl::sharedContext;
+    using GlContextImpl::createContext;
 
     // Make sure that there's an active context (context creation may need extensions, and thus a valid context)
     assert(sharedContext != nullptr);
@@ -468,7 +606,7 @@ std::unique_ptr<GlContext> GlContext::create()
         sharedContext->setActive(true);
 
         // Create the context
-        context = std::make_unique<ContextType>(sharedContext.get());
+        context = createContext(sharedContext.get());
 
         sharedContext->setActive(false);
     }
@@ -485,6 +623,7 @@ std::unique_ptr<GlContext> GlContext::create(const ContextSettings& settings, co
     using GlContextImpl::mutex;
     using GlContextImpl::resourceCount;
     using GlContextImpl::sharedContext;
+    using GlContextImpl::createContext;
     using GlContextImpl::loadExtensions;
 
     // Make sure that there's an active context (context creation may need extensions, and thus a valid context)
@@ -503,7 +642,7 @@ std::unique_ptr<GlContext> GlContext::create(const ContextSettings& settings, co
         // Re-create our shared context as a core context
         ContextSettings sharedSettings(0, 0, 0, settings.majorVersion, settings.minorVersion, settings.attributeFlags);
 
-        sharedContext = std::make_unique<ContextType>(nullptr, sharedSettings, 1, 1);
+        sharedContext = createContext(nullptr, sharedSettings, 1u, 1u);
         sharedContext->initialize(sharedSettings);
 
         // Reload our extensions vector
@@ -519,7 +658,7 @@ std::unique_ptr<GlContext> GlContext::create(const ContextSettings& settings, co
         sharedContext->setActive(true);
 
         // Create the context
-        context = std::make_unique<ContextType>(sharedContext.get(), settings, owner, bitsPerPixel);
+        context = createContext(sharedContext.get(), settings, owner, bitsPerPixel);
 
         sharedContext->setActive(false);
     }
@@ -537,6 +676,7 @@ std::unique_ptr<GlContext> GlContext::create(const ContextSettings& settings, un
     using GlContextImpl::mutex;
     using GlContextImpl::resourceCount;
     using GlContextImpl::sharedContext;
+    using GlContextImpl::createContext;
     using GlContextImpl::loadExtensions;
 
     // Make sure that there's an active context (context creation may need extensions, and thus a valid context)
@@ -555,7 +695,7 @@ std::unique_ptr<GlContext> GlContext::create(const ContextSettings& settings, un
         // Re-create our shared context as a core context
         ContextSettings sharedSettings(0, 0, 0, settings.majorVersion, settings.minorVersion, settings.attributeFlags);
 
-        sharedContext = std::make_unique<ContextType>(nullptr, sharedSettings, 1, 1);
+        sharedContext = createContext(nullptr, sharedSettings, 1u, 1u);
         sharedContext->initialize(sharedSettings);
 
         // Reload our extensions vector
@@ -571,7 +711,7 @@ std::unique_ptr<GlContext> GlContext::create(const ContextSettings& settings, un
         sharedContext->setActive(true);
 
         // Create the context
-        context = std::make_unique<ContextType>(sharedContext.get(), settings, width, height);
+        context = createContext(sharedContext.get(), settings, width, height);
 
         sharedContext->setActive(false);
     }
@@ -596,6 +736,11 @@ GlFunctionPointer GlContext::getFunction(const char* name)
 {
     std::scoped_lock lock(GlContextImpl::mutex);
 
+#if defined(SFML_HEADLESS_CONTEXT)
+    if (GlContextImpl::headless)
+        return HeadlessContext::getFunction(name);
+#endif
+
     return ContextType::getFunction(name);
 }
 
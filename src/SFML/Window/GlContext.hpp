@@ -95,6 +95,14 @@ public:
     ////////////////////////////////////////////////////////////
     static void releaseTransientContext();
 
+    ////////////////////////////////////////////////////////////
+    /// \brief Get statistics about the synchronization of the contexts
+    ///
+    /// \return Statistics accumulated since the start of the program
+    ///
+    ////////////////////////////////////////////////////////////
+    static Context::Statistics getStatistics();
+
     ////////////////////////////////////////////////////////////
     /// \brief Create a new context, not associated to a window
     ///
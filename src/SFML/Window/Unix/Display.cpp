@@ -75,6 +75,24 @@ Display* OpenDisplay()
 }
 
 
+////////////////////////////////////////////////////////////
+bool IsDisplayAvailable()
+{
+    std::scoped_lock lock(mutex);
+
+    if (referenceCount > 0)
+        return true;
+
+    Display* display = XOpenDisplay(nullptr);
+
+    if (!display)
+        return false;
+
+    XCloseDisplay(display);
+    return true;
+}
+
+
 ////////////////////////////////////////////////////////////
 void CloseDisplay(Display* display)
 {
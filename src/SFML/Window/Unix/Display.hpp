@@ -47,6 +47,17 @@ namespace priv
 ////////////////////////////////////////////////////////////
 Display* OpenDisplay();
 
+////////////////////////////////////////////////////////////
+/// \brief Check whether a connection to the X server can be opened
+///
+/// Unlike OpenDisplay, this function doesn't abort the program
+/// when there is no X server to connect to.
+///
+/// \return True if the display is available
+///
+////////////////////////////////////////////////////////////
+bool IsDisplayAvailable();
+
 ////////////////////////////////////////////////////////////
 /// \brief Release a reference to the shared display
 ///
@@ -0,0 +1,455 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/Unix/HeadlessContext.hpp>
+#include <SFML/Window/EGLCheck.hpp>
+#include <SFML/System/Err.hpp>
+#include <cstring>
+#include <ostream>
+#include <vector>
+
+// Tokens of the extensions that are not part of our EGL loader
+#if !defined(EGL_PLATFORM_DEVICE_EXT)
+    #define EGL_PLATFORM_DEVICE_EXT 0x313F
+#endif
+
+#if !defined(EGL_PLATFORM_SURFACELESS_MESA)
+    #define EGL_PLATFORM_SURFACELESS_MESA 0x31DD
+#endif
+
+
+namespace
+{
+    // A nested named namespace is used here to allow unity builds of SFML.
+    namespace HeadlessContextImpl
+    {
+        using eglGetPlatformDisplayEXTFuncType = EGLDisplay (GLAD_API_PTR *)(EGLenum, void*, const EGLint*);
+        using eglQueryDevicesEXTFuncType = EGLBoolean (GLAD_API_PTR *)(EGLint, EGLDeviceEXT*, EGLint*);
+
+        // Whether contexts can be made current without any surface
+        bool surfaceless = false;
+
+        // Check whether an extension appears in an EGL extension string
+        bool hasExtension(const char* extensions, const char* name)
+        {
+            if (!extensions)
+                return false;
+
+            const std::size_t length = std::strlen(name);
+
+            for (const char* start = std::strstr(extensions, name); start; start = std::strstr(start + length, name))
+            {
+                if (((start == extensions) || (start[-1] == ' ')) && ((start[length] == ' ') || (start[length] == '\0')))
+                    return true;
+            }
+
+            return false;
+        }
+
+        // Get the display used by all the headless contexts, initializing it on first use
+        EGLDisplay getInitializedDisplay()
+        {
+            static bool initialized = false;
+            static EGLDisplay display = EGL_NO_DISPLAY;
+
+            if (initialized)
+                return display;
+
+            initialized = true;
+
+            // We don't check the return value since the extension
+            // flags are cleared even if loading fails
+            gladLoaderLoadEGL(EGL_NO_DISPLAY);
+
+            if (!eglGetProcAddress || !eglQueryString)
+            {
+                sf::err() << "Failed to load EGL, headless contexts are not available" << std::endl;
+                return EGL_NO_DISPLAY;
+            }
+
+            const char* clientExtensions = nullptr;
+            eglCheck(clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS));
+
+            auto eglGetPlatformDisplayEXTFunc = reinterpret_cast<eglGetPlatformDisplayEXTFuncType>(eglGetProcAddress("eglGetPlatformDisplayEXT"));
+
+            if (eglGetPlatformDisplayEXTFunc)
+            {
+                // Mesa can create contexts without any display server or device
+                if (hasExtension(clientExtensions, "EGL_MESA_platform_surfaceless"))
+                {
+                    eglCheck(display = eglGetPlatformDisplayEXTFunc(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr));
+                }
+
+                // Other drivers expose their devices directly
+                if ((display == EGL_NO_DISPLAY) && hasExtension(clientExtensions, "EGL_EXT_platform_device"))
+                {
+                    auto eglQueryDevicesEXTFunc = reinterpret_cast<eglQueryDevicesEXTFuncType>(eglGetProcAddress("eglQueryDevicesEXT"));
+
+                    EGLDeviceEXT device = nullptr;
+                    EGLint deviceCount = 0;
+
+                    if (eglQueryDevicesEXTFunc && eglQueryDevicesEXTFunc(1, &device, &deviceCount) && (deviceCount > 0))
+                        eglCheck(display = eglGetPlatformDisplayEXTFunc(EGL_PLATFORM_DEVICE_EXT, device, nullptr));
+                }
+            }
+
+            if (display == EGL_NO_DISPLAY)
+            {
+                sf::err() << "Failed to get an EGL display without display server, headless contexts are not available" << std::endl;
+                return EGL_NO_DISPLAY;
+            }
+
+            EGLBoolean result = EGL_FALSE;
+            eglCheck(result = eglInitialize(display, nullptr, nullptr));
+
+            if (result == EGL_FALSE)
+            {
+                sf::err() << "Failed to initialize EGL display, headless contexts are not available" << std::endl;
+                display = EGL_NO_DISPLAY;
+                return EGL_NO_DISPLAY;
+            }
+
+            // Continue loading with the display
+            gladLoaderLoadEGL(display);
+
+            const char* extensions = nullptr;
+            eglCheck(extensions = eglQueryString(display, EGL_EXTENSIONS));
+            surfaceless = hasExtension(extensions, "EGL_KHR_surfaceless_context");
+
+            return display;
+        }
+    }
+}
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+HeadlessContext::HeadlessContext(HeadlessContext* shared) :
+m_display(EGL_NO_DISPLAY),
+m_context(EGL_NO_CONTEXT),
+m_surface(EGL_NO_SURFACE),
+m_config (nullptr)
+{
+    // Save the creation settings
+    m_settings = ContextSettings();
+
+    // Get the initialized EGL display
+    m_display = HeadlessContextImpl::getInitializedDisplay();
+
+    // Create the context
+    createContext(shared);
+
+    // Contexts without a size render to FBOs only, they
+    // don't need a surface if the driver supports it
+    if (!HeadlessContextImpl::surfaceless)
+        createSurface(1, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+HeadlessContext::HeadlessContext(HeadlessContext* shared, const ContextSettings& settings, const WindowImpl& /*owner*/, unsigned int /*bitsPerPixel*/) :
+m_display(EGL_NO_DISPLAY),
+m_context(EGL_NO_CONTEXT),
+m_surface(EGL_NO_SURFACE),
+m_config (nullptr)
+{
+    err() << "Headless OpenGL contexts can't be attached to windows, the context will not have any surface" << std::endl;
+
+    // Save the creation settings
+    m_settings = settings;
+
+    // Get the initialized EGL display
+    m_display = HeadlessContextImpl::getInitializedDisplay();
+
+    // Create the context
+    createContext(shared);
+
+    if (!HeadlessContextImpl::surfaceless)
+        createSurface(1, 1);
+}
+
+
+////////////////////////////////////////////////////////////
+HeadlessContext::HeadlessContext(HeadlessContext* shared, const ContextSettings& settings, unsigned int width, unsigned int height) :
+m_display(EGL_NO_DISPLAY),
+m_context(EGL_NO_CONTEXT),
+m_surface(EGL_NO_SURFACE),
+m_config (nullptr)
+{
+    // Save the creation settings
+    m_settings = settings;
+
+    // Get the initialized EGL display
+    m_display = HeadlessContextImpl::getInitializedDisplay();
+
+    // Create the context and its pbuffer
+    createContext(shared);
+    createSurface(width, height);
+}
+
+
+////////////////////////////////////////////////////////////
+HeadlessContext::~HeadlessContext()
+{
+    // Notify unshared OpenGL resources of context destruction
+    cleanupUnsharedResources();
+
+    if (m_display == EGL_NO_DISPLAY)
+        return;
+
+    // Deactivate the current context
+    EGLContext currentContext = EGL_NO_CONTEXT;
+    eglCheck(currentContext = eglGetCurrentContext());
+
+    if ((m_context != EGL_NO_CONTEXT) && (currentContext == m_context))
+    {
+        eglCheck(eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT));
+    }
+
+    // Destroy the context
+    if (m_context != EGL_NO_CONTEXT)
+    {
+        eglCheck(eglDestroyContext(m_display, m_context));
+    }
+
+    // Destroy the surface
+    if (m_surface != EGL_NO_SURFACE)
+    {
+        eglCheck(eglDestroySurface(m_display, m_surface));
+    }
+}
+
+
+////////////////////////////////////////////////////////////
+bool HeadlessContext::isAvailable()
+{
+    return HeadlessContextImpl::getInitializedDisplay() != EGL_NO_DISPLAY;
+}
+
+
+////////////////////////////////////////////////////////////
+GlFunctionPointer HeadlessContext::getFunction(const char* name)
+{
+    if (HeadlessContextImpl::getInitializedDisplay() == EGL_NO_DISPLAY)
+        return nullptr;
+
+    return reinterpret_cast<GlFunctionPointer>(eglGetProcAddress(name));
+}
+
+
+////////////////////////////////////////////////////////////
+bool HeadlessContext::makeCurrent(bool current)
+{
+    if (m_context == EGL_NO_CONTEXT)
+        return false;
+
+    EGLBoolean result = EGL_FALSE;
+
+    if (current)
+    {
+        eglCheck(result = eglMakeCurrent(m_display, m_surface, m_surface, m_context));
+    }
+    else
+    {
+        eglCheck(result = eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT));
+    }
+
+    return (result != EGL_FALSE);
+}
+
+
+////////////////////////////////////////////////////////////
+void HeadlessContext::display()
+{
+    if (m_surface != EGL_NO_SURFACE)
+        eglCheck(eglSwapBuffers(m_display, m_surface));
+}
+
+
+////////////////////////////////////////////////////////////
+void HeadlessContext::setVerticalSyncEnabled(bool /*enabled*/)
+{
+    // Nothing to synchronize with
+}
+
+
+////////////////////////////////////////////////////////////
+void HeadlessContext::createContext(HeadlessContext* shared)
+{
+    if (m_display == EGL_NO_DISPLAY)
+        return;
+
+    // Choose a config supporting pbuffers, which are the only surfaces
+    // available without display server, dropping multisampling if needed
+    EGLint configCount = 0;
+
+    for (;;)
+    {
+        const EGLint attributes[] =
+        {
+            EGL_SURFACE_TYPE, EGL_PBUFFER_BIT,
+            EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT,
+            EGL_RED_SIZE, 8,
+            EGL_GREEN_SIZE, 8,
+            EGL_BLUE_SIZE, 8,
+            EGL_ALPHA_SIZE, 8,
+            EGL_DEPTH_SIZE, static_cast<EGLint>(m_settings.depthBits),
+            EGL_STENCIL_SIZE, static_cast<EGLint>(m_settings.stencilBits),
+            EGL_SAMPLE_BUFFERS, m_settings.antialiasingLevel ? 1 : 0,
+            EGL_SAMPLES, static_cast<EGLint>(m_settings.antialiasingLevel),
+            EGL_NONE
+        };
+
+        eglCheck(eglChooseConfig(m_display, attributes, &m_config, 1, &configCount));
+
+        if ((configCount > 0) || (m_settings.antialiasingLevel == 0))
+            break;
+
+        m_settings.antialiasingLevel = 0;
+    }
+
+    if (configCount == 0)
+    {
+        err() << "Failed to find an EGL config for the headless context" << std::endl;
+        return;
+    }
+
+    updateSettings();
+
+    // The rendering API is a per-thread state
+    eglCheck(eglBindAPI(EGL_OPENGL_API));
+
+    // Get the context to share display lists with
+    EGLContext toShare = shared ? shared->m_context : EGL_NO_CONTEXT;
+
+    if (toShare != EGL_NO_CONTEXT)
+    {
+        eglCheck(eglMakeCurrent(m_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT));
+    }
+
+    // Get a working copy of the context settings
+    const ContextSettings settings = m_settings;
+
+    while (!m_context && m_settings.majorVersion)
+    {
+        std::vector<EGLint> attributes;
+
+        // Check if the user requested a specific context version (anything > 1.1)
+        if ((m_settings.majorVersion > 1) || ((m_settings.majorVersion == 1) && (m_settings.minorVersion > 1)))
+        {
+            attributes.push_back(EGL_CONTEXT_MAJOR_VERSION);
+            attributes.push_back(static_cast<EGLint>(m_settings.majorVersion));
+            attributes.push_back(EGL_CONTEXT_MINOR_VERSION);
+            attributes.push_back(static_cast<EGLint>(m_settings.minorVersion));
+        }
+
+        attributes.push_back(EGL_CONTEXT_OPENGL_PROFILE_MASK);
+        attributes.push_back((m_settings.attributeFlags & ContextSettings::Core) ? EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT : EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT);
+
+        if (m_settings.attributeFlags & ContextSettings::Debug)
+        {
+            attributes.push_back(EGL_CONTEXT_OPENGL_DEBUG);
+            attributes.push_back(EGL_TRUE);
+        }
+
+        attributes.push_back(EGL_NONE);
+
+        eglCheck(m_context = eglCreateContext(m_display, m_config, toShare, attributes.data()));
+
+        if (!m_context)
+        {
+            // If we couldn't create the context, first try disabling flags,
+            // then lower the version number and try again -- stop at 0.0
+            if (m_settings.attributeFlags != ContextSettings::Default)
+            {
+                m_settings.attributeFlags = ContextSettings::Default;
+            }
+            else if (m_settings.minorVersion > 0)
+            {
+                // If the minor version is not 0, we decrease it and try again
+                --m_settings.minorVersion;
+
+                m_settings.attributeFlags = settings.attributeFlags;
+            }
+            else
+            {
+                // If the minor version is 0, we decrease the major version
+                --m_settings.majorVersion;
+                m_settings.minorVersion = 9;
+
+                m_settings.attributeFlags = settings.attributeFlags;
+            }
+        }
+    }
+
+    if (!m_context)
+        err() << "Failed to create a headless OpenGL context" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+void HeadlessContext::createSurface(unsigned int width, unsigned int height)
+{
+    if (!m_context)
+        return;
+
+    const EGLint attributes[] =
+    {
+        EGL_WIDTH, static_cast<EGLint>(width),
+        EGL_HEIGHT, static_cast<EGLint>(height),
+        EGL_NONE
+    };
+
+    eglCheck(m_surface = eglCreatePbufferSurface(m_display, m_config, attributes));
+
+    if (m_surface == EGL_NO_SURFACE)
+        err() << "Failed to create a pbuffer for the headless context" << std::endl;
+}
+
+
+////////////////////////////////////////////////////////////
+void HeadlessContext::updateSettings()
+{
+    EGLint value = 0;
+
+    // Update the internal context settings with the selected config
+    eglCheck(eglGetConfigAttrib(m_display, m_config, EGL_DEPTH_SIZE, &value));
+    m_settings.depthBits = static_cast<unsigned int>(value);
+
+    eglCheck(eglGetConfigAttrib(m_display, m_config, EGL_STENCIL_SIZE, &value));
+    m_settings.stencilBits = static_cast<unsigned int>(value);
+
+    eglCheck(eglGetConfigAttrib(m_display, m_config, EGL_SAMPLES, &value));
+    m_settings.antialiasingLevel = static_cast<unsigned int>(value);
+}
+
+} // namespace priv
+
+} // namespace sf
@@ -0,0 +1,178 @@
+////////////////////////////////////////////////////////////
+//
+// SFML - Simple and Fast Multimedia Library
+// Copyright (C) 2007-2022 Laurent Gomila (laurent@sfml-dev.org)
+//
+// This software is provided 'as-is', without any express or implied warranty.
+// In no event will the authors be held liable for any damages arising from the use of this software.
+//
+// Permission is granted to anyone to use this software for any purpose,
+// including commercial applications, and to alter it and redistribute it freely,
+// subject to the following restrictions:
+//
+// 1. The origin of this software must not be misrepresented;
+//    you must not claim that you wrote the original software.
+//    If you use this software in a product, an acknowledgment
+//    in the product documentation would be appreciated but is not required.
+//
+// 2. Altered source versions must be plainly marked as such,
+//    and must not be misrepresented as being the original software.
+//
+// 3. This notice may not be removed or altered from any source distribution.
+//
+////////////////////////////////////////////////////////////
+
+#ifndef SFML_HEADLESSCONTEXT_HPP
+#define SFML_HEADLESSCONTEXT_HPP
+
+////////////////////////////////////////////////////////////
+// Headers
+////////////////////////////////////////////////////////////
+#include <SFML/Window/GlContext.hpp>
+#include <glad/egl.h>
+
+
+namespace sf
+{
+namespace priv
+{
+////////////////////////////////////////////////////////////
+/// \brief EGL implementation of OpenGL contexts that don't
+///        need a connection to a display server
+///
+/// The contexts are created on the surfaceless platform of
+/// Mesa (EGL_MESA_platform_surfaceless), or on the first EGL
+/// device (EGL_EXT_platform_device) with other drivers. They
+/// render to FBOs, or to a pbuffer when they are given a size.
+///
+////////////////////////////////////////////////////////////
+class HeadlessContext : public GlContext
+{
+public:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new default context
+    ///
+    /// \param shared Context to share the new one with (can be a null pointer)
+    ///
+    ////////////////////////////////////////////////////////////
+    HeadlessContext(HeadlessContext* shared);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new context attached to a window
+    ///
+    /// Headless contexts can't be attached to windows, the
+    /// context is created without any surface.
+    ///
+    /// \param shared       Context to share the new one with
+    /// \param settings     Creation parameters
+    /// \param owner        Pointer to the owner window
+    /// \param bitsPerPixel Pixel depth, in bits per pixel
+    ///
+    ////////////////////////////////////////////////////////////
+    HeadlessContext(HeadlessContext* shared, const ContextSettings& settings, const WindowImpl& owner, unsigned int bitsPerPixel);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create a new context that embeds its own rendering target
+    ///
+    /// \param shared   Context to share the new one with
+    /// \param settings Creation parameters
+    /// \param width    Back buffer width, in pixels
+    /// \param height   Back buffer height, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    HeadlessContext(HeadlessContext* shared, const ContextSettings& settings, unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Destructor
+    ///
+    ////////////////////////////////////////////////////////////
+    ~HeadlessContext();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Check whether headless contexts can be created
+    ///
+    /// \return True if an EGL display without display server is available
+    ///
+    ////////////////////////////////////////////////////////////
+    static bool isAvailable();
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Get the address of an OpenGL function
+    ///
+    /// \param name Name of the function to get the address of
+    ///
+    /// \return Address of the OpenGL function, 0 on failure
+    ///
+    ////////////////////////////////////////////////////////////
+    static GlFunctionPointer getFunction(const char* name);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Activate the context as the current target for rendering
+    ///
+    /// \param current Whether to make the context current or no longer current
+    ///
+    /// \return True on success, false if any error happened
+    ///
+    ////////////////////////////////////////////////////////////
+    bool makeCurrent(bool current) override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Display what has been rendered to the context so far
+    ///
+    /// Headless contexts have nothing to present, this function
+    /// only flushes the pending commands.
+    ///
+    ////////////////////////////////////////////////////////////
+    void display() override;
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Enable or disable vertical synchronization
+    ///
+    /// There is no monitor to synchronize with, this function
+    /// does nothing.
+    ///
+    /// \param enabled True to enable v-sync, false to deactivate
+    ///
+    ////////////////////////////////////////////////////////////
+    void setVerticalSyncEnabled(bool enabled) override;
+
+private:
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Choose the EGL config and create the context
+    ///
+    /// \param shared Context to share the new one with (can be a null pointer)
+    ///
+    ////////////////////////////////////////////////////////////
+    void createContext(HeadlessContext* shared);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Create the pbuffer surface of the context
+    ///
+    /// \param width  Width of the surface, in pixels
+    /// \param height Height of the surface, in pixels
+    ///
+    ////////////////////////////////////////////////////////////
+    void createSurface(unsigned int width, unsigned int height);
+
+    ////////////////////////////////////////////////////////////
+    /// \brief Update the context settings from the selected config
+    ///
+    ////////////////////////////////////////////////////////////
+    void updateSettings();
+
+    ////////////////////////////////////////////////////////////
+    // Member data
+    ////////////////////////////////////////////////////////////
+    EGLDisplay m_display; ///< EGL display the context belongs to
+    EGLContext m_context; ///< EGL context
+    EGLSurface m_surface; ///< Pbuffer surface, or EGL_NO_SURFACE for surfaceless contexts
+    EGLConfig  m_config;  ///< EGL config of the context
+};
+
+} // namespace priv
+
+} // namespace sf
+
+#endif // SFML_HEADLESSCONTEXT_HPP
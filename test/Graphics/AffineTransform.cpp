@@ -0,0 +1,107 @@
+#include <SFML/Graphics/AffineTransform.hpp>
+#include <SFML/System/Angle.hpp>
+#include "GraphicsUtil.hpp"
+#include "SystemUtil.hpp"
+
+#include <doctest.h>
+
+using doctest::Approx;
+
+namespace
+{
+    // The same transform as a sf::Transform
+    sf::Transform toTransform(const sf::AffineTransform& transform)
+    {
+        return transform;
+    }
+
+    void checkApprox(const sf::Transform& left, const sf::Transform& right)
+    {
+        for (int i = 0; i < 16; ++i)
+            CHECK(left.getMatrix()[i] == Approx(static_cast<double>(right.getMatrix()[i])));
+    }
+}
+
+TEST_CASE("sf::AffineTransform class - [graphics]")
+{
+    const sf::AffineTransform transform(1.0f, 2.0f, 3.0f,
+                                        4.0f, 5.0f, 6.0f);
+    const sf::Transform full(1.0f, 2.0f, 3.0f,
+                             4.0f, 5.0f, 6.0f,
+                             0.0f, 0.0f, 1.0f);
+
+    SUBCASE("Construction")
+    {
+        CHECK(sf::AffineTransform() == sf::AffineTransform::Identity);
+        CHECK(toTransform(sf::AffineTransform::Identity) == sf::Transform::Identity);
+        CHECK(toTransform(transform) == full);
+        CHECK(sizeof(sf::AffineTransform) == 6 * sizeof(float));
+    }
+
+    SUBCASE("getInverse()")
+    {
+        CHECK(sf::AffineTransform::Identity.getInverse() == sf::AffineTransform::Identity);
+        CHECK(sf::AffineTransform(1.0f, 2.0f, 3.0f, 2.0f, 4.0f, 6.0f).getInverse() == sf::AffineTransform::Identity);
+        CHECK(toTransform(transform.getInverse()) == full.getInverse());
+        checkApprox(transform * transform.getInverse(), sf::Transform::Identity);
+    }
+
+    SUBCASE("transformPoint()")
+    {
+        CHECK(transform.transformPoint({0.0f, 0.0f}) == sf::Vector2f(3.0f, 6.0f));
+        CHECK(transform.transformPoint({-1.0f, 2.0f}) == full.transformPoint({-1.0f, 2.0f}));
+        CHECK(transform * sf::Vector2f(7.0f, -3.0f) == full * sf::Vector2f(7.0f, -3.0f));
+    }
+
+    SUBCASE("transformRect()")
+    {
+        const sf::AffineTransform mirror(-1.0f, 0.5f, 3.0f,
+                                          2.0f, -4.0f, 1.0f);
+        const sf::FloatRect rectangles[] = {{{-100.0f, -100.0f}, {200.0f, 200.0f}},
+                                            {{10.0f, 20.0f}, {-5.0f, 30.0f}},
+                                            {{0.0f, 0.0f}, {0.0f, 0.0f}}};
+        for (const sf::FloatRect& rectangle : rectangles)
+        {
+            CHECK(transform.transformRect(rectangle) == full.transformRect(rectangle));
+            CHECK(mirror.transformRect(rectangle) == toTransform(mirror).transformRect(rectangle));
+        }
+    }
+
+    SUBCASE("combine()")
+    {
+        const sf::AffineTransform other(10.0f, -2.0f, 3.0f,
+                                        4.0f, 0.5f, -40.0f);
+        CHECK(toTransform(transform * other) == full * toTransform(other));
+        CHECK(toTransform(other * transform) == toTransform(other) * full);
+
+        sf::AffineTransform combined = transform;
+        combined *= sf::AffineTransform::Identity;
+        CHECK(combined == transform);
+    }
+
+    SUBCASE("translate(), rotate() and scale()")
+    {
+        sf::AffineTransform affine = transform;
+        sf::Transform reference = full;
+
+        affine.translate({10.0f, -20.0f});
+        reference.translate({10.0f, -20.0f});
+        CHECK(toTransform(affine) == reference);
+
+        affine.scale({2.0f, 0.5f});
+        reference.scale({2.0f, 0.5f});
+        CHECK(toTransform(affine) == reference);
+
+        affine.scale({-1.0f, 3.0f}, {4.0f, 5.0f});
+        reference.scale({-1.0f, 3.0f}, {4.0f, 5.0f});
+        CHECK(toTransform(affine) == reference);
+
+        affine.rotate(sf::degrees(30));
+        reference.rotate(sf::degrees(30));
+        checkApprox(affine, reference);
+
+        affine.rotate(sf::degrees(-75), {1.0f, 2.0f});
+        reference.rotate(sf::degrees(-75), {1.0f, 2.0f});
+        checkApprox(affine, reference);
+    }
+}
@@ -0,0 +1,245 @@
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include "GraphicsUtil.hpp"
+
+#include <doctest.h>
+
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    const std::string characters = "AQgjy&@%WMl1";
+
+    // Metrics of a glyph that don't depend on where it is stored in the font's texture
+    struct Metrics
+    {
+        float         advance;
+        sf::FloatRect bounds;
+    };
+
+    std::vector<Metrics> getMetrics(const sf::Font& font, unsigned int characterSize)
+    {
+        std::vector<Metrics> metrics;
+        for (char character : characters)
+        {
+            const sf::Glyph& glyph = font.getGlyph(static_cast<sf::Uint32>(character), characterSize, false);
+            metrics.push_back({glyph.advance, glyph.bounds});
+        }
+        return metrics;
+    }
+
+    bool sameMetrics(const std::vector<Metrics>& left, const std::vector<Metrics>& right)
+    {
+        if (left.size() != right.size())
+            return false;
+
+        for (std::size_t i = 0; i < left.size(); ++i)
+        {
+            if ((left[i].advance != right[i].advance) || (left[i].bounds != right[i].bounds))
+                return false;
+        }
+        return true;
+    }
+}
+
+TEST_CASE("sf::Font class - [graphics]")
+{
+    // Reference font, with its own copy of the file
+    std::ifstream file(SFML_TEST_FONT, std::ios::binary);
+    const std::vector<char> contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    sf::Font reference;
+    REQUIRE(reference.loadFromMemory(contents.data(), contents.size()));
+    const std::vector<Metrics> small = getMetrics(reference, 20);
+    const std::vector<Metrics> large = getMetrics(reference, 40);
+    REQUIRE(!sameMetrics(small, large));
+
+    SUBCASE("Glyph and kerning caches")
+    {
+        sf::Font font;
+        REQUIRE(font.loadFromFile(SFML_TEST_FONT));
+
+        // Glyphs requested in another order are the same
+        std::vector<Metrics> reversed;
+        for (auto it = characters.rbegin(); it != characters.rend(); ++it)
+        {
+            const sf::Glyph& glyph = font.getGlyph(static_cast<sf::Uint32>(*it), 20, false);
+            reversed.insert(reversed.begin(), {glyph.advance, glyph.bounds});
+        }
+        CHECK(sameMetrics(reversed, small));
+
+        // Cached glyphs are found again, for each variant
+        const sf::Glyph& regular = font.getGlyph('A', 20, false);
+        const sf::Glyph& bold = font.getGlyph('A', 20, true);
+        const sf::Glyph& outlined = font.getGlyph('A', 20, false, 2);
+        CHECK(&font.getGlyph('A', 20, false) == &regular);
+        CHECK(&font.getGlyph('A', 20, true) == &bold);
+        CHECK(&font.getGlyph('A', 20, false, 2) == &outlined);
+        CHECK(&bold != &regular);
+        CHECK(&outlined != &regular);
+        CHECK(bold.bounds.width > regular.bounds.width);
+        CHECK(outlined.bounds.width > regular.bounds.width);
+
+        // Characters missing from the font, in and beyond the Basic Multilingual Plane, use the same glyph
+        CHECK(!font.hasGlyph(0x4E00));
+        CHECK(!font.hasGlyph(0x1F600));
+        CHECK(font.hasGlyph('A'));
+        CHECK(font.getGlyph(0x4E00, 20, false).advance == font.getGlyph(0x1F600, 20, false).advance);
+        CHECK(font.getGlyph(0x4E00, 20, false).bounds == font.getGlyph(0x1F600, 20, false).bounds);
+
+        // Cached kerning offsets are the ones computed by a font that didn't cache them yet
+        for (unsigned int characterSize : {20u, 40u})
+        {
+            for (int pass = 0; pass < 2; ++pass)
+            {
+                sf::Font uncached;
+                REQUIRE(uncached.loadFromFile(SFML_TEST_FONT));
+
+                for (char first : characters)
+                {
+                    for (char second : characters)
+                    {
+                        const float kerning = font.getKerning(static_cast<sf::Uint32>(first), static_cast<sf::Uint32>(second), characterSize);
+                        CHECK(kerning == uncached.getKerning(static_cast<sf::Uint32>(first), static_cast<sf::Uint32>(second), characterSize));
+                    }
+                }
+            }
+        }
+    }
+
+    SUBCASE("Alpha-only pages")
+    {
+        sf::Font rgba;
+        sf::Font alphaOnly;
+        REQUIRE(rgba.loadFromFile(SFML_TEST_FONT));
+        REQUIRE(alphaOnly.loadFromFile(SFML_TEST_FONT));
+        alphaOnly.setAlphaOnly(true);
+        CHECK(alphaOnly.isAlphaOnly());
+        CHECK(!rgba.isAlphaOnly());
+
+        // Enough glyphs to grow the pages, with rows of odd widths
+        bool oddWidth = false;
+        for (unsigned int characterSize : {20u, 60u})
+        {
+            for (sf::Uint32 codePoint = 33; codePoint < 127; ++codePoint)
+            {
+                const sf::Glyph& expected = rgba.getGlyph(codePoint, characterSize, false);
+                const sf::Glyph& glyph = alphaOnly.getGlyph(codePoint, characterSize, false);
+                CHECK(glyph.textureRect == expected.textureRect);
+                oddWidth = oddWidth || (glyph.textureRect.width % 2 != 0);
+            }
+
+            // Alpha-only pages are copied as white pixels with the glyph coverage in the alpha channel
+            const sf::Image expected = rgba.getTexture(characterSize).copyToImage();
+            const sf::Image image = alphaOnly.getTexture(characterSize).copyToImage();
+            CHECK(image.getSize() == expected.getSize());
+            CHECK(image.getSize().x > 128);
+            CHECK(image.getPixelFormat() == sf::RGBA8);
+            CHECK(image.getPixel(0, 0) == sf::Color::White);
+
+            // The grown parts of RGBA pages are transparent black, so only the alphas can be compared
+            bool sameCoverage = true;
+            bool white = true;
+            for (unsigned int y = 0; y < image.getSize().y; ++y)
+            {
+                for (unsigned int x = 0; x < image.getSize().x; ++x)
+                {
+                    const sf::Color pixel = image.getPixel(x, y);
+                    sameCoverage = sameCoverage && (pixel.a == expected.getPixel(x, y).a);
+                    white = white && (pixel.r == 255) && (pixel.g == 255) && (pixel.b == 255);
+                }
+            }
+            CHECK(sameCoverage);
+            CHECK(white);
+        }
+        CHECK(oddWidth);
+
+        // Switching back discards the alpha-only pages
+        alphaOnly.setAlphaOnly(false);
+        CHECK(!alphaOnly.isAlphaOnly());
+        CHECK(alphaOnly.getTexture(20).getSize() == sf::Vector2u(128, 128));
+        alphaOnly.getGlyph('A', 20, false);
+        CHECK(alphaOnly.getTexture(20).copyToImage().getPixel(0, 0) == sf::Color::White);
+    }
+
+    SUBCASE("Fonts loaded from the same file")
+    {
+        auto first = std::make_unique<sf::Font>();
+        sf::Font second;
+        REQUIRE(first->loadFromFile(SFML_TEST_FONT));
+        REQUIRE(second.loadFromFile(SFML_TEST_FONT));
+        CHECK(first->getInfo().family == reference.getInfo().family);
+        CHECK(second.getInfo().family == reference.getInfo().family);
+        CHECK(sameMetrics(getMetrics(*first, 20), small));
+
+        // The file stays mapped as long as a font uses it
+        first.reset();
+        CHECK(sameMetrics(getMetrics(second, 40), large));
+
+        sf::Font third;
+        REQUIRE(third.loadFromFile(SFML_TEST_FONT));
+        CHECK(sameMetrics(getMetrics(third, 20), small));
+    }
+
+    SUBCASE("Fonts loaded from the same buffer")
+    {
+        sf::Font first;
+        sf::Font second;
+        REQUIRE(first.loadFromMemory(contents.data(), contents.size()));
+        REQUIRE(second.loadFromMemory(contents.data(), contents.size()));
+        CHECK(sameMetrics(getMetrics(first, 20), small));
+        CHECK(sameMetrics(getMetrics(second, 40), large));
+    }
+
+    SUBCASE("Fonts of the same file at different sizes")
+    {
+        sf::Font first;
+        sf::Font second;
+        REQUIRE(first.loadFromFile(SFML_TEST_FONT));
+        REQUIRE(second.loadFromFile(SFML_TEST_FONT));
+
+        // Glyphs are loaded alternately from both fonts
+        for (std::size_t i = 0; i < characters.size(); ++i)
+        {
+            const auto codePoint = static_cast<sf::Uint32>(characters[i]);
+            const sf::Glyph& smallGlyph = first.getGlyph(codePoint, 20, false);
+            const sf::Glyph& largeGlyph = second.getGlyph(codePoint, 40, false);
+            CHECK(smallGlyph.advance == small[i].advance);
+            CHECK(smallGlyph.bounds == small[i].bounds);
+            CHECK(largeGlyph.advance == large[i].advance);
+            CHECK(largeGlyph.bounds == large[i].bounds);
+            CHECK(first.getLineSpacing(20) == reference.getLineSpacing(20));
+            CHECK(second.getLineSpacing(40) == reference.getLineSpacing(40));
+        }
+    }
+
+    SUBCASE("Fonts of the same file on several threads")
+    {
+        std::vector<sf::Font> fonts(4);
+        for (sf::Font& font : fonts)
+            REQUIRE(font.loadFromFile(SFML_TEST_FONT));
+
+        std::vector<std::vector<Metrics>> results(fonts.size());
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < fonts.size(); ++i)
+        {
+            threads.emplace_back([&fonts, &results, i]
+            {
+                const unsigned int characterSize = (i % 2) ? 40 : 20;
+                for (int repeat = 0; repeat < 20; ++repeat)
+                    results[i] = getMetrics(fonts[i], characterSize + static_cast<unsigned int>(repeat));
+                results[i] = getMetrics(fonts[i], characterSize);
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        for (std::size_t i = 0; i < fonts.size(); ++i)
+            CHECK(sameMetrics(results[i], (i % 2) ? large : small));
+    }
+}
@@ -0,0 +1,193 @@
+#include <SFML/Graphics/FrameRecorder.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include "GraphicsUtil.hpp"
+
+#include <doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Read the luma (Y) planes of the frames of a YUV4MPEG2 file, whose frames have even sizes
+    std::vector<std::string> readLumaPlanes(const std::filesystem::path& path, const sf::Vector2u& size)
+    {
+        std::ifstream file(path, std::ios::binary);
+        const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+        const std::size_t lumaSize  = static_cast<std::size_t>(size.x) * size.y;
+        const std::size_t frameSize = 6 + lumaSize * 3 / 2;
+
+        std::vector<std::string> planes;
+        std::size_t offset = contents.find('\n') + 1;
+        while (offset + frameSize <= contents.size())
+        {
+            if (contents.compare(offset, 6, "FRAME\n") != 0)
+                break;
+
+            planes.push_back(contents.substr(offset + 6, lumaSize));
+            offset += frameSize;
+        }
+
+        // Garbage at the end of the file is reported as an extra, empty frame
+        if (offset != contents.size())
+            planes.emplace_back();
+
+        return planes;
+    }
+
+    // Luma of a color, in video range (BT.601)
+    char luma(const sf::Color& color)
+    {
+        return static_cast<char>(((66 * color.r + 129 * color.g + 25 * color.b + 128) >> 8) + 16);
+    }
+}
+
+TEST_CASE("sf::FrameRecorder class - [graphics]")
+{
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "sfml-frame-recorder-test.y4m";
+    std::filesystem::remove(path);
+
+    SUBCASE("Default constructor")
+    {
+        const sf::FrameRecorder recorder;
+        CHECK(!recorder.isRecording());
+        CHECK(recorder.getSize() == sf::Vector2u(0, 0));
+        CHECK(recorder.getFrameCount() == 0);
+        CHECK(recorder.getDroppedFrameCount() == 0);
+    }
+
+    SUBCASE("Start and stop")
+    {
+        sf::FrameRecorder recorder;
+        REQUIRE(recorder.start(path, sf::Vector2u(64, 48), 30));
+        CHECK(recorder.isRecording());
+        CHECK(recorder.getSize() == sf::Vector2u(64, 48));
+
+        recorder.stop();
+        CHECK(!recorder.isRecording());
+        CHECK(recorder.getFrameCount() == 0);
+
+        // The stream header is written when the recording starts
+        std::ifstream file(path, std::ios::binary);
+        const std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+        CHECK(contents == "YUV4MPEG2 W64 H48 F30:1 Ip A1:1 C420jpeg\n");
+
+        // Stopping twice is harmless
+        recorder.stop();
+        CHECK(!recorder.isRecording());
+    }
+
+    SUBCASE("Invalid parameters")
+    {
+        sf::FrameRecorder recorder;
+        CHECK(!recorder.start(path, sf::Vector2u(0, 48)));
+        CHECK(!recorder.start(path, sf::Vector2u(64, 48), 0));
+        CHECK(!recorder.start(std::filesystem::temp_directory_path() / "sfml-missing-directory" / "recording.y4m", sf::Vector2u(64, 48)));
+        CHECK(!recorder.isRecording());
+    }
+
+    SUBCASE("Capture")
+    {
+        const sf::Vector2u size(64, 48);
+        sf::RenderTexture renderTexture;
+        REQUIRE(renderTexture.create(size.x, size.y));
+
+        SUBCASE("Solid color")
+        {
+            const sf::Color color(200, 100, 50);
+
+            // One buffer per frame, so that none is dropped however slow the writer is
+            sf::FrameRecorder recorder;
+            REQUIRE(recorder.start(path, size, 30, 10));
+            for (int i = 0; i < 10; ++i)
+            {
+                renderTexture.clear(color);
+                renderTexture.display();
+                CHECK(recorder.capture(renderTexture));
+            }
+            recorder.stop();
+
+            CHECK(recorder.getFrameCount() == 10);
+            CHECK(recorder.getDroppedFrameCount() == 0);
+
+            const std::vector<std::string> planes = readLumaPlanes(path, size);
+            REQUIRE(planes.size() == 10);
+            for (const std::string& plane : planes)
+                CHECK(plane == std::string(size.x * size.y, luma(color)));
+        }
+
+        SUBCASE("Orientation")
+        {
+            // Red top half, blue bottom half
+            sf::RectangleShape top(sf::Vector2f(64, 24));
+            top.setFillColor(sf::Color::Red);
+
+            sf::FrameRecorder recorder;
+            REQUIRE(recorder.start(path, size, 60, 5));
+            for (int i = 0; i < 5; ++i)
+            {
+                renderTexture.clear(sf::Color::Blue);
+                renderTexture.draw(top);
+                renderTexture.display();
+                CHECK(recorder.capture(renderTexture));
+            }
+            recorder.stop();
+
+            // The first row of the video is the top of the render-texture
+            const std::vector<std::string> planes = readLumaPlanes(path, size);
+            REQUIRE(planes.size() == 5);
+            for (const std::string& plane : planes)
+            {
+                CHECK(plane.substr(0, 64 * 24) == std::string(64 * 24, luma(sf::Color::Red)));
+                CHECK(plane.substr(64 * 24) == std::string(64 * 24, luma(sf::Color::Blue)));
+            }
+        }
+
+        SUBCASE("Dropped frames")
+        {
+            // With the minimum number of buffers, frames are dropped if the
+            // writer falls behind: every capture is either written or dropped
+            sf::FrameRecorder recorder;
+            REQUIRE(recorder.start(path, size, 60, 4));
+
+            sf::Uint64 failedCaptures = 0;
+            for (int i = 0; i < 100; ++i)
+            {
+                renderTexture.clear(sf::Color(static_cast<sf::Uint8>(i), 0, 0));
+                renderTexture.display();
+                if (!recorder.capture(renderTexture))
+                    ++failedCaptures;
+            }
+
+            // Captures of the wrong size are always dropped
+            sf::RenderTexture other;
+            REQUIRE(other.create(32, 32));
+            CHECK(!recorder.capture(other));
+            ++failedCaptures;
+
+            recorder.stop();
+
+            CHECK(recorder.getDroppedFrameCount() >= 1);
+            CHECK(recorder.getDroppedFrameCount() == failedCaptures);
+            CHECK(recorder.getFrameCount() + recorder.getDroppedFrameCount() == 101);
+            CHECK(readLumaPlanes(path, size).size() == recorder.getFrameCount());
+
+            // Starting a new recording resets the counts
+            REQUIRE(recorder.start(path, size, 60, 4));
+            CHECK(recorder.getFrameCount() == 0);
+            CHECK(recorder.getDroppedFrameCount() == 0);
+            recorder.stop();
+        }
+
+        // Nothing is captured without a recording
+        sf::FrameRecorder recorder;
+        CHECK(!recorder.capture(renderTexture));
+    }
+
+    std::filesystem::remove(path);
+}
@@ -0,0 +1,655 @@
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
+#include "GraphicsUtil.hpp"
+#include "SystemUtil.hpp"
+
+#include <doctest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace
+{
+    // Deterministic image with a mix of opaque, transparent and translucent pixels
+    sf::Image makeImage(unsigned int width, unsigned int height, unsigned int seed)
+    {
+        std::vector<sf::Uint8> pixels(static_cast<std::size_t>(width) * height * 4);
+        unsigned int state = seed;
+        for (std::size_t i = 0; i < pixels.size(); ++i)
+        {
+            state = state * 1664525u + 1013904223u;
+            pixels[i] = static_cast<sf::Uint8>(state >> 24);
+        }
+        for (std::size_t i = 3; i < pixels.size(); i += 4)
+        {
+            if (pixels[i] < 64)
+                pixels[i] = 0;
+            else if (pixels[i] > 192)
+                pixels[i] = 255;
+        }
+
+        sf::Image image;
+        image.create(width, height, pixels.data());
+        return image;
+    }
+
+    // Reference implementation of the alpha blending done by sf::Image::copy
+    sf::Color blend(const sf::Color& src, const sf::Color& dst)
+    {
+        auto alpha = static_cast<sf::Uint8>(src.a + dst.a - src.a * dst.a / 255);
+        if (!alpha)
+            return sf::Color(src.r, src.g, src.b, 0);
+
+        auto mix = [&](sf::Uint8 s, sf::Uint8 d) { return static_cast<sf::Uint8>((s * src.a + d * (alpha - src.a)) / alpha); };
+        return sf::Color(mix(src.r, dst.r), mix(src.g, dst.g), mix(src.b, dst.b), alpha);
+    }
+}
+
+TEST_CASE("sf::Image class - [graphics]")
+{
+    SUBCASE("Default constructor")
+    {
+        const sf::Image image;
+        CHECK(image.getSize() == sf::Vector2u());
+    }
+
+    SUBCASE("Create with color")
+    {
+        sf::Image image;
+        image.create(10, 5, sf::Color::Red);
+        CHECK(image.getSize() == sf::Vector2u(10, 5));
+        CHECK(image.getPixel(0, 0) == sf::Color::Red);
+        CHECK(image.getPixel(9, 4) == sf::Color::Red);
+    }
+
+    // Sizes small enough to use the scalar paths only, and large enough to be split between threads
+    const sf::Vector2u sizes[] = {sf::Vector2u(1, 1), sf::Vector2u(7, 3), sf::Vector2u(13, 2), sf::Vector2u(1031, 300)};
+
+    SUBCASE("Mask from color")
+    {
+        for (const sf::Vector2u& size : sizes)
+        {
+            const sf::Image original = makeImage(size.x, size.y, size.x + size.y);
+            const sf::Color key = original.getPixel(0, 0);
+            sf::Image image = original;
+            image.createMaskFromColor(key, 42);
+
+            sf::Image expected = original;
+            for (unsigned int y = 0; y < size.y; ++y)
+                for (unsigned int x = 0; x < size.x; ++x)
+                    if (original.getPixel(x, y) == key)
+                        expected.setPixel(x, y, sf::Color(key.r, key.g, key.b, 42));
+
+            CHECK(samePixels(image, expected));
+        }
+    }
+
+    SUBCASE("Copy with alpha")
+    {
+        for (const sf::Vector2u& size : sizes)
+        {
+            const sf::Image source = makeImage(size.x, size.y, size.x + size.y);
+            const sf::Image destination = makeImage(size.x, size.y, 12345);
+            sf::Image image = destination;
+            image.copy(source, 0, 0, sf::IntRect(), true);
+
+            sf::Image expected = destination;
+            for (unsigned int y = 0; y < size.y; ++y)
+                for (unsigned int x = 0; x < size.x; ++x)
+                    expected.setPixel(x, y, blend(source.getPixel(x, y), destination.getPixel(x, y)));
+
+            CHECK(samePixels(image, expected));
+        }
+    }
+
+    SUBCASE("Copy without alpha")
+    {
+        for (const sf::Vector2u& size : sizes)
+        {
+            const sf::Image source = makeImage(size.x, size.y, size.x + size.y);
+            sf::Image image = makeImage(size.x, size.y, 12345);
+            image.copy(source, 0, 0, sf::IntRect(), false);
+
+            CHECK(samePixels(image, source));
+        }
+    }
+
+    SUBCASE("Flip horizontally")
+    {
+        for (const sf::Vector2u& size : sizes)
+        {
+            const sf::Image original = makeImage(size.x, size.y, size.x + size.y);
+            sf::Image image = original;
+            image.flipHorizontally();
+
+            sf::Image expected = original;
+            for (unsigned int y = 0; y < size.y; ++y)
+                for (unsigned int x = 0; x < size.x; ++x)
+                    expected.setPixel(x, y, original.getPixel(size.x - 1 - x, y));
+
+            CHECK(samePixels(image, expected));
+        }
+    }
+
+    SUBCASE("Flip vertically")
+    {
+        for (const sf::Vector2u& size : sizes)
+        {
+            const sf::Image original = makeImage(size.x, size.y, size.x + size.y);
+            sf::Image image = original;
+            image.flipVertically();
+
+            sf::Image expected = original;
+            for (unsigned int y = 0; y < size.y; ++y)
+                for (unsigned int x = 0; x < size.x; ++x)
+                    expected.setPixel(x, y, original.getPixel(x, size.y - 1 - y));
+
+            CHECK(samePixels(image, expected));
+        }
+    }
+
+    SUBCASE("Resample")
+    {
+        SUBCASE("Empty image")
+        {
+            const sf::Image image;
+            CHECK(image.resample({4, 4}).getSize() == sf::Vector2u());
+        }
+
+        SUBCASE("Solid color is preserved by all filters")
+        {
+            sf::Image image;
+            image.create(37, 23, sf::Color(10, 200, 30, 255));
+
+            for (const auto filter : {sf::Image::Nearest, sf::Image::Bilinear, sf::Image::Box, sf::Image::Lanczos3})
+            {
+                for (const sf::Vector2u& size : {sf::Vector2u(5, 3), sf::Vector2u(37, 23), sf::Vector2u(80, 61)})
+                {
+                    for (const bool sRgb : {false, true})
+                    {
+                        const sf::Image resampled = image.resample(size, filter, sRgb);
+                        CHECK(resampled.getSize() == size);
+                        CHECK(resampled.getPixel(0, 0) == sf::Color(10, 200, 30, 255));
+                        CHECK(resampled.getPixel(size.x / 2, size.y / 2) == sf::Color(10, 200, 30, 255));
+                        CHECK(resampled.getPixel(size.x - 1, size.y - 1) == sf::Color(10, 200, 30, 255));
+                    }
+                }
+            }
+        }
+
+        SUBCASE("Same size is the identity")
+        {
+            const sf::Image original = makeImage(19, 11, 7);
+            CHECK(samePixels(original.resample({19, 11}, sf::Image::Nearest), original));
+            CHECK(samePixels(original.resample({19, 11}, sf::Image::Bilinear), original));
+            CHECK(samePixels(original.resample({19, 11}, sf::Image::Box), original));
+            CHECK(samePixels(original.resample({19, 11}, sf::Image::Lanczos3), original));
+        }
+
+        SUBCASE("Box filter averages")
+        {
+            sf::Image image;
+            image.create(2, 2, sf::Color::Black);
+            image.setPixel(0, 0, sf::Color::White);
+            image.setPixel(1, 1, sf::Color::White);
+
+            CHECK(image.resample({1, 1}, sf::Image::Box).getPixel(0, 0) == sf::Color(128, 128, 128));
+            CHECK(image.resample({1, 1}, sf::Image::Box, true).getPixel(0, 0) == sf::Color(188, 188, 188));
+        }
+
+        SUBCASE("Transparent pixels don't bleed")
+        {
+            sf::Image image;
+            image.create(2, 1, sf::Color::Transparent);
+            image.setPixel(0, 0, sf::Color::Red);
+
+            CHECK(image.resample({1, 1}, sf::Image::Box).getPixel(0, 0) == sf::Color(255, 0, 0, 128));
+        }
+
+        SUBCASE("Nearest picks source pixels")
+        {
+            const sf::Image original = makeImage(4, 4, 3);
+            const sf::Image upscaled = original.resample({8, 8}, sf::Image::Nearest);
+            for (unsigned int y = 0; y < 8; ++y)
+                for (unsigned int x = 0; x < 8; ++x)
+                    CHECK(upscaled.getPixel(x, y) == original.getPixel(x / 2, y / 2));
+        }
+
+        SUBCASE("Resize")
+        {
+            sf::Image image = makeImage(100, 50, 1);
+            image.resize({25, 60}, sf::Image::Lanczos3);
+            CHECK(image.getSize() == sf::Vector2u(25, 60));
+        }
+    }
+
+    SUBCASE("Create mipmap")
+    {
+        CHECK(sf::Image().createMipmap().empty());
+
+        sf::Image image;
+        image.create(1, 1, sf::Color::Red);
+        CHECK(image.createMipmap().empty());
+
+        image.create(10, 3, sf::Color::Red);
+        const std::vector<sf::Image> levels = image.createMipmap();
+        REQUIRE(levels.size() == 3);
+        CHECK(levels[0].getSize() == sf::Vector2u(5, 1));
+        CHECK(levels[1].getSize() == sf::Vector2u(2, 1));
+        CHECK(levels[2].getSize() == sf::Vector2u(1, 1));
+        CHECK(levels[2].getPixel(0, 0) == sf::Color::Red);
+    }
+
+    SUBCASE("Copy to an offset")
+    {
+        sf::Image image;
+        image.create(8, 8, sf::Color::Black);
+        sf::Image source;
+        source.create(4, 4, sf::Color::White);
+        image.copy(source, 6, 6);
+
+        CHECK(image.getPixel(5, 5) == sf::Color::Black);
+        CHECK(image.getPixel(6, 6) == sf::Color::White);
+        CHECK(image.getPixel(7, 7) == sf::Color::White);
+    }
+
+    SUBCASE("Pixel formats")
+    {
+        const sf::PixelFormat formats[] = {sf::R8, sf::RG8, sf::RGB8, sf::RGBA8, sf::R16, sf::RGBA16F, sf::RGBA32F};
+
+        SUBCASE("Pixel sizes")
+        {
+            CHECK(sf::getPixelSize(sf::R8) == 1);
+            CHECK(sf::getPixelSize(sf::RG8) == 2);
+            CHECK(sf::getPixelSize(sf::RGB8) == 3);
+            CHECK(sf::getPixelSize(sf::RGBA8) == 4);
+            CHECK(sf::getPixelSize(sf::R16) == 2);
+            CHECK(sf::getPixelSize(sf::RGBA16F) == 8);
+            CHECK(sf::getPixelSize(sf::RGBA32F) == 16);
+        }
+
+        SUBCASE("Create")
+        {
+            CHECK(sf::Image().getPixelFormat() == sf::RGBA8);
+
+            for (sf::PixelFormat format : formats)
+            {
+                sf::Image image;
+                image.create({3, 2}, format);
+                CHECK(image.getSize() == sf::Vector2u(3, 2));
+                CHECK(image.getPixelFormat() == format);
+
+                const std::size_t size = 6 * sf::getPixelSize(format);
+                CHECK(std::all_of(image.getPixelsPtr(), image.getPixelsPtr() + size, [](sf::Uint8 byte) { return byte == 0; }));
+            }
+
+            const sf::Uint8 pixels[] = {1, 2, 3, 4, 5, 6};
+            sf::Image image;
+            image.create({3, 1}, sf::RG8, pixels);
+            CHECK(image.getPixel(2, 0) == sf::Color(5, 6, 0, 255));
+        }
+
+        SUBCASE("Get and set pixels")
+        {
+            const sf::Color color(10, 20, 30, 40);
+            const sf::Color expected[] = {sf::Color(10, 0, 0, 255), sf::Color(10, 20, 0, 255), sf::Color(10, 20, 30, 255), color,
+                                          sf::Color(10, 0, 0, 255), color, color};
+
+            for (std::size_t i = 0; i < std::size(formats); ++i)
+            {
+                sf::Image image;
+                image.create({4, 4}, formats[i]);
+                image.setPixel(3, 2, color);
+                CHECK(image.getPixel(3, 2) == expected[i]);
+                CHECK(image.getPixel(2, 3) == image.getPixel(0, 0));
+            }
+        }
+
+        SUBCASE("Conversions")
+        {
+            const sf::Image image = makeImage(61, 17, 4);
+
+            // Conversions to formats that keep all the information are reversible
+            CHECK(samePixels(image.convert(sf::RGBA32F).convert(sf::RGBA8), image));
+            CHECK(samePixels(image.convert(sf::RGBA16F).convert(sf::RGBA8), image));
+            CHECK(image.convert(sf::RGBA8).getPixelFormat() == sf::RGBA8);
+
+            // Other channels are dropped or completed
+            const sf::Image rgb = image.convert(sf::RGB8);
+            const sf::Image red = image.convert(sf::R8);
+            const sf::Image deep = image.convert(sf::R16);
+            for (unsigned int y = 0; y < 17; ++y)
+            {
+                for (unsigned int x = 0; x < 61; ++x)
+                {
+                    const sf::Color color = image.getPixel(x, y);
+                    CHECK(rgb.getPixel(x, y) == sf::Color(color.r, color.g, color.b, 255));
+                    CHECK(red.getPixel(x, y) == sf::Color(color.r, 0, 0, 255));
+                    CHECK(deep.getPixel(x, y) == sf::Color(color.r, 0, 0, 255));
+                    CHECK(red.getPixelsPtr()[x + y * 61] == color.r);
+                }
+            }
+
+            CHECK(samePixels(rgb.convert(sf::RGBA8), image.convert(sf::RGB8).convert(sf::RGBA8)));
+            CHECK(sf::Image().convert(sf::R8).getPixelFormat() == sf::R8);
+        }
+
+        SUBCASE("Half precision floats")
+        {
+            const float values[] = {0.5f, -2.f, 65504.f, 1e-7f, 1e6f, 1.f / 3.f, 0.f, 1.f};
+            sf::Image image;
+            image.create({2, 1}, sf::RGBA32F, values);
+
+            const sf::Image converted = image.convert(sf::RGBA16F).convert(sf::RGBA32F);
+            float result[8];
+            std::memcpy(result, converted.getPixelsPtr(), sizeof(result));
+            CHECK(result[0] == 0.5f);
+            CHECK(result[1] == -2.f);
+            CHECK(result[2] == 65504.f);
+            CHECK(result[3] == doctest::Approx(1.1920929e-7f)); // Nearest subnormal half
+            CHECK(result[4] == std::numeric_limits<float>::infinity());
+            CHECK(result[5] == doctest::Approx(1.f / 3.f).epsilon(0.001));
+            CHECK(result[6] == 0.f);
+            CHECK(result[7] == 1.f);
+        }
+
+        SUBCASE("Copy between formats")
+        {
+            const sf::Image source = makeImage(40, 30, 5);
+
+            sf::Image image;
+            image.create({40, 30}, sf::RGBA32F);
+            image.copy(source, 0, 0);
+            CHECK(samePixels(image.convert(sf::RGBA8), source));
+
+            // Blending in floating point gives the same results as the 8-bit integer blending, give or take one
+            sf::Image background = makeImage(40, 30, 6);
+            sf::Image floatBackground = background.convert(sf::RGBA32F);
+            background.copy(source, 0, 0, sf::IntRect(), true);
+            floatBackground.copy(source, 0, 0, sf::IntRect(), true);
+            for (unsigned int y = 0; y < 30; ++y)
+            {
+                for (unsigned int x = 0; x < 40; ++x)
+                {
+                    const sf::Color expected = background.getPixel(x, y);
+                    const sf::Color actual = floatBackground.getPixel(x, y);
+                    CHECK(std::abs(expected.a - actual.a) <= 1);
+                    if (expected.a > 0)
+                        CHECK(std::abs(expected.r - actual.r) <= 1);
+                }
+            }
+        }
+
+        SUBCASE("Mask, flips and resampling")
+        {
+            for (sf::PixelFormat format : formats)
+            {
+                const sf::Image reference = makeImage(1031, 70, 7);
+                sf::Image image = reference.convert(format);
+                const sf::Image expected = image.convert(sf::RGBA8);
+
+                image.flipHorizontally();
+                image.flipVertically();
+                const sf::Image flipped = image.convert(sf::RGBA8);
+                CHECK(flipped.getPixel(0, 0) == expected.getPixel(1030, 69));
+                CHECK(flipped.getPixel(1030, 0) == expected.getPixel(0, 69));
+                CHECK(flipped.getPixel(500, 30) == expected.getPixel(530, 39));
+
+                const sf::Image resampled = image.resample({100, 10});
+                CHECK(resampled.getPixelFormat() == format);
+                CHECK(resampled.getSize() == sf::Vector2u(100, 10));
+            }
+
+            // Images without alpha channel are not masked
+            sf::Image rgb;
+            rgb.create({2, 2}, sf::RGB8);
+            rgb.createMaskFromColor(sf::Color::Black);
+            CHECK(rgb.getPixel(0, 0) == sf::Color::Black);
+
+            sf::Image floats = makeImage(2, 2, 8).convert(sf::RGBA16F);
+            const sf::Color key = floats.getPixel(1, 0);
+            floats.createMaskFromColor(key, 12);
+            CHECK(floats.getPixel(1, 0) == sf::Color(key.r, key.g, key.b, 12));
+        }
+
+        SUBCASE("Save and load")
+        {
+            const sf::Image image = makeImage(13, 9, 9);
+            std::vector<sf::Uint8> buffer;
+
+            // 8-bit grayscale and RGB images are saved with their channels
+            for (sf::PixelFormat format : {sf::R8, sf::RGB8, sf::RGBA8})
+            {
+                const sf::Image converted = image.convert(format);
+                buffer.clear();
+                REQUIRE(converted.saveToMemory(buffer, "png"));
+
+                sf::Image loaded;
+                REQUIRE(loaded.loadFromMemory(buffer.data(), buffer.size(), format));
+                CHECK(loaded.getPixelFormat() == format);
+                CHECK(samePixels(loaded.convert(sf::RGBA8), converted.convert(sf::RGBA8)));
+            }
+
+            // Other formats are converted
+            buffer.clear();
+            REQUIRE(image.convert(sf::RGBA32F).saveToMemory(buffer, "png"));
+            sf::Image loaded;
+            REQUIRE(loaded.loadFromMemory(buffer.data(), buffer.size(), sf::RGBA16F));
+            CHECK(loaded.getPixelFormat() == sf::RGBA16F);
+            CHECK(samePixels(loaded.convert(sf::RGBA8), image));
+
+            // A failed load leaves the image unchanged
+            const sf::Uint8 garbage[] = {1, 2, 3, 4};
+            CHECK(!loaded.loadFromMemory(garbage, sizeof(garbage), sf::R8));
+            CHECK(loaded.getPixelFormat() == sf::RGBA16F);
+            CHECK(loaded.getSize() == sf::Vector2u(13, 9));
+        }
+
+        SUBCASE("Load colors with fewer channels")
+        {
+            // The color channels are kept, like with convert, rather than reduced to their luminance
+            sf::Image image;
+            image.create(3, 2, sf::Color(200, 100, 50));
+            for (const char* extension : {"png", "tga"})
+            {
+                for (sf::PixelFormat fileFormat : {sf::RGB8, sf::RGBA8})
+                {
+                    std::vector<sf::Uint8> buffer;
+                    REQUIRE(image.convert(fileFormat).saveToMemory(buffer, extension));
+
+                    for (sf::PixelFormat format : {sf::R8, sf::RG8, sf::R16})
+                    {
+                        sf::Image loaded;
+                        REQUIRE(loaded.loadFromMemory(buffer.data(), buffer.size(), format));
+                        CHECK(samePixels(loaded, image.convert(format)));
+                    }
+                }
+            }
+
+            sf::Image loaded;
+            std::vector<sf::Uint8> buffer;
+            REQUIRE(image.saveToMemory(buffer, "png"));
+            REQUIRE(loaded.loadFromMemory(buffer.data(), buffer.size(), sf::R8));
+            CHECK(loaded.getPixel(1, 1) == sf::Color(200, 0, 0));
+            REQUIRE(loaded.loadFromMemory(buffer.data(), buffer.size(), sf::RG8));
+            CHECK(loaded.getPixel(1, 1) == sf::Color(200, 100, 0));
+        }
+    }
+
+    SUBCASE("QOI")
+    {
+        SUBCASE("Encoding")
+        {
+            // Initial pixel repeated, small difference, medium difference, new alpha, and a pixel from the index
+            const sf::Uint8 pixels[] = {0,   0,  0, 255,   0,   0,  0, 255,   1,   1,   1, 255,
+                                        26, 21, 18, 255, 200, 100, 50, 128,  1,   1,   1, 255};
+            sf::Image image;
+            image.create(3, 2, pixels);
+
+            std::vector<sf::Uint8> buffer;
+            REQUIRE(image.saveToMemory(buffer, "qoi"));
+
+            const std::vector<sf::Uint8> expected = {'q', 'o', 'i', 'f', 0, 0, 0, 3, 0, 0, 0, 2, 4, 0,
+                                                     0xc1,                                    // run of 2
+                                                     0x7f,                                    // diff (+1, +1, +1)
+                                                     0xb4, 0xd5,                              // luma (green +20, red +25, blue +17)
+                                                     0xff, 200, 100, 50, 128,                 // rgba
+                                                     (1 * 3 + 1 * 5 + 1 * 7 + 255 * 11) % 64, // index
+                                                     0, 0, 0, 0, 0, 0, 0, 1};
+            CHECK(buffer == expected);
+
+            sf::Image loaded;
+            REQUIRE(loaded.loadFromMemory(buffer.data(), buffer.size()));
+            CHECK(samePixels(loaded, image));
+        }
+
+        SUBCASE("Round trip")
+        {
+            const sf::Image image = makeImage(37, 21, 5);
+            std::vector<sf::Uint8> buffer;
+
+            // Grayscale images are stored as RGB
+            for (sf::PixelFormat format : {sf::R8, sf::RGB8, sf::RGBA8})
+            {
+                const sf::Image converted = image.convert(format);
+                buffer.clear();
+                REQUIRE(converted.saveToMemory(buffer, "qoi"));
+                CHECK(buffer[12] == ((format == sf::RGBA8) ? 4 : 3));
+
+                sf::Image loaded;
+                REQUIRE(loaded.loadFromMemory(buffer.data(), buffer.size(), format));
+                CHECK(loaded.getPixelFormat() == format);
+                CHECK(samePixels(loaded.convert(sf::RGBA8), converted.convert(sf::RGBA8)));
+
+                sf::MemoryInputStream stream;
+                stream.open(buffer.data(), buffer.size());
+                REQUIRE(loaded.loadFromStream(stream, format));
+                CHECK(samePixels(loaded.convert(sf::RGBA8), converted.convert(sf::RGBA8)));
+            }
+
+            // Files
+            const sf::Testing::TemporaryFile file(std::string(buffer.begin(), buffer.end()));
+            sf::Image loaded;
+            REQUIRE(loaded.loadFromFile(file.getPath()));
+            CHECK(samePixels(loaded, image));
+        }
+
+        SUBCASE("Corrupt data")
+        {
+            std::vector<sf::Uint8> buffer;
+            REQUIRE(makeImage(4, 4, 1).saveToMemory(buffer, "qoi"));
+
+            sf::Image image;
+            CHECK(!image.loadFromMemory(buffer.data(), 13));
+
+            buffer[12] = 5; // invalid number of channels
+            CHECK(!image.loadFromMemory(buffer.data(), buffer.size()));
+
+            buffer[12] = 4;
+            buffer[4] = 0xff; // too large
+            CHECK(!image.loadFromMemory(buffer.data(), buffer.size()));
+        }
+    }
+
+    SUBCASE("Save settings")
+    {
+        const sf::Image image = makeImage(64, 48, 3);
+
+        // PNG is lossless with any setting
+        for (unsigned int level : {1u, 6u, 9u})
+        {
+            for (auto filter : {sf::Image::SaveSettings::AdaptiveFilter, sf::Image::SaveSettings::NoFilter, sf::Image::SaveSettings::PaethFilter})
+            {
+                std::vector<sf::Uint8> buffer;
+                REQUIRE(image.saveToMemory(buffer, "png", sf::Image::SaveSettings(level, filter)));
+
+                sf::Image loaded;
+                REQUIRE(loaded.loadFromMemory(buffer.data(), buffer.size()));
+                CHECK(samePixels(loaded, image));
+            }
+        }
+
+        // JPEG files get smaller with the quality
+        std::vector<sf::Uint8> best;
+        std::vector<sf::Uint8> worst;
+        REQUIRE(image.saveToMemory(best, "jpg", sf::Image::SaveSettings(6, sf::Image::SaveSettings::AdaptiveFilter, 100)));
+        REQUIRE(image.saveToMemory(worst, "jpg", sf::Image::SaveSettings(6, sf::Image::SaveSettings::AdaptiveFilter, 10)));
+        CHECK(worst.size() < best.size());
+    }
+
+    SUBCASE("Batch loading")
+    {
+        // Encode a few different images, and some invalid data
+        std::vector<std::string> files;
+        std::vector<sf::Image> images;
+        for (unsigned int i = 0; i < 12; ++i)
+        {
+            images.push_back(makeImage(10 + i, 5 + i * 3, i));
+            std::vector<sf::Uint8> buffer;
+            REQUIRE(images.back().saveToMemory(buffer, (i % 2) ? "png" : "tga"));
+            files.emplace_back(buffer.begin(), buffer.end());
+        }
+        files[5] = "not an image";
+
+        SUBCASE("From files")
+        {
+            std::vector<std::unique_ptr<sf::Testing::TemporaryFile>> temporaryFiles;
+            std::vector<std::filesystem::path> paths;
+            for (const std::string& file : files)
+            {
+                temporaryFiles.push_back(std::make_unique<sf::Testing::TemporaryFile>(file));
+                paths.emplace_back(temporaryFiles.back()->getPath());
+            }
+            paths.emplace_back("missing-file.png");
+
+            const std::vector<sf::Image::LoadResult> results = sf::Image::loadFromFiles(paths);
+            REQUIRE(results.size() == 13);
+            for (std::size_t i = 0; i < 12; ++i)
+            {
+                if (i == 5)
+                    continue;
+
+                CHECK(results[i].success);
+                CHECK(results[i].error.empty());
+                CHECK(samePixels(results[i].image, images[i]));
+            }
+
+            CHECK(!results[5].success);
+            CHECK(!results[5].error.empty());
+            CHECK(results[5].image.getSize() == sf::Vector2u());
+            CHECK(!results[12].success);
+            CHECK(!results[12].error.empty());
+        }
+
+        SUBCASE("From streams")
+        {
+            std::vector<sf::MemoryInputStream> streams(files.size());
+            std::vector<sf::InputStream*> pointers;
+            for (std::size_t i = 0; i < files.size(); ++i)
+            {
+                streams[i].open(files[i].data(), files[i].size());
+                pointers.push_back(&streams[i]);
+            }
+
+            const std::vector<sf::Image::LoadResult> results = sf::Image::loadFromStreams(pointers, sf::R8);
+            REQUIRE(results.size() == 12);
+            for (std::size_t i = 0; i < 12; ++i)
+            {
+                CHECK(results[i].success == (i != 5));
+                if (i != 5)
+                {
+                    CHECK(results[i].image.getPixelFormat() == sf::R8);
+                    CHECK(samePixels(results[i].image, images[i].convert(sf::R8)));
+                }
+            }
+        }
+
+        CHECK(sf::Image::loadFromFiles({}).empty());
+    }
+}
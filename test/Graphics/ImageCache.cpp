@@ -0,0 +1,111 @@
+#include <SFML/Graphics/ImageCache.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include "GraphicsUtil.hpp"
+#include "SystemUtil.hpp"
+
+#include <doctest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace
+{
+    std::vector<std::filesystem::path> getEntries(const std::filesystem::path& directory)
+    {
+        std::vector<std::filesystem::path> entries;
+        for (const std::filesystem::directory_entry& entry : std::filesystem::directory_iterator(directory))
+            entries.push_back(entry.path());
+        return entries;
+    }
+}
+
+TEST_CASE("sf::ImageCache class - [graphics]")
+{
+    const std::filesystem::path directory = std::filesystem::temp_directory_path() / "sfml-image-cache-test";
+    std::filesystem::remove_all(directory);
+
+    const sf::ImageCache cache(directory);
+    CHECK(cache.getDirectory() == directory);
+
+    // Source file
+    sf::Image source;
+    source.create(7, 5, sf::Color(10, 20, 30, 40));
+    source.setPixel(3, 2, sf::Color(200, 100, 50, 255));
+    std::vector<sf::Uint8> encoded;
+    REQUIRE(source.saveToMemory(encoded, "png"));
+    const sf::Testing::TemporaryFile file(std::string(encoded.begin(), encoded.end()));
+
+    SUBCASE("Decoding and storing")
+    {
+        sf::Image image;
+        REQUIRE(cache.loadImage(file.getPath(), image));
+        CHECK(samePixels(image, source));
+        REQUIRE(getEntries(directory).size() == 1);
+        CHECK(std::filesystem::file_size(getEntries(directory)[0]) == 64 + 7 * 5 * 4);
+
+        // Each pixel format has its own entry
+        sf::Image gray;
+        REQUIRE(gray.loadFromFile(file.getPath(), sf::R8));
+        REQUIRE(cache.loadImage(file.getPath(), image, sf::R8));
+        CHECK(samePixels(image, gray));
+        CHECK(getEntries(directory).size() == 2);
+
+        cache.clear();
+        CHECK(getEntries(directory).empty());
+    }
+
+    SUBCASE("Loading from the cache")
+    {
+        sf::Image image;
+        REQUIRE(cache.loadImage(file.getPath(), image));
+        const std::filesystem::path entry = getEntries(directory).at(0);
+
+        // Modify the pixels of the entry, to tell where they come from
+        {
+            std::fstream stream(entry, std::ios_base::binary | std::ios_base::in | std::ios_base::out);
+            stream.seekp(64);
+            stream.put(static_cast<char>(99));
+        }
+
+        REQUIRE(cache.loadImage(file.getPath(), image));
+        CHECK(image.getPixel(0, 0) == sf::Color(99, 20, 30, 40));
+        CHECK(image.getPixel(3, 2) == sf::Color(200, 100, 50, 255));
+
+        // Invalid entries are replaced
+        std::filesystem::resize_file(entry, 70);
+        REQUIRE(cache.loadImage(file.getPath(), image));
+        CHECK(samePixels(image, source));
+        CHECK(std::filesystem::file_size(entry) == 64 + 7 * 5 * 4);
+    }
+
+    SUBCASE("Modified source")
+    {
+        sf::Image image;
+        REQUIRE(cache.loadImage(file.getPath(), image));
+
+        source.setPixel(0, 0, sf::Color::Green);
+        encoded.clear();
+        REQUIRE(source.saveToMemory(encoded, "png"));
+        const sf::Testing::TemporaryFile modified(std::string(encoded.begin(), encoded.end()));
+
+        REQUIRE(cache.loadImage(modified.getPath(), image));
+        CHECK(samePixels(image, source));
+        CHECK(getEntries(directory).size() == 2);
+    }
+
+    SUBCASE("Failures")
+    {
+        sf::Image image;
+        image.create(2, 2, sf::Color::Red);
+
+        CHECK(!cache.loadImage("missing-file.png", image));
+        const sf::Testing::TemporaryFile invalid("not an image");
+        CHECK(!cache.loadImage(invalid.getPath(), image));
+        CHECK(image.getSize() == sf::Vector2u(2, 2));
+        CHECK(!std::filesystem::exists(directory));
+    }
+
+    std::filesystem::remove_all(directory);
+}
@@ -0,0 +1,124 @@
+#include <SFML/Graphics/ParticleSystem.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include "GraphicsUtil.hpp"
+
+#include <doctest.h>
+
+TEST_CASE("sf::ParticleSystem class - [graphics]")
+{
+    SUBCASE("Construction")
+    {
+        const sf::ParticleSystem particles;
+        CHECK(particles.getParticleCount() == 0);
+        CHECK(particles.getAcceleration() == sf::Vector2f());
+        CHECK(particles.getStartColor() == sf::Color::White);
+        CHECK(particles.getEndColor() == sf::Color::White);
+        CHECK(particles.getParticleSize() == 1.f);
+        CHECK(particles.getTexture() == nullptr);
+    }
+
+    SUBCASE("Update")
+    {
+        sf::ParticleSystem particles;
+        particles.setAcceleration({0, 10});
+        particles.setColors(sf::Color(0, 0, 0, 255), sf::Color(200, 100, 0, 55));
+
+        particles.emit({1, 2}, {4, 0}, sf::seconds(1));
+        particles.emit({0, 0}, {0, 0}, sf::seconds(3));
+        particles.emit({0, 0}, {0, 0}, sf::Time::Zero);
+        REQUIRE(particles.getParticleCount() == 2);
+        CHECK(particles.getParticleColor(0) == sf::Color(0, 0, 0, 255));
+
+        particles.update(sf::seconds(0.5f));
+        REQUIRE(particles.getParticleCount() == 2);
+        CHECK(particles.getParticlePosition(0) == sf::Vector2f(3, 4.5f));
+        CHECK(particles.getParticleColor(0) == sf::Color(100, 50, 0, 155));
+
+        // The dead particle is replaced by the last one
+        particles.update(sf::seconds(0.5f));
+        REQUIRE(particles.getParticleCount() == 1);
+        CHECK(particles.getParticlePosition(0) == sf::Vector2f(0, 7.5f));
+
+        particles.clear();
+        CHECK(particles.getParticleCount() == 0);
+    }
+
+    SUBCASE("Large systems")
+    {
+        // Enough particles to be updated by several threads
+        sf::ParticleSystem particles;
+        particles.reserve(100000);
+        for (int i = 0; i < 100000; ++i)
+            particles.emit({static_cast<float>(i), 0}, {1, 2}, sf::seconds((i % 2) ? 1.f : 4.f));
+
+        particles.update(sf::seconds(2));
+        REQUIRE(particles.getParticleCount() == 50000);
+        bool survivorsMoved = true;
+        for (std::size_t i = 0; i < particles.getParticleCount(); ++i)
+        {
+            const sf::Vector2f position = particles.getParticlePosition(i);
+            survivorsMoved = survivorsMoved && (static_cast<int>(position.x) % 2 == 0) && (position.y == 4.f);
+        }
+        CHECK(survivorsMoved);
+    }
+
+    SUBCASE("Drawing")
+    {
+        sf::ParticleSystem particles;
+        particles.setParticleSize(4);
+        particles.setColors(sf::Color::Green, sf::Color::Blue);
+        particles.emit({4, 4}, {8, 0}, sf::seconds(2));
+        particles.emit({20, 4}, {0, 0}, sf::seconds(1));
+
+        sf::RenderTexture renderTexture;
+        REQUIRE(renderTexture.create(32, 8));
+
+        const auto render = [&]()
+        {
+            renderTexture.clear();
+            renderTexture.draw(particles);
+            renderTexture.display();
+            return renderTexture.getTexture().copyToImage();
+        };
+
+        sf::Image result = render();
+        CHECK(result.getPixel(2, 2) == sf::Color::Green);
+        CHECK(result.getPixel(5, 5) == sf::Color::Green);
+        CHECK(result.getPixel(6, 6) == sf::Color::Black);
+        CHECK(result.getPixel(21, 3) == sf::Color::Green);
+
+        // Drawn again, after the particles moved and changed color
+        particles.update(sf::seconds(1));
+        result = render();
+        CHECK(result.getPixel(5, 5) == sf::Color::Black);
+        CHECK(result.getPixel(13, 5) == sf::Color(0, 128, 128));
+        CHECK(result.getPixel(21, 3) == sf::Color::Black);
+
+        // Textured particles
+        sf::Image image;
+        image.create(2, 2, sf::Color::White);
+        image.setPixel(1, 1, sf::Color::Red);
+        sf::Texture texture;
+        REQUIRE(texture.loadFromImage(image));
+
+        particles.setTexture(&texture);
+        particles.setColors(sf::Color::White, sf::Color::White);
+        result = render();
+        CHECK(result.getPixel(10, 2) == sf::Color::White);
+        CHECK(result.getPixel(13, 5) == sf::Color::Red);
+
+        // Fewer particles than the vertex buffer holds
+        particles.clear();
+        particles.setTexture(nullptr);
+        particles.setColors(sf::Color::Green, sf::Color::Green);
+        particles.emit({4, 4}, {0, 0}, sf::seconds(1));
+        for (int frame = 0; frame < 4; ++frame)
+        {
+            result = render();
+            CHECK(result.getPixel(5, 5) == sf::Color::Green);
+            CHECK(result.getPixel(13, 5) == sf::Color::Black);
+        }
+    }
+}
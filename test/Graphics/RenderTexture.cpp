@@ -0,0 +1,343 @@
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Shader.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/VertexBuffer.hpp>
+#include <SFML/Graphics/VertexLayout.hpp>
+#include "GraphicsUtil.hpp"
+
+#include <doctest.h>
+
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <optional>
+
+TEST_CASE("sf::RenderTexture class - [graphics]")
+{
+    SUBCASE("Construction")
+    {
+        sf::RenderTexture renderTexture;
+        REQUIRE(renderTexture.create(64, 32));
+        CHECK(renderTexture.getSize() == sf::Vector2u(64, 32));
+        CHECK(renderTexture.getTexture().getSize() == sf::Vector2u(64, 32));
+    }
+
+    SUBCASE("Drawing")
+    {
+        sf::RenderTexture renderTexture;
+        REQUIRE(renderTexture.create(64, 32));
+
+        sf::RectangleShape rectangle({16, 8});
+        rectangle.setPosition({4, 2});
+        rectangle.setFillColor(sf::Color::Green);
+
+        renderTexture.clear(sf::Color::Red);
+        renderTexture.draw(rectangle);
+        renderTexture.display();
+
+        const sf::Image image = renderTexture.getTexture().copyToImage();
+        REQUIRE(image.getSize() == sf::Vector2u(64, 32));
+        CHECK(image.getPixel(0, 0) == sf::Color::Red);
+        CHECK(image.getPixel(4, 2) == sf::Color::Green);
+        CHECK(image.getPixel(19, 9) == sf::Color::Green);
+        CHECK(image.getPixel(20, 10) == sf::Color::Red);
+        CHECK(image.getPixel(63, 31) == sf::Color::Red);
+    }
+
+    SUBCASE("Vertex layouts")
+    {
+        sf::RenderTexture renderTexture;
+        REQUIRE(renderTexture.create(32, 32));
+        renderTexture.clear(sf::Color::Black);
+
+        const sf::ColoredVertex colored[] = {{{0, 0}, sf::Color::Red}, {{16, 0}, sf::Color::Red},
+                                             {{0, 16}, sf::Color::Red}, {{16, 16}, sf::Color::Red}};
+        renderTexture.draw(colored, 4, sf::VertexLayout::Colored, sf::TriangleStrip);
+
+        const sf::CompactVertex compact[] = {{{16, 16}, sf::Color::Green, {0, 0}}, {{32, 16}, sf::Color::Green, {0, 0}},
+                                             {{16, 32}, sf::Color::Green, {0, 0}}, {{32, 32}, sf::Color::Green, {0, 0}}};
+        sf::VertexBuffer vertexBuffer(sf::TriangleStrip);
+        vertexBuffer.setLayout(sf::VertexLayout::Compact);
+        REQUIRE(vertexBuffer.create(4));
+        REQUIRE(vertexBuffer.update(compact, 4, 0));
+        renderTexture.draw(vertexBuffer);
+
+        // Sizes must match the layout
+        const sf::Vertex vertices[4];
+        CHECK(!vertexBuffer.update(vertices, 4, 0));
+
+        renderTexture.display();
+        const sf::Image image = renderTexture.getTexture().copyToImage();
+        CHECK(image.getPixel(1, 1) == sf::Color::Red);
+        CHECK(image.getPixel(15, 15) == sf::Color::Red);
+        CHECK(image.getPixel(20, 20) == sf::Color::Green);
+        CHECK(image.getPixel(20, 4) == sf::Color::Black);
+    }
+
+    SUBCASE("Mapped and rotated vertex buffers")
+    {
+        sf::RenderTexture renderTexture;
+        REQUIRE(renderTexture.create(16, 16));
+
+        sf::VertexBuffer vertexBuffer(sf::TriangleStrip, sf::VertexBuffer::Stream);
+        vertexBuffer.setBufferCount(0);
+        CHECK(vertexBuffer.getBufferCount() == 1);
+        vertexBuffer.setBufferCount(3);
+        CHECK(vertexBuffer.getBufferCount() == 3);
+        REQUIRE(vertexBuffer.create(4));
+        CHECK(!vertexBuffer.unmap());
+        CHECK(vertexBuffer.map(2, 3) == nullptr);
+
+        // Each frame draws the last vertices written, whichever buffer they are in
+        const sf::Color colors[] = {sf::Color::Red, sf::Color::Green, sf::Color::Blue, sf::Color::Yellow, sf::Color::Cyan};
+        for (const sf::Color& color : colors)
+        {
+            auto* vertices = static_cast<sf::Vertex*>(vertexBuffer.map(0, 4));
+            REQUIRE(vertices != nullptr);
+            CHECK(vertexBuffer.map(0, 4) == nullptr);
+            vertices[0] = sf::Vertex({0, 0}, color);
+            vertices[1] = sf::Vertex({16, 0}, color);
+            vertices[2] = sf::Vertex({0, 16}, color);
+            vertices[3] = sf::Vertex({16, 16}, color);
+            CHECK(!vertexBuffer.update(vertices));
+            REQUIRE(vertexBuffer.unmap());
+
+            renderTexture.clear();
+            renderTexture.draw(vertexBuffer);
+            renderTexture.display();
+            CHECK(renderTexture.getTexture().copyToImage().getPixel(8, 8) == color);
+        }
+
+        // Partial updates write to the buffer holding the last vertices
+        const sf::Vertex magenta[] = {sf::Vertex({0, 16}, sf::Color::Magenta), sf::Vertex({16, 16}, sf::Color::Magenta)};
+        REQUIRE(vertexBuffer.update(magenta, 2, 2));
+        renderTexture.clear();
+        renderTexture.draw(vertexBuffer);
+        renderTexture.display();
+        const sf::Image image = renderTexture.getTexture().copyToImage();
+        CHECK(image.getPixel(8, 0).g > 240);
+        CHECK(image.getPixel(8, 15).g < 16);
+
+        // Copies draw the same vertices
+        const sf::VertexBuffer copy(vertexBuffer);
+        CHECK(copy.getBufferCount() == 3);
+        renderTexture.clear();
+        renderTexture.draw(copy);
+        renderTexture.display();
+        CHECK(renderTexture.getTexture().copyToImage().getPixel(8, 15).g < 16);
+
+        // Mapping the first vertices discards the others, and rotates the buffers too
+        CHECK(vertexBuffer.map(0) == nullptr);
+        CHECK(vertexBuffer.map(5) == nullptr);
+        for (const sf::Color& color : colors)
+        {
+            auto* vertices = static_cast<sf::Vertex*>(vertexBuffer.map(3));
+            REQUIRE(vertices != nullptr);
+            vertices[0] = sf::Vertex({0, 0}, color);
+            vertices[1] = sf::Vertex({32, 0}, color);
+            vertices[2] = sf::Vertex({0, 32}, color);
+            REQUIRE(vertexBuffer.unmap());
+
+            renderTexture.clear();
+            renderTexture.draw(vertexBuffer, 0, 3);
+            renderTexture.display();
+            CHECK(renderTexture.getTexture().copyToImage().getPixel(8, 8) == color);
+        }
+    }
+
+    SUBCASE("Switching targets and textures")
+    {
+        // The bindings and blend mode tracked for the context must follow the targets and the deleted objects
+        sf::RenderTexture first;
+        sf::RenderTexture second;
+        REQUIRE(first.create(8, 8));
+        REQUIRE(second.create(8, 8));
+
+        const auto makeTexture = [](const sf::Color& color)
+        {
+            sf::Image image;
+            image.create(2, 2, color);
+            sf::Texture texture;
+            REQUIRE(texture.loadFromImage(image));
+            return texture;
+        };
+
+        sf::RectangleShape rectangle({8, 8});
+        std::optional<sf::Texture> texture = makeTexture(sf::Color(100, 0, 0));
+        rectangle.setTexture(&*texture);
+
+        first.clear(sf::Color(0, 0, 50));
+        second.clear(sf::Color(0, 0, 50));
+        first.draw(rectangle, sf::BlendAdd);
+        second.draw(rectangle, sf::BlendAdd);
+        first.draw(rectangle, sf::BlendAdd);
+        first.display();
+        second.display();
+        CHECK(first.getTexture().copyToImage().getPixel(4, 4) == sf::Color(200, 0, 50));
+        CHECK(second.getTexture().copyToImage().getPixel(4, 4) == sf::Color(100, 0, 50));
+
+        // The name of the deleted texture is likely reused by the new one
+        texture.reset();
+        texture = makeTexture(sf::Color::Green);
+        rectangle.setTexture(&*texture);
+        first.clear();
+        first.draw(rectangle);
+        first.display();
+        CHECK(first.getTexture().copyToImage().getPixel(4, 4) == sf::Color::Green);
+
+        // A render texture drawn to another one, then modified and drawn again
+        sf::RectangleShape copy({8, 8});
+        copy.setTexture(&first.getTexture());
+        second.clear();
+        second.draw(copy);
+        second.display();
+        CHECK(second.getTexture().copyToImage().getPixel(4, 4) == sf::Color::Green);
+
+        first.clear(sf::Color::Blue);
+        first.display();
+        second.draw(copy);
+        second.display();
+        CHECK(second.getTexture().copyToImage().getPixel(4, 4) == sf::Color::Blue);
+    }
+
+    SUBCASE("Multiple target textures")
+    {
+        sf::RenderTexture renderTexture;
+        CHECK(!renderTexture.create(16, 16, std::initializer_list<sf::PixelFormat>()));
+        if (sf::RenderTexture::getMaximumTextureCount() < 2)
+            return;
+
+        REQUIRE(renderTexture.create(16, 16, {sf::RGBA8, sf::RGBA8}));
+        REQUIRE(renderTexture.getTextureCount() == 2);
+        CHECK(&renderTexture.getTexture(0) == &renderTexture.getTexture());
+        CHECK(renderTexture.getTexture(1).getSize() == sf::Vector2u(16, 16));
+
+        // Without shader, the same color is written to all the textures
+        sf::RectangleShape rectangle({8, 8});
+        rectangle.setFillColor(sf::Color::Green);
+        renderTexture.clear(sf::Color::Black);
+        renderTexture.draw(rectangle);
+        renderTexture.display();
+        CHECK(renderTexture.getTexture(0).copyToImage().getPixel(4, 4) == sf::Color::Green);
+        CHECK(renderTexture.getTexture(1).copyToImage().getPixel(4, 4) == sf::Color::Green);
+        CHECK(renderTexture.getTexture(1).copyToImage().getPixel(12, 12) == sf::Color::Black);
+
+        if (!sf::Shader::isAvailable())
+            return;
+
+        sf::Shader shader;
+        REQUIRE(shader.loadFromMemory("void main()"
+                                      "{"
+                                      "    gl_FragData[0] = vec4(1.0, 0.0, 0.0, 1.0);"
+                                      "    gl_FragData[1] = vec4(0.0, 0.0, 1.0, 1.0);"
+                                      "}",
+                                      sf::Shader::Fragment));
+
+        // A shader writes a different color to each texture, with or without multisampling
+        for (unsigned int antialiasingLevel : {0u, 4u})
+        {
+            if (antialiasingLevel > sf::RenderTexture::getMaximumAntialiasingLevel())
+                continue;
+
+            sf::ContextSettings settings;
+            settings.antialiasingLevel = antialiasingLevel;
+            REQUIRE(renderTexture.create(16, 16, {sf::RGBA8, sf::RGBA8}, settings));
+
+            renderTexture.clear(sf::Color::Black);
+            renderTexture.draw(rectangle, &shader);
+            renderTexture.display();
+            CHECK(renderTexture.getTexture(0).copyToImage().getPixel(4, 4) == sf::Color::Red);
+            CHECK(renderTexture.getTexture(1).copyToImage().getPixel(4, 4) == sf::Color::Blue);
+            CHECK(renderTexture.getTexture(1).copyToImage().getPixel(12, 12) == sf::Color::Black);
+        }
+
+        // The textures can have different formats: multisample color buffers take the format of their
+        // texture, so that values out of the [0, 1] range are kept in floating point textures
+        sf::Shader rangeShader;
+        REQUIRE(rangeShader.loadFromMemory("void main()"
+                                           "{"
+                                           "    gl_FragData[0] = vec4(1.0, 0.0, 0.0, 1.0);"
+                                           "    gl_FragData[1] = vec4(2.0, 1.0, 0.0, 1.0);"
+                                           "}",
+                                           sf::Shader::Fragment));
+
+        for (sf::PixelFormat format : {sf::R8, sf::RGBA16F})
+        {
+            for (unsigned int antialiasingLevel : {0u, 4u})
+            {
+                if (antialiasingLevel > sf::RenderTexture::getMaximumAntialiasingLevel())
+                    continue;
+
+                sf::ContextSettings settings;
+                settings.antialiasingLevel = antialiasingLevel;
+                REQUIRE(renderTexture.create(16, 16, {sf::RGBA8, format}, settings));
+                CHECK(renderTexture.getTexture(0).getPixelFormat() == sf::RGBA8);
+                CHECK(renderTexture.getTexture(1).getPixelFormat() == format);
+
+                renderTexture.clear(sf::Color::Black);
+                renderTexture.draw(rectangle, &rangeShader);
+                renderTexture.display();
+                const sf::Image image = renderTexture.getTexture(1).copyToImage();
+                REQUIRE(image.getPixelFormat() == format);
+                CHECK(renderTexture.getTexture(0).copyToImage().getPixel(4, 4) == sf::Color::Red);
+                CHECK(image.getPixel(4, 4) == ((format == sf::R8) ? sf::Color::Red : sf::Color::Yellow));
+                CHECK(image.getPixel(12, 12) == sf::Color::Black);
+
+                if (format == sf::RGBA16F)
+                {
+                    // Half precision red and green of the pixel (4, 4): 2.0 and 1.0
+                    sf::Uint16 halves[2];
+                    std::memcpy(halves, image.getPixelsPtr() + (4 + 4 * 16) * sf::getPixelSize(format), sizeof(halves));
+                    CHECK(halves[0] == 0x4000);
+                    CHECK(halves[1] == 0x3C00);
+                }
+            }
+        }
+
+        // Creating the render texture again with a single texture still works
+        REQUIRE(renderTexture.create(16, 16));
+        CHECK(renderTexture.getTextureCount() == 1);
+    }
+
+    SUBCASE("Custom vertex attributes")
+    {
+        sf::RenderTexture renderTexture;
+        REQUIRE(renderTexture.create(16, 16));
+        if (!sf::Shader::isAvailable())
+            return;
+
+        // Normalized 16-bit attribute, read by the vertex shader
+        struct ShadedVertex
+        {
+            float      position[2];
+            sf::Uint16 shade;
+        };
+
+        sf::VertexLayout layout(sizeof(ShadedVertex), sf::VertexLayout::Float, offsetof(ShadedVertex, position));
+        layout.addAttribute("shade", sf::VertexLayout::UnsignedShort, 1, true, offsetof(ShadedVertex, shade));
+
+        sf::Shader shader;
+        REQUIRE(shader.loadFromMemory("attribute float shade;"
+                                      "varying float value;"
+                                      "void main()"
+                                      "{"
+                                      "    gl_Position = gl_ModelViewProjectionMatrix * gl_Vertex;"
+                                      "    value = shade;"
+                                      "}",
+                                      "varying float value;"
+                                      "void main()"
+                                      "{"
+                                      "    gl_FragColor = vec4(value, 0.0, 0.0, 1.0);"
+                                      "}"));
+
+        const ShadedVertex vertices[] = {{{0, 0}, 32896}, {{16, 0}, 32896}, {{0, 16}, 32896}, {{16, 16}, 32896}};
+        renderTexture.clear(sf::Color::Black);
+        renderTexture.draw(vertices, 4, layout, sf::TriangleStrip, &shader);
+        renderTexture.display();
+
+        const sf::Image image = renderTexture.getTexture().copyToImage();
+        CHECK(image.getPixel(8, 8) == sf::Color(128, 0, 0));
+    }
+}
@@ -0,0 +1,131 @@
+#include <SFML/Graphics/SceneGraph.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/SoftwareRenderTarget.hpp>
+#include <SFML/System/Angle.hpp>
+#include "GraphicsUtil.hpp"
+
+#include <doctest.h>
+
+TEST_CASE("sf::SceneGraph class - [graphics]")
+{
+    SUBCASE("Construction")
+    {
+        const sf::SceneGraph scene;
+        CHECK(scene.getNodeCount() == 1);
+        CHECK(scene.contains(sf::SceneGraph::Root));
+        CHECK(!scene.contains(1));
+        CHECK(scene.getWorldTransform(sf::SceneGraph::Root) == sf::AffineTransform::Identity);
+    }
+
+    SUBCASE("World transforms")
+    {
+        sf::SceneGraph scene;
+        const sf::SceneGraph::NodeId parent = scene.createNode();
+        const sf::SceneGraph::NodeId child = scene.createNode(parent);
+        const sf::SceneGraph::NodeId grandChild = scene.createNode(child);
+        CHECK(scene.getNodeCount() == 4);
+        CHECK(scene.getParent(grandChild) == child);
+
+        scene.getTransformable(parent).setPosition({10, 20});
+        scene.getTransformable(child).setScale({2, 2});
+        scene.getTransformable(grandChild).setPosition({1, 1});
+        CHECK(scene.getWorldTransform(grandChild).transformPoint({0, 0}) == sf::Vector2f(12, 22));
+        CHECK(scene.getInverseWorldTransform(grandChild).transformPoint({12, 22}) == sf::Vector2f(0, 0));
+
+        // Modifying a node updates its descendants only
+        scene.getTransformable(child).setScale({3, 3});
+        CHECK(scene.getWorldTransform(grandChild).transformPoint({0, 0}) == sf::Vector2f(13, 23));
+        CHECK(scene.getWorldTransform(parent).transformPoint({0, 0}) == sf::Vector2f(10, 20));
+
+        scene.getTransformable(parent).move({5, 0});
+        CHECK(scene.getWorldTransform(grandChild).transformPoint({0, 0}) == sf::Vector2f(18, 23));
+        const sf::Vector2f local = scene.getInverseWorldTransform(grandChild).transformPoint({18, 23});
+        CHECK(local.x == doctest::Approx(0));
+        CHECK(local.y == doctest::Approx(0));
+    }
+
+    SUBCASE("Hierarchy changes")
+    {
+        sf::SceneGraph scene;
+        const sf::SceneGraph::NodeId a = scene.createNode();
+        const sf::SceneGraph::NodeId b = scene.createNode();
+        const sf::SceneGraph::NodeId aChild = scene.createNode(a);
+        const sf::SceneGraph::NodeId bChild = scene.createNode(b);
+        scene.getTransformable(a).setPosition({100, 0});
+        scene.getTransformable(b).setPosition({0, 100});
+        CHECK(scene.getWorldTransform(aChild).transformPoint({0, 0}) == sf::Vector2f(100, 0));
+        CHECK(scene.getWorldTransform(bChild).transformPoint({0, 0}) == sf::Vector2f(0, 100));
+
+        // Cycles are refused
+        scene.setParent(a, aChild);
+        CHECK(scene.getParent(a) == sf::SceneGraph::Root);
+
+        scene.setParent(aChild, b);
+        CHECK(scene.getParent(aChild) == b);
+        CHECK(scene.getWorldTransform(aChild).transformPoint({0, 0}) == sf::Vector2f(0, 100));
+
+        scene.removeNode(b);
+        CHECK(scene.getNodeCount() == 2);
+        CHECK(!scene.contains(b));
+        CHECK(!scene.contains(aChild));
+        CHECK(!scene.contains(bChild));
+        CHECK(scene.contains(a));
+        CHECK(scene.getWorldTransform(a).transformPoint({0, 0}) == sf::Vector2f(100, 0));
+
+        // Identifiers of removed nodes are reused
+        const sf::SceneGraph::NodeId reused = scene.createNode(a);
+        CHECK(reused != a);
+        CHECK(reused < 5);
+        CHECK(scene.getWorldTransform(reused).transformPoint({1, 1}) == sf::Vector2f(101, 1));
+
+        scene.removeNode(sf::SceneGraph::Root);
+        CHECK(scene.getNodeCount() == 3);
+    }
+
+    SUBCASE("World bounds")
+    {
+        sf::SceneGraph scene;
+        const sf::SceneGraph::NodeId parent = scene.createNode();
+        const sf::SceneGraph::NodeId child = scene.createNode(parent);
+        scene.setLocalBounds(child, sf::FloatRect({0, 0}, {10, 5}));
+        scene.getTransformable(parent).setPosition({20, 30});
+        scene.getTransformable(parent).setRotation(sf::degrees(90));
+        const sf::FloatRect bounds = scene.getWorldBounds(child);
+        CHECK(bounds.left == doctest::Approx(15));
+        CHECK(bounds.top == doctest::Approx(30));
+        CHECK(bounds.width == doctest::Approx(5));
+        CHECK(bounds.height == doctest::Approx(10));
+    }
+
+    SUBCASE("Drawing")
+    {
+        sf::RectangleShape red({4, 4});
+        red.setFillColor(sf::Color::Red);
+        sf::RectangleShape green({4, 4});
+        green.setFillColor(sf::Color::Green);
+
+        sf::SceneGraph scene;
+        const sf::SceneGraph::NodeId parent = scene.createNode();
+        const sf::SceneGraph::NodeId child = scene.createNode(parent);
+        const sf::SceneGraph::NodeId culled = scene.createNode(parent);
+        scene.setDrawable(parent, &red);
+        scene.setDrawable(child, &green);
+        scene.setDrawable(culled, &green);
+        scene.setLocalBounds(culled, red.getLocalBounds());
+        scene.getTransformable(parent).setPosition({2, 2});
+        scene.getTransformable(child).setPosition({2, 2});
+        scene.getTransformable(culled).setPosition({100, 100});
+
+        sf::SoftwareRenderTarget target;
+        REQUIRE(target.create(16, 16));
+        target.clear();
+        target.draw(scene);
+        target.display();
+
+        const sf::Image& image = target.getImage();
+        CHECK(image.getPixel(2, 2) == sf::Color::Red);
+        CHECK(image.getPixel(4, 4) == sf::Color::Green);
+        CHECK(image.getPixel(7, 7) == sf::Color::Green);
+        CHECK(image.getPixel(8, 8) == sf::Color::Black);
+    }
+}
@@ -0,0 +1,209 @@
+#include <SFML/Graphics/SoftwareRenderTarget.hpp>
+#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include <SFML/Graphics/View.hpp>
+#include "GraphicsUtil.hpp"
+
+#include <doctest.h>
+
+#include <algorithm>
+#include <iterator>
+#include <vector>
+
+TEST_CASE("sf::SoftwareRenderTarget class - [graphics]")
+{
+    SUBCASE("Construction")
+    {
+        sf::SoftwareRenderTarget target;
+        CHECK(target.getSize() == sf::Vector2u());
+        CHECK(target.getImage().getSize() == sf::Vector2u());
+        CHECK(!target.create(0, 32));
+
+        REQUIRE(target.create(64, 32));
+        CHECK(target.getSize() == sf::Vector2u(64, 32));
+        CHECK(target.getImage().getSize() == sf::Vector2u(64, 32));
+        CHECK(target.getImage().getPixel(0, 0) == sf::Color::Transparent);
+        CHECK(target.getView().getSize() == sf::Vector2f(64, 32));
+        CHECK(!target.setActive(true));
+    }
+
+    SUBCASE("Drawing")
+    {
+        sf::SoftwareRenderTarget target;
+        REQUIRE(target.create(64, 32));
+
+        sf::RectangleShape rectangle({16, 8});
+        rectangle.setPosition({4, 2});
+        rectangle.setFillColor(sf::Color::Green);
+
+        target.clear(sf::Color::Red);
+        target.draw(rectangle);
+        CHECK(target.getImage().getPixel(0, 0) == sf::Color::Transparent);
+
+        target.display();
+        const sf::Image& image = target.getImage();
+        CHECK(image.getPixel(0, 0) == sf::Color::Red);
+        CHECK(image.getPixel(4, 2) == sf::Color::Green);
+        CHECK(image.getPixel(19, 9) == sf::Color::Green);
+        CHECK(image.getPixel(3, 2) == sf::Color::Red);
+        CHECK(image.getPixel(20, 9) == sf::Color::Red);
+        CHECK(image.getPixel(19, 10) == sf::Color::Red);
+    }
+
+    SUBCASE("Blending")
+    {
+        sf::SoftwareRenderTarget target;
+        REQUIRE(target.create(8, 8));
+
+        sf::RectangleShape rectangle({8, 8});
+        rectangle.setFillColor(sf::Color(255, 0, 0, 128));
+
+        target.clear(sf::Color(0, 0, 255));
+        target.draw(rectangle);
+        target.display();
+        CHECK(target.getImage().getPixel(3, 3) == sf::Color(128, 0, 127));
+
+        target.clear(sf::Color(0, 100, 0));
+        target.draw(rectangle, sf::BlendAdd);
+        target.display();
+        CHECK(target.getImage().getPixel(3, 3) == sf::Color(128, 100, 0));
+
+        target.clear(sf::Color(200, 100, 50));
+        target.draw(rectangle, sf::BlendMax);
+        target.display();
+        CHECK(target.getImage().getPixel(3, 3) == sf::Color(255, 100, 50));
+    }
+
+    SUBCASE("Fill rule")
+    {
+        // Adjacent triangles cover each pixel exactly once
+        sf::SoftwareRenderTarget target;
+        REQUIRE(target.create(32, 32));
+
+        const sf::Color color(10, 20, 30, 40);
+        const sf::Vertex vertices[] = {{{1.3f, 2.7f}, color}, {{30.1f, 0.4f}, color}, {{17.5f, 16.5f}, color},
+                                       {{28.9f, 31.2f}, color}, {{0.2f, 29.8f}, color}};
+        const std::size_t fan[] = {2, 0, 1, 3, 4, 0};
+
+        std::vector<sf::Vertex> triangles;
+        for (std::size_t i = 0; i + 1 < std::size(fan); ++i)
+        {
+            triangles.push_back(vertices[fan[0]]);
+            triangles.push_back(vertices[fan[i]]);
+            triangles.push_back(vertices[fan[i + 1]]);
+        }
+
+        target.clear(sf::Color::Transparent);
+        target.draw(triangles.data(), triangles.size(), sf::Triangles, sf::BlendMode(sf::BlendMode::One, sf::BlendMode::One));
+        target.display();
+
+        const sf::Image& image = target.getImage();
+        for (unsigned int y = 0; y < 32; ++y)
+            for (unsigned int x = 0; x < 32; ++x)
+                CHECK(((image.getPixel(x, y) == color) || (image.getPixel(x, y) == sf::Color::Transparent)));
+        CHECK(image.getPixel(16, 16) == color);
+    }
+
+    SUBCASE("View")
+    {
+        sf::SoftwareRenderTarget target;
+        REQUIRE(target.create(64, 64));
+
+        sf::View view({0, 0}, {32, 32});
+        view.setViewport(sf::FloatRect({0.5f, 0.5f}, {0.5f, 0.5f}));
+        target.setView(view);
+
+        // The rectangle covers the whole view, but nothing outside of its viewport
+        sf::RectangleShape rectangle({100, 100});
+        rectangle.setPosition({-50, -50});
+        rectangle.setFillColor(sf::Color::White);
+
+        target.clear(sf::Color::Black);
+        target.draw(rectangle);
+        target.display();
+
+        const sf::Image& image = target.getImage();
+        CHECK(image.getPixel(31, 31) == sf::Color::Black);
+        CHECK(image.getPixel(32, 32) == sf::Color::White);
+        CHECK(image.getPixel(63, 63) == sf::Color::White);
+        CHECK(image.getPixel(63, 0) == sf::Color::Black);
+    }
+
+    SUBCASE("Texturing")
+    {
+        sf::Image texture;
+        texture.create(2, 2, sf::Color::Red);
+        texture.setPixel(1, 0, sf::Color::Green);
+        texture.setPixel(0, 1, sf::Color::Blue);
+
+        sf::SoftwareRenderTarget target;
+        REQUIRE(target.create(4, 4));
+
+        const sf::Vertex quad[] = {{{0, 0}, {0, 0}}, {{4, 0}, {2, 0}}, {{0, 4}, {0, 2}}, {{4, 4}, {2, 2}}};
+        target.clear();
+        target.draw(quad, 4, sf::TriangleStrip, texture);
+        target.display();
+
+        const sf::Image& image = target.getImage();
+        CHECK(image.getPixel(0, 0) == sf::Color::Red);
+        CHECK(image.getPixel(3, 0) == sf::Color::Green);
+        CHECK(image.getPixel(1, 3) == sf::Color::Blue);
+        CHECK(image.getPixel(2, 2) == sf::Color::Red);
+    }
+
+    SUBCASE("Lines and points")
+    {
+        sf::SoftwareRenderTarget target;
+        REQUIRE(target.create(8, 8));
+
+        const sf::Vertex line[] = {{{0, 1.5f}, sf::Color::White}, {{8, 1.5f}, sf::Color::White}};
+        const sf::Vertex point[] = {{{5.5f, 6.5f}, sf::Color::Yellow}};
+        target.clear();
+        target.draw(line, 2, sf::Lines);
+        target.draw(point, 1, sf::Points);
+        target.display();
+
+        const sf::Image& image = target.getImage();
+        for (unsigned int x = 0; x < 8; ++x)
+            CHECK(image.getPixel(x, 1) == sf::Color::White);
+        CHECK(image.getPixel(3, 0) == sf::Color::Black);
+        CHECK(image.getPixel(3, 2) == sf::Color::Black);
+        CHECK(image.getPixel(5, 6) == sf::Color::Yellow);
+    }
+
+    SUBCASE("Determinism")
+    {
+        // Rendering many primitives at once or one by one gives the same pixels
+        std::vector<sf::Vertex> vertices;
+        for (unsigned int i = 0; i < 300; ++i)
+        {
+            const auto x = static_cast<float>((i * 37) % 200) - 20.f;
+            const auto y = static_cast<float>((i * 91) % 150) - 20.f;
+            const auto size = static_cast<float>(i % 41) + 1.5f;
+            const sf::Color color(static_cast<sf::Uint8>(i * 7), static_cast<sf::Uint8>(i * 13), static_cast<sf::Uint8>(i * 29), static_cast<sf::Uint8>(i * 3));
+            vertices.emplace_back(sf::Vector2f(x, y), color);
+            vertices.emplace_back(sf::Vector2f(x + size, y + size / 3.f), sf::Color::White);
+            vertices.emplace_back(sf::Vector2f(x + size / 2.f, y + size * 1.7f), color);
+        }
+
+        sf::SoftwareRenderTarget batched;
+        sf::SoftwareRenderTarget sequential;
+        REQUIRE(batched.create(180, 130));
+        REQUIRE(sequential.create(180, 130));
+
+        batched.clear(sf::Color(20, 40, 60));
+        batched.draw(vertices.data(), vertices.size(), sf::Triangles);
+        batched.display();
+
+        sequential.clear(sf::Color(20, 40, 60));
+        for (std::size_t i = 0; i < vertices.size(); i += 3)
+        {
+            sequential.draw(&vertices[i], 3, sf::Triangles);
+            sequential.display();
+        }
+
+        const sf::Image& left = batched.getImage();
+        const sf::Image& right = sequential.getImage();
+        CHECK(std::equal(left.getPixelsPtr(), left.getPixelsPtr() + 180 * 130 * 4, right.getPixelsPtr()));
+    }
+}
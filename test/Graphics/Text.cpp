@@ -0,0 +1,230 @@
+#include <SFML/Graphics/Text.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include "GraphicsUtil.hpp"
+
+#include <doctest.h>
+
+#include <vector>
+
+TEST_CASE("sf::Text class - [graphics]")
+{
+    sf::Font font;
+    REQUIRE(font.loadFromFile(SFML_TEST_FONT));
+
+    sf::RenderTexture renderTexture;
+    REQUIRE(renderTexture.create(400, 300));
+
+    SUBCASE("Layout resumed after a string change")
+    {
+        sf::Text text("First line\nSecond line\nThird line", font, 20);
+        text.setPosition({10, 10});
+        render(renderTexture, text);
+
+        const auto checkSameAsNewText = [&]()
+        {
+            sf::Text expected(text.getString(), font, 20);
+            expected.setPosition({10, 10});
+            CHECK(samePixels(render(renderTexture, text), render(renderTexture, expected)));
+            CHECK(text.getLocalBounds() == expected.getLocalBounds());
+        };
+
+        // Change in the last line
+        text.setString("First line\nSecond line\nThird lane");
+        checkSameAsNewText();
+
+        // Change in the first line, which moves the next ones
+        text.setString("First\nlonger line\nSecond line\nThird lane");
+        checkSameAsNewText();
+
+        // Appended lines
+        text.appendString("\nFourth line");
+        checkSameAsNewText();
+
+        // Removed lines
+        text.setString("First");
+        checkSameAsNewText();
+    }
+
+    SUBCASE("Layout rebuilt after a character size change")
+    {
+        sf::Text text("Hello\nWorld", font, 30);
+        render(renderTexture, text);
+
+        text.setCharacterSize(60);
+        render(renderTexture, text);
+
+        sf::Text expected("Hello\nWorld", font, 60);
+        render(renderTexture, expected);
+        CHECK(text.getLocalBounds() == expected.getLocalBounds());
+        CHECK(samePixels(render(renderTexture, text), render(renderTexture, expected)));
+    }
+
+    SUBCASE("Layout rebuilt after a font change")
+    {
+        sf::Font otherFont;
+        REQUIRE(otherFont.loadFromFile(SFML_TEST_FONT));
+
+        sf::Text text("Hello\nWorld", font, 30);
+        render(renderTexture, text);
+
+        // The glyphs of the other font are on a different texture
+        text.setFont(otherFont);
+        text.setCharacterSize(40);
+        render(renderTexture, text);
+
+        sf::Text expected("Hello\nWorld", otherFont, 40);
+        render(renderTexture, expected);
+        CHECK(text.getLocalBounds() == expected.getLocalBounds());
+        CHECK(samePixels(render(renderTexture, text), render(renderTexture, expected)));
+    }
+
+    SUBCASE("Layout rebuilt after a style change")
+    {
+        sf::Text text("Hello\nWorld", font, 30);
+        render(renderTexture, text);
+
+        text.setStyle(sf::Text::Bold | sf::Text::Underlined);
+        text.setOutlineThickness(2);
+        render(renderTexture, text);
+
+        sf::Text expected("Hello\nWorld", font, 30);
+        expected.setStyle(sf::Text::Bold | sf::Text::Underlined);
+        expected.setOutlineThickness(2);
+        render(renderTexture, expected);
+        CHECK(text.getLocalBounds() == expected.getLocalBounds());
+        CHECK(samePixels(render(renderTexture, text), render(renderTexture, expected)));
+    }
+
+    SUBCASE("Character index")
+    {
+        sf::Text text("Hello world\nSecond line\n\nLast", font, 20);
+        const float lineSpacing = font.getLineSpacing(20);
+
+        // The index of a point just after the position of a character is the index of the character
+        const auto checkIndices = [&]()
+        {
+            for (std::size_t i = 0; i < text.getString().getSize(); ++i)
+            {
+                const sf::Vector2f local = text.getInverseTransform().transformPoint(text.findCharacterPos(i));
+                CHECK(text.findCharacterIndex(text.getTransform().transformPoint(local + sf::Vector2f(1, lineSpacing / 2))) == i);
+            }
+        };
+
+        checkIndices();
+
+        // Positions past the end of a line give the index of its line break, or of the end of the string
+        CHECK(text.findCharacterIndex({1000, lineSpacing / 2}) == 11);
+        CHECK(text.findCharacterIndex({1000, lineSpacing * 2.5f}) == 24);
+        CHECK(text.findCharacterIndex({1000, lineSpacing * 10}) == text.getString().getSize());
+        CHECK(text.findCharacterIndex({-10, -10}) == 0);
+
+        // Transformed texts
+        text.setPosition({50, 30});
+        text.setScale({2, 1.5f});
+        text.setRotation(sf::degrees(20));
+        checkIndices();
+
+        // Empty string
+        text.setString("");
+        CHECK(text.findCharacterIndex({10, 10}) == 0);
+    }
+
+    SUBCASE("Wrapped string")
+    {
+        const sf::String string = "The quick brown fox jumps over the lazy dog\nand then an extraordinarily long word";
+        const sf::Text text(string, font, 20);
+
+        // Width of each line of a string, without its trailing spaces
+        const auto getLineWidths = [&](const sf::String& lines)
+        {
+            const sf::Text measured(lines, font, 20);
+            std::vector<float> widths;
+            std::size_t end = 0;
+            for (std::size_t i = 0; i <= lines.getSize(); ++i)
+            {
+                if ((i == lines.getSize()) || (lines[i] == '\n'))
+                {
+                    widths.push_back(measured.findCharacterPos(end).x);
+                    end = i + 1;
+                }
+                else if (lines[i] != ' ')
+                {
+                    end = i + 1;
+                }
+            }
+            return widths;
+        };
+
+        for (float width : {400.f, 150.f, 60.f})
+        {
+            const sf::String wrapped = text.getWrappedString(width);
+            for (float lineWidth : getLineWidths(wrapped))
+                CHECK(lineWidth <= width);
+
+            // Line breaks only replace spaces, or are inserted in words that don't fit on a line
+            sf::String unwrapped;
+            for (std::size_t i = 0, j = 0; i < wrapped.getSize(); ++i)
+            {
+                if ((wrapped[i] == '\n') && (string[j] != '\n') && (string[j] != ' '))
+                    continue;
+
+                unwrapped += (wrapped[i] == '\n') ? string[j] : wrapped[i];
+                ++j;
+            }
+            CHECK(unwrapped == string);
+        }
+
+        // A large enough width keeps the string
+        CHECK(text.getWrappedString(1000) == string);
+
+        // Words are only broken when they don't fit on a line of their own
+        const sf::String wrapped = text.getWrappedString(60);
+        CHECK(wrapped.find("extraordinarily") == sf::String::InvalidPos);
+        CHECK(wrapped.find("quick") != sf::String::InvalidPos);
+        CHECK(wrapped.find("jumps") != sf::String::InvalidPos);
+
+        // The text itself is not modified
+        CHECK(text.getString() == string);
+    }
+
+    SUBCASE("Measured bounds")
+    {
+        // The bounds measured before the geometry is built are the bounds of the geometry
+        const auto checkMeasuredBounds = [&](sf::Text& text)
+        {
+            const sf::FloatRect measured = text.getLocalBounds();
+            render(renderTexture, text);
+            CHECK(text.getLocalBounds() == measured);
+        };
+
+        sf::Text text("Hello\tWorld\nSecond  line\n", font, 30);
+        checkMeasuredBounds(text);
+
+        for (sf::Uint32 style : {sf::Uint32{sf::Text::Bold}, sf::Uint32{sf::Text::Italic}, sf::Uint32{sf::Text::Underlined}, sf::Uint32{sf::Text::StrikeThrough},
+                                 sf::Uint32{sf::Text::Bold | sf::Text::Italic | sf::Text::Underlined | sf::Text::StrikeThrough}})
+        {
+            text.setStyle(style);
+            checkMeasuredBounds(text);
+
+            text.setOutlineThickness(3);
+            checkMeasuredBounds(text);
+
+            text.setOutlineThickness(0);
+            text.setLetterSpacing(2);
+            text.setLineSpacing(1.5f);
+            checkMeasuredBounds(text);
+
+            text.setLetterSpacing(1);
+            text.setLineSpacing(1);
+        }
+
+        // Strings without glyphs
+        text.setString("");
+        checkMeasuredBounds(text);
+        text.setString("  \n ");
+        text.setStyle(sf::Text::Regular);
+        checkMeasuredBounds(text);
+    }
+}
@@ -0,0 +1,113 @@
+#include <SFML/Graphics/TextBatch.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include "GraphicsUtil.hpp"
+
+#include <doctest.h>
+
+#include <algorithm>
+
+namespace
+{
+    // Smallest rectangle that contains both rectangles
+    sf::FloatRect merge(const sf::FloatRect& left, const sf::FloatRect& right)
+    {
+        const float minX = std::min(left.left, right.left);
+        const float minY = std::min(left.top, right.top);
+        const float maxX = std::max(left.left + left.width, right.left + right.width);
+        const float maxY = std::max(left.top + left.height, right.top + right.height);
+        return sf::FloatRect({minX, minY}, {maxX - minX, maxY - minY});
+    }
+}
+
+TEST_CASE("sf::TextBatch class - [graphics]")
+{
+    sf::Font font;
+    REQUIRE(font.loadFromFile(SFML_TEST_FONT));
+
+    sf::RenderTexture renderTexture;
+    REQUIRE(renderTexture.create(400, 300));
+
+    SUBCASE("Bounds")
+    {
+        sf::TextBatch batch;
+        CHECK(batch.getBounds() == sf::FloatRect());
+
+        // Texts without geometry don't change the bounds
+        batch.append(sf::Text("", font, 20));
+        batch.append(sf::Text(" \n ", font, 20));
+        CHECK(batch.getBounds() == sf::FloatRect());
+
+        // The bounds of a single text don't include the origin of the batch
+        sf::Text first("First", font, 20);
+        first.setPosition({100, 120});
+        batch.append(first);
+        CHECK(batch.getBounds() == first.getGlobalBounds());
+        CHECK(batch.getBounds().left > 100);
+        CHECK(batch.getBounds().top > 120);
+
+        sf::Text second("Second\nline", font, 30);
+        second.setPosition({250, 40});
+        second.setRotation(sf::degrees(10));
+        batch.append(second);
+        CHECK(batch.getBounds() == merge(first.getGlobalBounds(), second.getGlobalBounds()));
+
+        // Clearing resets the bounds: the next text alone defines them
+        batch.clear();
+        CHECK(batch.getBounds() == sf::FloatRect());
+        batch.append(second);
+        CHECK(batch.getBounds() == second.getGlobalBounds());
+    }
+
+    SUBCASE("Rendering")
+    {
+        sf::Font otherFont;
+        REQUIRE(otherFont.loadFromFile(SFML_TEST_FONT));
+
+        sf::Text first("Hello", font, 20);
+        first.setPosition({10, 10});
+        first.setFillColor(sf::Color::Red);
+
+        sf::Text second("World", font, 40);
+        second.setPosition({50, 100});
+        second.setOutlineThickness(2);
+        second.setOutlineColor(sf::Color::Blue);
+
+        sf::Text third("Other font", otherFont, 20);
+        third.setPosition({200, 200});
+        third.setStyle(sf::Text::Underlined);
+
+        sf::TextBatch batch;
+        batch.append(first);
+        batch.append(second);
+        batch.append(third);
+
+        // The batch renders the same pixels as the texts drawn one after the other
+        renderTexture.clear();
+        renderTexture.draw(first);
+        renderTexture.draw(second);
+        renderTexture.draw(third);
+        renderTexture.display();
+        const sf::Image expected = renderTexture.getTexture().copyToImage();
+        CHECK(samePixels(render(renderTexture, batch), expected));
+
+        // The batch is a copy: changing the texts has no effect
+        first.setString("Changed");
+        CHECK(samePixels(render(renderTexture, batch), expected));
+
+        // Strings appended without a text are laid out like a text at the same position
+        sf::Text text("Label 42", font, 30);
+        text.setPosition({20, 150});
+        text.setFillColor(sf::Color::Green);
+        text.setStyle(sf::Text::Bold);
+
+        batch.clear();
+        CHECK(samePixels(render(renderTexture, batch), render(renderTexture, sf::Text())));
+        batch.append("Label 41", font, 30, {20, 150}, sf::Color::Green, sf::Text::Bold);
+        batch.clear();
+        batch.append("Label 42", font, 30, {20, 150}, sf::Color::Green, sf::Text::Bold);
+        CHECK(batch.getBounds() == text.getGlobalBounds());
+        CHECK(samePixels(render(renderTexture, batch), render(renderTexture, text)));
+    }
+}
@@ -0,0 +1,200 @@
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/System/MemoryInputStream.hpp>
+#include <SFML/Window/Context.hpp>
+#include <SFML/Window/GlResource.hpp>
+#include "GraphicsUtil.hpp"
+
+#include <doctest.h>
+
+#include <array>
+#include <condition_variable>
+#include <filesystem>
+#include <fstream>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // Blocks the threads that call wait() until all of them have called it
+    class Barrier
+    {
+    public:
+
+        explicit Barrier(std::size_t count) :
+        m_count(count)
+        {
+        }
+
+        void wait()
+        {
+            std::unique_lock lock(m_mutex);
+            const std::size_t generation = m_generation;
+            if (++m_waiting == m_count)
+            {
+                m_waiting = 0;
+                ++m_generation;
+                m_condition.notify_all();
+            }
+            else
+            {
+                m_condition.wait(lock, [&] { return m_generation != generation; });
+            }
+        }
+
+    private:
+
+        std::mutex              m_mutex;
+        std::condition_variable m_condition;
+        std::size_t             m_count;
+        std::size_t             m_waiting = 0;
+        std::size_t             m_generation = 0;
+    };
+
+    // Holds a transient context during its lifetime, like the texture functions do
+    struct TransientContextHolder : sf::GlResource
+    {
+        TransientContextLock lock;
+    };
+}
+
+TEST_CASE("sf::Texture class - [graphics]")
+{
+    SUBCASE("Loading from files, memory and streams")
+    {
+        // Pattern with varying colors and alphas
+        sf::Image pattern;
+        pattern.create(13, 9);
+        for (unsigned int y = 0; y < 9; ++y)
+        {
+            for (unsigned int x = 0; x < 13; ++x)
+                pattern.setPixel(x, y, sf::Color(static_cast<sf::Uint8>(x * 19), static_cast<sf::Uint8>(y * 28), 150, static_cast<sf::Uint8>(255 - x * y)));
+        }
+
+        const std::filesystem::path path = std::filesystem::temp_directory_path() / "sfml-texture-test.png";
+
+        // The files saved from images of each pixel format are uploaded like the images they decode to
+        for (sf::PixelFormat format : {sf::R8, sf::RG8, sf::RGB8, sf::RGBA8, sf::R16, sf::RGBA16F, sf::RGBA32F})
+        {
+            std::vector<sf::Uint8> buffer;
+            REQUIRE(pattern.convert(format).saveToMemory(buffer, "png"));
+            {
+                std::ofstream file(path, std::ios::binary);
+                file.write(reinterpret_cast<const char*>(buffer.data()), static_cast<std::streamsize>(buffer.size()));
+            }
+
+            sf::Image decoded;
+            REQUIRE(decoded.loadFromMemory(buffer.data(), buffer.size()));
+
+            for (const sf::IntRect& area : {sf::IntRect(), sf::IntRect({2, 3}, {5, 4})})
+            {
+                sf::Texture expected;
+                REQUIRE(expected.loadFromImage(decoded, area));
+                const sf::Image expectedPixels = expected.copyToImage();
+
+                sf::Texture fromFile;
+                REQUIRE(fromFile.loadFromFile(path, area));
+                CHECK(samePixels(fromFile.copyToImage(), expectedPixels));
+
+                sf::Texture fromMemory;
+                REQUIRE(fromMemory.loadFromMemory(buffer.data(), buffer.size(), area));
+                CHECK(samePixels(fromMemory.copyToImage(), expectedPixels));
+
+                sf::MemoryInputStream stream;
+                stream.open(buffer.data(), buffer.size());
+                sf::Texture fromStream;
+                REQUIRE(fromStream.loadFromStream(stream, area));
+                CHECK(samePixels(fromStream.copyToImage(), expectedPixels));
+            }
+        }
+
+        std::filesystem::remove(path);
+
+        // A failed load leaves the texture unchanged
+        sf::Texture texture;
+        REQUIRE(texture.loadFromImage(pattern));
+        const sf::Uint8 garbage[] = {1, 2, 3, 4};
+        CHECK(!texture.loadFromMemory(garbage, sizeof(garbage)));
+        CHECK(samePixels(texture.copyToImage(), pattern));
+    }
+
+    SUBCASE("Loading on several threads")
+    {
+        sf::Texture texture;
+        REQUIRE(texture.create(1, 1));
+
+        const sf::Context::Statistics before = sf::Context::getStatistics();
+
+        // Threads without active context borrow transient contexts, which share the textures
+        std::array<sf::Texture, 4> textures;
+        std::array<bool, 4> loaded{};
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < textures.size(); ++i)
+        {
+            threads.emplace_back([&textures, &loaded, i]
+            {
+                sf::Image image;
+                image.create(8, 8, sf::Color(static_cast<sf::Uint8>(i * 60), 10, 20));
+                loaded[i] = textures[i].loadFromImage(image);
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        for (std::size_t i = 0; i < textures.size(); ++i)
+        {
+            CHECK(loaded[i]);
+            CHECK(textures[i].copyToImage().getPixel(4, 4) == sf::Color(static_cast<sf::Uint8>(i * 60), 10, 20));
+        }
+
+        const sf::Context::Statistics after = sf::Context::getStatistics();
+        CHECK(after.lockCount > before.lockCount);
+        CHECK(after.contendedLockCount <= after.lockCount);
+        CHECK(after.transientContextCount >= 1);
+    }
+
+    SUBCASE("Simultaneous operations on several threads")
+    {
+        // No other resource is alive: the pool of transient contexts starts empty
+        const sf::Context::Statistics before = sf::Context::getStatistics();
+        sf::Texture texture;
+        REQUIRE(texture.create(1, 1));
+
+        // Both threads are in the middle of a texture operation at the same time
+        Barrier barrier(2);
+        std::array<sf::Texture, 2> textures;
+        std::array<bool, 2> loaded{};
+        std::array<sf::Uint64, 2> contextIds{};
+        std::vector<std::thread> threads;
+        for (std::size_t i = 0; i < textures.size(); ++i)
+        {
+            threads.emplace_back([&textures, &loaded, &contextIds, &barrier, i]
+            {
+                const TransientContextHolder holder;
+
+                sf::Image image;
+                image.create(4, 4, sf::Color(static_cast<sf::Uint8>(i * 100), 20, 30));
+                loaded[i] = textures[i].loadFromImage(image);
+
+                barrier.wait();
+                contextIds[i] = sf::Context::getActiveContextId();
+                barrier.wait();
+            });
+        }
+
+        for (std::thread& thread : threads)
+            thread.join();
+
+        CHECK(loaded[0]);
+        CHECK(loaded[1]);
+        CHECK(contextIds[0] != 0);
+        CHECK(contextIds[1] != 0);
+        CHECK(contextIds[0] != contextIds[1]);
+        CHECK(textures[1].copyToImage().getPixel(2, 2) == sf::Color(100, 20, 30));
+
+        const sf::Context::Statistics after = sf::Context::getStatistics();
+        CHECK(after.transientContextCount >= before.transientContextCount + 2);
+    }
+}
@@ -0,0 +1,126 @@
+#include <SFML/Graphics/TileMap.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/Texture.hpp>
+#include <SFML/Graphics/View.hpp>
+#include "GraphicsUtil.hpp"
+
+#include <doctest.h>
+
+#include <vector>
+
+TEST_CASE("sf::TileMap class - [graphics]")
+{
+    SUBCASE("Construction")
+    {
+        sf::TileMap map;
+        CHECK(map.getSize() == sf::Vector2u());
+        CHECK(map.getLayerCount() == 0);
+        CHECK(map.getTileset() == nullptr);
+        CHECK(!map.create({0, 10}, {16, 16}));
+        CHECK(!map.create({10, 10}, {16, 16}, 0));
+        CHECK(!map.create({10, 10}, {2048, 16}));
+
+        REQUIRE(map.create({40, 3}, {4, 8}, 2));
+        CHECK(map.getSize() == sf::Vector2u(40, 3));
+        CHECK(map.getTileSize() == sf::Vector2u(4, 8));
+        CHECK(map.getLayerCount() == 2);
+        CHECK(map.getLocalBounds() == sf::FloatRect({0, 0}, {160, 24}));
+        CHECK(map.getTile(1, {39, 2}) == 0);
+    }
+
+    SUBCASE("Tiles")
+    {
+        sf::TileMap map;
+        REQUIRE(map.create({40, 3}, {4, 4}, 2));
+
+        map.setTile(1, {35, 2}, 7);
+        CHECK(map.getTile(1, {35, 2}) == 7);
+        CHECK(map.getTile(0, {35, 2}) == 0);
+
+        // Out of range
+        map.setTile(2, {0, 0}, 1);
+        map.setTile(0, {40, 0}, 1);
+        CHECK(map.getTile(2, {0, 0}) == 0);
+        CHECK(map.getTile(0, {40, 0}) == 0);
+
+        const std::vector<sf::Uint16> layer(40 * 3, 3);
+        map.setTiles(0, layer.data());
+        CHECK(map.getTile(0, {0, 0}) == 3);
+        CHECK(map.getTile(0, {39, 2}) == 3);
+        CHECK(map.getTile(1, {0, 0}) == 0);
+    }
+
+    SUBCASE("Drawing")
+    {
+        // Tileset of three 4x4 tiles: red, green, blue
+        sf::Image image;
+        image.create(12, 4, sf::Color::Red);
+        for (unsigned int y = 0; y < 4; ++y)
+        {
+            for (unsigned int x = 0; x < 4; ++x)
+            {
+                image.setPixel(4 + x, y, sf::Color::Green);
+                image.setPixel(8 + x, y, sf::Color::Blue);
+            }
+        }
+
+        sf::Texture tileset;
+        REQUIRE(tileset.loadFromImage(image));
+
+        sf::TileMap map;
+        REQUIRE(map.create({40, 3}, {4, 4}, 2));
+        map.setTileset(tileset);
+        map.setTile(0, {0, 0}, 1);
+        map.setTile(0, {1, 0}, 2);
+        map.setTile(0, {33, 1}, 3);
+        map.setTile(1, {33, 1}, 1);
+
+        sf::RenderTexture renderTexture;
+        REQUIRE(renderTexture.create(160, 12));
+
+        const auto render = [&]()
+        {
+            renderTexture.clear();
+            renderTexture.draw(map);
+            renderTexture.display();
+            return renderTexture.getTexture().copyToImage();
+        };
+
+        sf::Image result = render();
+        CHECK(result.getPixel(1, 1) == sf::Color::Red);
+        CHECK(result.getPixel(6, 2) == sf::Color::Green);
+        CHECK(result.getPixel(10, 2) == sf::Color::Black);
+        CHECK(result.getPixel(134, 6) == sf::Color::Red); // Layer 1 above layer 0, in the second chunk
+
+        // Changing a tile rebuilds its chunk
+        map.setTile(1, {33, 1}, 0);
+        map.setTile(0, {2, 0}, 3);
+        result = render();
+        CHECK(result.getPixel(134, 6) == sf::Color::Blue);
+        CHECK(result.getPixel(10, 2) == sf::Color::Blue);
+
+        // Tiles beyond the last image of the tileset are not drawn
+        map.setTile(0, {3, 0}, 4);
+        map.setTile(0, {4, 0}, 65535);
+        result = render();
+        CHECK(result.getPixel(14, 2) == sf::Color::Black);
+        CHECK(result.getPixel(18, 2) == sf::Color::Black);
+        CHECK(result.getPixel(10, 2) == sf::Color::Blue);
+
+        // Chunks that were not visible for a long time are rebuilt when they are visible again
+        renderTexture.setView(sf::View(sf::FloatRect({0, 0}, {64, 12})));
+        for (int i = 0; i < 1000; ++i)
+            renderTexture.draw(map);
+        renderTexture.setView(renderTexture.getDefaultView());
+        result = render();
+        CHECK(result.getPixel(134, 6) == sf::Color::Blue);
+        CHECK(result.getPixel(1, 1) == sf::Color::Red);
+
+        // Transformed map
+        map.setPosition({-128, 0});
+        result = render();
+        CHECK(result.getPixel(6, 6) == sf::Color::Blue);
+        CHECK(result.getPixel(1, 1) == sf::Color::Black);
+    }
+}
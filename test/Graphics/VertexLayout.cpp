@@ -0,0 +1,118 @@
+#include <SFML/Graphics/VertexLayout.hpp>
+#include <SFML/Graphics/SoftwareRenderTarget.hpp>
+#include <SFML/Graphics/Vertex.hpp>
+#include "GraphicsUtil.hpp"
+
+#include <doctest.h>
+
+#include <algorithm>
+#include <cstddef>
+
+TEST_CASE("sf::VertexLayout class - [graphics]")
+{
+    SUBCASE("Construction")
+    {
+        SUBCASE("Default constructor")
+        {
+            const sf::VertexLayout layout;
+            CHECK(layout.getStride() == sizeof(sf::Vertex));
+            CHECK(layout.getPosition().type == sf::VertexLayout::Float);
+            CHECK(layout.getPosition().offset == 0);
+            REQUIRE(layout.getColor());
+            CHECK(layout.getColor()->offset == 8);
+            REQUIRE(layout.getTexCoords());
+            CHECK(layout.getTexCoords()->type == sf::VertexLayout::Float);
+            CHECK(layout.getTexCoords()->offset == 12);
+            CHECK(layout.getAttributes().empty());
+        }
+
+        SUBCASE("Position constructor")
+        {
+            const sf::VertexLayout layout(6, sf::VertexLayout::HalfFloat, 2);
+            CHECK(layout.getStride() == 6);
+            CHECK(layout.getPosition().type == sf::VertexLayout::HalfFloat);
+            CHECK(layout.getPosition().size == 2);
+            CHECK(layout.getPosition().offset == 2);
+            CHECK(!layout.getColor());
+            CHECK(!layout.getTexCoords());
+        }
+    }
+
+    SUBCASE("Predefined layouts")
+    {
+        CHECK(sizeof(sf::ColoredVertex) == 12);
+        CHECK(sf::VertexLayout::Colored.getStride() == 12);
+        CHECK(sf::VertexLayout::Colored.getColor()->offset == 8);
+        CHECK(!sf::VertexLayout::Colored.getTexCoords());
+
+        CHECK(sizeof(sf::CompactVertex) == 12);
+        CHECK(sf::VertexLayout::Compact.getStride() == 12);
+        CHECK(sf::VertexLayout::Compact.getPosition().type == sf::VertexLayout::Short);
+        CHECK(sf::VertexLayout::Compact.getColor()->offset == 4);
+        CHECK(sf::VertexLayout::Compact.getTexCoords()->type == sf::VertexLayout::Short);
+        CHECK(sf::VertexLayout::Compact.getTexCoords()->offset == 8);
+    }
+
+    SUBCASE("Attributes")
+    {
+        sf::VertexLayout layout(16, sf::VertexLayout::Float, 0);
+        layout.setTexCoords(sf::VertexLayout::UnsignedShort, 8);
+        CHECK(!layout.getTexCoords());
+
+        layout.setTexCoords(sf::VertexLayout::HalfFloat, 8);
+        REQUIRE(layout.getTexCoords());
+        CHECK(layout.getTexCoords()->type == sf::VertexLayout::HalfFloat);
+
+        layout.addAttribute("uv", sf::VertexLayout::UnsignedShort, 2, true, 12);
+        layout.addAttribute("invalid", sf::VertexLayout::Float, 5, false, 0);
+        layout.addAttribute("", sf::VertexLayout::Float, 1, false, 0);
+        REQUIRE(layout.getAttributes().size() == 1);
+        CHECK(layout.getAttributes()[0].name == "uv");
+        CHECK(layout.getAttributes()[0].normalized);
+        CHECK(layout.getAttributes()[0].offset == 12);
+    }
+
+    SUBCASE("Type sizes")
+    {
+        CHECK(sf::VertexLayout::getTypeSize(sf::VertexLayout::Float) == 4);
+        CHECK(sf::VertexLayout::getTypeSize(sf::VertexLayout::HalfFloat) == 2);
+        CHECK(sf::VertexLayout::getTypeSize(sf::VertexLayout::Short) == 2);
+        CHECK(sf::VertexLayout::getTypeSize(sf::VertexLayout::UnsignedShort) == 2);
+        CHECK(sf::VertexLayout::getTypeSize(sf::VertexLayout::UnsignedByte) == 1);
+    }
+
+    SUBCASE("Drawing")
+    {
+        // The same quad in three formats renders the same pixels
+        const sf::Color color(10, 200, 30);
+        const sf::Vertex vertices[] = {{{2, 3}, color}, {{13, 3}, color}, {{2, 9}, color}, {{13, 9}, color}};
+        const sf::CompactVertex compact[] = {{{2, 3}, color, {0, 0}}, {{13, 3}, color, {0, 0}}, {{2, 9}, color, {0, 0}}, {{13, 9}, color, {0, 0}}};
+
+        // Half floats: 2 = 0x4000, 3 = 0x4200, 9 = 0x4880, 13 = 0x4A80
+        const sf::Uint16 half[][2] = {{0x4000, 0x4200}, {0x4A80, 0x4200}, {0x4000, 0x4880}, {0x4A80, 0x4880}};
+
+        sf::SoftwareRenderTarget expected;
+        sf::SoftwareRenderTarget target;
+        REQUIRE(expected.create(16, 16));
+        REQUIRE(target.create(16, 16));
+
+        expected.clear();
+        expected.draw(vertices, 4, sf::TriangleStrip);
+        expected.display();
+
+        target.clear();
+        target.draw(compact, 4, sf::VertexLayout::Compact, sf::TriangleStrip);
+        target.display();
+        CHECK(std::equal(expected.getImage().getPixelsPtr(), expected.getImage().getPixelsPtr() + 16 * 16 * 4, target.getImage().getPixelsPtr()));
+        CHECK(target.getImage().getPixel(2, 3) == color);
+
+        // Vertices without color are white
+        target.clear();
+        target.draw(half, 4, sf::VertexLayout(sizeof(half[0]), sf::VertexLayout::HalfFloat, 0), sf::TriangleStrip);
+        target.display();
+        CHECK(target.getImage().getPixel(2, 3) == sf::Color::White);
+        CHECK(target.getImage().getPixel(12, 8) == sf::Color::White);
+        CHECK(target.getImage().getPixel(13, 8) == sf::Color::Black);
+        CHECK(target.getImage().getPixel(12, 9) == sf::Color::Black);
+    }
+}
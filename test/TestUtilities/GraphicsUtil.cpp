@@ -1,8 +1,11 @@
 // Note: No need to increase compile time by including TestUtilities/Graphics.hpp
 #include <SFML/Graphics/BlendMode.hpp>
 #include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Image.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
 #include <SFML/Graphics/Transform.hpp>
 
+#include <algorithm>
 #include <ostream>
 
 namespace sf
@@ -37,3 +40,20 @@ namespace sf
         return os;
     }
 }
+
+bool samePixels(const sf::Image& left, const sf::Image& right)
+{
+    if ((left.getSize() != right.getSize()) || (left.getPixelFormat() != right.getPixelFormat()))
+        return false;
+
+    const std::size_t size = static_cast<std::size_t>(left.getSize().x) * left.getSize().y * sf::getPixelSize(left.getPixelFormat());
+    return std::equal(left.getPixelsPtr(), left.getPixelsPtr() + size, right.getPixelsPtr());
+}
+
+sf::Image render(sf::RenderTexture& renderTexture, const sf::Drawable& drawable)
+{
+    renderTexture.clear();
+    renderTexture.draw(drawable);
+    renderTexture.display();
+    return renderTexture.getTexture().copyToImage();
+}
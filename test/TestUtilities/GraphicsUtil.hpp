@@ -16,6 +16,9 @@ namespace sf
 {
     struct BlendMode;
     class Color;
+    class Drawable;
+    class Image;
+    class RenderTexture;
     class Transform;
 
     std::ostream& operator <<(std::ostream& os, const BlendMode& blendMode);
@@ -33,4 +36,10 @@ namespace sf
     }
 }
 
+// Utilities for image comparison
+bool samePixels(const sf::Image& left, const sf::Image& right);
+
+// Draw a drawable alone on a render texture, and return the rendered image
+sf::Image render(sf::RenderTexture& renderTexture, const sf::Drawable& drawable);
+
 #endif // SFML_TESTUTILITIES_GRAPHICS_HPP